@@ -17,6 +17,7 @@
 #ifndef CYBER_MESSAGE_MESSAGE_TRAITS_H_
 #define CYBER_MESSAGE_MESSAGE_TRAITS_H_
 
+#include <cstdint>
 #include <string>
 
 #include "cyber/base/macros.h"
@@ -109,6 +110,21 @@ std::string MessageType() {
   return typeid(T).name();
 }
 
+// Publish time of a message with an apollo.common.Header in nanoseconds, 0 if
+// the message has no such header or the time is not set.
+template <typename T>
+auto HeaderTimestampNs(const T& message, int)
+    -> decltype(static_cast<void>(message.header().timestamp_sec()),
+                uint64_t()) {
+  const double timestamp_sec = message.header().timestamp_sec();
+  return timestamp_sec > 0.0 ? static_cast<uint64_t>(timestamp_sec * 1e9) : 0;
+}
+
+template <typename T>
+uint64_t HeaderTimestampNs(const T& message, ...) {
+  return 0;
+}
+
 template <typename T>
 typename std::enable_if<HasSetType<T>::value, void>::type SetTypeName(
     const std::string& type_name, T* message) {
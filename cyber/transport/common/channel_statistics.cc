@@ -0,0 +1,215 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/common/channel_statistics.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+using common::GlobalData;
+
+// Counters are shared between processes, so they must not take locks.
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "uint64_t atomics are not lock free");
+
+struct alignas(64) ChannelStatistics::Entry {
+  // 0 for a free entry.
+  std::atomic<uint64_t> channel_id;
+  std::atomic<uint64_t> msg_count;
+  std::atomic<uint64_t> bytes;
+  std::atomic<uint64_t> last_seq_num;
+  std::atomic<uint64_t> last_time_ns;
+  std::atomic<uint64_t> interval_histogram[kNumIntervalBuckets];
+};
+
+ChannelStatistics::ChannelStatistics() {
+  const char* env = std::getenv("CYBER_CHANNEL_STATISTICS");
+  shm_name_ = env == nullptr ? kDefaultShmName : env;
+  shm_size_ = sizeof(Entry) * kCapacity;
+
+  // Every process using the table holds a shared lock on it. A process that
+  // gets the lock exclusively is the only user, so the table left by an
+  // earlier run is stale and it starts the table over.
+  int fd = -1;
+  bool reset = false;
+  struct stat st;
+  while (true) {
+    fd = shm_open(shm_name_.c_str(), O_RDWR | O_CREAT, 0600);
+    if (fd < 0) {
+      AWARN << "open channel statistics " << shm_name_
+            << " failed: " << strerror(errno);
+      return;
+    }
+    reset = flock(fd, LOCK_EX | LOCK_NB) == 0;
+    if ((!reset && flock(fd, LOCK_SH) < 0) || fstat(fd, &st) < 0) {
+      AWARN << "lock channel statistics " << shm_name_
+            << " failed: " << strerror(errno);
+      close(fd);
+      return;
+    }
+    if (st.st_nlink > 0) {
+      break;
+    }
+    // The last user removed the table after it was opened here.
+    close(fd);
+  }
+  // A zero filled table is empty.
+  if ((reset && (fchmod(fd, 0600) < 0 || ftruncate(fd, 0) < 0)) ||
+      ((reset || static_cast<size_t>(st.st_size) < shm_size_) &&
+       ftruncate(fd, shm_size_) < 0) ||
+      (reset && flock(fd, LOCK_SH) < 0)) {
+    AWARN << "size channel statistics " << shm_name_
+          << " failed: " << strerror(errno);
+    close(fd);
+    return;
+  }
+  void* addr =
+      mmap(nullptr, shm_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (addr == MAP_FAILED) {
+    AWARN << "map channel statistics " << shm_name_
+          << " failed: " << strerror(errno);
+    close(fd);
+    return;
+  }
+  // kept open to hold the lock
+  fd_ = fd;
+  entries_ = static_cast<Entry*>(addr);
+}
+
+ChannelStatistics::~ChannelStatistics() { Shutdown(); }
+
+void ChannelStatistics::Shutdown() {
+  if (entries_ != nullptr) {
+    munmap(entries_, shm_size_);
+    entries_ = nullptr;
+  }
+  if (fd_ >= 0) {
+    // The last user removes the table.
+    if (flock(fd_, LOCK_EX | LOCK_NB) == 0) {
+      shm_unlink(shm_name_.c_str());
+    }
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+ChannelStatistics::Entry* ChannelStatistics::FindEntry(uint64_t channel_id,
+                                                        bool create) const {
+  if (entries_ == nullptr || channel_id == 0) {
+    return nullptr;
+  }
+  const uint64_t start = channel_id % kCapacity;
+  for (uint64_t i = 0; i < kCapacity; ++i) {
+    Entry* entry = &entries_[(start + i) % kCapacity];
+    uint64_t id = entry->channel_id.load(std::memory_order_acquire);
+    if (id == channel_id) {
+      return entry;
+    }
+    if (id == 0) {
+      if (!create) {
+        return nullptr;
+      }
+      if (entry->channel_id.compare_exchange_strong(
+              id, channel_id, std::memory_order_acq_rel) ||
+          id == channel_id) {
+        return entry;
+      }
+    }
+  }
+  if (create) {
+    AWARN_EVERY(1000) << "channel statistics table is full, channel "
+                      << GlobalData::GetChannelById(channel_id)
+                      << " is not counted.";
+  }
+  return nullptr;
+}
+
+int ChannelStatistics::IntervalBucket(uint64_t interval_ns) {
+  uint64_t interval_ms = interval_ns / 1000000;
+  int bucket = 0;
+  while (interval_ms > 0 && bucket < kNumIntervalBuckets - 1) {
+    interval_ms >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+void ChannelStatistics::AddMessage(uint64_t channel_id, uint64_t seq_num,
+                                   uint64_t timestamp_ns) {
+  Entry* entry = FindEntry(channel_id, true);
+  if (entry == nullptr) {
+    return;
+  }
+  entry->msg_count.fetch_add(1, std::memory_order_relaxed);
+  entry->last_seq_num.store(seq_num, std::memory_order_relaxed);
+  if (timestamp_ns == 0) {
+    return;
+  }
+  const uint64_t last = entry->last_time_ns.exchange(timestamp_ns);
+  if (last != 0 && timestamp_ns >= last) {
+    entry->interval_histogram[IntervalBucket(timestamp_ns - last)].fetch_add(
+        1, std::memory_order_relaxed);
+  }
+}
+
+void ChannelStatistics::AddBytes(uint64_t channel_id, size_t bytes) {
+  Entry* entry = FindEntry(channel_id, true);
+  if (entry != nullptr) {
+    entry->bytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+}
+
+bool ChannelStatistics::GetSnapshot(uint64_t channel_id,
+                                    Snapshot* snapshot) const {
+  *snapshot = Snapshot();
+  const Entry* entry = FindEntry(channel_id, false);
+  if (entry == nullptr) {
+    return false;
+  }
+  snapshot->msg_count = entry->msg_count.load(std::memory_order_relaxed);
+  snapshot->bytes = entry->bytes.load(std::memory_order_relaxed);
+  snapshot->last_seq_num = entry->last_seq_num.load(std::memory_order_relaxed);
+  snapshot->last_time_ns = entry->last_time_ns.load(std::memory_order_relaxed);
+  for (int i = 0; i < kNumIntervalBuckets; ++i) {
+    snapshot->interval_histogram[i] =
+        entry->interval_histogram[i].load(std::memory_order_relaxed);
+  }
+  return true;
+}
+
+bool ChannelStatistics::GetSnapshot(const std::string& channel_name,
+                                    Snapshot* snapshot) const {
+  return GetSnapshot(GlobalData::RegisterChannel(channel_name), snapshot);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_TRANSPORT_COMMON_CHANNEL_STATISTICS_H_
+#define CYBER_TRANSPORT_COMMON_CHANNEL_STATISTICS_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+/**
+ * @class ChannelStatistics
+ * @brief Per-channel transmit counters kept in a POSIX shared memory table,
+ * which all processes on the host update when they transmit and which tools
+ * such as the monitor read without subscribing to or deserializing channels.
+ *
+ * The table has a fixed number of entries of atomic counters. A channel claims
+ * the entry at its id, or the next free one, the first time it is written.
+ * Bytes are counted by the transports that serialize the message, so a channel
+ * only delivered within its process has messages but no bytes.
+ *
+ * The table is named by the environment variable CYBER_CHANNEL_STATISTICS, or
+ * kDefaultShmName if it is not set. Only the user who runs the processes may
+ * open it. A process which finds no other process using the table starts it
+ * over, and the last one to leave removes it. Statistics are disabled if the
+ * table cannot be mapped.
+ */
+class ChannelStatistics {
+ public:
+  static constexpr char kDefaultShmName[] = "/apollo_cyber_channel_statistics";
+  static constexpr uint32_t kCapacity = 1024;
+  // Bucket 0 counts intervals below 1ms, bucket i intervals in
+  // [2^(i-1), 2^i) ms, and the last bucket all longer ones.
+  static constexpr int kNumIntervalBuckets = 16;
+
+  struct Snapshot {
+    uint64_t msg_count = 0;
+    uint64_t bytes = 0;
+    uint64_t last_seq_num = 0;
+    // Header time of the last message which has one, in nanoseconds.
+    uint64_t last_time_ns = 0;
+    std::array<uint64_t, kNumIntervalBuckets> interval_histogram{};
+  };
+
+  ~ChannelStatistics();
+
+  bool IsEnabled() const { return entries_ != nullptr; }
+
+  /**
+   * @brief Counts a message on the channel, and its interval to the last one
+   * by the time the message carries, if not 0.
+   */
+  void AddMessage(uint64_t channel_id, uint64_t seq_num,
+                  uint64_t timestamp_ns);
+
+  /**
+   * @brief Counts the serialized bytes of a message on the channel.
+   */
+  void AddBytes(uint64_t channel_id, size_t bytes);
+
+  /**
+   * @brief Reads the counters of a channel.
+   * @return False if statistics are disabled or the channel was never
+   * written, in which case the snapshot is all zeros.
+   */
+  bool GetSnapshot(uint64_t channel_id, Snapshot* snapshot) const;
+  bool GetSnapshot(const std::string& channel_name, Snapshot* snapshot) const;
+
+  static int IntervalBucket(uint64_t interval_ns);
+
+  void Shutdown();
+
+ private:
+  struct Entry;
+
+  Entry* FindEntry(uint64_t channel_id, bool create) const;
+
+  std::string shm_name_;
+  int fd_ = -1;
+  Entry* entries_ = nullptr;
+  size_t shm_size_ = 0;
+
+  DECLARE_SINGLETON(ChannelStatistics)
+};
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_TRANSPORT_COMMON_CHANNEL_STATISTICS_H_
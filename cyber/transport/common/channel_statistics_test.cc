@@ -0,0 +1,163 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/transport/common/channel_statistics.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "cyber/common/global_data.h"
+
+namespace apollo {
+namespace cyber {
+namespace transport {
+
+namespace {
+
+const std::string& TestShmName() {
+  static const std::string name =
+      "/channel_statistics_test_" + std::to_string(getpid());
+  return name;
+}
+
+// Leaves a table of a crashed earlier run, readable by anyone and full of
+// counters, under the test name.
+void CreateStaleTable() {
+  int fd = shm_open(TestShmName().c_str(), O_RDWR | O_CREAT, 0644);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(0, fchmod(fd, 0644));
+  const std::vector<char> junk(4096, 0x11);
+  ASSERT_EQ(junk.size(), write(fd, junk.data(), junk.size()));
+  close(fd);
+}
+
+ChannelStatistics* GetTestStatistics() {
+  static const bool created = [] {
+    CreateStaleTable();
+    setenv("CYBER_CHANNEL_STATISTICS", TestShmName().c_str(), 1);
+    return std::atexit([] { shm_unlink(TestShmName().c_str()); }) == 0;
+  }();
+  (void)created;
+  return ChannelStatistics::Instance();
+}
+
+}  // namespace
+
+TEST(ChannelStatisticsTest, IntervalBucket) {
+  EXPECT_EQ(0, ChannelStatistics::IntervalBucket(0));
+  EXPECT_EQ(0, ChannelStatistics::IntervalBucket(999999));
+  EXPECT_EQ(1, ChannelStatistics::IntervalBucket(1000000));
+  EXPECT_EQ(4, ChannelStatistics::IntervalBucket(10000000));
+  EXPECT_EQ(7, ChannelStatistics::IntervalBucket(100000000));
+  EXPECT_EQ(ChannelStatistics::kNumIntervalBuckets - 1,
+            ChannelStatistics::IntervalBucket(1000000000000));
+}
+
+TEST(ChannelStatisticsTest, Counters) {
+  auto statistics = GetTestStatistics();
+  ASSERT_TRUE(statistics->IsEnabled());
+
+  const uint64_t channel_id =
+      common::GlobalData::RegisterChannel("/channel_statistics/counters");
+  ChannelStatistics::Snapshot snapshot;
+  EXPECT_FALSE(statistics->GetSnapshot(channel_id, &snapshot));
+  EXPECT_EQ(0, snapshot.msg_count);
+
+  statistics->AddMessage(channel_id, 1, 1000000000);
+  statistics->AddBytes(channel_id, 100);
+  statistics->AddMessage(channel_id, 2, 1002000000);
+  statistics->AddBytes(channel_id, 50);
+  ASSERT_TRUE(
+      statistics->GetSnapshot("/channel_statistics/counters", &snapshot));
+  EXPECT_EQ(2, snapshot.msg_count);
+  EXPECT_EQ(150, snapshot.bytes);
+  EXPECT_EQ(2, snapshot.last_seq_num);
+  EXPECT_EQ(1002000000, snapshot.last_time_ns);
+  uint64_t num_intervals = 0;
+  for (int i = 0; i < ChannelStatistics::kNumIntervalBuckets; ++i) {
+    num_intervals += snapshot.interval_histogram[i];
+  }
+  EXPECT_EQ(1, num_intervals);
+  EXPECT_EQ(1, snapshot.interval_histogram[2]);
+
+  // A message without time is counted, but does not end an interval.
+  statistics->AddMessage(channel_id, 3, 0);
+  ASSERT_TRUE(statistics->GetSnapshot(channel_id, &snapshot));
+  EXPECT_EQ(3, snapshot.msg_count);
+  EXPECT_EQ(1002000000, snapshot.last_time_ns);
+
+  // Colliding channel ids take the next entries.
+  const uint64_t colliding_id = channel_id + ChannelStatistics::kCapacity;
+  statistics->AddMessage(colliding_id, 7, 0);
+  ASSERT_TRUE(statistics->GetSnapshot(colliding_id, &snapshot));
+  EXPECT_EQ(1, snapshot.msg_count);
+  EXPECT_EQ(7, snapshot.last_seq_num);
+  ASSERT_TRUE(statistics->GetSnapshot(channel_id, &snapshot));
+  EXPECT_EQ(3, snapshot.msg_count);
+}
+
+TEST(ChannelStatisticsTest, StaleTableStartedOver) {
+  auto statistics = GetTestStatistics();
+  ASSERT_TRUE(statistics->IsEnabled());
+
+  int fd = shm_open(TestShmName().c_str(), O_RDONLY, 0);
+  ASSERT_GE(fd, 0);
+  struct stat st;
+  ASSERT_EQ(0, fstat(fd, &st));
+  close(fd);
+  EXPECT_EQ(0600, st.st_mode & 0777);
+
+  const uint64_t channel_id =
+      common::GlobalData::RegisterChannel("/channel_statistics/stale");
+  ChannelStatistics::Snapshot snapshot;
+  EXPECT_FALSE(statistics->GetSnapshot(channel_id, &snapshot));
+}
+
+TEST(ChannelStatisticsTest, SharedBetweenProcesses) {
+  auto statistics = GetTestStatistics();
+  ASSERT_TRUE(statistics->IsEnabled());
+
+  const uint64_t channel_id =
+      common::GlobalData::RegisterChannel("/channel_statistics/shared");
+  const pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    for (uint64_t seq = 1; seq <= 10; ++seq) {
+      statistics->AddMessage(channel_id, seq, seq * 1000000);
+    }
+    _exit(0);
+  }
+  int status = 0;
+  ASSERT_EQ(pid, waitpid(pid, &status, 0));
+
+  ChannelStatistics::Snapshot snapshot;
+  ASSERT_TRUE(statistics->GetSnapshot(channel_id, &snapshot));
+  EXPECT_EQ(10, snapshot.msg_count);
+  EXPECT_EQ(10, snapshot.last_seq_num);
+}
+
+}  // namespace transport
+}  // namespace cyber
+}  // namespace apollo
@@ -122,7 +122,12 @@ bool RtpsTransmitter<M>::Transmit(const M& msg, const MessageInfo& msg_info) {
   if (participant_->is_shutdown()) {
     return false;
   }
-  return publisher_->write(reinterpret_cast<void*>(&m), wparams);
+  if (!publisher_->write(reinterpret_cast<void*>(&m), wparams)) {
+    return false;
+  }
+  ChannelStatistics::Instance()->AddBytes(this->attr_.channel_id(),
+                                          m.data().size());
+  return true;
 }
 
 }  // namespace transport
@@ -22,6 +22,8 @@
 #include <string>
 
 #include "cyber/event/perf_event_cache.h"
+#include "cyber/message/message_traits.h"
+#include "cyber/transport/common/channel_statistics.h"
 #include "cyber/transport/common/endpoint.h"
 #include "cyber/transport/message/message_info.h"
 
@@ -73,6 +75,9 @@ bool Transmitter<M>::Transmit(const MessagePtr& msg) {
   msg_info_.set_seq_num(NextSeqNum());
   PerfEventCache::Instance()->AddTransportEvent(
       TransPerf::TRANSMIT_BEGIN, attr_.channel_id(), msg_info_.seq_num());
+  ChannelStatistics::Instance()->AddMessage(
+      attr_.channel_id(), msg_info_.seq_num(),
+      message::HeaderTimestampNs(*msg, 0));
   return Transmit(msg, msg_info_);
 }
 
@@ -16,15 +16,18 @@
 
 #include "modules/canbus/canbus_component.h"
 
+#include "cyber/time/clock.h"
 #include "cyber/time/time.h"
 #include "modules/canbus/common/canbus_gflags.h"
 #include "modules/canbus/vehicle/vehicle_factory.h"
 #include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/latency_recorder/latency_tracer.h"
 #include "modules/common/util/util.h"
 #include "modules/drivers/canbus/can_client/can_client_factory.h"
 
 using apollo::common::ErrorCode;
 using apollo::control::ControlCommand;
+using apollo::cyber::Clock;
 using apollo::cyber::Time;
 using apollo::drivers::canbus::CanClientFactory;
 using apollo::guardian::GuardianCommand;
@@ -197,7 +200,9 @@ bool CanbusComponent::Proc() {
 }
 
 void CanbusComponent::OnControlCommand(const ControlCommand &control_command) {
-  int64_t current_timestamp = Time::Now().ToMicrosecond();
+  const auto start_time = Time::Now();
+  const auto trace_begin_time = Clock::Now();
+  int64_t current_timestamp = start_time.ToMicrosecond();
   // if command coming too soon, just ignore it.
   if (current_timestamp - last_timestamp_ < FLAGS_min_cmd_interval * 1000) {
     ADEBUG << "Control command comes too soon. Ignore.\n Required "
@@ -221,6 +226,8 @@ void CanbusComponent::OnControlCommand(const ControlCommand &control_command) {
     return;
   }
   can_sender_.Update();
+  common::LatencyTracer::FinishTrace(control_command.header(), "canbus",
+                                     trace_begin_time);
 }
 
 void CanbusComponent::OnGuardianCommand(
@@ -262,6 +262,10 @@ DEFINE_string(latency_recording_topic, "/apollo/common/latency_records",
               "Latency recording topic.");
 DEFINE_string(latency_reporting_topic, "/apollo/common/latency_reports",
               "Latency reporting topic.");
+DEFINE_string(latency_trace_topic, "/apollo/common/latency_traces",
+              "Latency trace topic.");
+DEFINE_string(scope_profile_topic, "/apollo/common/scope_profiles",
+              "Scope profile reporting topic.");
 DEFINE_string(task_topic, "/apollo/task_manager", "task manager topic name");
 // value: velodyne128, velodyne64, velodyne16
 DEFINE_string(lidar_model_version, "",
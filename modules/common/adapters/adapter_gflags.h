@@ -139,6 +139,10 @@ DECLARE_string(recorder_status_topic);
 DECLARE_string(latency_recording_topic);
 // Latency reporting topic
 DECLARE_string(latency_reporting_topic);
+// Latency trace topic
+DECLARE_string(latency_trace_topic);
+// Scope profile reporting topic
+DECLARE_string(scope_profile_topic);
 
 // It determins which lidar model(16 or 128) to load, if not to set,
 // the model will be loaded by the sensor name. Mainly for D-kit.
@@ -83,6 +83,21 @@ DEFINE_bool(state_transform_to_com_drive, true,
 DEFINE_bool(multithread_run, false,
             "multi-thread run flag mainly used by simulation");
 
+// on by default in the prof build config
+#if defined(ENABLE_PERF)
+constexpr bool kEnableScopeProfiler = true;
+#else
+constexpr bool kEnableScopeProfiler = false;
+#endif
+DEFINE_bool(enable_scope_profiler, kEnableScopeProfiler,
+            "Record the durations of the PERF_FUNCTION and PERF_BLOCK scopes "
+            "in histograms published on scope_profile_topic");
+DEFINE_double(scope_profile_interval, 5.0,
+              "Seconds between two scope profile reports");
+DEFINE_int32(latency_trace_sample_interval, 10,
+             "Trace the latency of one in this number of sensor frames, "
+             "none if 0");
+
 // localization
 DEFINE_bool(enable_map_reference_unify, true,
             "enable IMU data convert to map reference");
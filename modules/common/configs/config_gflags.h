@@ -54,6 +54,10 @@ DECLARE_bool(state_transform_to_com_reverse);
 DECLARE_bool(state_transform_to_com_drive);
 DECLARE_bool(multithread_run);
 
+DECLARE_bool(enable_scope_profiler);
+DECLARE_double(scope_profile_interval);
+DECLARE_int32(latency_trace_sample_interval);
+
 // localizaiton
 DECLARE_bool(enable_map_reference_unify);
 
@@ -0,0 +1,171 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/latency_recorder/latency_tracer.h"
+
+#include "absl/strings/str_cat.h"
+
+#include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/util/message_util.h"
+
+using apollo::cyber::Clock;
+using apollo::cyber::Time;
+
+namespace apollo {
+namespace common {
+
+namespace {
+
+void AppendSpan(const std::string& module_name, uint64_t begin_time,
+                LatencyTrace* trace) {
+  auto* span = trace->add_span();
+  span->set_module_name(module_name);
+  span->set_begin_time(begin_time);
+  span->set_end_time(Clock::Now().ToNanosecond());
+}
+
+// Whether the frame of trace_id is one of the 1 in interval traced. The
+// decision depends on the frame only, so sources sharing a process or a
+// module name are sampled independently, and the trace ids, mostly multiples
+// of a sensor period, are mixed first.
+bool IsSampled(uint64_t trace_id, int interval) {
+  uint64_t hash = trace_id;
+  hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+  hash ^= hash >> 31;
+  return hash % static_cast<uint64_t>(interval) == 0;
+}
+
+}  // namespace
+
+LatencyTracer::LatencyTracer() {}
+
+bool LatencyTracer::StartTrace(const std::string& module_name,
+                               uint64_t trace_id, const Time& begin_time,
+                               Header* header) {
+  const int interval = FLAGS_latency_trace_sample_interval;
+  if (interval <= 0 || trace_id == 0 || !IsSampled(trace_id, interval)) {
+    header->clear_latency_trace();
+    return false;
+  }
+  auto* trace = header->mutable_latency_trace();
+  trace->Clear();
+  trace->set_trace_id(trace_id);
+  AppendSpan(module_name, begin_time.ToNanosecond(), trace);
+  return true;
+}
+
+bool LatencyTracer::ContinueTrace(const Header& input,
+                                  const std::string& module_name,
+                                  const Time& begin_time, Header* output) {
+  if (!input.has_latency_trace() ||
+      !Instance()->IsFirstOutput(module_name,
+                                 input.latency_trace().trace_id())) {
+    output->clear_latency_trace();
+    return false;
+  }
+  auto* trace = output->mutable_latency_trace();
+  trace->CopyFrom(input.latency_trace());
+  AppendSpan(module_name, begin_time.ToNanosecond(), trace);
+  return true;
+}
+
+void LatencyTracer::StashTrace(const Header& input, const Time& begin_time) {
+  if (!input.has_latency_trace()) {
+    return;
+  }
+  LatencyTracer* tracer = Instance();
+  std::lock_guard<std::mutex> lock(tracer->mutex_);
+  StashedTrace& stashed =
+      tracer->stashed_traces_[input.latency_trace().trace_id()];
+  stashed.trace = input.latency_trace();
+  stashed.begin_time = begin_time.ToNanosecond();
+  if (tracer->stashed_traces_.size() > kMaxStashedTraces) {
+    tracer->stashed_traces_.erase(tracer->stashed_traces_.begin());
+  }
+}
+
+bool LatencyTracer::ContinueStashedTrace(uint64_t trace_id,
+                                         const std::string& module_name,
+                                         Header* output) {
+  output->clear_latency_trace();
+  LatencyTracer* tracer = Instance();
+  std::lock_guard<std::mutex> lock(tracer->mutex_);
+  auto iter = tracer->stashed_traces_.find(trace_id);
+  if (iter == tracer->stashed_traces_.end()) {
+    return false;
+  }
+  auto* trace = output->mutable_latency_trace();
+  trace->Swap(&iter->second.trace);
+  AppendSpan(module_name, iter->second.begin_time, trace);
+  tracer->stashed_traces_.erase(iter);
+  return true;
+}
+
+void LatencyTracer::FinishTrace(const Header& input,
+                                const std::string& module_name,
+                                const Time& begin_time) {
+  if (!input.has_latency_trace()) {
+    return;
+  }
+  LatencyTracer* tracer = Instance();
+  if (!tracer->IsFirstOutput(module_name, input.latency_trace().trace_id())) {
+    return;
+  }
+  LatencyTrace trace = input.latency_trace();
+  AppendSpan(module_name, begin_time.ToNanosecond(), &trace);
+
+  std::lock_guard<std::mutex> lock(tracer->mutex_);
+  tracer->traces_.add_latency_traces()->Swap(&trace);
+  const auto now = Clock::Now();
+  const apollo::cyber::Duration kPublishInterval(3.0);
+  if (now - tracer->published_time_ > kPublishInterval) {
+    tracer->PublishTraces(module_name);
+    tracer->published_time_ = now;
+  }
+}
+
+bool LatencyTracer::IsFirstOutput(const std::string& module_name,
+                                  uint64_t trace_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t& last_trace_id = last_trace_ids_[module_name];
+  if (trace_id == last_trace_id) {
+    return false;
+  }
+  last_trace_id = trace_id;
+  return true;
+}
+
+void LatencyTracer::PublishTraces(const std::string& module_name) {
+  if (writer_ == nullptr) {
+    node_ = apollo::cyber::CreateNode(absl::StrCat(
+        "latency_tracer", module_name, Clock::Now().ToNanosecond()));
+    if (node_ == nullptr) {
+      AERROR << "unable to create node for latency traces";
+      traces_.clear_latency_traces();
+      return;
+    }
+    writer_ = node_->CreateWriter<LatencyTraceMap>(FLAGS_latency_trace_topic);
+  }
+  traces_.set_module_name(module_name);
+  apollo::common::util::FillHeader("LatencyTracer", &traces_);
+  writer_->Write(traces_);
+  traces_.clear_latency_traces();
+}
+
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "cyber/cyber.h"
+
+#include "modules/common/latency_recorder/proto/latency_record.pb.h"
+#include "modules/common_msgs/basic_msgs/header.pb.h"
+
+namespace apollo {
+namespace common {
+
+/**
+ * @class LatencyTracer
+ * @brief Traces one in FLAGS_latency_trace_sample_interval sensor frames from
+ * their measurement to the control command sent on the CAN bus. The source
+ * starts the trace in the header of its output, each module copies the
+ * trace of its input header to its first output for the frame with its own
+ * span appended, and canbus finishes it. The finished traces are published
+ * on FLAGS_latency_trace_topic. Messages of the frames which are not sampled
+ * carry no trace, so following them costs a has_latency_trace check.
+ *
+ * Span times are cyber::Clock nanoseconds, begin_time included, so that the
+ * stages of a trace compare in simulation too.
+ */
+class LatencyTracer {
+ public:
+  /**
+   * @brief Start the trace of the frame measured at trace_id, in
+   * nanoseconds, if it is sampled. Frames are sampled by trace_id.
+   * @return true if the frame is traced.
+   */
+  static bool StartTrace(const std::string& module_name, uint64_t trace_id,
+                         const apollo::cyber::Time& begin_time,
+                         Header* header);
+
+  /**
+   * @brief Copy the trace of input, if any, to output with the span of
+   * module_name from begin_time to now appended. Only the first output of
+   * a module for a trace carries it.
+   * @return true if output is traced.
+   */
+  static bool ContinueTrace(const Header& input,
+                            const std::string& module_name,
+                            const apollo::cyber::Time& begin_time,
+                            Header* output);
+
+  /**
+   * @brief Keep the trace of input, if any, for ContinueStashedTrace in the
+   * same process, where the frame goes through stages without a header.
+   */
+  static void StashTrace(const Header& input,
+                         const apollo::cyber::Time& begin_time);
+
+  /**
+   * @brief Copy the trace stashed for trace_id, if any, to output with the
+   * span of module_name from the stash begin_time to now appended.
+   * @return true if output is traced.
+   */
+  static bool ContinueStashedTrace(uint64_t trace_id,
+                                   const std::string& module_name,
+                                   Header* output);
+
+  /**
+   * @brief Append the span of module_name from begin_time to now to the
+   * trace of input, if any, and queue it for publishing.
+   */
+  static void FinishTrace(const Header& input, const std::string& module_name,
+                          const apollo::cyber::Time& begin_time);
+
+ private:
+  struct StashedTrace {
+    LatencyTrace trace;
+    uint64_t begin_time = 0;
+  };
+
+  // The oldest stashed traces beyond, of frames dropped on the way, go.
+  static constexpr size_t kMaxStashedTraces = 16;
+
+  // Whether trace_id differs from the last trace module_name continued.
+  bool IsFirstOutput(const std::string& module_name, uint64_t trace_id);
+  void PublishTraces(const std::string& module_name);
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, uint64_t> last_trace_ids_;
+  std::map<uint64_t, StashedTrace> stashed_traces_;
+  LatencyTraceMap traces_;
+  apollo::cyber::Time published_time_;
+  std::shared_ptr<apollo::cyber::Node> node_;
+  std::shared_ptr<apollo::cyber::Writer<LatencyTraceMap>> writer_;
+
+  DECLARE_SINGLETON(LatencyTracer)
+};
+
+}  // namespace common
+}  // namespace apollo
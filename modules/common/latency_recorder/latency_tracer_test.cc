@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/latency_recorder/latency_tracer.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/common/configs/config_gflags.h"
+
+namespace apollo {
+namespace common {
+
+using apollo::cyber::Time;
+
+TEST(LatencyTracerTest, Sampling) {
+  Header header;
+  FLAGS_latency_trace_sample_interval = 0;
+  EXPECT_FALSE(LatencyTracer::StartTrace("lidar", 100, Time(90), &header));
+  EXPECT_FALSE(header.has_latency_trace());
+
+  // lidar frames every 100 ms, sampled by trace id whoever starts them
+  FLAGS_latency_trace_sample_interval = 10;
+  const uint64_t kFirstId = 1700000000000000000ULL;
+  const uint64_t kPeriod = 100000000ULL;
+  int traced = 0;
+  for (uint64_t i = 0; i < 3000; ++i) {
+    const uint64_t id = kFirstId + i * kPeriod;
+    const bool lidar_traced =
+        LatencyTracer::StartTrace("lidar", id, Time(id), &header);
+    if (lidar_traced) {
+      ++traced;
+      EXPECT_EQ(id, header.latency_trace().trace_id());
+    } else {
+      EXPECT_FALSE(header.has_latency_trace());
+    }
+    Header other_header;
+    EXPECT_EQ(lidar_traced, LatencyTracer::StartTrace("other_lidar", id,
+                                                      Time(id), &other_header));
+  }
+  EXPECT_GT(traced, 240);
+  EXPECT_LT(traced, 360);
+}
+
+TEST(LatencyTracerTest, Propagation) {
+  FLAGS_latency_trace_sample_interval = 1;
+  Header lidar_header;
+  ASSERT_TRUE(
+      LatencyTracer::StartTrace("lidar", 1000, Time(1100), &lidar_header));
+  ASSERT_EQ(1, lidar_header.latency_trace().span_size());
+  EXPECT_EQ("lidar", lidar_header.latency_trace().span(0).module_name());
+  EXPECT_EQ(1100, lidar_header.latency_trace().span(0).begin_time());
+
+  // perception goes through stages without a header
+  LatencyTracer::StashTrace(lidar_header, Time(1200));
+  Header perception_header;
+  EXPECT_FALSE(LatencyTracer::ContinueStashedTrace(999, "perception",
+                                                   &perception_header));
+  ASSERT_TRUE(LatencyTracer::ContinueStashedTrace(1000, "perception",
+                                                  &perception_header));
+  ASSERT_EQ(2, perception_header.latency_trace().span_size());
+  EXPECT_EQ(1200, perception_header.latency_trace().span(1).begin_time());
+  Header stale_header;
+  EXPECT_FALSE(
+      LatencyTracer::ContinueStashedTrace(1000, "perception", &stale_header));
+  EXPECT_FALSE(stale_header.has_latency_trace());
+
+  // only the first output of a module for the frame carries the trace
+  Header planning_header;
+  EXPECT_TRUE(LatencyTracer::ContinueTrace(perception_header, "planning",
+                                           Time(1300), &planning_header));
+  ASSERT_EQ(3, planning_header.latency_trace().span_size());
+  EXPECT_EQ("planning", planning_header.latency_trace().span(2).module_name());
+  EXPECT_EQ(1000, planning_header.latency_trace().trace_id());
+  Header next_planning_header = planning_header;
+  EXPECT_FALSE(LatencyTracer::ContinueTrace(perception_header, "planning",
+                                            Time(1400), &next_planning_header));
+  EXPECT_FALSE(next_planning_header.has_latency_trace());
+
+  Header untraced_header;
+  EXPECT_FALSE(LatencyTracer::ContinueTrace(untraced_header, "control",
+                                            Time(1500), &planning_header));
+  EXPECT_FALSE(planning_header.has_latency_trace());
+}
+
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "cyber/cyber.h"
+#include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/scope_profiler/scope_profiler.h"
+
+DEFINE_string(scope_profile_module, "",
+              "Only print the reports of this module, all if empty.");
+
+using apollo::common::ScopeProfile;
+using apollo::common::ScopeProfileReport;
+using apollo::common::ScopeStats;
+
+namespace {
+
+std::mutex totals_mutex;
+// the stats of every report so far, by module and scope name
+std::map<std::pair<std::string, std::string>, ScopeStats> totals;
+
+void PrintRow(const std::string& module_name, const std::string& scope_name,
+              const ScopeStats& stats) {
+  printf("%-16s %10lu %10.1f %10.1f %10.1f %10.1f  %s\n", module_name.c_str(),
+         static_cast<unsigned long>(stats.count),  // NOLINT
+         static_cast<double>(stats.Percentile(0.5)) / 1e3,
+         static_cast<double>(stats.Percentile(0.99)) / 1e3,
+         static_cast<double>(stats.Percentile(0.999)) / 1e3,
+         static_cast<double>(stats.max_ns) / 1e3, scope_name.c_str());
+}
+
+void PrintHeader() {
+  printf("%-16s %10s %10s %10s %10s %10s  %s\n", "module", "count", "p50 us",
+         "p99 us", "p99.9 us", "max us", "scope");
+}
+
+void MessageCallback(const std::shared_ptr<ScopeProfileReport>& report) {
+  if (!FLAGS_scope_profile_module.empty() &&
+      report->module_name() != FLAGS_scope_profile_module) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(totals_mutex);
+  printf("\n%.3f s of %s\n",
+         static_cast<double>(report->end_time() - report->begin_time()) / 1e9,
+         report->module_name().c_str());
+  PrintHeader();
+  for (const ScopeProfile& profile : report->scope_profile()) {
+    const ScopeStats stats = ScopeStats::FromProto(profile);
+    PrintRow(report->module_name(), profile.name(), stats);
+    totals[std::make_pair(report->module_name(), profile.name())].Merge(stats);
+  }
+  fflush(stdout);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  apollo::cyber::Init(argv[0]);
+
+  auto listener_node = apollo::cyber::CreateNode("scope_profile_dump");
+  auto listener = listener_node->CreateReader<ScopeProfileReport>(
+      FLAGS_scope_profile_topic, MessageCallback);
+  apollo::cyber::WaitForShutdown();
+
+  std::lock_guard<std::mutex> lock(totals_mutex);
+  printf("\ntotal\n");
+  PrintHeader();
+  for (const auto& total : totals) {
+    PrintRow(total.first.first, total.first.second, total.second);
+  }
+  return 0;
+}
@@ -0,0 +1,307 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/scope_profiler/scope_profiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "cyber/binary.h"
+#include "modules/common/adapters/adapter_gflags.h"
+
+namespace apollo {
+namespace common {
+
+using apollo::cyber::Time;
+
+uint64_t LatencyHistogram::BucketLowerBound(int index) {
+  if (index < (1 << kSubBucketBits)) {
+    return index;
+  }
+  const int exponent = (index >> kSubBucketBits) - 1;
+  const uint64_t mantissa =
+      (index & ((1 << kSubBucketBits) - 1)) + (1 << kSubBucketBits);
+  return mantissa << exponent;
+}
+
+void ScopeStats::Add(const LatencyHistogram& histogram) {
+  for (int i = 0; i < LatencyHistogram::kNumBuckets; ++i) {
+    const uint64_t bucket_count = histogram.bucket_count(i);
+    bucket_counts[i] += bucket_count;
+    count += bucket_count;
+  }
+  total_ns += histogram.total_ns();
+  max_ns = std::max(max_ns, histogram.max_ns());
+}
+
+void ScopeStats::Merge(const ScopeStats& other) {
+  for (int i = 0; i < LatencyHistogram::kNumBuckets; ++i) {
+    bucket_counts[i] += other.bucket_counts[i];
+  }
+  count += other.count;
+  total_ns += other.total_ns;
+  max_ns = std::max(max_ns, other.max_ns);
+}
+
+ScopeStats ScopeStats::Since(const ScopeStats& earlier) const {
+  ScopeStats stats;
+  int last_bucket = -1;
+  for (int i = 0; i < LatencyHistogram::kNumBuckets; ++i) {
+    // the histograms are read while recorded, never go below the earlier copy
+    const uint64_t bucket_count =
+        bucket_counts[i] - std::min(bucket_counts[i], earlier.bucket_counts[i]);
+    stats.bucket_counts[i] = bucket_count;
+    stats.count += bucket_count;
+    if (bucket_count > 0) {
+      last_bucket = i;
+    }
+  }
+  stats.total_ns = total_ns - std::min(total_ns, earlier.total_ns);
+  if (last_bucket >= 0) {
+    const uint64_t last_upper_bound =
+        LatencyHistogram::BucketLowerBound(last_bucket + 1) - 1;
+    stats.max_ns = std::min(max_ns, last_upper_bound);
+  }
+  return stats;
+}
+
+uint64_t ScopeStats::Percentile(double fraction) const {
+  if (count == 0) {
+    return 0;
+  }
+  const double rank_fraction = std::ceil(fraction * static_cast<double>(count));
+  const uint64_t rank =
+      std::max<uint64_t>(1, static_cast<uint64_t>(rank_fraction));
+  uint64_t seen = 0;
+  for (int i = 0; i < LatencyHistogram::kNumBuckets; ++i) {
+    seen += bucket_counts[i];
+    if (seen >= rank) {
+      const uint64_t lower = LatencyHistogram::BucketLowerBound(i);
+      const uint64_t upper = LatencyHistogram::BucketLowerBound(i + 1) - 1;
+      return std::min(max_ns, lower + (upper - lower) / 2);
+    }
+  }
+  return max_ns;
+}
+
+void ScopeStats::ToProto(ScopeProfile* profile) const {
+  profile->set_count(count);
+  profile->set_total_ns(total_ns);
+  profile->set_max_ns(max_ns);
+  profile->set_p50_ns(Percentile(0.5));
+  profile->set_p90_ns(Percentile(0.9));
+  profile->set_p99_ns(Percentile(0.99));
+  profile->set_p999_ns(Percentile(0.999));
+  for (int i = 0; i < LatencyHistogram::kNumBuckets; ++i) {
+    if (bucket_counts[i] > 0) {
+      profile->add_bucket_index(i);
+      profile->add_bucket_count(bucket_counts[i]);
+    }
+  }
+}
+
+ScopeStats ScopeStats::FromProto(const ScopeProfile& profile) {
+  ScopeStats stats;
+  const int size =
+      std::min(profile.bucket_index_size(), profile.bucket_count_size());
+  for (int i = 0; i < size; ++i) {
+    const uint32_t index = profile.bucket_index(i);
+    if (index < static_cast<uint32_t>(LatencyHistogram::kNumBuckets)) {
+      stats.bucket_counts[index] += profile.bucket_count(i);
+      stats.count += profile.bucket_count(i);
+    }
+  }
+  stats.total_ns = profile.total_ns();
+  stats.max_ns = profile.max_ns();
+  return stats;
+}
+
+// Moves the histograms of its thread to the exited stats at thread exit.
+class ScopeProfiler::ThreadProfileHolder {
+ public:
+  ~ThreadProfileHolder() {
+    if (profile != nullptr) {
+      ScopeProfiler::Instance()->RemoveThread(profile);
+    }
+  }
+
+  ThreadProfile* profile = nullptr;
+};
+
+ScopeProfiler::ScopeProfiler() : reported_time_(Time::Now().ToNanosecond()) {}
+
+int ScopeProfiler::ScopeId(const std::string& name) {
+  thread_local std::unordered_map<std::string, int> ids;
+  auto iter = ids.find(name);
+  if (iter != ids.end()) {
+    return iter->second;
+  }
+  ScopeProfiler* profiler = Instance();
+  int id = -1;
+  {
+    std::lock_guard<std::mutex> lock(profiler->mutex_);
+    auto found = profiler->ids_.find(name);
+    if (found != profiler->ids_.end()) {
+      id = found->second;
+    } else if (profiler->names_.size() < kMaxScopes) {
+      id = static_cast<int>(profiler->names_.size());
+      profiler->names_.push_back(name);
+      profiler->ids_.emplace(name, id);
+    } else {
+      AERROR << "More than " << kMaxScopes << " scopes, " << name
+             << " is not profiled";
+    }
+  }
+  ids.emplace(name, id);
+  return id;
+}
+
+void ScopeProfiler::Record(int scope_id, uint64_t start_ns, uint64_t end_ns) {
+  if (scope_id < 0 || scope_id >= kMaxScopes) {
+    return;
+  }
+  ThreadProfile* profile = LocalProfile();
+  LatencyHistogram* histogram =
+      profile->histograms[scope_id].load(std::memory_order_acquire);
+  if (histogram == nullptr) {
+    std::lock_guard<std::mutex> lock(Instance()->mutex_);
+    profile->owned.emplace_back(new LatencyHistogram());
+    histogram = profile->owned.back().get();
+    profile->histograms[scope_id].store(histogram, std::memory_order_release);
+  }
+  histogram->Record(end_ns - start_ns);
+
+  ScopeProfiler* profiler = Instance();
+  if (end_ns >= profiler->next_publish_ns_.load(std::memory_order_relaxed)) {
+    profiler->MaybePublish(end_ns);
+  }
+}
+
+ScopeProfiler::ThreadProfile* ScopeProfiler::LocalProfile() {
+  thread_local ThreadProfileHolder holder;
+  if (holder.profile == nullptr) {
+    holder.profile = Instance()->AddThread();
+  }
+  return holder.profile;
+}
+
+ScopeProfiler::ThreadProfile* ScopeProfiler::AddThread() {
+  auto* profile = new ThreadProfile();
+  std::lock_guard<std::mutex> lock(mutex_);
+  threads_.push_back(profile);
+  return profile;
+}
+
+void ScopeProfiler::RemoveThread(ThreadProfile* profile) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  exited_.resize(names_.size());
+  AddTo(*profile, &exited_);
+  threads_.erase(std::remove(threads_.begin(), threads_.end(), profile),
+                 threads_.end());
+  delete profile;
+}
+
+void ScopeProfiler::AddTo(const ThreadProfile& profile,
+                          std::vector<ScopeStats>* stats) {
+  for (size_t id = 0; id < stats->size(); ++id) {
+    const LatencyHistogram* histogram =
+        profile.histograms[id].load(std::memory_order_acquire);
+    if (histogram != nullptr) {
+      (*stats)[id].Add(*histogram);
+    }
+  }
+}
+
+std::vector<ScopeStats> ScopeProfiler::CollectById() {
+  std::vector<ScopeStats> stats = exited_;
+  stats.resize(names_.size());
+  for (const ThreadProfile* profile : threads_) {
+    AddTo(*profile, &stats);
+  }
+  return stats;
+}
+
+std::unordered_map<std::string, ScopeStats> ScopeProfiler::Collect() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<ScopeStats> stats = CollectById();
+  std::unordered_map<std::string, ScopeStats> named_stats;
+  for (size_t id = 0; id < stats.size(); ++id) {
+    if (stats[id].count > 0) {
+      named_stats.emplace(names_[id], std::move(stats[id]));
+    }
+  }
+  return named_stats;
+}
+
+bool ScopeProfiler::CollectReport(ScopeProfileReport* report) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<ScopeStats> stats = CollectById();
+  reported_.resize(stats.size());
+  for (size_t id = 0; id < stats.size(); ++id) {
+    const ScopeStats period = stats[id].Since(reported_[id]);
+    if (period.count == 0) {
+      continue;
+    }
+    ScopeProfile* profile = report->add_scope_profile();
+    profile->set_name(names_[id]);
+    period.ToProto(profile);
+  }
+  reported_ = std::move(stats);
+
+  const Time now = Time::Now();
+  report->mutable_header()->set_timestamp_sec(now.ToSecond());
+  report->mutable_header()->set_module_name("ScopeProfiler");
+  report->mutable_header()->set_sequence_num(++sequence_num_);
+  report->set_module_name(cyber::binary::GetName());
+  report->set_begin_time(reported_time_);
+  report->set_end_time(now.ToNanosecond());
+  reported_time_ = now.ToNanosecond();
+  return report->scope_profile_size() > 0;
+}
+
+void ScopeProfiler::MaybePublish(uint64_t now_ns) {
+  uint64_t next_publish_ns = next_publish_ns_.load();
+  const uint64_t interval_ns =
+      static_cast<uint64_t>(FLAGS_scope_profile_interval * 1e9);
+  // the other recording threads go on while one publishes
+  if (now_ns < next_publish_ns ||
+      !next_publish_ns_.compare_exchange_strong(next_publish_ns,
+                                                now_ns + interval_ns)) {
+    return;
+  }
+  if (next_publish_ns == 0 || !cyber::OK()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(publish_mutex_);
+  ScopeProfileReport report;
+  if (!CollectReport(&report)) {
+    return;
+  }
+  if (writer_ == nullptr) {
+    node_ = cyber::CreateNode("scope_profiler_" + cyber::binary::GetName() +
+                              "_" + std::to_string(report.end_time()));
+    if (node_ == nullptr) {
+      AERROR << "Unable to create node for scope profiles";
+      return;
+    }
+    writer_ = node_->CreateWriter<ScopeProfileReport>(
+        FLAGS_scope_profile_topic);
+  }
+  writer_->Write(report);
+}
+
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,264 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/cyber.h"
+
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/scope_profiler/proto/scope_profile.pb.h"
+
+namespace apollo {
+namespace common {
+
+/**
+ * @class LatencyHistogram
+ * @brief Log-linear histogram of durations in nanoseconds, with 16 buckets
+ * per power of two, so that a bucket spans at most 6.25% of its durations.
+ * Recorded by one thread without atomic read-modify-writes, and read by any.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits = 4;
+  // longer durations, above 68 s, are counted in the last bucket
+  static constexpr int kMaxBits = 36;
+  static constexpr int kNumBuckets = (kMaxBits - kSubBucketBits + 1)
+                                     << kSubBucketBits;
+
+  static int BucketIndex(uint64_t ns) {
+    constexpr uint64_t kMaxValue = (uint64_t{1} << kMaxBits) - 1;
+    if (ns > kMaxValue) {
+      ns = kMaxValue;
+    }
+    if (ns < (uint64_t{1} << kSubBucketBits)) {
+      return static_cast<int>(ns);
+    }
+    const int exponent = 63 - __builtin_clzll(ns) - kSubBucketBits;
+    return ((exponent + 1) << kSubBucketBits) +
+           static_cast<int>(ns >> exponent) - (1 << kSubBucketBits);
+  }
+
+  // The smallest duration of the bucket.
+  static uint64_t BucketLowerBound(int index);
+
+  void Record(uint64_t ns) {
+    Add(&counts_[BucketIndex(ns)], 1);
+    Add(&total_ns_, ns);
+    if (ns > max_ns_.load(std::memory_order_relaxed)) {
+      max_ns_.store(ns, std::memory_order_relaxed);
+    }
+  }
+
+  uint64_t total_ns() const {
+    return total_ns_.load(std::memory_order_relaxed);
+  }
+  uint64_t max_ns() const { return max_ns_.load(std::memory_order_relaxed); }
+  uint64_t bucket_count(int index) const {
+    return counts_[index].load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Only the recording thread writes.
+  static void Add(std::atomic<uint64_t>* value, uint64_t delta) {
+    value->store(value->load(std::memory_order_relaxed) + delta,
+                 std::memory_order_relaxed);
+  }
+
+  std::array<std::atomic<uint64_t>, kNumBuckets> counts_{};
+  std::atomic<uint64_t> total_ns_{0};
+  std::atomic<uint64_t> max_ns_{0};
+};
+
+/**
+ * @struct ScopeStats
+ * @brief A copy of histograms, which can be merged, subtracted and queried.
+ */
+struct ScopeStats {
+  // the sum of the bucket counts
+  uint64_t count = 0;
+  uint64_t total_ns = 0;
+  uint64_t max_ns = 0;
+  std::vector<uint64_t> bucket_counts =
+      std::vector<uint64_t>(LatencyHistogram::kNumBuckets, 0);
+
+  void Add(const LatencyHistogram& histogram);
+  void Merge(const ScopeStats& other);
+
+  /**
+   * @brief The stats recorded since earlier, a previous copy of the same
+   * histograms. The max is bounded by the last non-empty bucket.
+   */
+  ScopeStats Since(const ScopeStats& earlier) const;
+
+  /**
+   * @brief The duration at fraction of the count, in the middle of its
+   * bucket and no more than max_ns.
+   */
+  uint64_t Percentile(double fraction) const;
+
+  void ToProto(ScopeProfile* profile) const;
+  static ScopeStats FromProto(const ScopeProfile& profile);
+};
+
+/**
+ * @class ScopeProfiler
+ * @brief Per thread latency histograms of named scopes. Each thread records
+ * into its own histograms, so recording takes no lock. Every
+ * FLAGS_scope_profile_interval seconds, the thread recording at that time
+ * merges the histograms of all the threads and publishes the stats of the
+ * period on FLAGS_scope_profile_topic.
+ */
+class ScopeProfiler {
+ public:
+  // Ids above are not recorded.
+  static constexpr int kMaxScopes = 1024;
+
+  static bool Enabled() { return FLAGS_enable_scope_profiler; }
+
+  /**
+   * @brief The id of the scope called name, registered on first use, or -1
+   * when there are kMaxScopes scopes already.
+   */
+  static int ScopeId(const std::string& name);
+
+  // Record the scope which ran from start_ns to end_ns.
+  static void Record(int scope_id, uint64_t start_ns, uint64_t end_ns);
+
+  /**
+   * @brief The stats of every scope recorded so far, by name, including the
+   * threads which have exited.
+   */
+  std::unordered_map<std::string, ScopeStats> Collect();
+
+  /**
+   * @brief Fill report with the scopes recorded since the previous report.
+   * @return false if nothing was recorded.
+   */
+  bool CollectReport(ScopeProfileReport* report);
+
+ private:
+  // The histograms of a thread, by scope id, allocated on first record.
+  struct ThreadProfile {
+    std::array<std::atomic<LatencyHistogram*>, kMaxScopes> histograms{};
+    std::vector<std::unique_ptr<LatencyHistogram>> owned;
+  };
+  class ThreadProfileHolder;
+
+  static ThreadProfile* LocalProfile();
+  ThreadProfile* AddThread();
+  void RemoveThread(ThreadProfile* profile);
+  // Adds the histograms of profile to stats, by scope id.
+  void AddTo(const ThreadProfile& profile, std::vector<ScopeStats>* stats);
+  // The stats of every scope by id, with mutex_ held.
+  std::vector<ScopeStats> CollectById();
+  void MaybePublish(uint64_t now_ns);
+
+  std::mutex mutex_;
+  std::vector<std::string> names_;
+  std::unordered_map<std::string, int> ids_;
+  std::vector<ThreadProfile*> threads_;
+  // the stats of the threads which have exited
+  std::vector<ScopeStats> exited_;
+
+  // the stats at the previous report, by scope id
+  std::vector<ScopeStats> reported_;
+  uint64_t reported_time_ = 0;
+  uint32_t sequence_num_ = 0;
+  // steady clock time of the next report, 0 before the first record
+  std::atomic<uint64_t> next_publish_ns_{0};
+  // held by the thread publishing, which creates the writer on first use
+  std::mutex publish_mutex_;
+  std::shared_ptr<apollo::cyber::Node> node_;
+  std::shared_ptr<apollo::cyber::Writer<ScopeProfileReport>> writer_;
+
+  DECLARE_SINGLETON(ScopeProfiler)
+};
+
+inline uint64_t ScopeProfilerNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * @class ScopeTimer
+ * @brief Records the duration of its scope, unless the scope id is -1.
+ */
+class ScopeTimer {
+ public:
+  explicit ScopeTimer(int scope_id) : scope_id_(scope_id) {
+    if (scope_id_ >= 0) {
+      start_ns_ = ScopeProfilerNowNs();
+    }
+  }
+
+  ~ScopeTimer() {
+    if (scope_id_ >= 0) {
+      ScopeProfiler::Record(scope_id_, start_ns_, ScopeProfilerNowNs());
+    }
+  }
+
+ private:
+  int scope_id_;
+  uint64_t start_ns_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopeTimer);
+};
+
+/**
+ * @class BlockTimer
+ * @brief Records the blocks between its construction and each End, when
+ * the profiler is enabled.
+ */
+class BlockTimer {
+ public:
+  BlockTimer()
+      : start_ns_(ScopeProfiler::Enabled() ? ScopeProfilerNowNs() : 0) {}
+
+  // Records the block since the previous End as name, and starts the next.
+  void End(const std::string& name) {
+    if (!ScopeProfiler::Enabled()) {
+      return;
+    }
+    const uint64_t now_ns = ScopeProfilerNowNs();
+    if (start_ns_ != 0) {
+      ScopeProfiler::Record(ScopeProfiler::ScopeId(name), start_ns_, now_ns);
+    }
+    start_ns_ = now_ns;
+  }
+
+ private:
+  uint64_t start_ns_;
+
+  DISALLOW_COPY_AND_ASSIGN(BlockTimer);
+};
+
+}  // namespace common
+}  // namespace apollo
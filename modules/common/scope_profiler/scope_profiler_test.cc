@@ -0,0 +1,165 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/scope_profiler/scope_profiler.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+
+TEST(LatencyHistogramTest, BucketIndex) {
+  for (uint64_t ns = 0; ns < 16; ++ns) {
+    EXPECT_EQ(ns, LatencyHistogram::BucketIndex(ns));
+  }
+  EXPECT_EQ(16, LatencyHistogram::BucketIndex(16));
+  EXPECT_EQ(31, LatencyHistogram::BucketIndex(31));
+  EXPECT_EQ(32, LatencyHistogram::BucketIndex(32));
+  EXPECT_EQ(32, LatencyHistogram::BucketIndex(33));
+  EXPECT_EQ(LatencyHistogram::kNumBuckets - 1,
+            LatencyHistogram::BucketIndex(uint64_t{1} << 40));
+
+  for (int i = 0; i + 1 < LatencyHistogram::kNumBuckets; ++i) {
+    const uint64_t lower = LatencyHistogram::BucketLowerBound(i);
+    const uint64_t upper = LatencyHistogram::BucketLowerBound(i + 1) - 1;
+    EXPECT_EQ(i, LatencyHistogram::BucketIndex(lower));
+    EXPECT_EQ(i, LatencyHistogram::BucketIndex(upper));
+    // a bucket spans no more than 1/16 of its lower bound
+    EXPECT_LE((upper - lower) * 16, std::max<uint64_t>(lower, 16));
+  }
+}
+
+TEST(ScopeStatsTest, Percentile) {
+  LatencyHistogram histogram;
+  for (uint64_t us = 1; us <= 1000; ++us) {
+    histogram.Record(us * 1000);
+  }
+  ScopeStats stats;
+  stats.Add(histogram);
+  EXPECT_EQ(1000, stats.count);
+  EXPECT_EQ(500500000, stats.total_ns);
+  EXPECT_EQ(1000000, stats.max_ns);
+  EXPECT_NEAR(500000.0, static_cast<double>(stats.Percentile(0.5)),
+              500000 / 16);
+  EXPECT_NEAR(990000.0, static_cast<double>(stats.Percentile(0.99)),
+              990000 / 16);
+  EXPECT_EQ(LatencyHistogram::BucketIndex(1000000),
+            LatencyHistogram::BucketIndex(stats.Percentile(1.0)));
+  EXPECT_EQ(0, ScopeStats().Percentile(0.5));
+}
+
+TEST(ScopeStatsTest, SinceAndProto) {
+  LatencyHistogram histogram;
+  histogram.Record(100);
+  histogram.Record(1000000);
+  ScopeStats earlier;
+  earlier.Add(histogram);
+
+  histogram.Record(200);
+  histogram.Record(300);
+  ScopeStats now;
+  now.Add(histogram);
+
+  const ScopeStats period = now.Since(earlier);
+  EXPECT_EQ(2, period.count);
+  EXPECT_EQ(500, period.total_ns);
+  // bounded by the bucket of 300 rather than the earlier 1 ms
+  EXPECT_EQ(LatencyHistogram::BucketIndex(300),
+            LatencyHistogram::BucketIndex(period.max_ns));
+
+  ScopeProfile profile;
+  period.ToProto(&profile);
+  EXPECT_EQ(2, profile.bucket_index_size());
+  ScopeStats merged = ScopeStats::FromProto(profile);
+  merged.Merge(ScopeStats::FromProto(profile));
+  EXPECT_EQ(4, merged.count);
+  EXPECT_EQ(1000, merged.total_ns);
+  EXPECT_EQ(period.max_ns, merged.max_ns);
+  EXPECT_EQ(period.Percentile(0.5), merged.Percentile(0.5));
+}
+
+TEST(ScopeProfilerTest, RecordFromThreads) {
+  ScopeProfiler* profiler = ScopeProfiler::Instance();
+  const int id = ScopeProfiler::ScopeId("ScopeProfilerTest_threads");
+  EXPECT_EQ(id, ScopeProfiler::ScopeId("ScopeProfilerTest_threads"));
+  const int other_id = ScopeProfiler::ScopeId("ScopeProfilerTest_other");
+  EXPECT_NE(id, other_id);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([id]() {
+      for (uint64_t i = 0; i < 1000; ++i) {
+        ScopeProfiler::Record(id, 0, 1000 + i);
+      }
+    });
+  }
+  // collected while the threads record and after they have exited
+  profiler->Collect();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ScopeProfiler::Record(id, 0, 5000000);
+
+  auto stats = profiler->Collect();
+  ASSERT_EQ(1, stats.count("ScopeProfilerTest_threads"));
+  EXPECT_EQ(0, stats.count("ScopeProfilerTest_other"));
+  const ScopeStats& scope = stats["ScopeProfilerTest_threads"];
+  EXPECT_EQ(4001, scope.count);
+  EXPECT_EQ(5000000, scope.max_ns);
+
+  ScopeProfileReport report;
+  EXPECT_TRUE(profiler->CollectReport(&report));
+  bool reported = false;
+  for (const auto& profile : report.scope_profile()) {
+    if (profile.name() == "ScopeProfilerTest_threads") {
+      EXPECT_EQ(4001, profile.count());
+      reported = true;
+    }
+  }
+  EXPECT_TRUE(reported);
+  // nothing new since the last report
+  ScopeProfileReport next_report;
+  EXPECT_FALSE(profiler->CollectReport(&next_report));
+}
+
+TEST(ScopeTimerTest, Scopes) {
+  const int id = ScopeProfiler::ScopeId("ScopeTimerTest");
+  {
+    ScopeTimer timer(id);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  { ScopeTimer timer(-1); }
+  auto stats = ScopeProfiler::Instance()->Collect();
+  ASSERT_EQ(1, stats.count("ScopeTimerTest"));
+  EXPECT_EQ(1, stats["ScopeTimerTest"].count);
+  EXPECT_GE(stats["ScopeTimerTest"].max_ns, 9000000);
+
+  FLAGS_enable_scope_profiler = true;
+  BlockTimer block_timer;
+  block_timer.End("BlockTimerTest_1");
+  block_timer.End("BlockTimerTest_2");
+  FLAGS_enable_scope_profiler = false;
+  block_timer.End("BlockTimerTest_3");
+  stats = ScopeProfiler::Instance()->Collect();
+  EXPECT_EQ(1, stats.count("BlockTimerTest_1"));
+  EXPECT_EQ(1, stats.count("BlockTimerTest_2"));
+  EXPECT_EQ(0, stats.count("BlockTimerTest_3"));
+}
+
+}  // namespace common
+}  // namespace apollo
@@ -21,6 +21,7 @@
 
 #include "cyber/common/macros.h"
 #include "cyber/time/time.h"
+#include "modules/common/scope_profiler/scope_profiler.h"
 
 #if defined(__GNUC__) || defined(__GNUG__)
 #define AFUNC __PRETTY_FUNCTION__
@@ -36,10 +37,6 @@
 //          PERF_FUNCION();
 //          // do somethings.
 //      }
-//  Console log:
-//  >>>>>>>>>>>>>>>>>>
-//  I0615 15:49:30.756429 12748 timer.cpp:31] TIMER MyFunc elapsed time: 100 ms
-//  >>>>>>>>>>>>>>>>>>
 //
 //  2) Use PERF_BLOCK_START/END to compute time cost of block execution.
 //      void MyFunc() {
@@ -55,11 +52,16 @@
 //          PERF_BLOCK_END("xx3");
 //      }
 //
-//  Console log:
+//  With --enable_scope_profiler, on by default with ENABLE_PERF, the time
+//  costs of MyFunc, xx2 and xx3 are recorded in the latency histograms of
+//  ScopeProfiler, and their counts and percentiles published every
+//  --scope_profile_interval seconds on --scope_profile_topic:
 //  >>>>>>>>>>>>>>>
-//  I0615 15:49:30.756429 12748 timer.cpp:31] TIMER xx2 elapsed time: 100 ms
-//  I0615 15:49:30.756429 12748 timer.cpp:31] TIMER xx3 elapsed time: 200 ms
+//  $ scope_profile_dump
+//  module      count   p50 us   p99 us  p99.9 us   max us  scope
+//  planning     1000    801.2   1210.9    1498.1   1533.0  xx2
 //  >>>>>>>>>>>>>>>
+
 namespace apollo {
 namespace common {
 namespace util {
@@ -104,30 +106,33 @@ class TimerWrapper {
 }  // namespace common
 }  // namespace apollo
 
-#if defined(ENABLE_PERF)
-#define PERF_FUNCTION()                               \
-  apollo::common::util::TimerWrapper _timer_wrapper_( \
-      apollo::common::util::function_signature(AFUNC))
-#define PERF_FUNCTION_WITH_NAME(func_name) \
-  apollo::common::util::TimerWrapper _timer_wrapper_(func_name)
-#define PERF_FUNCTION_WITH_INDICATOR(indicator)       \
-  apollo::common::util::TimerWrapper _timer_wrapper_( \
-      apollo::common::util::function_signature(AFUNC, indicator))
-#define PERF_BLOCK_START()             \
-  apollo::common::util::Timer _timer_; \
-  _timer_.Start()
-#define PERF_BLOCK_END(msg) _timer_.End(msg)
-#define PERF_BLOCK_END_WITH_INDICATOR(indicator, msg) \
-  _timer_.End(absl::StrCat(indicator, "_", msg))
-#else
-#define PERF_FUNCTION()
-#define PERF_FUNCTION_WITH_NAME(func_name) UNUSED(func_name);
-#define PERF_FUNCTION_WITH_INDICATOR(indicator) UNUSED(indicator);
-#define PERF_BLOCK_START()
-#define PERF_BLOCK_END(msg) UNUSED(msg);
+#define PERF_FUNCTION()                                                      \
+  static const int _perf_scope_id_ = apollo::common::ScopeProfiler::ScopeId( \
+      apollo::common::util::function_signature(AFUNC));                      \
+  apollo::common::ScopeTimer _timer_wrapper_(                                \
+      apollo::common::ScopeProfiler::Enabled() ? _perf_scope_id_ : -1)
+#define PERF_FUNCTION_WITH_NAME(func_name)                    \
+  apollo::common::ScopeTimer _timer_wrapper_(                 \
+      apollo::common::ScopeProfiler::Enabled()                \
+          ? apollo::common::ScopeProfiler::ScopeId(func_name) \
+          : -1)
+#define PERF_FUNCTION_WITH_INDICATOR(indicator)                      \
+  apollo::common::ScopeTimer _timer_wrapper_(                        \
+      apollo::common::ScopeProfiler::Enabled()                       \
+          ? apollo::common::ScopeProfiler::ScopeId(                  \
+                apollo::common::util::function_signature(AFUNC,      \
+                                                         indicator)) \
+          : -1)
+#define PERF_BLOCK_START() apollo::common::BlockTimer _timer_
+#define PERF_BLOCK_END(msg)                         \
+  do {                                              \
+    if (apollo::common::ScopeProfiler::Enabled()) { \
+      _timer_.End(msg);                             \
+    }                                               \
+  } while (0)
 #define PERF_BLOCK_END_WITH_INDICATOR(indicator, msg) \
-  {                                                   \
-    UNUSED(indicator);                                \
-    UNUSED(msg);                                      \
-  }
-#endif  // ENABLE_PERF
+  do {                                                \
+    if (apollo::common::ScopeProfiler::Enabled()) {   \
+      _timer_.End(absl::StrCat(indicator, "_", msg)); \
+    }                                                 \
+  } while (0)
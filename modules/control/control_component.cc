@@ -22,6 +22,7 @@
 #include "cyber/time/clock.h"
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/latency_recorder/latency_recorder.h"
+#include "modules/common/latency_recorder/latency_tracer.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/control/common/control_gflags.h"
 
@@ -425,6 +426,10 @@ bool ControlComponent::Proc() {
         local_view_.trajectory().header().lidar_timestamp(), start_time,
         end_time);
   }
+  // the first command on a traced trajectory carries the trace to canbus
+  common::LatencyTracer::ContinueTrace(local_view_.trajectory().header(),
+                                       "control", start_time,
+                                       control_command.mutable_header());
   control_cmd_writer_->Write(control_command);
   return true;
 }
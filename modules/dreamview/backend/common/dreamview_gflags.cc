@@ -64,6 +64,17 @@ DEFINE_bool(enable_update_size_check, true,
 DEFINE_uint32(max_update_size, 1000000,
               "Number of max update bytes allowed to push to dreamview FE");
 
+DEFINE_bool(enable_sim_world_delta_stream, false,
+            "True to push SimulationWorld as deltas to the frontends that "
+            "request it.");
+
+DEFINE_uint32(sim_world_delta_history_size, 10,
+              "Number of SimulationWorld frames a delta can be based on.");
+
+DEFINE_uint32(sim_world_max_push_interval_ms, 1000,
+              "Max interval of pushing SimulationWorld to a frontend that "
+              "cannot keep up.");
+
 DEFINE_bool(sim_world_with_routing_path, false,
             "Whether the routing_path is included in sim_world proto.");
 
@@ -44,6 +44,12 @@ DECLARE_bool(enable_update_size_check);
 
 DECLARE_uint32(max_update_size);
 
+DECLARE_bool(enable_sim_world_delta_stream);
+
+DECLARE_uint32(sim_world_delta_history_size);
+
+DECLARE_uint32(sim_world_max_push_interval_ms);
+
 DECLARE_bool(sim_world_with_routing_path);
 
 DECLARE_string(request_timeout_ms);
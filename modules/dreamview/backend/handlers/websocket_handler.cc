@@ -59,6 +59,11 @@ void WebSocketHandler::handleClose(CivetServer *server,
 
   AINFO << name_
         << ": Connection closed. Total connections: " << connections_.size();
+
+  // Trigger registered closed connection handlers.
+  for (const auto &handler : connection_close_handlers_) {
+    handler(connection);
+  }
 }
 
 bool WebSocketHandler::BroadcastData(const std::string &data, bool skippable) {
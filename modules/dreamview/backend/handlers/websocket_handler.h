@@ -54,6 +54,7 @@ class WebSocketHandler : public CivetWebSocketHandler {
   using Connection = struct mg_connection;
   using MessageHandler = std::function<void(const Json &, Connection *)>;
   using ConnectionReadyHandler = std::function<void(Connection *)>;
+  using ConnectionCloseHandler = std::function<void(Connection *)>;
 
   explicit WebSocketHandler(const std::string &name) : name_(name) {}
   ~WebSocketHandler() override = default;
@@ -150,6 +151,14 @@ class WebSocketHandler : public CivetWebSocketHandler {
     connection_ready_handlers_.emplace_back(handler);
   }
 
+  /**
+   * @brief Add a new handler for closed connections.
+   * @param handler The function to handle the connection after it is closed.
+   */
+  void RegisterConnectionCloseHandler(ConnectionCloseHandler handler) {
+    connection_close_handlers_.emplace_back(handler);
+  }
+
  private:
   const std::string name_;
 
@@ -157,6 +166,8 @@ class WebSocketHandler : public CivetWebSocketHandler {
   std::unordered_map<std::string, MessageHandler> message_handlers_;
   // New connection ready handlers.
   std::vector<ConnectionReadyHandler> connection_ready_handlers_;
+  // Closed connection handlers.
+  std::vector<ConnectionCloseHandler> connection_close_handlers_;
 
   // The mutex guarding the connection set. We are not using read
   // write lock, as the server is not expected to get many clients
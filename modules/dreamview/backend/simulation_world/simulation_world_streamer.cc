@@ -0,0 +1,374 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/simulation_world/simulation_world_streamer.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace dreamview {
+
+namespace {
+
+using google::protobuf::FieldDescriptor;
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::internal::WireFormatLite;
+
+constexpr size_t kMagicSize = sizeof(SimulationWorldStreamer::kDeltaMagic) - 1;
+
+void PutUint32(uint32_t value, std::string *out) {
+  for (int i = 0; i < 4; ++i) {
+    out->push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+bool GetUint32(const std::string &in, size_t *pos, uint32_t *value) {
+  if (*pos + 4 > in.size()) {
+    return false;
+  }
+  *value = 0;
+  for (int i = 0; i < 4; ++i) {
+    *value |= static_cast<uint32_t>(static_cast<uint8_t>(in[*pos + i]))
+              << (8 * i);
+  }
+  *pos += 4;
+  return true;
+}
+
+// Gets the id of a serialized Object without parsing the rest of it. The
+// serializer writes the id first.
+bool GetObjectId(std::string_view object, std::string_view *id) {
+  CodedInputStream input(reinterpret_cast<const uint8_t *>(object.data()),
+                         static_cast<int>(object.size()));
+  for (uint32_t tag = input.ReadTag(); tag != 0; tag = input.ReadTag()) {
+    if (tag != WireFormatLite::MakeTag(
+                   Object::kIdFieldNumber,
+                   WireFormatLite::WIRETYPE_LENGTH_DELIMITED)) {
+      if (!WireFormatLite::SkipField(&input, tag)) {
+        return false;
+      }
+      continue;
+    }
+    uint32_t length = 0;
+    if (!input.ReadVarint32(&length) ||
+        input.CurrentPosition() + length > object.size()) {
+      return false;
+    }
+    *id = object.substr(input.CurrentPosition(), length);
+    return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+SimulationWorldStreamer::SimulationWorldStreamer(size_t history_size)
+    : history_size_(std::max<size_t>(history_size, 1)) {}
+
+bool SimulationWorldStreamer::Publish(std::string sim_world) {
+  auto frame = std::make_shared<Frame>();
+  if (!ParseFrame(std::make_shared<const std::string>(std::move(sim_world)),
+                  frame.get())) {
+    AERROR << "Failed to parse simulation world of size "
+           << frame->wire->size();
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  frame->id = history_.empty() ? 1 : history_.back()->id + 1;
+  history_.push_back(std::move(frame));
+  while (history_.size() > history_size_) {
+    history_.pop_front();
+  }
+  deltas_.clear();
+  return true;
+}
+
+std::shared_ptr<const std::string> SimulationWorldStreamer::GetFrame(
+    uint64_t base_id, uint64_t *id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (history_.empty()) {
+    return nullptr;
+  }
+  const Frame &latest = *history_.back();
+  *id = latest.id;
+  if (base_id == latest.id) {
+    return nullptr;
+  }
+  const auto delta_iter = deltas_.find(base_id);
+  if (delta_iter != deltas_.end()) {
+    return delta_iter->second;
+  }
+  const auto base_iter =
+      std::find_if(history_.begin(), history_.end(),
+                   [base_id](const std::shared_ptr<const Frame> &frame) {
+                     return frame->id == base_id;
+                   });
+  if (base_iter == history_.end() || !(*base_iter)->fields_contiguous ||
+      !latest.fields_contiguous) {
+    return latest.wire;
+  }
+
+  auto delta = std::make_shared<const std::string>(
+      EncodeDelta(**base_iter, latest));
+  if (delta->size() >= latest.wire->size()) {
+    // Everything changed, the key frame is cheaper to apply.
+    delta = latest.wire;
+  }
+  deltas_[base_id] = delta;
+  return delta;
+}
+
+bool SimulationWorldStreamer::IsDeltaFrame(const std::string &frame) {
+  return frame.compare(0, kMagicSize, kDeltaMagic) == 0;
+}
+
+bool SimulationWorldStreamer::ParseFrame(
+    std::shared_ptr<const std::string> wire, Frame *frame) {
+  frame->wire = std::move(wire);
+  const std::string_view data(*frame->wire);
+  const int size = static_cast<int>(data.size());
+  CodedInputStream input(reinterpret_cast<const uint8_t *>(data.data()),
+                         size);
+  int last_field = 0;
+  while (true) {
+    const int start = input.CurrentPosition();
+    const uint32_t tag = input.ReadTag();
+    if (tag == 0) {
+      // End of input, or a malformed tag.
+      return start == size;
+    }
+    const int field = WireFormatLite::GetTagFieldNumber(tag);
+    if (tag == WireFormatLite::MakeTag(
+                   SimulationWorld::kObjectFieldNumber,
+                   WireFormatLite::WIRETYPE_LENGTH_DELIMITED)) {
+      uint32_t length = 0;
+      if (!input.ReadVarint32(&length)) {
+        return false;
+      }
+      const int object_start = input.CurrentPosition();
+      if (!input.Skip(static_cast<int>(length))) {
+        return false;
+      }
+      std::string_view id;
+      if (!GetObjectId(data.substr(object_start, length), &id) ||
+          !frame->object_index.emplace(id, frame->objects.size()).second) {
+        frame->objects_by_id = false;
+      }
+      frame->objects.emplace_back(
+          id, data.substr(start, input.CurrentPosition() - start));
+    } else if (field == SimulationWorld::kSequenceNumFieldNumber &&
+               WireFormatLite::GetTagWireType(tag) ==
+                   WireFormatLite::WIRETYPE_VARINT) {
+      if (!input.ReadVarint32(&frame->seq)) {
+        return false;
+      }
+    } else if (!WireFormatLite::SkipField(&input, tag)) {
+      return false;
+    }
+    const std::string_view value =
+        data.substr(start, input.CurrentPosition() - start);
+
+    auto field_iter = frame->fields.find(field);
+    if (field_iter == frame->fields.end()) {
+      frame->fields.emplace(field, value);
+    } else if (field == last_field) {
+      field_iter->second = data.substr(
+          field_iter->second.data() - data.data(),
+          field_iter->second.size() + value.size());
+    } else {
+      frame->fields_contiguous = false;
+    }
+    last_field = field;
+  }
+}
+
+std::string SimulationWorldStreamer::EncodeDelta(const Frame &base,
+                                                 const Frame &latest) {
+  const bool objects_by_id = base.objects_by_id && latest.objects_by_id;
+  std::vector<bool> kept(base.objects.size(), false);
+  std::vector<std::string_view> changed_objects;
+  // Objects mostly keep their order, so the one after the last match is
+  // tried before the index.
+  size_t next_base_index = 0;
+  for (size_t i = 0; objects_by_id && i < latest.objects.size(); ++i) {
+    const auto &object = latest.objects[i];
+    size_t base_index = next_base_index;
+    if (base_index >= base.objects.size() ||
+        base.objects[base_index].first != object.first) {
+      const auto base_iter = base.object_index.find(object.first);
+      if (base_iter == base.object_index.end()) {
+        changed_objects.push_back(object.second);
+        continue;
+      }
+      base_index = base_iter->second;
+    }
+    kept[base_index] = true;
+    next_base_index = base_index + 1;
+    if (base.objects[base_index].second != object.second) {
+      changed_objects.push_back(object.second);
+    }
+  }
+
+  std::vector<uint32_t> cleared;
+  for (const auto &field : base.fields) {
+    if (latest.fields.count(field.first) == 0 &&
+        !(objects_by_id &&
+          field.first == SimulationWorld::kObjectFieldNumber)) {
+      cleared.push_back(field.first);
+    }
+  }
+  // The changed fields and objects, copied once into the frame.
+  std::vector<std::string_view> payload;
+  for (const auto &field : latest.fields) {
+    if (objects_by_id && field.first == SimulationWorld::kObjectFieldNumber) {
+      continue;
+    }
+    const auto base_iter = base.fields.find(field.first);
+    if (base_iter == base.fields.end() || base_iter->second != field.second) {
+      payload.push_back(field.second);
+    }
+  }
+  std::vector<std::string_view> removed;
+  if (objects_by_id) {
+    payload.insert(payload.end(), changed_objects.begin(),
+                   changed_objects.end());
+    for (size_t i = 0; i < base.objects.size(); ++i) {
+      if (!kept[i]) {
+        removed.push_back(base.objects[i].first);
+      }
+    }
+  }
+
+  size_t size = kMagicSize + 4 * (4 + cleared.size() + removed.size());
+  for (const auto id : removed) {
+    size += id.size();
+  }
+  for (const auto value : payload) {
+    size += value.size();
+  }
+  std::string delta;
+  delta.reserve(size);
+  delta.append(kDeltaMagic, kMagicSize);
+  PutUint32(base.seq, &delta);
+  PutUint32(objects_by_id ? 0 : kObjectsReplaced, &delta);
+  PutUint32(static_cast<uint32_t>(cleared.size()), &delta);
+  for (const uint32_t field : cleared) {
+    PutUint32(field, &delta);
+  }
+  PutUint32(static_cast<uint32_t>(removed.size()), &delta);
+  for (const auto id : removed) {
+    PutUint32(static_cast<uint32_t>(id.size()), &delta);
+    delta += id;
+  }
+  for (const auto value : payload) {
+    delta += value;
+  }
+  return delta;
+}
+
+bool SimulationWorldStreamer::ApplyFrame(const std::string &frame,
+                                         SimulationWorld *world) {
+  if (!IsDeltaFrame(frame)) {
+    return world->ParseFromString(frame);
+  }
+
+  size_t pos = kMagicSize;
+  uint32_t base_seq = 0;
+  uint32_t flags = 0;
+  uint32_t num_cleared = 0;
+  if (!GetUint32(frame, &pos, &base_seq) || !GetUint32(frame, &pos, &flags) ||
+      !GetUint32(frame, &pos, &num_cleared)) {
+    return false;
+  }
+  if (base_seq != world->sequence_num()) {
+    AWARN << "Delta frame is based on " << base_seq << ", world is at "
+          << world->sequence_num();
+    return false;
+  }
+  const auto *descriptor = world->GetDescriptor();
+  const auto *reflection = world->GetReflection();
+  for (uint32_t i = 0; i < num_cleared; ++i) {
+    uint32_t number = 0;
+    if (!GetUint32(frame, &pos, &number)) {
+      return false;
+    }
+    const FieldDescriptor *field = descriptor->FindFieldByNumber(number);
+    if (field != nullptr) {
+      reflection->ClearField(world, field);
+    }
+  }
+  uint32_t num_removed = 0;
+  if (!GetUint32(frame, &pos, &num_removed)) {
+    return false;
+  }
+  std::unordered_set<std::string> removed;
+  for (uint32_t i = 0; i < num_removed; ++i) {
+    uint32_t length = 0;
+    if (!GetUint32(frame, &pos, &length) || pos + length > frame.size()) {
+      return false;
+    }
+    removed.insert(frame.substr(pos, length));
+    pos += length;
+  }
+
+  SimulationWorld delta;
+  if (!delta.ParseFromArray(frame.data() + pos,
+                            static_cast<int>(frame.size() - pos))) {
+    return false;
+  }
+  const bool objects_replaced = (flags & kObjectsReplaced) != 0;
+  std::vector<const FieldDescriptor *> fields;
+  delta.GetReflection()->ListFields(delta, &fields);
+  for (const FieldDescriptor *field : fields) {
+    if (objects_replaced ||
+        field->number() != SimulationWorld::kObjectFieldNumber) {
+      reflection->ClearField(world, field);
+    }
+  }
+  if (!objects_replaced) {
+    auto *objects = world->mutable_object();
+    objects->erase(std::remove_if(objects->begin(), objects->end(),
+                                  [&removed](const Object &object) {
+                                    return removed.count(object.id()) > 0;
+                                  }),
+                   objects->end());
+    std::unordered_map<std::string, Object *> objects_by_id;
+    for (auto &object : *objects) {
+      objects_by_id[object.id()] = &object;
+    }
+    for (auto &object : *delta.mutable_object()) {
+      const auto iter = objects_by_id.find(object.id());
+      if (iter != objects_by_id.end()) {
+        iter->second->Swap(&object);
+      } else {
+        world->add_object()->Swap(&object);
+      }
+    }
+    delta.clear_object();
+  }
+  world->MergeFrom(delta);
+  return true;
+}
+
+}  // namespace dreamview
+}  // namespace apollo
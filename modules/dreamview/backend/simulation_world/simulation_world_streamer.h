@@ -0,0 +1,133 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "modules/dreamview/proto/simulation_world.pb.h"
+
+/**
+ * @namespace apollo::dreamview
+ * @brief apollo::dreamview
+ */
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @class SimulationWorldStreamer
+ * @brief Keeps the last few serialized SimulationWorld frames and encodes a
+ * frame for a client as a delta against the frame the client already has.
+ *
+ * A key frame is the plain SimulationWorld wire format. A delta frame is
+ *
+ *   "SWD1" | base seq | flags | cleared field numbers | removed object ids |
+ *   SimulationWorld wire format with the changed fields and objects
+ *
+ * with all integers little-endian uint32 and each list prefixed with its
+ * length. The base seq is the sequence_num of the base frame. A changed
+ * top-level field replaces the one of the base frame; objects are matched by
+ * id, and new ones appended, unless kObjectsReplaced is set. A key frame
+ * never starts with 'S', the start-group tag of field 10.
+ *
+ * Frames are returned as shared immutable buffers, so all clients at the same
+ * base share one encoding and key frames are never copied.
+ */
+class SimulationWorldStreamer {
+ public:
+  static constexpr char kDeltaMagic[] = "SWD1";
+  static constexpr uint32_t kObjectsReplaced = 1;
+
+  /**
+   * @brief Constructor with the number of frames a delta can be based on.
+   */
+  explicit SimulationWorldStreamer(size_t history_size);
+
+  /**
+   * @brief Adds the latest serialized SimulationWorld.
+   * @return False if the frame cannot be parsed, in which case it is dropped.
+   */
+  bool Publish(std::string sim_world);
+
+  /**
+   * @brief Gets the latest frame for a client that has the frame base_id.
+   * Frames are identified by the streamer rather than by sequence_num, which
+   * restarts when the world is reset.
+   * @param base_id Id of the frame the client has, 0 for none.
+   * @param id Output id of the latest frame.
+   * @return The key frame if base_id is not in the history, a delta frame
+   * otherwise, nullptr if there is no frame or the client is up to date.
+   */
+  std::shared_ptr<const std::string> GetFrame(uint64_t base_id, uint64_t *id);
+
+  /**
+   * @brief Applies a key or delta frame to a SimulationWorld, as the frontend
+   * does. The world has to be the base frame for a delta frame. Objects may
+   * end up in another order than in the latest frame.
+   */
+  static bool ApplyFrame(const std::string &frame, SimulationWorld *world);
+
+  /**
+   * @brief Returns whether the frame is a delta frame.
+   */
+  static bool IsDeltaFrame(const std::string &frame);
+
+ private:
+  // Views into the wire format of a frame, which the frame keeps alive.
+  struct Frame {
+    uint64_t id = 0;
+    uint32_t seq = 0;
+    std::shared_ptr<const std::string> wire;
+    // Tag-value bytes of each top-level field, which the serializer writes
+    // contiguously.
+    std::map<int, std::string_view> fields;
+    // Id and tag-value bytes of each object, in order.
+    std::vector<std::pair<std::string_view, std::string_view>> objects;
+    std::unordered_map<std::string_view, size_t> object_index;
+    // False if some field is split, or some object has no id or a duplicated
+    // one.
+    bool fields_contiguous = true;
+    bool objects_by_id = true;
+  };
+
+  static bool ParseFrame(std::shared_ptr<const std::string> wire,
+                         Frame *frame);
+  static std::string EncodeDelta(const Frame &base, const Frame &latest);
+
+  const size_t history_size_;
+
+  std::mutex mutex_;
+  // Oldest frame first.
+  std::deque<std::shared_ptr<const Frame>> history_;
+  // Delta frames to the latest frame, keyed by base id.
+  std::unordered_map<uint64_t, std::shared_ptr<const std::string>> deltas_;
+};
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -0,0 +1,164 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Simulates clients polling a SimulationWorld with many moving
+ * obstacles, and compares the bytes and the CPU time per tick of sending the
+ * full world to each client with those of the delta stream.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "google/protobuf/util/message_differencer.h"
+
+#include "cyber/common/log.h"
+#include "modules/dreamview/backend/simulation_world/simulation_world_streamer.h"
+
+DEFINE_int32(benchmark_clients, 8, "number of clients");
+DEFINE_int32(benchmark_obstacles, 2000, "number of obstacles");
+DEFINE_double(benchmark_moving_ratio, 0.3,
+              "ratio of the obstacles that move in each tick");
+DEFINE_int32(benchmark_ticks, 200, "number of ticks");
+DEFINE_int32(benchmark_history_size, 10, "frames a delta can be based on");
+
+namespace {
+
+using apollo::dreamview::Object;
+using apollo::dreamview::SimulationWorld;
+using apollo::dreamview::SimulationWorldStreamer;
+
+void SetObstacle(double x, double y, Object *object) {
+  object->set_position_x(x);
+  object->set_position_y(y);
+  object->set_heading(0.1);
+  object->set_length(4.5);
+  object->set_width(2.0);
+  object->set_height(1.5);
+  object->set_speed(5.0);
+  object->set_type(Object::VEHICLE);
+  object->clear_polygon_point();
+  for (int i = 0; i < 8; ++i) {
+    auto *point = object->add_polygon_point();
+    point->set_x(x + 2.0 * std::cos(i * M_PI / 4.0));
+    point->set_y(y + 2.0 * std::sin(i * M_PI / 4.0));
+  }
+}
+
+double ElapsedUs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  std::mt19937 random(0);
+  std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  SimulationWorld world;
+  int next_id = 0;
+  for (int i = 0; i < FLAGS_benchmark_obstacles; ++i) {
+    auto *object = world.add_object();
+    object->set_id(std::to_string(next_id++));
+    SetObstacle(coordinate(random), coordinate(random), object);
+  }
+
+  SimulationWorldStreamer streamer(FLAGS_benchmark_history_size);
+  // Clients poll at different rates, as slow connections are throttled.
+  std::vector<uint64_t> client_ids(FLAGS_benchmark_clients, 0);
+  std::vector<SimulationWorld> client_worlds(FLAGS_benchmark_clients);
+  double full_us = 0.0;
+  double delta_us = 0.0;
+  double full_bytes = 0.0;
+  double delta_bytes = 0.0;
+  int num_pushes = 0;
+  for (int tick = 1; tick <= FLAGS_benchmark_ticks; ++tick) {
+    world.set_sequence_num(tick);
+    world.set_timestamp(tick * 100.0);
+    for (auto &object : *world.mutable_object()) {
+      if (unit(random) < FLAGS_benchmark_moving_ratio) {
+        SetObstacle(object.position_x() + 0.5, object.position_y(), &object);
+      }
+    }
+    // Some obstacles leave and some enter.
+    world.mutable_object()->DeleteSubrange(0, 2);
+    for (int i = 0; i < 2; ++i) {
+      auto *object = world.add_object();
+      object->set_id(std::to_string(next_id++));
+      SetObstacle(coordinate(random), coordinate(random), object);
+    }
+    std::string wire;
+    world.SerializeToString(&wire);
+
+    // Full world to each client, copied out as the request handler does.
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::string> sent;
+    for (int client = 0; client < FLAGS_benchmark_clients; ++client) {
+      if (tick % (1 + client % 3) == 0) {
+        sent.push_back(wire);
+        full_bytes += static_cast<double>(sent.back().size());
+      }
+    }
+    full_us += ElapsedUs(start);
+
+    start = std::chrono::steady_clock::now();
+    streamer.Publish(std::move(wire));
+    std::vector<std::shared_ptr<const std::string>> frames(
+        FLAGS_benchmark_clients);
+    for (int client = 0; client < FLAGS_benchmark_clients; ++client) {
+      if (tick % (1 + client % 3) == 0) {
+        frames[client] = streamer.GetFrame(client_ids[client],
+                                           &client_ids[client]);
+        delta_bytes += static_cast<double>(frames[client]->size());
+        ++num_pushes;
+      }
+    }
+    delta_us += ElapsedUs(start);
+
+    for (int client = 0; client < FLAGS_benchmark_clients; ++client) {
+      if (frames[client] != nullptr) {
+        ACHECK(SimulationWorldStreamer::ApplyFrame(*frames[client],
+                                                   &client_worlds[client]));
+      }
+    }
+  }
+  google::protobuf::util::MessageDifferencer differencer;
+  differencer.TreatAsMap(
+      SimulationWorld::descriptor()->FindFieldByNumber(
+          SimulationWorld::kObjectFieldNumber),
+      Object::descriptor()->FindFieldByNumber(Object::kIdFieldNumber));
+  ACHECK(differencer.Compare(world, client_worlds[0]))
+      << "Client world differs from the server world.";
+
+  AINFO << FLAGS_benchmark_clients << " clients, "
+        << FLAGS_benchmark_obstacles << " obstacles, "
+        << FLAGS_benchmark_moving_ratio * 100.0 << "% moving, " << num_pushes
+        << " pushes in " << FLAGS_benchmark_ticks << " ticks";
+  AINFO << "full world: " << full_bytes / FLAGS_benchmark_ticks
+        << " bytes/tick, " << full_us / FLAGS_benchmark_ticks << " us/tick";
+  AINFO << "delta stream: " << delta_bytes / FLAGS_benchmark_ticks
+        << " bytes/tick, " << delta_us / FLAGS_benchmark_ticks << " us/tick";
+  return 0;
+}
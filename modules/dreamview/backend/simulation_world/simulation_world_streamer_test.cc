@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/simulation_world/simulation_world_streamer.h"
+
+#include <string>
+
+#include "google/protobuf/util/message_differencer.h"
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace dreamview {
+
+using google::protobuf::util::MessageDifferencer;
+
+namespace {
+
+void AddObject(const std::string &id, double x, SimulationWorld *world) {
+  Object *object = world->add_object();
+  object->set_id(id);
+  object->set_position_x(x);
+  object->add_polygon_point()->set_x(x);
+}
+
+// Objects are compared by id, as their order may differ.
+bool Equals(const SimulationWorld &expected, const SimulationWorld &actual) {
+  MessageDifferencer differencer;
+  differencer.TreatAsMap(
+      SimulationWorld::descriptor()->FindFieldByNumber(
+          SimulationWorld::kObjectFieldNumber),
+      Object::descriptor()->FindFieldByNumber(Object::kIdFieldNumber));
+  return differencer.Compare(expected, actual);
+}
+
+}  // namespace
+
+TEST(SimulationWorldStreamerTest, KeyFrame) {
+  SimulationWorldStreamer streamer(3);
+  uint64_t id = 0;
+  EXPECT_EQ(nullptr, streamer.GetFrame(0, &id));
+
+  SimulationWorld world;
+  world.set_sequence_num(1);
+  AddObject("1", 1.0, &world);
+  ASSERT_TRUE(streamer.Publish(world.SerializeAsString()));
+  const auto frame = streamer.GetFrame(0, &id);
+  ASSERT_NE(nullptr, frame);
+  EXPECT_FALSE(SimulationWorldStreamer::IsDeltaFrame(*frame));
+  EXPECT_EQ(world.SerializeAsString(), *frame);
+  // Up to date.
+  EXPECT_EQ(nullptr, streamer.GetFrame(id, &id));
+  // Unknown base.
+  EXPECT_EQ(frame, streamer.GetFrame(id + 10, &id));
+
+  EXPECT_FALSE(streamer.Publish("\xff\xff"));
+}
+
+TEST(SimulationWorldStreamerTest, DeltaFrames) {
+  SimulationWorldStreamer streamer(2);
+  std::vector<SimulationWorld> worlds(6);
+  for (size_t i = 0; i < worlds.size(); ++i) {
+    worlds[i].set_sequence_num(static_cast<uint32_t>(i + 1));
+    worlds[i].set_timestamp(100.0 * static_cast<double>(i));
+  }
+  // Objects are kept, moved, removed and added.
+  for (int i = 0; i < 50; ++i) {
+    AddObject(std::to_string(i), i, &worlds[0]);
+    AddObject(std::to_string(i), i == 7 ? 70.0 : i, &worlds[1]);
+  }
+  AddObject("new", 1.0, &worlds[1]);
+  worlds[0].mutable_auto_driving_car()->set_position_x(1.0);
+  worlds[0].set_map_hash(7);
+  worlds[1].mutable_auto_driving_car()->set_position_x(2.0);
+  // Objects are reordered.
+  AddObject("new", 1.0, &worlds[2]);
+  AddObject("0", 0.0, &worlds[2]);
+  // An object without id.
+  worlds[3].add_object()->set_position_x(1.0);
+  // Objects are removed.
+  worlds[4].add_route_path()->add_point()->set_x(1.0);
+
+  SimulationWorld client;
+  uint64_t client_id = 0;
+  int num_deltas = 0;
+  for (const auto &world : worlds) {
+    ASSERT_TRUE(streamer.Publish(world.SerializeAsString()));
+    uint64_t id = 0;
+    const auto frame = streamer.GetFrame(client_id, &id);
+    ASSERT_NE(nullptr, frame);
+    if (SimulationWorldStreamer::IsDeltaFrame(*frame)) {
+      ++num_deltas;
+    }
+    // Clients at the same base share the frame.
+    EXPECT_EQ(frame, streamer.GetFrame(client_id, &id));
+    ASSERT_TRUE(SimulationWorldStreamer::ApplyFrame(*frame, &client));
+    EXPECT_TRUE(Equals(world, client))
+        << world.sequence_num() << ": " << client.ShortDebugString();
+    client_id = id;
+  }
+
+  EXPECT_GT(num_deltas, 0);
+}
+
+TEST(SimulationWorldStreamerTest, DeltaIsSmall) {
+  SimulationWorldStreamer streamer(2);
+  SimulationWorld world;
+  world.set_sequence_num(1);
+  for (int i = 0; i < 200; ++i) {
+    AddObject(std::to_string(i), i, &world);
+  }
+  ASSERT_TRUE(streamer.Publish(world.SerializeAsString()));
+  uint64_t base_id = 0;
+  const auto key_frame = streamer.GetFrame(0, &base_id);
+  world.set_sequence_num(2);
+  world.mutable_object(3)->set_position_x(-1.0);
+  ASSERT_TRUE(streamer.Publish(world.SerializeAsString()));
+  uint64_t id = 0;
+  const auto delta = streamer.GetFrame(base_id, &id);
+  ASSERT_TRUE(SimulationWorldStreamer::IsDeltaFrame(*delta));
+  EXPECT_LT(delta->size() * 20, key_frame->size());
+
+  // A delta only applies to its base.
+  SimulationWorld client;
+  ASSERT_TRUE(SimulationWorldStreamer::ApplyFrame(*key_frame, &client));
+  client.set_sequence_num(3);
+  EXPECT_FALSE(SimulationWorldStreamer::ApplyFrame(*delta, &client));
+  // The base falls out of the history.
+  world.set_sequence_num(3);
+  ASSERT_TRUE(streamer.Publish(world.SerializeAsString()));
+  EXPECT_FALSE(SimulationWorldStreamer::IsDeltaFrame(
+      *streamer.GetFrame(base_id, &id)));
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -16,6 +16,8 @@
 
 #include "modules/dreamview/backend/simulation_world/simulation_world_updater.h"
 
+#include <algorithm>
+
 #include "google/protobuf/util/json_util.h"
 
 #include "cyber/common/file.h"
@@ -46,7 +48,62 @@ using apollo::task_manager::Task;
 
 using Json = nlohmann::json;
 using google::protobuf::util::JsonStringToMessage;
-using google::protobuf::util::MessageToJsonString;
+
+namespace {
+
+// Converts MapElementIds from and to JSON directly, rather than through the
+// protobuf JSON printer and parser and another round of JSON.
+bool MapElementIdsFromJson(const Json &json, MapElementIds *ids) {
+  if (!json.is_object()) {
+    return false;
+  }
+  const auto *descriptor = ids->GetDescriptor();
+  const auto *reflection = ids->GetReflection();
+  size_t num_fields = 0;
+  for (int i = 0; i < descriptor->field_count(); ++i) {
+    const auto *field = descriptor->field(i);
+    auto iter = json.find(field->json_name());
+    if (iter == json.end()) {
+      iter = json.find(field->name());
+    }
+    if (iter == json.end()) {
+      continue;
+    }
+    ++num_fields;
+    if (!iter->is_array()) {
+      return false;
+    }
+    for (const auto &id : *iter) {
+      if (!id.is_string()) {
+        return false;
+      }
+      reflection->AddString(ids, field, id.get<std::string>());
+    }
+  }
+  // Unknown fields are rejected, as by the protobuf JSON parser.
+  return num_fields == json.size();
+}
+
+Json MapElementIdsToJson(const MapElementIds &ids) {
+  Json json = Json::object();
+  const auto *descriptor = ids.GetDescriptor();
+  const auto *reflection = ids.GetReflection();
+  for (int i = 0; i < descriptor->field_count(); ++i) {
+    const auto *field = descriptor->field(i);
+    const auto &values =
+        reflection->GetRepeatedPtrField<std::string>(ids, field);
+    if (values.empty()) {
+      continue;
+    }
+    Json &json_values = json[field->json_name()];
+    for (const auto &value : values) {
+      json_values.push_back(value);
+    }
+  }
+  return json;
+}
+
+}  // namespace
 
 SimulationWorldUpdater::SimulationWorldUpdater(
     WebSocketHandler *websocket, WebSocketHandler *map_ws,
@@ -62,6 +119,9 @@ SimulationWorldUpdater::SimulationWorldUpdater(
       plugin_ws_(plugin_ws),
       sim_control_manager_(sim_control_manager),
       perception_camera_updater_(perception_camera_updater),
+      sim_world_streamer_(FLAGS_sim_world_delta_history_size),
+      sim_world_with_planning_data_streamer_(
+          FLAGS_sim_world_delta_history_size),
       plugin_manager_(plugin_manager) {
   RegisterMessageHandlers();
 }
@@ -76,13 +136,19 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
         websocket_->SendData(conn, response.dump());
       });
 
+  websocket_->RegisterConnectionCloseHandler(
+      [this](WebSocketHandler::Connection *conn) {
+        std::lock_guard<std::mutex> lock(stream_mutex_);
+        stream_states_.erase(conn);
+      });
+
   map_ws_->RegisterMessageHandler(
       "RetrieveMapData",
       [this](const Json &json, WebSocketHandler::Connection *conn) {
         auto iter = json.find("elements");
         if (iter != json.end()) {
           MapElementIds map_element_ids;
-          if (JsonStringToMessage(iter->dump(), &map_element_ids).ok()) {
+          if (MapElementIdsFromJson(*iter, &map_element_ids)) {
             auto retrieved = map_service_->RetrieveMapElements(map_element_ids);
 
             std::string retrieved_map_string;
@@ -140,9 +206,7 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
 
         MapElementIds ids;
         sim_world_service_.GetMapElementIds(*radius, &ids);
-        std::string elementIds;
-        MessageToJsonString(ids, &elementIds);
-        response["mapElementIds"] = Json::parse(elementIds);
+        response["mapElementIds"] = MapElementIdsToJson(ids);
 
         websocket_->SendData(conn, response.dump());
       });
@@ -263,6 +327,17 @@ void SimulationWorldUpdater::RegisterMessageHandlers() {
         if (planning != json.end() && planning->is_boolean()) {
           enable_pnc_monitor = json["planning"];
         }
+        auto delta = json.find("delta");
+        if (FLAGS_enable_sim_world_delta_stream && delta != json.end() &&
+            delta->is_boolean() && delta->get<bool>()) {
+          // The frontend acks the sequence_num of its frame, 0 for none.
+          auto ack = json.find("ack");
+          const bool resync = ack == json.end() ||
+                              !ack->is_number_unsigned() ||
+                              ack->get<uint32_t>() == 0;
+          PushSimulationWorldDelta(conn, enable_pnc_monitor, resync);
+          return;
+        }
         std::string to_send;
         {
           // Pay the price to copy the data instead of sending data over the
@@ -727,6 +802,73 @@ void SimulationWorldUpdater::OnTimer() {
     sim_world_service_.GetRelativeMap().SerializeToString(
         &relative_map_string_);
   }
+
+  if (FLAGS_enable_sim_world_delta_stream) {
+    // Only this timer writes the simulation_world strings, so reading them
+    // needs no lock.
+    sim_world_streamer_.Publish(simulation_world_);
+    sim_world_with_planning_data_streamer_.Publish(
+        simulation_world_with_planning_data_);
+  }
+}
+
+void SimulationWorldUpdater::PushSimulationWorldDelta(
+    WebSocketHandler::Connection *conn, bool planning, bool resync) {
+  const auto now = std::chrono::steady_clock::now();
+  uint64_t base_id = 0;
+  {
+    std::lock_guard<std::mutex> lock(stream_mutex_);
+    const StreamState &state = stream_states_[conn];
+    // Requests come once per timer interval, give them half of it as slack.
+    if (now - state.last_push_time <
+        std::chrono::duration<double, std::milli>(
+            state.push_interval_ms - kSimWorldTimeIntervalMs / 2)) {
+      return;
+    }
+    // Frames are written to a connection in order, so the frontend applies
+    // the next frame to the last one written.
+    if (!resync && state.planning == planning) {
+      base_id = state.frame_id;
+    }
+  }
+
+  auto &streamer = planning ? sim_world_with_planning_data_streamer_
+                            : sim_world_streamer_;
+  uint64_t frame_id = 0;
+  const auto frame = streamer.GetFrame(base_id, &frame_id);
+  if (frame == nullptr) {
+    return;
+  }
+  if (FLAGS_enable_update_size_check && !planning &&
+      frame->size() > FLAGS_max_update_size) {
+    AWARN << "update size is too big:" << frame->size();
+    return;
+  }
+  const bool sent = websocket_->SendBinaryData(conn, *frame, true);
+  const double send_time_ms = std::chrono::duration<double, std::milli>(
+                                  std::chrono::steady_clock::now() - now)
+                                  .count();
+
+  std::lock_guard<std::mutex> lock(stream_mutex_);
+  auto iter = stream_states_.find(conn);
+  if (iter == stream_states_.end()) {
+    return;
+  }
+  StreamState &state = iter->second;
+  state.last_push_time = now;
+  if (sent) {
+    state.planning = planning;
+    state.frame_id = frame_id;
+  }
+  // Back off while the connection is busy or slow, and recover gradually.
+  if (!sent || send_time_ms > state.push_interval_ms / 2) {
+    state.push_interval_ms =
+        std::min(2.0 * state.push_interval_ms,
+                 static_cast<double>(FLAGS_sim_world_max_push_interval_ms));
+  } else {
+    state.push_interval_ms =
+        std::max(0.8 * state.push_interval_ms, kSimWorldTimeIntervalMs);
+  }
 }
 
 bool SimulationWorldUpdater::LoadPOI() {
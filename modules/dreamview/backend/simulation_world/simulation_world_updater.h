@@ -20,8 +20,11 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/thread/locks.hpp>
@@ -40,6 +43,7 @@
 #include "modules/dreamview/backend/plugins/plugin_manager.h"
 #include "modules/dreamview/backend/sim_control_manager/sim_control_manager.h"
 #include "modules/dreamview/backend/simulation_world/simulation_world_service.h"
+#include "modules/dreamview/backend/simulation_world/simulation_world_streamer.h"
 
 /**
  * @namespace apollo::dreamview
@@ -173,6 +177,16 @@ class SimulationWorldUpdater {
 
   void RegisterMessageHandlers();
 
+  /**
+   * @brief Pushes the latest simulation_world to a frontend as a delta against
+   * the frame last pushed to it, throttling frontends that cannot keep up.
+   * @param conn the frontend connection
+   * @param planning whether to push the simulation_world with planning data
+   * @param resync whether the frontend needs a key frame
+   */
+  void PushSimulationWorldDelta(WebSocketHandler::Connection *conn,
+                                bool planning, bool resync);
+
   SimulationWorldService sim_world_service_;
   const MapService *map_service_ = nullptr;
   WebSocketHandler *websocket_ = nullptr;
@@ -197,6 +211,22 @@ class SimulationWorldUpdater {
   std::string simulation_world_;
   std::string simulation_world_with_planning_data_;
 
+  // Delta streams of the simulation_world with and without planning data.
+  SimulationWorldStreamer sim_world_streamer_;
+  SimulationWorldStreamer sim_world_with_planning_data_streamer_;
+
+  // Delta stream state of a frontend connection.
+  struct StreamState {
+    bool planning = false;
+    // Id of the frame last pushed, the base of the next delta.
+    uint64_t frame_id = 0;
+    double push_interval_ms = kSimWorldTimeIntervalMs;
+    std::chrono::steady_clock::time_point last_push_time;
+  };
+  std::mutex stream_mutex_;
+  std::unordered_map<WebSocketHandler::Connection *, StreamState>
+      stream_states_;
+
   // Received relative map data in wire format.
   std::string relative_map_string_;
 
@@ -10,6 +10,9 @@ export default class RealtimeWebSocketEndpoint {
     this.websocket = null;
     this.simWorldUpdatePeriodMs = 100;
     this.simWorldLastUpdateTimestamp = 0;
+    // Sequence number of the last simulation world, the base of the next
+    // delta the backend sends, 0 to request a full one.
+    this.simWorldAckSeqNum = 0;
     this.mapUpdatePeriodMs = 1000;
     this.mapLastUpdateTimestamp = 0;
     this.updatePOI = true;
@@ -53,8 +56,12 @@ export default class RealtimeWebSocketEndpoint {
         case 'SimControlStatus':
           STORE.setOptionStatus('enableSimControl', message.enabled);
           break;
+        case 'SimWorldResync':
+          this.simWorldAckSeqNum = 0;
+          break;
         case 'SimWorldUpdate':
           this.checkMessage(message);
+          this.simWorldAckSeqNum = message.sequenceNum;
 
           const isNewMode = (this.currentMode
             && this.currentMode !== STORE.hmi.currentMode);
@@ -226,6 +233,8 @@ export default class RealtimeWebSocketEndpoint {
     this.websocket.send(JSON.stringify({
       type: 'RequestSimulationWorld',
       planning: requestPlanningData,
+      delta: true,
+      ack: this.simWorldAckSeqNum,
     }));
   }
 
@@ -12,6 +12,74 @@ const pointCloudRoot = protobuf.Root.fromJSON(
 
 const pointCloudMessage = pointCloudRoot.lookupType('apollo.dreamview.PointCloud');
 
+// Delta frames of SimulationWorld, see
+// backend/simulation_world/simulation_world_streamer.h.
+const SIM_WORLD_DELTA_MAGIC = [0x53, 0x57, 0x44, 0x31]; // 'SWD1'
+const SIM_WORLD_OBJECTS_REPLACED = 1;
+const textDecoder = new TextDecoder();
+let lastSimWorld = null;
+
+function isSimWorldDelta(bytes) {
+  return bytes.length >= SIM_WORLD_DELTA_MAGIC.length
+    && SIM_WORLD_DELTA_MAGIC.every((byte, i) => bytes[i] === byte);
+}
+
+// Applies a delta frame to the last SimulationWorld, returns null if the
+// delta is not based on it.
+function applySimWorldDelta(bytes) {
+  const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+  let pos = SIM_WORLD_DELTA_MAGIC.length;
+  const readUint32 = () => {
+    const value = view.getUint32(pos, true);
+    pos += 4;
+    return value;
+  };
+
+  const baseSeqNum = readUint32();
+  if (!lastSimWorld || lastSimWorld.sequenceNum !== baseSeqNum) {
+    return null;
+  }
+  const world = lastSimWorld;
+  const flags = readUint32();
+  const numCleared = readUint32();
+  for (let i = 0; i < numCleared; i++) {
+    const field = SimWorldMessage.fieldsById[readUint32()];
+    if (field) {
+      delete world[field.name];
+    }
+  }
+  const numRemoved = readUint32();
+  const removed = new Set();
+  for (let i = 0; i < numRemoved; i++) {
+    const length = readUint32();
+    removed.add(textDecoder.decode(bytes.subarray(pos, pos + length)));
+    pos += length;
+  }
+
+  const delta = SimWorldMessage.toObject(
+    SimWorldMessage.decode(bytes.subarray(pos)),
+    { enums: String },
+  );
+  if (!(flags & SIM_WORLD_OBJECTS_REPLACED)) {
+    const objects = (world.object || [])
+      .filter((object) => !removed.has(object.id));
+    const objectIndex = new Map(objects.map((object, i) => [object.id, i]));
+    (delta.object || []).forEach((object) => {
+      if (objectIndex.has(object.id)) {
+        objects[objectIndex.get(object.id)] = object;
+      } else {
+        objects.push(object);
+      }
+    });
+    delete delta.object;
+    delete world.object;
+    if (objects.length > 0) {
+      world.object = objects;
+    }
+  }
+  return Object.assign(world, delta);
+}
+
 self.addEventListener('message', (event) => {
   let message = null;
   const data = event.data.data;
@@ -20,11 +88,22 @@ self.addEventListener('message', (event) => {
       if (typeof data === 'string') {
         message = JSON.parse(data);
       } else {
-        message = SimWorldMessage.toObject(
-          SimWorldMessage.decode(new Uint8Array(data)),
-          { enums: String },
-        );
-        message.type = 'SimWorldUpdate';
+        const bytes = new Uint8Array(data);
+        if (isSimWorldDelta(bytes)) {
+          message = applySimWorldDelta(bytes);
+        } else {
+          message = SimWorldMessage.toObject(
+            SimWorldMessage.decode(bytes),
+            { enums: String },
+          );
+        }
+        lastSimWorld = message;
+        if (message) {
+          message.type = 'SimWorldUpdate';
+        } else {
+          // Ask for a key frame.
+          message = { type: 'SimWorldResync' };
+        }
       }
       break;
     case 'map':
@@ -242,7 +242,8 @@ void CameraDevice::SetCameraParameters() {
   }
 }
 
-bool CameraDevice::Poll(std::shared_ptr<Image> pb_image) {
+bool CameraDevice::Poll(std::shared_ptr<Image> pb_image,
+                        std::shared_ptr<Image> raw_image) {
   // If in reconnecting state, attempt to reconnect first
   if (state_ == State::RECONNECTING) {
     Reconnect();
@@ -319,6 +320,12 @@ bool CameraDevice::Poll(std::shared_ptr<Image> pb_image) {
     }
     last_timestamp_ns_ = current_ts_ns;  // Update last timestamp for next cycle
 
+    // The caller has no free message to fill, give the buffer back unread
+    if (pb_image == nullptr) {
+      device_->QueueBuffer(v4l2_buf.index);
+      return false;
+    }
+
     // 5. Fill protobuf Image message metadata
     pb_image->set_measurement_time(static_cast<double>(current_ts_ns) /
                                    1e9);  // Convert ns to seconds
@@ -337,6 +344,21 @@ bool CameraDevice::Poll(std::shared_ptr<Image> pb_image) {
     // Processor will write directly into pb_image->mutable_data()->data()
     processor_->Process(v4l2_buf.start, v4l2_buf.length, pb_image);
 
+    if (raw_image != nullptr) {
+      raw_image->set_measurement_time(pb_image->measurement_time());
+      raw_image->set_frame_id(config_->frame_id());
+      raw_image->set_encoding("yuyv");
+      raw_image->set_width(config_->width());
+      raw_image->set_height(config_->height());
+      raw_image->set_step(config_->width() * 2);
+      // Process has checked that the buffer holds a whole frame
+      if (!processor_->ProcessRaw(v4l2_buf.start,
+                                  raw_image->height() * raw_image->step(),
+                                  raw_image)) {
+        AWARN_EVERY(1000) << "No raw frame from " << config_->camera_dev();
+      }
+    }
+
     // 7. Enqueue the buffer back to the V4L2 device for reuse
     device_->QueueBuffer(v4l2_buf.index);
 
@@ -52,10 +52,13 @@ class CameraDevice {
    * @param pb_image Shared pointer to the protobuf Image message to fill.
    *                 The caller is responsible for ensuring pb_image points to a
    * valid Image object with pre-allocated data buffer of sufficient size.
+   * If null, the frame is dequeued and dropped.
+   * @param raw_image If not null, also filled with the frame as YUYV.
    * @return True if a new image was successfully processed and filled into
    * pb_image, false otherwise.
    */
-  bool Poll(std::shared_ptr<Image> pb_image);
+  bool Poll(std::shared_ptr<Image> pb_image,
+            std::shared_ptr<Image> raw_image = nullptr);
 
   /**
    * @brief Checks if the camera is currently in an initialized state and
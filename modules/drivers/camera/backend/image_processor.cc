@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <mutex>
 #include <stdexcept>
 #include <vector>
@@ -31,12 +32,10 @@ namespace camera {
 // --- YuvProcessor Helper Functions (now private to the class, declared static)
 namespace {
 
-inline void ConvertUYVYToYUYV(const uint8_t* src, size_t len,
-                              std::vector<uint8_t>& out) {
+inline void ConvertUYVYToYUYV(const uint8_t* src, size_t len, uint8_t* out) {
   // UYVY: U Y V Y (for two pixels)
   // YUYV: Y U Y V (for two pixels)
   // U0 Y0 V0 Y1 -> Y0 U0 Y1 V0
-  out.resize(len);
   for (size_t i = 0; i + 3 < len; i += 4) {
     out[i + 0] = src[i + 1];
     out[i + 1] = src[i + 0];
@@ -52,53 +51,46 @@ inline void ConvertUYVYToYUYV(const uint8_t* src, size_t len,
 YuvProcessor::YuvProcessor(OutputFormat format, bool is_uyvy)
     : output_format_(format), is_uyvy_(is_uyvy) {}
 
-void YuvProcessor::ConvertYUYVToBGR(const uint8_t* src, int width, int height,
-                                    uint8_t* dst_bgr) {
-  // Create a cv::Mat for the YUYV input
-  // YUYV is an interleaved format where each pixel pair (Y0U0Y1V0) represents
-  // two pixels. OpenCV typically treats YUYV as a 2-channel image (CV_8UC2)
-  // where each "pixel" in the Mat is a UV or Y channel pair, or it can be
-  // explicitly handled as YUV. When using COLOR_YUV2BGR_YUYV, OpenCV expects
-  // the input data to be arranged as YUYV and correctly infers the width and
-  // height for conversion. The width passed to Mat constructor should be the
-  // actual pixel width of the image. The stride (step) is 2 bytes per YUYV
-  // pixel (YUYV is 4 bytes for 2 pixels, so 2 bytes/pixel avg) For
-  // cv::Mat(rows, cols, type, data), cols should be the pixel width, not byte
-  // width.
-  size_t yuyv_len = static_cast<size_t>(width) * height * 2;
-  if (opencv_yuyv_temp_buffer_.size() < yuyv_len) {
-    opencv_yuyv_temp_buffer_.resize(yuyv_len);
-  }
-  std::memcpy(opencv_yuyv_temp_buffer_.data(), src, yuyv_len);
-  cv::Mat yuyv_mat(height, width, CV_8UC2, opencv_yuyv_temp_buffer_.data());
+void YuvProcessor::ConvertToBGR(const uint8_t* src, int width, int height,
+                                uint8_t* dst_bgr) {
+  // OpenCV treats 4:2:2 data as a 2-channel image of the pixel width, and
+  // converts both byte orders directly, so the V4L2 buffer is wrapped as is.
+  cv::Mat yuv_mat(height, width, CV_8UC2, const_cast<uint8_t*>(src));
   cv::Mat bgr_mat(height, width, CV_8UC3, dst_bgr);
-  cv::cvtColor(yuyv_mat, bgr_mat, cv::COLOR_YUV2BGR_YUYV);
+  cv::cvtColor(yuv_mat, bgr_mat,
+               is_uyvy_ ? cv::COLOR_YUV2BGR_UYVY : cv::COLOR_YUV2BGR_YUYV);
 }
 
-void YuvProcessor::Process(const void* src, size_t len,
-                           std::shared_ptr<Image> dest_pb) {
-  const uint8_t* yuv_data_ptr = static_cast<const uint8_t*>(src);
-
-  // If the format is UYVY, convert to YUYV first.
-  // Reuse member variable yuyv_buffer_ to avoid repeated memory allocation.
+bool YuvProcessor::ProcessRaw(const void* src, size_t len,
+                              std::shared_ptr<Image> dest_pb) {
+  auto* out = dest_pb->mutable_data();
+  out->resize(len);
+  uint8_t* dest_yuyv_ptr = reinterpret_cast<uint8_t*>(&(*out)[0]);
   if (is_uyvy_) {
-    if (yuyv_buffer_.size() != len) {
-      yuyv_buffer_.resize(len);
-    }
-    ConvertUYVYToYUYV(yuv_data_ptr, len, yuyv_buffer_);
-    yuv_data_ptr = yuyv_buffer_.data();
+    ConvertUYVYToYUYV(static_cast<const uint8_t*>(src), len, dest_yuyv_ptr);
+  } else {
+    std::memcpy(dest_yuyv_ptr, src, len);
   }
+  return true;
+}
 
+void YuvProcessor::Process(const void* src, size_t len,
+                           std::shared_ptr<Image> dest_pb) {
   int width = dest_pb->width();
   int height = dest_pb->height();
   if (width <= 0 || height <= 0) {
     AERROR << "YuvProcessor: invalid image size " << width << "x" << height;
     throw std::invalid_argument("Invalid width/height");
   }
+  const size_t yuv_len = static_cast<size_t>(width) * height * 2;
+  if (len < yuv_len) {
+    AERROR << "YuvProcessor: frame too small: " << len << " < " << yuv_len;
+    throw std::invalid_argument("Incomplete frame");
+  }
 
   if (output_format_ == OutputFormat::YUYV) {
     // Direct copy to protobuf buffer for YUYV output
-    dest_pb->set_data(yuv_data_ptr, len);
+    ProcessRaw(src, yuv_len, dest_pb);
   } else if (output_format_ == OutputFormat::RGB) {
     const size_t needed = static_cast<size_t>(width) * height * 3;
     auto* out = dest_pb->mutable_data();
@@ -110,10 +102,11 @@ void YuvProcessor::Process(const void* src, size_t len,
     // Get mutable pointer to the protobuf's internal data buffer
     // This buffer must have been pre-allocated to the correct size in
     // CameraComponent
-    uint8_t* dest_rgb_ptr = reinterpret_cast<uint8_t*>(out->data());
+    uint8_t* dest_rgb_ptr = reinterpret_cast<uint8_t*>(&(*out)[0]);
 
-    // Convert YUYV to RGB (BGR order) using OpenCV efficient method
-    ConvertYUYVToBGR(yuv_data_ptr, width, height, dest_rgb_ptr);
+    // Convert straight from the V4L2 buffer (BGR order, as the encoding)
+    ConvertToBGR(static_cast<const uint8_t*>(src), width, height,
+                 dest_rgb_ptr);
   } else {
     // This should ideally be caught during configuration.
     AERROR << "YuvProcessor: unsupported output format "
@@ -42,12 +42,23 @@ class ImageProcessor {
    * correct size.
    */
   virtual void Process(const void* src, size_t len, ImagePtr dest_pb) = 0;
+
+  /**
+   * @brief Writes the raw frame as YUYV into dest_pb, for the consumers
+   * which can use it without the RGB conversion.
+   * @return False if the source format has no raw YUYV frame.
+   */
+  virtual bool ProcessRaw(const void* /*src*/, size_t /*len*/,
+                          ImagePtr /*dest_pb*/) {
+    return false;
+  }
 };
 
 /**
  * @brief Processes YUYV (or UYVY) image data.
- * Supports converting to RGB or outputting as YUYV. Includes SIMD
- * optimizations.
+ * Supports converting to RGB or outputting as YUYV. The frame is read in
+ * place from the V4L2 buffer and written into the message data, with no
+ * intermediate buffer; the color conversion is the SIMD kernel of OpenCV.
  */
 class YuvProcessor : public ImageProcessor {
  public:
@@ -67,25 +78,28 @@ class YuvProcessor : public ImageProcessor {
    */
   void Process(const void* src, size_t len, ImagePtr dest_pb) override;
 
+  /**
+   * @brief Copies the frame into dest_pb, swapping UYVY to YUYV on the way.
+   */
+  bool ProcessRaw(const void* src, size_t len, ImagePtr dest_pb) override;
+
  private:
   /**
-   * @brief Converts YUYV (YUV 4:2:2) formatted data to a BGR image.
+   * @brief Converts YUYV or UYVY (YUV 4:2:2) formatted data to a BGR image.
    *
-   * @param src       Pointer to input YUYV data, with length width * height * 2
+   * @param src       Pointer to input YUV data, with length width * height * 2
    * bytes.
    * @param width     Image width in pixels.
    * @param height    Image height in pixels.
    * @param dst_bgr   Pointer to output buffer for BGR data, size should be
    * width * height * 3 bytes.
    */
-  void ConvertYUYVToBGR(const uint8_t* src, int width, int height,
-                        uint8_t* dst_bgr);
+  void ConvertToBGR(const uint8_t* src, int width, int height,
+                    uint8_t* dst_bgr);
 
  private:
   OutputFormat output_format_;
-  bool is_uyvy_;                      ///< True if input is UYVY, false if YUYV
-  std::vector<uint8_t> yuyv_buffer_;  ///< Buffer for UYVY to YUYV conversion
-  std::vector<uint8_t> opencv_yuyv_temp_buffer_;
+  bool is_uyvy_;  ///< True if input is UYVY, false if YUYV
 };
 
 /**
@@ -0,0 +1,139 @@
+/**
+ * Per frame latency of the YUV capture path with a synthetic frame source:
+ * the frames stand in for the mapped V4L2 buffers, and are converted into
+ * preallocated messages the way CameraDevice::Poll does, by the copy through
+ * intermediate buffers of the previous YuvProcessor and by YuvProcessor.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <opencv2/imgproc.hpp>
+
+#include "gflags/gflags.h"
+
+#include "modules/drivers/camera/backend/image_processor.h"
+
+DEFINE_int32(frames, 300, "frames to convert");
+DEFINE_int32(width, 1920, "frame width");
+DEFINE_int32(height, 1080, "frame height");
+
+namespace {
+
+using apollo::drivers::Image;
+using apollo::drivers::camera::YuvProcessor;
+
+struct Latency {
+  std::vector<double> ms;
+
+  void Print(const char* name) {
+    std::sort(ms.begin(), ms.end());
+    double sum = 0.0;
+    for (double t : ms) {
+      sum += t;
+    }
+    printf("%-20s mean %7.3f ms, p50 %7.3f ms, p99 %7.3f ms\n", name,
+           sum / static_cast<double>(ms.size()), ms[ms.size() / 2],
+           ms[std::min(ms.size() - 1, ms.size() * 99 / 100)]);
+  }
+};
+
+std::vector<std::vector<uint8_t>> MakeFrames(int count) {
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::vector<std::vector<uint8_t>> frames(count);
+  for (auto& frame : frames) {
+    frame.resize(static_cast<size_t>(FLAGS_width) * FLAGS_height * 2);
+    for (auto& value : frame) {
+      value = static_cast<uint8_t>(byte(rng));
+    }
+  }
+  return frames;
+}
+
+std::shared_ptr<Image> MakeImage(int bytes_per_pixel) {
+  auto image = std::make_shared<Image>();
+  image->set_width(FLAGS_width);
+  image->set_height(FLAGS_height);
+  image->set_step(FLAGS_width * bytes_per_pixel);
+  image->mutable_data()->resize(static_cast<size_t>(FLAGS_width) *
+                                FLAGS_height * bytes_per_pixel);
+  return image;
+}
+
+// The conversion of YuvProcessor before it read the V4L2 buffer in place.
+void CopyAndConvert(const std::vector<uint8_t>& frame, bool is_uyvy,
+                    std::vector<uint8_t>* yuyv_buffer,
+                    std::vector<uint8_t>* temp_buffer, Image* image) {
+  const uint8_t* src = frame.data();
+  const size_t len = frame.size();
+  if (is_uyvy) {
+    yuyv_buffer->resize(len);
+    for (size_t i = 0; i + 3 < len; i += 4) {
+      (*yuyv_buffer)[i + 0] = src[i + 1];
+      (*yuyv_buffer)[i + 1] = src[i + 0];
+      (*yuyv_buffer)[i + 2] = src[i + 3];
+      (*yuyv_buffer)[i + 3] = src[i + 2];
+    }
+    src = yuyv_buffer->data();
+  }
+  temp_buffer->resize(len);
+  std::memcpy(temp_buffer->data(), src, len);
+  cv::Mat yuyv_mat(FLAGS_height, FLAGS_width, CV_8UC2, temp_buffer->data());
+  cv::Mat bgr_mat(FLAGS_height, FLAGS_width, CV_8UC3,
+                  &(*image->mutable_data())[0]);
+  cv::cvtColor(yuyv_mat, bgr_mat, cv::COLOR_YUV2BGR_YUYV);
+}
+
+double Elapsed(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+void Run(const std::vector<std::vector<uint8_t>>& frames, bool is_uyvy) {
+  auto image = MakeImage(3);
+  auto raw_image = MakeImage(2);
+  YuvProcessor processor(YuvProcessor::OutputFormat::RGB, is_uyvy);
+  std::vector<uint8_t> yuyv_buffer;
+  std::vector<uint8_t> temp_buffer;
+  Latency copied;
+  Latency in_place;
+  Latency with_raw;
+  for (int i = 0; i < FLAGS_frames; ++i) {
+    const auto& frame = frames[i % frames.size()];
+    auto start = std::chrono::steady_clock::now();
+    CopyAndConvert(frame, is_uyvy, &yuyv_buffer, &temp_buffer, image.get());
+    copied.ms.push_back(Elapsed(start));
+
+    start = std::chrono::steady_clock::now();
+    processor.Process(frame.data(), frame.size(), image);
+    in_place.ms.push_back(Elapsed(start));
+
+    start = std::chrono::steady_clock::now();
+    processor.Process(frame.data(), frame.size(), image);
+    processor.ProcessRaw(frame.data(), frame.size(), raw_image);
+    with_raw.ms.push_back(Elapsed(start));
+  }
+  printf("%s:\n", is_uyvy ? "uyvy" : "yuyv");
+  copied.Print("  copied");
+  in_place.Print("  in place");
+  with_raw.Print("  in place, raw too");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  const auto frames = MakeFrames(4);
+  printf("%d frames of %dx%d to bgr8\n", FLAGS_frames, FLAGS_width,
+         FLAGS_height);
+  Run(frames, false);
+  Run(frames, true);
+  return 0;
+}
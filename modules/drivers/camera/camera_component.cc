@@ -67,38 +67,88 @@ bool CameraComponent::Init() {
   device_wait_ms_ = camera_config_->device_wait_ms();
 
   // Initialize Protobuf message buffer pool
+  InitImagePool(encoding_str, step_bytes, image_size_expected, &image_pool_);
+  writer_ = node_->CreateWriter<Image>(camera_config_->channel_name());
+
+  if (!camera_config_->raw_channel_name().empty()) {
+    const std::string& pixel_format = camera_config_->pixel_format();
+    if ((pixel_format == "yuyv" || pixel_format == "uyvy") &&
+        camera_config_->output_type() == config::OutputType::RGB) {
+      InitImagePool("yuyv", 2 * actual_width,
+                    actual_width * actual_height * 2, &raw_image_pool_);
+      raw_writer_ =
+          node_->CreateWriter<Image>(camera_config_->raw_channel_name());
+    } else {
+      AWARN << "No raw frames on " << camera_config_->raw_channel_name()
+            << " for pixel format " << pixel_format << " and output type "
+            << camera_config_->output_type();
+    }
+  }
+
+  // Start asynchronous run loop
+  running_.store(true);
+  async_result_ = cyber::Async(&CameraComponent::Run, this);
+  return true;
+}
+
+void CameraComponent::InitImagePool(const std::string& encoding,
+                                    uint32_t step_bytes, uint32_t image_size,
+                                    ImagePool* pool) {
   for (int i = 0; i < buffer_size_; ++i) {
     auto pb_image = std::make_shared<Image>();
     pb_image->mutable_header()->set_frame_id(camera_config_->frame_id());
-    pb_image->set_width(actual_width);
-    pb_image->set_height(actual_height);
-    pb_image->set_encoding(encoding_str);
+    pb_image->set_width(camera_config_->width());
+    pb_image->set_height(camera_config_->height());
+    pb_image->set_encoding(encoding);
     pb_image->set_step(step_bytes);
 
     // Key: Pre-allocate memory by resizing the string. This enables Zero-Copy
     // during subsequent image processing by ensuring mutable_data()->data()
     // returns a valid pointer to the allocated memory.
-    pb_image->mutable_data()->resize(image_size_expected);
+    pb_image->mutable_data()->resize(image_size);
 
-    pb_image_buffer_.push_back(pb_image);
+    pool->images.push_back(pb_image);
   }
+}
 
-  writer_ = node_->CreateWriter<Image>(camera_config_->channel_name());
-
-  // Start asynchronous run loop
-  running_.store(true);
-  async_result_ = cyber::Async(&CameraComponent::Run, this);
-  return true;
+std::shared_ptr<Image> CameraComponent::NextImage(ImagePool* pool) {
+  const size_t size = pool->images.size();
+  for (size_t i = 0; i < size; ++i) {
+    const size_t index = (pool->index + i) % size;
+    // Readers of the same process share the published message, it is only
+    // overwritten once they have released it.
+    if (pool->images[index].use_count() == 1) {
+      pool->index = (index + 1) % size;
+      return pool->images[index];
+    }
+  }
+  if (size < kMaxImagePoolSize) {
+    auto pb_image = std::make_shared<Image>(*pool->images[pool->index]);
+    pool->images.insert(pool->images.begin() + pool->index, pb_image);
+    pool->index = (pool->index + 1) % pool->images.size();
+    return pb_image;
+  }
+  AWARN_EVERY(100) << "Readers hold all the " << size
+                   << " image messages, dropping a frame";
+  return nullptr;
 }
 
 void CameraComponent::Run() {
   while (running_.load() && !cyber::IsShutdown()) {
-    // Get a protobuf message from the buffer pool
-    auto pb_image = pb_image_buffer_[index_];
-    index_ = (index_ + 1) % buffer_size_;
+    // Get protobuf messages from the buffer pools
+    auto pb_image = NextImage(&image_pool_);
+    std::shared_ptr<Image> raw_image;
+    if (raw_writer_ != nullptr && pb_image != nullptr) {
+      raw_image = NextImage(&raw_image_pool_);
+    }
 
     // The Poll method now directly processes data into pb_image
-    if (!camera_device_->Poll(pb_image)) {
+    if (!camera_device_->Poll(pb_image, raw_image)) {
+      // Poll has dropped the frame for want of a free message, the device
+      // is fine
+      if (pb_image == nullptr && camera_device_->IsCapturing()) {
+        continue;
+      }
       // If Poll fails, the internal reconnection logic has been handled, just
       // wait here
       cyber::SleepFor(std::chrono::milliseconds(device_wait_ms_));
@@ -111,6 +161,11 @@ void CameraComponent::Run() {
 
     // measurement_time and image data have been filled in Poll()
     writer_->Write(pb_image);
+    if (raw_image != nullptr) {
+      raw_image->mutable_header()->set_timestamp_sec(
+          pb_image->header().timestamp_sec());
+      raw_writer_->Write(raw_image);
+    }
 
     // Note: There is no extra SleepFor(spin_rate_). The loop rate is determined
     // by the blocking behavior of Poll().
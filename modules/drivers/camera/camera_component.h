@@ -19,6 +19,7 @@
 #include <atomic>
 #include <future>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "modules/common_msgs/sensor_msgs/sensor_image.pb.h"
@@ -46,22 +47,48 @@ class CameraComponent : public apollo::cyber::Component<> {
   ~CameraComponent();
 
  private:
+  /**
+   * @brief Circular buffer of protobuf image messages, whose data buffers are
+   * written in place by the CameraDevice.
+   */
+  struct ImagePool {
+    std::vector<std::shared_ptr<apollo::drivers::Image>> images;
+    size_t index = 0;  ///< Next message to fill
+  };
+
   // Main execution loop for image polling and publishing
   void Run();
 
+  /**
+   * @brief Initializes a pool of buffer_size_ messages for frames of the
+   * given encoding.
+   */
+  void InitImagePool(const std::string& encoding, uint32_t step_bytes,
+                     uint32_t image_size, ImagePool* pool);
+
+  /**
+   * @brief Returns the next message of the pool that no reader holds any
+   * more, adding one to the pool when the readers hold all of them, or
+   * nullptr when the pool has kMaxImagePoolSize messages already.
+   */
+  std::shared_ptr<apollo::drivers::Image> NextImage(ImagePool* pool);
+
   std::shared_ptr<apollo::cyber::Writer<apollo::drivers::Image>>
       writer_;  ///< Cyber RT writer for image messages
+  std::shared_ptr<apollo::cyber::Writer<apollo::drivers::Image>>
+      raw_writer_;  ///< Cyber RT writer for the YUYV frames, if configured
   std::unique_ptr<CameraDevice> camera_device_;    ///< Camera device interface
   std::shared_ptr<config::Config> camera_config_;  ///< Camera configuration
-  std::vector<std::shared_ptr<apollo::drivers::Image>>
-      pb_image_buffer_;  ///< Circular buffer for protobuf image messages
+  ImagePool image_pool_;      ///< Messages of the published images
+  ImagePool raw_image_pool_;  ///< Messages of the published YUYV frames
 
   uint32_t device_wait_ms_;  ///< Delay in milliseconds after poll failure
-  int index_ = 0;            ///< Current index in the circular buffer
-  int buffer_size_ = 3;      ///< Size of the circular buffer
+  int buffer_size_ = 3;      ///< Initial size of the circular buffers
 
   static constexpr int32_t kMaxImageSize =
       20 * 1024 * 1024;  ///< Maximum allowed image size in bytes (20 MB)
+  static constexpr size_t kMaxImagePoolSize =
+      8;  ///< Frames are dropped while readers hold more messages
 
   std::future<void>
       async_result_;  ///< Future object for managing the async run() thread
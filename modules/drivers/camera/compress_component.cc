@@ -16,12 +16,6 @@
 
 #include "modules/drivers/camera/compress_component.h"
 
-#include <exception>
-#include <vector>
-
-#include "opencv2/imgcodecs.hpp"
-#include "opencv2/imgproc/imgproc.hpp"
-
 namespace apollo {
 namespace drivers {
 namespace camera {
@@ -43,6 +37,11 @@ bool CompressComponent::Init() {
 
   writer_ = node_->CreateWriter<CompressedImage>(
       config_.compress_conf().output_channel());
+  compressor_.reset(new JpegCompressor(
+      config_.compress_conf(),
+      [this](const std::shared_ptr<CompressedImage>& compressed_image) {
+        writer_->Write(compressed_image);
+      }));
   return true;
 }
 
@@ -54,25 +53,11 @@ bool CompressComponent::Proc(const std::shared_ptr<Image>& image) {
   compressed_image->set_measurement_time(image->measurement_time());
   compressed_image->set_format(image->encoding() + "; jpeg compressed bgr8");
 
-  std::vector<int> params;
-  params.resize(3, 0);
-  params[0] = cv::IMWRITE_JPEG_QUALITY;
-  params[1] = 95;
-
-  try {
-    cv::Mat mat_image(image->height(), image->width(), CV_8UC3,
-                      const_cast<char*>(image->data().data()), image->step());
-    cv::Mat tmp_mat;
-    cv::cvtColor(mat_image, tmp_mat, cv::COLOR_RGB2BGR);
-    std::vector<uint8_t> compress_buffer;
-    if (!cv::imencode(".jpg", tmp_mat, compress_buffer, params)) {
-      AERROR << "cv::imencode (jpeg) failed on input image";
-      return false;
-    }
-    compressed_image->set_data(compress_buffer.data(), compress_buffer.size());
-    writer_->Write(compressed_image);
-  } catch (std::exception& e) {
-    AERROR << "cv::imencode (jpeg) exception :" << e.what();
+  if (!compressor_->Submit(image, compressed_image)) {
+    AWARN_EVERY(100) << "Drop frames, " << compressor_->dropped_frames()
+                     << " dropped as "
+                     << config_.compress_conf().max_pending_frames()
+                     << " frames are pending";
     return false;
   }
   return true;
@@ -20,6 +20,7 @@
 
 #include "cyber/base/concurrent_object_pool.h"
 #include "cyber/cyber.h"
+#include "modules/drivers/camera/jpeg_compressor.h"
 #include "modules/drivers/camera/proto/config.pb.h"
 #include "modules/common_msgs/sensor_msgs/sensor_image.pb.h"
 
@@ -41,6 +42,8 @@ class CompressComponent : public Component<Image> {
  private:
   std::shared_ptr<CCObjectPool<CompressedImage>> image_pool_;
   std::shared_ptr<Writer<CompressedImage>> writer_ = nullptr;
+  // publishes with writer_, so it is destroyed first
+  std::unique_ptr<JpegCompressor> compressor_;
   Config config_;
 };
 
@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/drivers/camera/jpeg_compressor.h"
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+#include <vector>
+
+#include "opencv2/imgcodecs.hpp"
+#include "opencv2/imgproc/imgproc.hpp"
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace drivers {
+namespace camera {
+
+JpegCompressor::JpegCompressor(const config::Config::CompressConfig& conf,
+                               Publisher publisher)
+    : publisher_(std::move(publisher)),
+      quality_(static_cast<int>(conf.jpeg_quality())),
+      downsample_factor_(
+          std::max(1, static_cast<int>(conf.downsample_factor()))),
+      max_pending_frames_(std::max<uint64_t>(1, conf.max_pending_frames())) {
+  if (conf.worker_num() > 0) {
+    // never full, Submit drops the frames beyond max_pending_frames
+    pool_.reset(new cyber::base::ThreadPool(conf.worker_num(),
+                                            max_pending_frames_));
+  }
+}
+
+JpegCompressor::~JpegCompressor() {
+  Flush();
+  pool_.reset();
+}
+
+bool JpegCompressor::Submit(
+    const std::shared_ptr<Image>& image,
+    const std::shared_ptr<CompressedImage>& compressed) {
+  uint64_t seq = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (next_seq_ - published_seq_ >= max_pending_frames_) {
+      ++dropped_frames_;
+      return false;
+    }
+    seq = next_seq_++;
+  }
+  if (pool_ == nullptr) {
+    Run(seq, image, compressed);
+  } else {
+    // the camera refills its pooled messages in place, so the workers
+    // encode a copy taken before Submit returns
+    auto input = std::make_shared<Image>(*image);
+    pool_->Enqueue([this, seq, input, compressed] {
+      Run(seq, input, compressed);
+    });
+  }
+  return true;
+}
+
+void JpegCompressor::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  published_cv_.wait(lock, [this] { return published_seq_ == next_seq_; });
+}
+
+uint64_t JpegCompressor::dropped_frames() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return dropped_frames_;
+}
+
+void JpegCompressor::Run(uint64_t seq, const std::shared_ptr<Image>& image,
+                         const std::shared_ptr<CompressedImage>& compressed) {
+  bool encoded = false;
+  try {
+    encoded = Encode(*image, quality_, downsample_factor_,
+                     compressed->mutable_data());
+    if (!encoded) {
+      AERROR << "cv::imencode (jpeg) failed on input image";
+    }
+  } catch (std::exception& e) {
+    AERROR << "cv::imencode (jpeg) exception :" << e.what();
+  }
+
+  // the frames before seq may still be encoding on the other workers
+  std::unique_lock<std::mutex> lock(mutex_);
+  published_cv_.wait(lock, [this, seq] { return published_seq_ == seq; });
+  if (encoded) {
+    publisher_(compressed);
+  }
+  ++published_seq_;
+  published_cv_.notify_all();
+}
+
+bool JpegCompressor::Encode(const Image& image, int quality,
+                            int downsample_factor, std::string* jpeg) {
+  const int width = static_cast<int>(image.width());
+  const int height = static_cast<int>(image.height());
+  if (width <= 0 || height <= 0 ||
+      image.data().size() < static_cast<size_t>(image.step()) * height) {
+    AERROR << "Image of " << width << "x" << height << " has "
+           << image.data().size() << " bytes";
+    return false;
+  }
+  thread_local cv::Mat bgr;
+  thread_local std::vector<uint8_t> buffer;
+
+  cv::Mat rgb(height, width, CV_8UC3, const_cast<char*>(image.data().data()),
+              image.step());
+  if (downsample_factor > 1) {
+    cv::resize(rgb, bgr,
+               cv::Size(std::max(1, width / downsample_factor),
+                        std::max(1, height / downsample_factor)),
+               0, 0, cv::INTER_AREA);
+    // swap the channels of the smaller image, in place
+    cv::cvtColor(bgr, bgr, cv::COLOR_RGB2BGR);
+  } else {
+    cv::cvtColor(rgb, bgr, cv::COLOR_RGB2BGR);
+  }
+
+  const std::vector<int> params = {cv::IMWRITE_JPEG_QUALITY, quality};
+  if (!cv::imencode(".jpg", bgr, buffer, params)) {
+    return false;
+  }
+  // the pooled message keeps the capacity of its data
+  jpeg->assign(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+  return true;
+}
+
+}  // namespace camera
+}  // namespace drivers
+}  // namespace apollo
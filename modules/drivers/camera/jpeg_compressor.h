@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "cyber/base/thread_pool.h"
+#include "modules/common_msgs/sensor_msgs/sensor_image.pb.h"
+#include "modules/drivers/camera/proto/config.pb.h"
+
+namespace apollo {
+namespace drivers {
+namespace camera {
+
+/**
+ * @class JpegCompressor
+ * @brief Encodes rgb8 images to jpeg on a pool of worker threads. The frames
+ *        are published in the order they are submitted, and a frame is
+ *        dropped when max_pending_frames frames are not published yet.
+ *        With worker_num 0 the frames are encoded in Submit.
+ */
+class JpegCompressor {
+ public:
+  using Publisher =
+      std::function<void(const std::shared_ptr<CompressedImage>&)>;
+
+  JpegCompressor(const config::Config::CompressConfig& conf,
+                 Publisher publisher);
+
+  // Publishes the pending frames first.
+  ~JpegCompressor();
+
+  /**
+   * @brief Encode image into the data of compressed, whose other fields are
+   *        set by the caller, and publish it. image may be reused once
+   *        Submit returns.
+   * @return false if the frame is dropped.
+   */
+  bool Submit(const std::shared_ptr<Image>& image,
+              const std::shared_ptr<CompressedImage>& compressed);
+
+  // Wait until all the submitted frames are published.
+  void Flush();
+
+  uint64_t dropped_frames();
+
+  /**
+   * @brief Encode an rgb8 image, with the color and downsampling buffers of
+   *        the calling thread, which are reused by its next frames.
+   */
+  static bool Encode(const Image& image, int quality, int downsample_factor,
+                     std::string* jpeg);
+
+ private:
+  void Run(uint64_t seq, const std::shared_ptr<Image>& image,
+           const std::shared_ptr<CompressedImage>& compressed);
+
+  Publisher publisher_;
+  int quality_ = 95;
+  int downsample_factor_ = 1;
+  uint64_t max_pending_frames_ = 1;
+
+  std::mutex mutex_;
+  // signaled when a frame is published
+  std::condition_variable published_cv_;
+  // sequence number of the next submitted frame
+  uint64_t next_seq_ = 0;
+  // sequence number of the next frame to publish
+  uint64_t published_seq_ = 0;
+  uint64_t dropped_frames_ = 0;
+
+  std::unique_ptr<cyber::base::ThreadPool> pool_;
+};
+
+}  // namespace camera
+}  // namespace drivers
+}  // namespace apollo
@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * Throughput of the camera compression: the encoding CompressComponent did
+ * on its own thread, with a new color swapped image and jpeg buffer per
+ * frame, and JpegCompressor with --worker_num workers. Frames are pushed as
+ * fast as they are accepted; the report is frames per second and process
+ * cpu time per frame.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "opencv2/imgcodecs.hpp"
+#include "opencv2/imgproc/imgproc.hpp"
+
+#include "modules/drivers/camera/jpeg_compressor.h"
+
+DEFINE_int32(frames, 300, "frames to encode");
+DEFINE_int32(width, 1920, "image width");
+DEFINE_int32(height, 1080, "image height");
+DEFINE_int32(worker_num, 4, "JpegCompressor workers");
+DEFINE_int32(downsample_factor, 2, "downsample factor of the last run");
+
+namespace {
+
+using apollo::drivers::CompressedImage;
+using apollo::drivers::Image;
+using apollo::drivers::camera::JpegCompressor;
+
+// Smooth gradients with sensor noise, so that jpeg does some work.
+std::shared_ptr<Image> MakeImage(int index) {
+  auto image = std::make_shared<Image>();
+  image->set_width(FLAGS_width);
+  image->set_height(FLAGS_height);
+  image->set_step(FLAGS_width * 3);
+  image->set_encoding("rgb8");
+  std::string* data = image->mutable_data();
+  data->resize(static_cast<size_t>(FLAGS_width) * FLAGS_height * 3);
+  std::mt19937 rng(index);
+  std::uniform_int_distribution<int> noise(-8, 8);
+  for (int y = 0; y < FLAGS_height; ++y) {
+    for (int x = 0; x < FLAGS_width; ++x) {
+      char* pixel = &(*data)[(static_cast<size_t>(y) * FLAGS_width + x) * 3];
+      pixel[0] = static_cast<char>((x + index * 7) % 256 / 2 + 64 + noise(rng));
+      pixel[1] = static_cast<char>(y % 256 / 2 + 64 + noise(rng));
+      pixel[2] = static_cast<char>((x + y) % 256 / 2 + 64 + noise(rng));
+    }
+  }
+  return image;
+}
+
+void Report(const char* name, int frames,
+            const std::chrono::steady_clock::time_point& start,
+            std::clock_t cpu_start) {
+  const double seconds = std::chrono::duration<double>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+  const double cpu_ms =
+      1000.0 * static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+  printf("%-24s %7.1f fps, %6.2f ms cpu per frame\n", name, frames / seconds,
+         cpu_ms / frames);
+}
+
+void RunInline(const std::vector<std::shared_ptr<Image>>& images) {
+  const std::vector<int> params = {cv::IMWRITE_JPEG_QUALITY, 95};
+  CompressedImage compressed;
+  const auto start = std::chrono::steady_clock::now();
+  const std::clock_t cpu_start = std::clock();
+  for (int i = 0; i < FLAGS_frames; ++i) {
+    const Image& image = *images[i % images.size()];
+    cv::Mat mat_image(image.height(), image.width(), CV_8UC3,
+                      const_cast<char*>(image.data().data()), image.step());
+    cv::Mat tmp_mat;
+    cv::cvtColor(mat_image, tmp_mat, cv::COLOR_RGB2BGR);
+    std::vector<uint8_t> compress_buffer;
+    cv::imencode(".jpg", tmp_mat, compress_buffer, params);
+    compressed.set_data(compress_buffer.data(), compress_buffer.size());
+  }
+  Report("inline", FLAGS_frames, start, cpu_start);
+}
+
+void RunCompressor(const char* name,
+                   const std::vector<std::shared_ptr<Image>>& images,
+                   int worker_num, int downsample_factor) {
+  apollo::drivers::camera::config::Config::CompressConfig conf;
+  conf.set_worker_num(worker_num);
+  conf.set_max_pending_frames(2 * worker_num + 2);
+  conf.set_downsample_factor(downsample_factor);
+  size_t bytes = 0;
+  int published = 0;
+  JpegCompressor compressor(
+      conf, [&bytes, &published](
+                const std::shared_ptr<CompressedImage>& compressed) {
+        bytes += compressed->data().size();
+        ++published;
+      });
+  const auto start = std::chrono::steady_clock::now();
+  const std::clock_t cpu_start = std::clock();
+  for (int i = 0; i < FLAGS_frames; ++i) {
+    const auto& image = images[i % images.size()];
+    while (!compressor.Submit(image, std::make_shared<CompressedImage>())) {
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+  }
+  compressor.Flush();
+  Report(name, published, start, cpu_start);
+  printf("%-24s %7.1f KB per frame\n", "", bytes / 1024.0 / published);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  std::vector<std::shared_ptr<Image>> images;
+  for (int i = 0; i < 8; ++i) {
+    images.push_back(MakeImage(i));
+  }
+  printf("%d frames of %dx%d, %u hardware threads\n", FLAGS_frames,
+         FLAGS_width, FLAGS_height, std::thread::hardware_concurrency());
+  RunInline(images);
+  RunCompressor("compressor, sync", images, 0, 1);
+  RunCompressor("compressor, workers", images, FLAGS_worker_num, 1);
+  RunCompressor("compressor, downsampled", images, FLAGS_worker_num,
+                FLAGS_downsample_factor);
+  return 0;
+}
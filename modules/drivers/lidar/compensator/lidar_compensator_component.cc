@@ -19,9 +19,11 @@
 
 #include "modules/drivers/lidar/compensator/proto/lidar_compensator_config.pb.h"
 
+#include "cyber/time/clock.h"
 #include "cyber/time/time.h"
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/latency_recorder/latency_recorder.h"
+#include "modules/common/latency_recorder/latency_tracer.h"
 
 namespace apollo {
 namespace drivers {
@@ -52,6 +54,7 @@ bool LidarCompensatorComponent::Init() {
 bool LidarCompensatorComponent::Proc(
     const std::shared_ptr<PointCloud>& point_cloud) {
   const auto start_time = apollo::cyber::Time::Now();
+  const auto trace_begin_time = apollo::cyber::Clock::Now();
   std::shared_ptr<PointCloud> point_cloud_compensated =
       compensator_pool_->GetObject();
   if (point_cloud_compensated == nullptr) {
@@ -79,6 +82,10 @@ bool LidarCompensatorComponent::Proc(
     latency_recorder.AppendLatencyRecord(
         point_cloud_compensated->header().lidar_timestamp(), start_time,
         end_time);
+    auto* header = point_cloud_compensated->mutable_header();
+    common::LatencyTracer::StartTrace("lidar_compensator",
+                                      header->lidar_timestamp(),
+                                      trace_begin_time, header);
 
     point_cloud_compensated->mutable_header()->set_sequence_num(seq_);
     writer_->Write(point_cloud_compensated);
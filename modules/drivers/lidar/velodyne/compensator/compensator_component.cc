@@ -17,12 +17,15 @@
 
 #include <memory>
 
+#include "cyber/time/clock.h"
 #include "cyber/time/time.h"
 
 #include "modules/common/adapters/adapter_gflags.h"
 #include "modules/common/latency_recorder/latency_recorder.h"
+#include "modules/common/latency_recorder/latency_tracer.h"
 #include "modules/drivers/lidar/proto/velodyne.pb.h"
 
+using apollo::cyber::Clock;
 using apollo::cyber::Time;
 
 namespace apollo {
@@ -54,6 +57,7 @@ bool CompensatorComponent::Init() {
 bool CompensatorComponent::Proc(
     const std::shared_ptr<PointCloud>& point_cloud) {
   const auto start_time = Time::Now();
+  const auto trace_begin_time = Clock::Now();
   std::shared_ptr<PointCloud> point_cloud_compensated =
       compensator_pool_->GetObject();
   if (point_cloud_compensated == nullptr) {
@@ -79,6 +83,10 @@ bool CompensatorComponent::Proc(
     latency_recorder.AppendLatencyRecord(
         point_cloud_compensated->header().lidar_timestamp(), start_time,
         end_time);
+    auto* header = point_cloud_compensated->mutable_header();
+    common::LatencyTracer::StartTrace("lidar_compensator",
+                                      header->lidar_timestamp(),
+                                      trace_begin_time, header);
 
     point_cloud_compensated->mutable_header()->set_sequence_num(seq_);
     writer_->Write(point_cloud_compensated);
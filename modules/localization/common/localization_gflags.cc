@@ -73,6 +73,9 @@ DEFINE_double(lidar_imu_max_delay_time, 0.4,
               "Lidar msg and imu msg max delay time");
 DEFINE_double(lidar_map_coverage_theshold, 0.9,
               "Threshold to detect whether vehicle is out of map");
+DEFINE_double(lidar_map_prefetch_time, 0.0,
+              "Seconds ahead along the velocity to preload the lidar map "
+              "nodes, 0 to preload the nodes around the vehicle only.");
 DEFINE_bool(lidar_debug_log_flag, false, "Lidar Debug switch.");
 DEFINE_int32(point_cloud_step, 2, "Point cloud step");
 DEFINE_bool(if_use_avx, false,
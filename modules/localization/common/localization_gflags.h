@@ -56,6 +56,7 @@ DECLARE_int32(lidar_yaw_align_mode);
 DECLARE_int32(lidar_filter_size);
 DECLARE_double(lidar_imu_max_delay_time);
 DECLARE_double(lidar_map_coverage_theshold);
+DECLARE_double(lidar_map_prefetch_time);
 DECLARE_bool(lidar_debug_log_flag);
 DECLARE_int32(point_cloud_step);
 DECLARE_bool(if_use_avx);
@@ -15,6 +15,7 @@
  *****************************************************************************/
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <utility>
 #include "cyber/common/log.h"
@@ -77,6 +78,14 @@ class MapNodeCache {
   unsigned int Size() { return lru_map_nodes_.size(); }
   /**@brief return cache's max capacity. */
   unsigned Capacity() { return lru_map_nodes_.capacity(); }
+  /**@brief return the number of Get calls that found / missed the key. */
+  uint64_t HitCount() const { return hit_count_; }
+  uint64_t MissCount() const { return miss_count_; }
+  /**@brief reset the hit and miss counts. */
+  void ResetCounts() {
+    hit_count_ = 0;
+    miss_count_ = 0;
+  }
 
  private:
   /**@brief do something before remove an element from cache.
@@ -85,6 +94,8 @@ class MapNodeCache {
    * remove. */
   const DestroyFunc destroy_func_;
   MapLRUCache lru_map_nodes_;
+  uint64_t hit_count_ = 0;
+  uint64_t miss_count_ = 0;
 };
 
 template <class Key, class Element, class MapLRUCache>
@@ -92,8 +103,10 @@ bool MapNodeCache<Key, Element, MapLRUCache>::Get(const Key& key,
                                                   Element** value) {
   auto value_ptr = lru_map_nodes_.Get(key);
   if (!value_ptr) {
+    ++miss_count_;
     return false;
   }
+  ++hit_count_;
   *value = *value_ptr;
   return true;
 }
@@ -156,6 +156,22 @@ TEST_F(MapNodeCacheTest, PutOverCapacity) {
   EXPECT_EQ(map_node_cache_lvl_->IsExist(std::move(NodeIndex(4, 5))), true);
 }
 
+TEST_F(MapNodeCacheTest, HitAndMissCounts) {
+  map_node_cache_lvl_->Put(node_pool_[0].first, &(node_pool_[0].second));
+  NodeData* node_data = nullptr;
+  EXPECT_TRUE(map_node_cache_lvl_->Get(NodeIndex(1, 2), &node_data));
+  EXPECT_TRUE(map_node_cache_lvl_->Get(NodeIndex(1, 2), &node_data));
+  EXPECT_FALSE(map_node_cache_lvl_->Get(NodeIndex(2, 3), &node_data));
+  // neither checking nor silent reads count
+  EXPECT_TRUE(map_node_cache_lvl_->IsExist(NodeIndex(1, 2)));
+  EXPECT_TRUE(map_node_cache_lvl_->GetSilent(NodeIndex(1, 2), &node_data));
+  EXPECT_EQ(map_node_cache_lvl_->HitCount(), 2);
+  EXPECT_EQ(map_node_cache_lvl_->MissCount(), 1);
+  map_node_cache_lvl_->ResetCounts();
+  EXPECT_EQ(map_node_cache_lvl_->HitCount(), 0);
+  EXPECT_EQ(map_node_cache_lvl_->MissCount(), 0);
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
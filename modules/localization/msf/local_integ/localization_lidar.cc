@@ -16,6 +16,8 @@
 
 #include "modules/localization/msf/local_integ/localization_lidar.h"
 
+#include "modules/localization/common/localization_gflags.h"
+
 namespace apollo {
 namespace localization {
 namespace msf {
@@ -136,7 +138,18 @@ int LocalizationLidar::Update(const unsigned int frame_idx,
   map_.LoadMapArea(pose_trans, resolution_id_, zone_id_, 0, 0);
 
   // preload map for next locate
-  map_.PreloadMapArea(pose_trans, velocity, resolution_id_, zone_id_);
+  if (FLAGS_lidar_map_prefetch_time > 0.0) {
+    map_.PrefetchMapArea(pose_trans, velocity, FLAGS_lidar_map_prefetch_time,
+                         resolution_id_, zone_id_);
+  } else {
+    map_.PreloadMapArea(pose_trans, velocity, resolution_id_, zone_id_);
+  }
+  const pyramid_map::MapNodeLoadStats load_stats = map_.GetLoadStats();
+  AINFO_EVERY(100) << "Lidar map nodes found: " << load_stats.area_hits
+                   << " waited for: " << load_stats.area_misses
+                   << " max wait: " << load_stats.max_wait_ms
+                   << " ms, loaded: " << load_stats.loads << " max load: "
+                   << load_stats.max_load_ms << " ms";
 
   // generate composed map for compare
   ComposeMapNode(pose_trans);
@@ -16,8 +16,11 @@
 
 #include "modules/localization/msf/local_pyramid_map/base_map/base_map.h"
 
+#include <algorithm>
+#include <chrono>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 
@@ -125,6 +128,7 @@ void BaseMap::LoadMapNodes(std::set<MapNodeIndex>* map_ids) {
     std::cerr << "map_ids's size is bigger than cache's capacity" << std::endl;
     return;
   }
+  const size_t area_size = map_ids->size();
 
   // check in cacheL1
   std::set<MapNodeIndex>::iterator itr = map_ids->begin();
@@ -142,6 +146,8 @@ void BaseMap::LoadMapNodes(std::set<MapNodeIndex>* map_ids) {
   }
   // check and update cache
   CheckAndUpdateCache(map_ids);
+  const size_t misses = map_ids->size();
+  const auto wait_start = std::chrono::steady_clock::now();
   // load from disk sync
   std::vector<std::future<void>> load_futures_;
   itr = map_ids->begin();
@@ -159,6 +165,16 @@ void BaseMap::LoadMapNodes(std::set<MapNodeIndex>* map_ids) {
   }
   // check in cacheL2 again
   CheckAndUpdateCache(map_ids);
+
+  const double wait_ms = std::chrono::duration<double, std::milli>(
+                             std::chrono::steady_clock::now() - wait_start)
+                             .count();
+  boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
+  load_stats_.area_hits += area_size - misses;
+  load_stats_.area_misses += misses;
+  if (misses > 0) {
+    load_stats_.max_wait_ms = std::max(load_stats_.max_wait_ms, wait_ms);
+  }
 }
 
 void BaseMap::CheckAndUpdateCache(std::set<MapNodeIndex>* map_ids) {
@@ -241,13 +257,20 @@ void BaseMap::LoadMapNodeThreadSafety(const MapNodeIndex& index,
   }
   map_node->SetMapNodeIndex(index);
 
+  const auto load_start = std::chrono::steady_clock::now();
   if (!map_node->Load()) {
     AINFO << "Created map node: " << index;
   } else {
     AINFO << "Loaded map node: " << index;
   }
+  const double load_ms = std::chrono::duration<double, std::milli>(
+                             std::chrono::steady_clock::now() - load_start)
+                             .count();
   map_node->SetIsReserved(is_reserved);
   boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
+  ++load_stats_.loads;
+  load_stats_.total_load_ms += load_ms;
+  load_stats_.max_load_ms = std::max(load_stats_.max_load_ms, load_ms);
   BaseMapNode* node_remove = map_node_cache_lvl2_->Put(index, map_node);
   // if the node already added into cacheL2, erase it from preloading set
   auto itr = map_preloading_task_index_.find(index);
@@ -487,6 +510,96 @@ bool BaseMap::LoadMapArea(const Eigen::Vector3d& seed_pt3d,
   return true;
 }
 
+void BaseMap::PrefetchMapArea(const Eigen::Vector3d& location,
+                              const Eigen::Vector3d& velocity, double horizon,
+                              unsigned int resolution_id,
+                              unsigned int zone_id) {
+  if (map_node_pool_ == nullptr) {
+    std::cerr << "Map node pool is nullptr!" << std::endl;
+    return;
+  }
+  const double map_pixel_resolution =
+      this->map_config_->map_resolutions_[resolution_id];
+  const double half_size_x =
+      this->map_config_->map_node_size_x_ * map_pixel_resolution / 2.0;
+  const double half_size_y =
+      this->map_config_->map_node_size_y_ * map_pixel_resolution / 2.0;
+
+  // the way ahead, sampled at half a node
+  std::vector<Eigen::Vector3d> points;
+  const double distance = velocity.head<2>().norm() * std::max(horizon, 0.0);
+  GetWayAhead(location, velocity, distance, std::min(half_size_x, half_size_y),
+              &points);
+
+  // the nodes LoadMapArea needs at each point, nearest first, leaving the
+  // nodes reserved by the level 1 cache in the level 2 cache
+  const size_t capacity_lvl1 = map_node_cache_lvl1_->Capacity();
+  const size_t capacity_lvl2 = map_node_cache_lvl2_->Capacity();
+  const size_t max_nodes = capacity_lvl2 > capacity_lvl1
+                               ? capacity_lvl2 - capacity_lvl1
+                               : capacity_lvl2;
+  std::set<MapNodeIndex> map_ids;
+  for (const auto& point : points) {
+    for (int i = -1; i <= 1 && map_ids.size() < max_nodes; i += 2) {
+      for (int j = -1; j <= 1 && map_ids.size() < max_nodes; j += 2) {
+        Eigen::Vector3d pt(point[0] + i * half_size_x,
+                           point[1] + j * half_size_y, 0.0);
+        map_ids.insert(MapNodeIndex::GetMapNodeIndex(*map_config_, pt,
+                                                     resolution_id, zone_id));
+      }
+    }
+    if (map_ids.size() >= max_nodes) {
+      break;
+    }
+  }
+
+  this->PreloadMapNodes(&map_ids);
+}
+
+void BaseMap::GetWayAhead(const Eigen::Vector3d& location,
+                          const Eigen::Vector3d& direction, double distance,
+                          double step, std::vector<Eigen::Vector3d>* points) {
+  points->clear();
+  points->push_back(location);
+  if (distance <= 0.0 || step <= 0.0) {
+    return;
+  }
+
+  const double norm = direction.head<2>().norm();
+  if (norm <= 0.0) {
+    return;
+  }
+  Eigen::Vector3d unit(direction[0] / norm, direction[1] / norm, 0.0);
+  for (double s = step; s < distance + step; s += step) {
+    points->push_back(location + std::min(s, distance) * unit);
+  }
+}
+
+MapNodeLoadStats BaseMap::GetLoadStats() {
+  boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
+  MapNodeLoadStats stats = load_stats_;
+  if (map_node_cache_lvl1_ != nullptr) {
+    stats.cache_lvl1_hits = map_node_cache_lvl1_->HitCount();
+    stats.cache_lvl1_misses = map_node_cache_lvl1_->MissCount();
+  }
+  if (map_node_cache_lvl2_ != nullptr) {
+    stats.cache_lvl2_hits = map_node_cache_lvl2_->HitCount();
+    stats.cache_lvl2_misses = map_node_cache_lvl2_->MissCount();
+  }
+  return stats;
+}
+
+void BaseMap::ResetLoadStats() {
+  boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
+  load_stats_ = MapNodeLoadStats();
+  if (map_node_cache_lvl1_ != nullptr) {
+    map_node_cache_lvl1_->ResetCounts();
+  }
+  if (map_node_cache_lvl2_ != nullptr) {
+    map_node_cache_lvl2_->ResetCounts();
+  }
+}
+
 MapNodeIndex BaseMap::GetMapIndexFromMapPath(const std::string& map_path) {
   MapNodeIndex index;
   char buf[100];
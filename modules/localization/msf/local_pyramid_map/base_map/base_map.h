@@ -15,6 +15,7 @@
  *****************************************************************************/
 #pragma once
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <set>
@@ -34,6 +35,26 @@ namespace localization {
 namespace msf {
 namespace pyramid_map {
 
+/**@brief The statistics of the map node loading. */
+struct MapNodeLoadStats {
+  /**@brief The nodes LoadMapArea found in the caches. */
+  uint64_t area_hits = 0;
+  /**@brief The nodes LoadMapArea had to load and wait for. */
+  uint64_t area_misses = 0;
+  /**@brief The longest LoadMapArea waited for the disk in ms. */
+  double max_wait_ms = 0.0;
+  /**@brief The nodes loaded from the disk. */
+  uint64_t loads = 0;
+  /**@brief The total and the longest time to load a node in ms. */
+  double total_load_ms = 0.0;
+  double max_load_ms = 0.0;
+  /**@brief The Get hits and misses of the level 1 and level 2 caches. */
+  uint64_t cache_lvl1_hits = 0;
+  uint64_t cache_lvl1_misses = 0;
+  uint64_t cache_lvl2_hits = 0;
+  uint64_t cache_lvl2_misses = 0;
+};
+
 /**@brief The data structure of the base map. */
 class BaseMap {
  public:
@@ -84,6 +105,19 @@ class BaseMap {
   virtual bool LoadMapArea(const Eigen::Vector3d& seed_pt3d,
                            unsigned int resolution_id, unsigned int zone_id,
                            int filter_size_x, int filter_size_y);
+  /**@brief Preload the map nodes the car will need within horizon seconds
+   * along the velocity. The nodes LoadMapArea will need along it are
+   * loaded nearest first, as many as the level 2 cache holds besides the
+   * level 1 cache. It does not wait for the loading. */
+  virtual void PrefetchMapArea(const Eigen::Vector3d& location,
+                               const Eigen::Vector3d& velocity, double horizon,
+                               unsigned int resolution_id,
+                               unsigned int zone_id);
+
+  /**@brief Get the statistics of the map node loading. */
+  MapNodeLoadStats GetLoadStats();
+  /**@brief Reset the statistics of the map node loading. */
+  void ResetLoadStats();
 
   /**@brief Compute md5 for all map node file in map. */
   void ComputeMd5ForAllMapNodes();
@@ -120,6 +154,11 @@ class BaseMap {
                                bool is_reserved = false);
   /**@brief Check map node in L2 Cache.*/
   void CheckAndUpdateCache(std::set<MapNodeIndex>* map_ids);
+  /**@brief The points ahead of the location every step meters up to
+   * distance along the direction. */
+  void GetWayAhead(const Eigen::Vector3d& location,
+                   const Eigen::Vector3d& direction, double distance,
+                   double step, std::vector<Eigen::Vector3d>* points);
 
   /**@brief The map settings. */
   BaseMapConfig* map_config_ = nullptr;
@@ -145,6 +184,9 @@ class BaseMap {
 
   /**@brief All the map nodes' md5 in the Map (in the disk). */
   std::vector<std::string> all_map_node_md5s_;
+
+  /**@brief The statistics of the loading, guarded by map_load_mutex_. */
+  MapNodeLoadStats load_stats_;
 };
 
 }  // namespace pyramid_map
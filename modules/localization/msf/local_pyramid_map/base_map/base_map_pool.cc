@@ -61,6 +61,7 @@ void BaseMapNodePool::Release() {
 
 BaseMapNode* BaseMapNodePool::AllocMapNode() {
   if (free_list_.empty()) {
+    boost::unique_lock<boost::mutex> lock(node_reset_workers_mutex_);
     if (node_reset_workers_.valid()) {
       node_reset_workers_.wait();
     }
@@ -84,6 +85,7 @@ BaseMapNode* BaseMapNodePool::AllocMapNode() {
 }
 
 void BaseMapNodePool::FreeMapNode(BaseMapNode* map_node) {
+  boost::unique_lock<boost::mutex> lock(node_reset_workers_mutex_);
   node_reset_workers_ =
       cyber::Async(&BaseMapNodePool::FreeMapNodeTask, this, map_node);
 }
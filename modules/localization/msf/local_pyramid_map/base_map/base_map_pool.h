@@ -85,6 +85,9 @@ class BaseMapNodePool {
   unsigned int pool_size_ = 0;
   /**@brief The thread pool for release node. */
   std::future<void> node_reset_workers_;
+  /**@brief The mutex for node_reset_workers_, as the loading threads free
+   * nodes concurrently. */
+  boost::mutex node_reset_workers_mutex_;
   /**@brief The mutex for release thread.*/
   boost::mutex mutex_;
   /**@brief The mutex for release thread.*/
@@ -0,0 +1,209 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Replays a highway drive over a synthetic pyramid map, loading the
+ * nodes of each frame as LocalizationLidar does, with the nodes preloaded
+ * around the car (PreloadMapArea) or along the velocity (PrefetchMapArea).
+ * Reports the frames that waited for a node load and the time they waited.
+ *
+ * Usage: pyramid_map_prefetch_benchmark [map_folder] [speed_m_per_s]
+ *                                       [node_size]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map.h"
+#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_config.h"
+#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_node.h"
+#include "modules/localization/msf/local_pyramid_map/pyramid_map/pyramid_map_pool.h"
+
+namespace {
+
+using apollo::localization::msf::pyramid_map::MapNodeIndex;
+using apollo::localization::msf::pyramid_map::MapNodeLoadStats;
+using apollo::localization::msf::pyramid_map::PyramidMap;
+using apollo::localization::msf::pyramid_map::PyramidMapConfig;
+using apollo::localization::msf::pyramid_map::PyramidMapNode;
+using apollo::localization::msf::pyramid_map::PyramidMapNodePool;
+
+constexpr double kOriginX = 438000.0;
+constexpr double kOriginY = 4432000.0;
+constexpr double kStraight = 1500.0;
+constexpr double kTurned = 500.0;
+constexpr double kFrameRate = 10.0;
+constexpr double kPrefetchTime = 3.0;
+constexpr unsigned int kZoneId = 50;
+
+// East along the highway, then north after the interchange.
+Eigen::Vector3d DrivePosition(double distance) {
+  if (distance < kStraight) {
+    return Eigen::Vector3d(kOriginX + distance, kOriginY, 0.0);
+  }
+  return Eigen::Vector3d(kOriginX + kStraight, kOriginY + distance - kStraight,
+                         0.0);
+}
+
+// Writes the nodes within a node of the road, every cell filled as a
+// surveyed map would have it.
+bool CreateMap(const std::string& folder, unsigned int node_size) {
+  PyramidMapConfig config("lossy_full_alt");
+  config.SetMapNodeSize(node_size, node_size);
+  config.resolution_num_ = 1;
+  config.map_folder_path_ = folder;
+  const float resolution = config.map_resolutions_[0];
+  const double node_meters = node_size * resolution;
+
+  std::set<MapNodeIndex> indexes;
+  for (double d = 0.0; d <= kStraight + kTurned; d += 0.5 * node_meters) {
+    const Eigen::Vector3d center = DrivePosition(d);
+    for (int dx = -1; dx <= 1; ++dx) {
+      for (int dy = -1; dy <= 1; ++dy) {
+        const Eigen::Vector3d pt =
+            center + Eigen::Vector3d(dx * node_meters, dy * node_meters, 0.0);
+        indexes.insert(MapNodeIndex::GetMapNodeIndex(config, pt, 0, kZoneId));
+      }
+    }
+  }
+
+  std::vector<Eigen::Vector3d> coordinates;
+  std::vector<unsigned char> intensities;
+  for (const MapNodeIndex& index : indexes) {
+    PyramidMapNode node;
+    node.Init(&config);
+    node.SetMapNodeIndex(index);
+    const Eigen::Vector2d& corner = node.GetLeftTopCorner();
+    coordinates.clear();
+    intensities.clear();
+    for (unsigned int y = 0; y < node_size; ++y) {
+      for (unsigned int x = 0; x < node_size; ++x) {
+        const double altitude = 0.01 * ((x * 7 + y * 3) % 50);
+        coordinates.emplace_back(corner[0] + (x + 0.5) * resolution,
+                                 corner[1] + (y + 0.5) * resolution, altitude);
+        intensities.push_back(
+            static_cast<unsigned char>((x * 13 + y * 29 + index.n_) % 256));
+      }
+    }
+    node.AddValueIfInBound(coordinates, intensities, 0);
+    if (!node.Save()) {
+      fprintf(stderr, "failed to save node %s\n",
+              index.ToString().c_str());
+      return false;
+    }
+  }
+  config.Save(folder + "/config.xml");
+  printf("%s: %zu nodes of %.0f m\n", folder.c_str(), indexes.size(),
+         node_meters);
+  return true;
+}
+
+struct ReplayResult {
+  int frames = 0;
+  int waiting_frames = 0;
+  double total_frame_ms = 0.0;
+  double max_frame_ms = 0.0;
+  MapNodeLoadStats stats;
+};
+
+ReplayResult Replay(const std::string& folder, double speed, bool prefetch) {
+  ReplayResult result;
+  PyramidMapConfig config("lossy_full_alt");
+  if (!config.Load(folder + "/config.xml")) {
+    fprintf(stderr, "failed to load %s/config.xml\n", folder.c_str());
+    return result;
+  }
+  // as LocalizationLidar sizes them
+  PyramidMapNodePool node_pool(25, 8);
+  node_pool.Initial(&config);
+  PyramidMap map(&config);
+  map.InitMapNodeCaches(12, 24);
+  map.AttachMapNodePool(&node_pool);
+  if (!map.SetMapFolderPath(folder)) {
+    fprintf(stderr, "failed to open the map %s\n", folder.c_str());
+    return result;
+  }
+
+  const double step = speed / kFrameRate;
+  const auto frame_period =
+      std::chrono::microseconds(static_cast<int64_t>(1e6 / kFrameRate));
+  Eigen::Vector3d location = DrivePosition(0.0);
+  map.LoadMapArea(location, 0, kZoneId, 0, 0);
+  map.ResetLoadStats();
+  for (double d = step; d <= kStraight + kTurned; d += step) {
+    const Eigen::Vector3d next = DrivePosition(d);
+    const Eigen::Vector3d velocity = (next - location) * kFrameRate;
+    location = next;
+    const uint64_t misses = map.GetLoadStats().area_misses;
+    const auto start = std::chrono::steady_clock::now();
+    map.LoadMapArea(location, 0, kZoneId, 0, 0);
+    const double frame_ms = std::chrono::duration<double, std::milli>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+    if (prefetch) {
+      map.PrefetchMapArea(location, velocity, kPrefetchTime, 0, kZoneId);
+    } else {
+      map.PreloadMapArea(location, velocity / kFrameRate, 0, kZoneId);
+    }
+    ++result.frames;
+    result.waiting_frames += map.GetLoadStats().area_misses > misses;
+    result.total_frame_ms += frame_ms;
+    result.max_frame_ms = std::max(result.max_frame_ms, frame_ms);
+    // the rest of the frame goes to matching, the loads run meanwhile
+    std::this_thread::sleep_until(start + frame_period);
+  }
+  result.stats = map.GetLoadStats();
+  return result;
+}
+
+void Print(const char* name, const ReplayResult& result) {
+  const MapNodeLoadStats& stats = result.stats;
+  printf(
+      "%-28s frames waiting %4d of %4d, LoadMapArea mean %7.3f max %8.3f ms, "
+      "nodes waited for %4lu, loads %4lu mean %7.3f max %8.3f ms\n",
+      name, result.waiting_frames, result.frames,
+      result.total_frame_ms / std::max(result.frames, 1), result.max_frame_ms,
+      static_cast<unsigned long>(stats.area_misses),  // NOLINT
+      static_cast<unsigned long>(stats.loads),        // NOLINT
+      stats.total_load_ms / static_cast<double>(std::max<uint64_t>(
+                                stats.loads, 1)),
+      stats.max_load_ms);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::string folder =
+      argc > 1 ? argv[1] : "/tmp/pyramid_map_prefetch_benchmark";
+  const double speed = argc > 2 ? atof(argv[2]) : 30.0;
+  const unsigned int node_size = argc > 3 ? atoi(argv[3]) : 256;
+
+  if (!CreateMap(folder, node_size)) {
+    return 1;
+  }
+  printf("%.0f m at %.1f m/s, %.0f Hz, prefetching %.1f s ahead\n",
+         kStraight + kTurned, speed, kFrameRate, kPrefetchTime);
+  Print("around the car", Replay(folder, speed, false));
+  Print("along the velocity", Replay(folder, speed, true));
+  return 0;
+}
@@ -224,6 +224,65 @@ TEST_F(PyramidMapTestSuite, test_init) {
   EXPECT_TRUE(pyramid_map.LoadMapArea(loc, 0, 50, 0, 0));
 }
 
+TEST_F(PyramidMapTestSuite, prefetch_map_area) {
+  // init config
+  PyramidMapConfig* config = new PyramidMapConfig("lossy_full_alt");
+  config->SetMapNodeSize(2, 2);
+  config->resolution_num_ = 1;
+  config->map_folder_path_ = "test_map_prefetch";
+
+  // create and save nodes, of 0.25m
+  unsigned int M = 8;
+  unsigned int N = 8;
+  for (unsigned int m = 0; m < M; ++m) {
+    for (unsigned int n = 0; n < N; ++n) {
+      MapNodeIndex index;
+      index.resolution_id_ = 0;
+      index.zone_id_ = 50;
+      index.m_ = m;
+      index.n_ = n;
+      CreateTestMapNode(m, n, index, config);
+    }
+  }
+  config->Save("test_map_prefetch/config.xml");
+
+  PyramidMapNodePool pm_node_pool(16, 4);
+  pm_node_pool.Initial(config);
+  PyramidMap pyramid_map(config);
+  pyramid_map.InitMapNodeCaches(4, 15);
+  pyramid_map.AttachMapNodePool(&pm_node_pool);
+  EXPECT_TRUE(pyramid_map.SetMapFolderPath(config->map_folder_path_));
+
+  // the nodes (0, 0) to (1, 1)
+  Eigen::Vector3d loc(0.3, 0.3, 1.0);
+  EXPECT_TRUE(pyramid_map.LoadMapArea(loc, 0, 50, 0, 0));
+  EXPECT_EQ(pyramid_map.GetLoadStats().area_misses, 4);
+  EXPECT_EQ(pyramid_map.GetLoadStats().loads, 4);
+  Eigen::Vector3d node_loc(0.25 + 0.125, 0.25 + 0.125, 1.0);
+  EXPECT_FLOAT_EQ(pyramid_map.GetIntensitySafe(node_loc, 50, 0),
+                  1.f * static_cast<float>(config->map_node_size_x_) + 1.f);
+
+  // a meter ahead along x, the nodes n 0 to 5 within the 11 the level 2
+  // cache holds besides the level 1 cache
+  pyramid_map.ResetLoadStats();
+  Eigen::Vector3d velocity(1.0, 0.0, 0.0);
+  pyramid_map.PrefetchMapArea(loc, velocity, 1.0, 0, 50);
+  Eigen::Vector3d ahead(1.05, 0.3, 1.0);
+  EXPECT_TRUE(pyramid_map.LoadMapArea(ahead, 0, 50, 0, 0));
+  MapNodeLoadStats stats = pyramid_map.GetLoadStats();
+  EXPECT_EQ(stats.area_hits, 4);
+  EXPECT_EQ(stats.area_misses, 0);
+  EXPECT_GT(stats.loads, 4);
+  Eigen::Vector3d beyond(1.8, 0.3, 1.0);
+  EXPECT_TRUE(pyramid_map.LoadMapArea(beyond, 0, 50, 0, 0));
+  EXPECT_EQ(pyramid_map.GetLoadStats().area_misses, 4);
+
+  if (config != nullptr) {
+    delete config;
+    config = nullptr;
+  }
+}
+
 }  // namespace pyramid_map
 }  // namespace msf
 }  // namespace localization
@@ -278,6 +278,56 @@ std::string PathOverlap::DebugString() const {
   return absl::StrCat(object_id, " ", start_s, " ", end_s);
 }
 
+LaneSegmentCache::Entry* LaneSegmentCache::GetEntry(
+    const LaneSegment& segment) {
+  Entry& entry = entries_[std::make_tuple(segment.lane.get(), segment.start_s,
+                                          segment.end_s)];
+  // keeps the lane, and so its address in the key, alive
+  entry.lane = segment.lane;
+  entry.last_path = num_paths_;
+  return &entry;
+}
+
+std::shared_ptr<const std::vector<MapPathPoint>> LaneSegmentCache::GetPoints(
+    const LaneSegment& segment) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Entry* entry = GetEntry(segment);
+  if (entry->points == nullptr) {
+    entry->points = std::make_shared<const std::vector<MapPathPoint>>(
+        MapPathPoint::GetPointsFromLane(segment.lane, segment.start_s,
+                                        segment.end_s));
+  }
+  return entry->points;
+}
+
+std::shared_ptr<const LaneSegmentOverlaps> LaneSegmentCache::GetOverlaps(
+    const LaneSegment& segment) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Entry* entry = GetEntry(segment);
+  if (entry->overlaps == nullptr) {
+    entry->overlaps = std::make_shared<const LaneSegmentOverlaps>(
+        Path::GetLaneSegmentOverlaps(segment));
+  }
+  return entry->overlaps;
+}
+
+void LaneSegmentCache::EndPath() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++num_paths_;
+  for (auto iter = entries_.begin(); iter != entries_.end();) {
+    if (iter->second.last_path + max_idle_paths_ < num_paths_) {
+      iter = entries_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+size_t LaneSegmentCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
 Path::Path(const std::vector<MapPathPoint>& path_points)
     : path_points_(path_points) {
   Init();
@@ -336,6 +386,27 @@ Path::Path(std::vector<LaneSegment>&& segments)
   Init();
 }
 
+Path::Path(const std::vector<LaneSegment>& segments, LaneSegmentCache* cache)
+    : lane_segments_(segments) {
+  CHECK_NOTNULL(cache);
+  std::vector<std::shared_ptr<const std::vector<MapPathPoint>>> points;
+  points.reserve(lane_segments_.size());
+  size_t num_points = 0;
+  for (const auto& segment : lane_segments_) {
+    points.push_back(cache->GetPoints(segment));
+    num_points += points.back()->size();
+  }
+  path_points_.reserve(num_points);
+  for (const auto& segment_points : points) {
+    path_points_.insert(path_points_.end(), segment_points->begin(),
+                        segment_points->end());
+  }
+  MapPathPoint::RemoveDuplicates(&path_points_);
+  CHECK_GE(path_points_.size(), 2U);
+  Init(cache);
+  cache->EndPath();
+}
+
 Path::Path(std::vector<MapPathPoint>&& path_points,
            std::vector<LaneSegment>&& lane_segments,
            const double max_approximation_error)
@@ -348,12 +419,12 @@ Path::Path(std::vector<MapPathPoint>&& path_points,
   }
 }
 
-void Path::Init() {
+void Path::Init(LaneSegmentCache* cache) {
   InitPoints();
   InitLaneSegments();
   InitPointIndex();
   InitWidth();
-  InitOverlaps();
+  InitOverlaps(cache);
 }
 
 void Path::InitPoints() {
@@ -438,9 +509,9 @@ void Path::InitWidth() {
   road_right_width_.reserve(num_sample_points_);
 
   double s = 0;
+  LaneWaypoint waypoint;
   for (int i = 0; i < num_sample_points_; ++i) {
-    const MapPathPoint point = GetSmoothPoint(s);
-    if (point.lane_waypoints().empty()) {
+    if (!GetSmoothLaneWaypoint(s, &waypoint)) {
       lane_left_width_.push_back(FLAGS_default_lane_width / 2.0);
       lane_right_width_.push_back(FLAGS_default_lane_width / 2.0);
 
@@ -449,7 +520,6 @@ void Path::InitWidth() {
       // ADEBUG << "path point:" << point.DebugString() << " has invalid
       // width.";
     } else {
-      const LaneWaypoint waypoint = point.lane_waypoints()[0];
       CHECK_NOTNULL(waypoint.lane);
 
       double lane_left_width = 0.0;
@@ -492,8 +562,66 @@ void Path::InitPointIndex() {
   CHECK_EQ(last_point_index_.size(), static_cast<size_t>(num_sample_points_));
 }
 
-void Path::GetAllOverlaps(GetOverlapFromLaneFunc GetOverlaps_from_lane,
-                          std::vector<PathOverlap>* const overlaps) const {
+void Path::GetLaneSegmentOverlaps(
+    const LaneSegment& lane_segment,
+    GetOverlapFromLaneFunc GetOverlaps_from_lane,
+    std::vector<PathOverlap>* const overlaps) {
+  for (const auto& overlap : GetOverlaps_from_lane(*(lane_segment.lane))) {
+    const auto& overlap_info =
+        overlap->GetObjectOverlapInfo(lane_segment.lane->id());
+    if (overlap_info == nullptr) {
+      continue;
+    }
+
+    const auto& lane_overlap_info = overlap_info->lane_overlap_info();
+    if (lane_overlap_info.start_s() <= lane_segment.end_s &&
+        lane_overlap_info.end_s() >= lane_segment.start_s) {
+      const double start_s =
+          std::max(lane_overlap_info.start_s(), lane_segment.start_s);
+      const double end_s =
+          std::min(lane_overlap_info.end_s(), lane_segment.end_s);
+      for (const auto& object : overlap->overlap().object()) {
+        if (object.id().id() != lane_segment.lane->id().id()) {
+          overlaps->emplace_back(object.id().id(), start_s, end_s);
+        }
+      }
+    }
+  }
+}
+
+LaneSegmentOverlaps Path::GetLaneSegmentOverlaps(
+    const LaneSegment& lane_segment) {
+  LaneSegmentOverlaps overlaps;
+  GetLaneSegmentOverlaps(lane_segment, std::bind(&LaneInfo::cross_lanes, _1),
+                         &overlaps.lanes);
+  GetLaneSegmentOverlaps(lane_segment, std::bind(&LaneInfo::signals, _1),
+                         &overlaps.signals);
+  GetLaneSegmentOverlaps(lane_segment, std::bind(&LaneInfo::yield_signs, _1),
+                         &overlaps.yield_signs);
+  GetLaneSegmentOverlaps(lane_segment, std::bind(&LaneInfo::stop_signs, _1),
+                         &overlaps.stop_signs);
+  GetLaneSegmentOverlaps(lane_segment, std::bind(&LaneInfo::crosswalks, _1),
+                         &overlaps.crosswalks);
+  GetLaneSegmentOverlaps(lane_segment, std::bind(&LaneInfo::junctions, _1),
+                         &overlaps.junctions);
+  GetLaneSegmentOverlaps(lane_segment,
+                         std::bind(&LaneInfo::pnc_junctions, _1),
+                         &overlaps.pnc_junctions);
+  GetLaneSegmentOverlaps(lane_segment, std::bind(&LaneInfo::clear_areas, _1),
+                         &overlaps.clear_areas);
+  GetLaneSegmentOverlaps(lane_segment, std::bind(&LaneInfo::speed_bumps, _1),
+                         &overlaps.speed_bumps);
+  GetLaneSegmentOverlaps(lane_segment,
+                         std::bind(&LaneInfo::parking_spaces, _1),
+                         &overlaps.parking_spaces);
+  return overlaps;
+}
+
+void Path::GetAllOverlaps(
+    const std::vector<std::shared_ptr<const LaneSegmentOverlaps>>&
+        segment_overlaps,
+    std::vector<PathOverlap> LaneSegmentOverlaps::*type,
+    std::vector<PathOverlap>* const overlaps) const {
   if (overlaps == nullptr) {
     return;
   }
@@ -501,32 +629,15 @@ void Path::GetAllOverlaps(GetOverlapFromLaneFunc GetOverlaps_from_lane,
   std::unordered_map<std::string, std::vector<std::pair<double, double>>>
       overlaps_by_id;
   double s = 0.0;
-  for (const auto& lane_segment : lane_segments_) {
+  for (size_t i = 0; i < lane_segments_.size(); ++i) {
+    const auto& lane_segment = lane_segments_[i];
     if (lane_segment.lane == nullptr) {
       continue;
     }
-    for (const auto& overlap : GetOverlaps_from_lane(*(lane_segment.lane))) {
-      const auto& overlap_info =
-          overlap->GetObjectOverlapInfo(lane_segment.lane->id());
-      if (overlap_info == nullptr) {
-        continue;
-      }
-
-      const auto& lane_overlap_info = overlap_info->lane_overlap_info();
-      if (lane_overlap_info.start_s() <= lane_segment.end_s &&
-          lane_overlap_info.end_s() >= lane_segment.start_s) {
-        const double ref_s = s - lane_segment.start_s;
-        const double adjusted_start_s =
-            std::max(lane_overlap_info.start_s(), lane_segment.start_s) + ref_s;
-        const double adjusted_end_s =
-            std::min(lane_overlap_info.end_s(), lane_segment.end_s) + ref_s;
-        for (const auto& object : overlap->overlap().object()) {
-          if (object.id().id() != lane_segment.lane->id().id()) {
-            overlaps_by_id[object.id().id()].emplace_back(adjusted_start_s,
-                                                          adjusted_end_s);
-          }
-        }
-      }
+    const double ref_s = s - lane_segment.start_s;
+    for (const auto& overlap : (*segment_overlaps[i]).*type) {
+      overlaps_by_id[overlap.object_id].emplace_back(overlap.start_s + ref_s,
+                                                     overlap.end_s + ref_s);
     }
     s += lane_segment.end_s - lane_segment.start_s;
   }
@@ -563,18 +674,38 @@ const PathOverlap* Path::NextLaneOverlap(double s) const {
   }
 }
 
-void Path::InitOverlaps() {
-  GetAllOverlaps(std::bind(&LaneInfo::cross_lanes, _1), &lane_overlaps_);
-  GetAllOverlaps(std::bind(&LaneInfo::signals, _1), &signal_overlaps_);
-  GetAllOverlaps(std::bind(&LaneInfo::yield_signs, _1), &yield_sign_overlaps_);
-  GetAllOverlaps(std::bind(&LaneInfo::stop_signs, _1), &stop_sign_overlaps_);
-  GetAllOverlaps(std::bind(&LaneInfo::crosswalks, _1), &crosswalk_overlaps_);
-  GetAllOverlaps(std::bind(&LaneInfo::junctions, _1), &junction_overlaps_);
-  GetAllOverlaps(std::bind(&LaneInfo::pnc_junctions, _1),
+void Path::InitOverlaps(LaneSegmentCache* cache) {
+  std::vector<std::shared_ptr<const LaneSegmentOverlaps>> segment_overlaps;
+  segment_overlaps.reserve(lane_segments_.size());
+  for (const auto& lane_segment : lane_segments_) {
+    if (lane_segment.lane == nullptr) {
+      segment_overlaps.emplace_back();
+    } else if (cache != nullptr) {
+      segment_overlaps.push_back(cache->GetOverlaps(lane_segment));
+    } else {
+      segment_overlaps.push_back(std::make_shared<LaneSegmentOverlaps>(
+          GetLaneSegmentOverlaps(lane_segment)));
+    }
+  }
+  GetAllOverlaps(segment_overlaps, &LaneSegmentOverlaps::lanes,
+                 &lane_overlaps_);
+  GetAllOverlaps(segment_overlaps, &LaneSegmentOverlaps::signals,
+                 &signal_overlaps_);
+  GetAllOverlaps(segment_overlaps, &LaneSegmentOverlaps::yield_signs,
+                 &yield_sign_overlaps_);
+  GetAllOverlaps(segment_overlaps, &LaneSegmentOverlaps::stop_signs,
+                 &stop_sign_overlaps_);
+  GetAllOverlaps(segment_overlaps, &LaneSegmentOverlaps::crosswalks,
+                 &crosswalk_overlaps_);
+  GetAllOverlaps(segment_overlaps, &LaneSegmentOverlaps::junctions,
+                 &junction_overlaps_);
+  GetAllOverlaps(segment_overlaps, &LaneSegmentOverlaps::pnc_junctions,
                  &pnc_junction_overlaps_);
-  GetAllOverlaps(std::bind(&LaneInfo::clear_areas, _1), &clear_area_overlaps_);
-  GetAllOverlaps(std::bind(&LaneInfo::speed_bumps, _1), &speed_bump_overlaps_);
-  GetAllOverlaps(std::bind(&LaneInfo::parking_spaces, _1),
+  GetAllOverlaps(segment_overlaps, &LaneSegmentOverlaps::clear_areas,
+                 &clear_area_overlaps_);
+  GetAllOverlaps(segment_overlaps, &LaneSegmentOverlaps::speed_bumps,
+                 &speed_bump_overlaps_);
+  GetAllOverlaps(segment_overlaps, &LaneSegmentOverlaps::parking_spaces,
                  &parking_space_overlaps_);
 }
 
@@ -615,6 +746,31 @@ MapPathPoint Path::GetSmoothPoint(double s) const {
   return GetSmoothPoint(GetIndexFromS(s));
 }
 
+bool Path::GetSmoothLaneWaypoint(const double s,
+                                 LaneWaypoint* waypoint) const {
+  const InterpolatedIndex index = GetIndexFromS(s);
+  const MapPathPoint& ref_point = path_points_[index.id];
+  if (ref_point.lane_waypoints().empty()) {
+    return false;
+  }
+  *waypoint = ref_point.lane_waypoints()[0];
+  if (std::abs(index.offset) > kMathEpsilon && index.id < num_segments_) {
+    const LaneSegment& lane_segment = lane_segments_to_next_point_[index.id];
+    if (lane_segment.lane != nullptr) {
+      double l = waypoint->l;
+      for (const auto& lane_waypoint : ref_point.lane_waypoints()) {
+        if (lane_waypoint.lane->id().id() == lane_segment.lane->id().id()) {
+          l = lane_waypoint.l;
+          break;
+        }
+      }
+      *waypoint = LaneWaypoint(lane_segment.lane,
+                               lane_segment.start_s + index.offset, l);
+    }
+  }
+  return true;
+}
+
 double Path::GetSFromIndex(const InterpolatedIndex& index) const {
   if (index.id < 0) {
     return 0.0;
@@ -16,7 +16,12 @@
 
 #pragma once
 
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -203,6 +208,66 @@ class PathApproximation {
   std::vector<int> sampled_max_original_projections_to_left_;
 };
 
+/**
+ * @brief The overlaps of a lane segment with the objects a Path keeps
+ * overlaps with, by object type, in the s of the lane.
+ */
+struct LaneSegmentOverlaps {
+  std::vector<PathOverlap> lanes;
+  std::vector<PathOverlap> signals;
+  std::vector<PathOverlap> yield_signs;
+  std::vector<PathOverlap> stop_signs;
+  std::vector<PathOverlap> crosswalks;
+  std::vector<PathOverlap> junctions;
+  std::vector<PathOverlap> pnc_junctions;
+  std::vector<PathOverlap> clear_areas;
+  std::vector<PathOverlap> speed_bumps;
+  std::vector<PathOverlap> parking_spaces;
+};
+
+/**
+ * @class LaneSegmentCache
+ * @brief Keeps the points and the overlaps a Path computes for each of its
+ * lane segments for the paths built after it. The paths of consecutive
+ * planning cycles cover mostly the same lane segments, so only the segments
+ * new to the window are computed again. Thread safe.
+ */
+class LaneSegmentCache {
+ public:
+  /**
+   * @param max_idle_paths the segments none of the last max_idle_paths paths
+   * built with the cache used are dropped.
+   */
+  explicit LaneSegmentCache(int max_idle_paths = 8)
+      : max_idle_paths_(max_idle_paths) {}
+
+  std::shared_ptr<const std::vector<MapPathPoint>> GetPoints(
+      const LaneSegment& segment);
+  std::shared_ptr<const LaneSegmentOverlaps> GetOverlaps(
+      const LaneSegment& segment);
+
+  /**
+   * @brief Called once a path is built, drops the segments idle for too long.
+   */
+  void EndPath();
+
+  size_t size() const;
+
+ private:
+  struct Entry {
+    LaneInfoConstPtr lane;
+    std::shared_ptr<const std::vector<MapPathPoint>> points;
+    std::shared_ptr<const LaneSegmentOverlaps> overlaps;
+    uint64_t last_path = 0;
+  };
+  Entry* GetEntry(const LaneSegment& segment);
+
+  const int max_idle_paths_;
+  mutable std::mutex mutex_;
+  uint64_t num_paths_ = 0;
+  std::map<std::tuple<const LaneInfo*, double, double>, Entry> entries_;
+};
+
 class InterpolatedIndex {
  public:
   InterpolatedIndex(int id, double offset) : id(id), offset(offset) {}
@@ -217,6 +282,11 @@ class Path {
   explicit Path(std::vector<MapPathPoint>&& path_points);
   explicit Path(std::vector<LaneSegment>&& path_points);
   explicit Path(const std::vector<LaneSegment>& path_points);
+  /**
+   * @brief Build the path of the lane segments, taking the points and the
+   * overlaps of the segments already built with the cache from it.
+   */
+  Path(const std::vector<LaneSegment>& segments, LaneSegmentCache* cache);
 
   Path(const std::vector<MapPathPoint>& path_points,
        const std::vector<LaneSegment>& lane_segments);
@@ -332,20 +402,36 @@ class Path {
 
   std::string DebugString() const;
 
+  /**
+   * @brief Get the overlaps of the lane of a segment within the segment.
+   */
+  static LaneSegmentOverlaps GetLaneSegmentOverlaps(
+      const LaneSegment& lane_segment);
+
  protected:
-  void Init();
+  void Init(LaneSegmentCache* cache = nullptr);
   void InitPoints();
   void InitLaneSegments();
   void InitWidth();
   void InitPointIndex();
-  void InitOverlaps();
+  void InitOverlaps(LaneSegmentCache* cache);
+
+  // The first lane waypoint of GetSmoothPoint(s), if any.
+  bool GetSmoothLaneWaypoint(const double s, LaneWaypoint* waypoint) const;
 
   double GetSample(const std::vector<double>& samples, const double s) const;
 
   using GetOverlapFromLaneFunc =
       std::function<const std::vector<OverlapInfoConstPtr>&(const LaneInfo&)>;
-  void GetAllOverlaps(GetOverlapFromLaneFunc GetOverlaps_from_lane,
-                      std::vector<PathOverlap>* const overlaps) const;
+  static void GetLaneSegmentOverlaps(
+      const LaneSegment& lane_segment,
+      GetOverlapFromLaneFunc GetOverlaps_from_lane,
+      std::vector<PathOverlap>* const overlaps);
+  void GetAllOverlaps(
+      const std::vector<std::shared_ptr<const LaneSegmentOverlaps>>&
+          segment_overlaps,
+      std::vector<PathOverlap> LaneSegmentOverlaps::*type,
+      std::vector<PathOverlap>* const overlaps) const;
 
  protected:
   int num_points_ = 0;
@@ -0,0 +1,255 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Builds the path of a reference line window sliding along a
+ * synthetic road every planning cycle, as ReferenceLineProvider does, with
+ * and without a LaneSegmentCache. Reports the time per cycle.
+ *
+ * Usage: path_build_benchmark [speed_m_per_s] [look_forward_m]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "modules/common_msgs/map_msgs/map.pb.h"
+#include "modules/map/hdmap/hdmap.h"
+#include "modules/map/pnc_map/path.h"
+
+namespace {
+
+using apollo::common::math::Vec2d;
+using apollo::hdmap::HDMap;
+using apollo::hdmap::LaneInfoConstPtr;
+using apollo::hdmap::LaneSegment;
+using apollo::hdmap::LaneSegmentCache;
+using apollo::hdmap::Path;
+
+constexpr int kNumLanes = 100;
+constexpr double kLookBackward = 50.0;
+constexpr double kFrameRate = 10.0;
+constexpr double kLaneLength = 50.0;
+constexpr double kPointSpacing = 0.5;
+
+Vec2d RoadPoint(double s) {
+  return {s, 20.0 * std::sin(s / 200.0)};
+}
+
+void AddLineCurve(const Vec2d& from,
+                  const Vec2d& to, int num_points,
+                  apollo::hdmap::Curve* curve) {
+  auto* line = curve->add_segment()->mutable_line_segment();
+  for (int i = 0; i < num_points; ++i) {
+    const auto p = from + (to - from) * (static_cast<double>(i) /
+                                         (num_points - 1));
+    auto* point = line->add_point();
+    point->set_x(p.x());
+    point->set_y(p.y());
+  }
+}
+
+void AddPolygon(double x, double y, double half_size,
+                apollo::hdmap::Polygon* polygon) {
+  const double dx[] = {-1, 1, 1, -1};
+  const double dy[] = {-1, -1, 1, 1};
+  for (int i = 0; i < 4; ++i) {
+    auto* point = polygon->add_point();
+    point->set_x(x + dx[i] * half_size);
+    point->set_y(y + dy[i] * half_size);
+  }
+}
+
+apollo::hdmap::Overlap* AddOverlap(const std::string& id,
+                                   apollo::hdmap::Lane* lane, double start_s,
+                                   double end_s, const std::string& object_id,
+                                   apollo::hdmap::Map* map) {
+  auto* overlap = map->add_overlap();
+  overlap->mutable_id()->set_id(id);
+  lane->add_overlap_id()->set_id(id);
+  auto* lane_object = overlap->add_object();
+  lane_object->mutable_id()->set_id(lane->id().id());
+  lane_object->mutable_lane_overlap_info()->set_start_s(start_s);
+  lane_object->mutable_lane_overlap_info()->set_end_s(end_s);
+  auto* object = overlap->add_object();
+  object->mutable_id()->set_id(object_id);
+  return overlap;
+}
+
+void CreateRoadMap(int num_lanes, apollo::hdmap::Map* map) {
+  map->Clear();
+  const int points_per_lane = static_cast<int>(kLaneLength / kPointSpacing);
+  for (int i = 0; i < num_lanes; ++i) {
+    const std::string id = "lane_" + std::to_string(i);
+    auto* lane = map->add_lane();
+    lane->mutable_id()->set_id(id);
+    auto* line =
+        lane->mutable_central_curve()->add_segment()->mutable_line_segment();
+    for (int j = 0; j <= points_per_lane; ++j) {
+      const auto p = RoadPoint(i * kLaneLength + j * kPointSpacing);
+      auto* point = line->add_point();
+      point->set_x(p.x());
+      point->set_y(p.y());
+    }
+    for (int j = 0; j <= 5; ++j) {
+      auto* left = lane->add_left_sample();
+      left->set_s(j * kLaneLength / 5);
+      left->set_width(1.75 + 0.05 * j);
+      auto* right = lane->add_right_sample();
+      right->set_s(j * kLaneLength / 5);
+      right->set_width(1.75 - 0.05 * j);
+      auto* left_road = lane->add_left_road_sample();
+      left_road->set_s(j * kLaneLength / 5);
+      left_road->set_width(5.25);
+      auto* right_road = lane->add_right_road_sample();
+      right_road->set_s(j * kLaneLength / 5);
+      right_road->set_width(1.75);
+    }
+    if (i > 0) {
+      lane->add_predecessor_id()->set_id("lane_" + std::to_string(i - 1));
+    }
+    if (i + 1 < num_lanes) {
+      lane->add_successor_id()->set_id("lane_" + std::to_string(i + 1));
+    }
+    const double start_x = i * kLaneLength;
+    const std::string suffix = "_" + std::to_string(i);
+    if (i % 2 == 0) {
+      auto* crosswalk = map->add_crosswalk();
+      crosswalk->mutable_id()->set_id("crosswalk" + suffix);
+      const auto p = RoadPoint(start_x + 22.0);
+      AddPolygon(p.x(), p.y(), 2.0, crosswalk->mutable_polygon());
+      AddOverlap("overlap_crosswalk" + suffix, lane, 20.0, 24.0,
+                 "crosswalk" + suffix, map)
+          ->mutable_object(1)
+          ->mutable_crosswalk_overlap_info();
+    }
+    if (i % 4 == 1) {
+      auto* stop_sign = map->add_stop_sign();
+      stop_sign->mutable_id()->set_id("stop_sign" + suffix);
+      const auto p = RoadPoint(start_x + 45.0);
+      AddLineCurve(p + Vec2d(0, -2),
+                   p + Vec2d(0, 2), 2,
+                   stop_sign->add_stop_line());
+      AddOverlap("overlap_stop_sign" + suffix, lane, 45.0, 45.5,
+                 "stop_sign" + suffix, map)
+          ->mutable_object(1)
+          ->mutable_stop_sign_overlap_info();
+    }
+    if (i % 4 == 2) {
+      auto* junction = map->add_junction();
+      junction->mutable_id()->set_id("junction" + suffix);
+      const auto p = RoadPoint(start_x + 25.0);
+      AddPolygon(p.x(), p.y(), 25.0, junction->mutable_polygon());
+      AddOverlap("overlap_junction" + suffix, lane, 0.0, kLaneLength,
+                 "junction" + suffix, map)
+          ->mutable_object(1)
+          ->mutable_junction_overlap_info();
+
+      auto* cross_lane = map->add_lane();
+      cross_lane->mutable_id()->set_id("cross" + suffix);
+      const auto c = RoadPoint(start_x + 12.0);
+      AddLineCurve(c + Vec2d(0, -20),
+                   c + Vec2d(0, 20), 81,
+                   cross_lane->mutable_central_curve());
+      auto* overlap = AddOverlap("overlap_cross" + suffix, lane, 10.0, 14.0,
+                                 "cross" + suffix, map);
+      cross_lane->add_overlap_id()->set_id("overlap_cross" + suffix);
+      overlap->mutable_object(1)->mutable_lane_overlap_info()->set_start_s(
+          18.0);
+      overlap->mutable_object(1)->mutable_lane_overlap_info()->set_end_s(
+          22.0);
+    }
+  }
+}
+
+
+// The lane segments of the window from start_s to end_s along the road.
+std::vector<LaneSegment> Window(const std::vector<LaneInfoConstPtr>& lanes,
+                                double start_s, double end_s) {
+  std::vector<LaneSegment> segments;
+  for (size_t i = 0; i < lanes.size(); ++i) {
+    const double lane_start_s = static_cast<double>(i) * kLaneLength;
+    const double lane_end_s = lane_start_s + kLaneLength;
+    if (lane_end_s <= start_s || lane_start_s >= end_s) {
+      continue;
+    }
+    segments.emplace_back(lanes[i],
+                          std::max(start_s, lane_start_s) - lane_start_s,
+                          std::min(end_s, lane_end_s) - lane_start_s);
+  }
+  return segments;
+}
+
+void Replay(const char* name, const std::vector<LaneInfoConstPtr>& lanes,
+            double speed, double look_forward, LaneSegmentCache* cache) {
+  const double step = speed / kFrameRate;
+  const double road_length = static_cast<double>(lanes.size()) * kLaneLength;
+  int cycles = 0;
+  double total_ms = 0.0;
+  double max_ms = 0.0;
+  size_t num_overlaps = 0;
+  for (double s = kLookBackward; s + look_forward < road_length; s += step) {
+    const std::vector<LaneSegment> segments =
+        Window(lanes, s - kLookBackward, s + look_forward);
+    const auto start = std::chrono::steady_clock::now();
+    const Path path =
+        cache == nullptr ? Path(segments) : Path(segments, cache);
+    const double ms = std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+    num_overlaps += path.lane_overlaps().size() +
+                    path.crosswalk_overlaps().size() +
+                    path.stop_sign_overlaps().size() +
+                    path.junction_overlaps().size();
+    total_ms += ms;
+    max_ms = std::max(max_ms, ms);
+    ++cycles;
+  }
+  printf("%-24s %5d cycles, path build mean %7.3f max %7.3f ms, "
+         "%zu overlaps\n",
+         name, cycles, total_ms / std::max(cycles, 1), max_ms, num_overlaps);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const double speed = argc > 1 ? atof(argv[1]) : 15.0;
+  const double look_forward = argc > 2 ? atof(argv[2]) : 250.0;
+
+  apollo::hdmap::Map map;
+  CreateRoadMap(kNumLanes, &map);
+  HDMap hdmap;
+  if (hdmap.LoadMapFromProto(map) != 0) {
+    fprintf(stderr, "failed to load the road map\n");
+    return 1;
+  }
+  std::vector<LaneInfoConstPtr> lanes;
+  for (int i = 0; i < kNumLanes; ++i) {
+    lanes.push_back(hdmap.GetLaneById(
+        apollo::hdmap::MakeMapId("lane_" + std::to_string(i))));
+  }
+  printf("%.0f m window at %.1f m/s, %.0f Hz\n", kLookBackward + look_forward,
+         speed, kFrameRate);
+  Replay("Path(segments)", lanes, speed, look_forward, nullptr);
+  LaneSegmentCache cache;
+  Replay("Path(segments, cache)", lanes, speed, look_forward, &cache);
+  return 0;
+}
@@ -16,7 +16,9 @@
 
 #include "modules/map/pnc_map/path.h"
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_cat.h"
 #include "gtest/gtest.h"
@@ -794,6 +796,141 @@ TEST(TestSuite, compute_lane_segments_from_points) {
   EXPECT_NEAR(path.lane_segments()[1].end_s, 0.4, 1e-6);
 }
 
+TEST(TestSuite, lane_segment_cache) {
+  // a straight road of lanes with a crosswalk on each and a crossing lane
+  constexpr int kNumLanes = 6;
+  constexpr double kLaneLength = 20.0;
+  Map map;
+  for (int i = 0; i < kNumLanes; ++i) {
+    const std::string id = absl::StrCat("lane_", i);
+    Lane* lane = map.add_lane();
+    lane->mutable_id()->set_id(id);
+    auto* segment =
+        lane->mutable_central_curve()->add_segment()->mutable_line_segment();
+    for (int j = 0; j <= 40; ++j) {
+      const double x = i * kLaneLength + j * 0.5;
+      *segment->add_point() = MakePoint(x, 0.01 * x * x, 0);
+    }
+    *lane->add_left_sample() = MakeSample(0.0, 1.5 + 0.1 * i);
+    *lane->add_left_sample() = MakeSample(kLaneLength, 1.6 + 0.1 * i);
+    *lane->add_right_sample() = MakeSample(0.0, 1.5);
+    *lane->add_right_sample() = MakeSample(kLaneLength, 1.7);
+    if (i + 1 < kNumLanes) {
+      lane->add_successor_id()->set_id(absl::StrCat("lane_", i + 1));
+    }
+
+    const std::string crosswalk_id = absl::StrCat("crosswalk_", i);
+    auto* crosswalk = map.add_crosswalk();
+    crosswalk->mutable_id()->set_id(crosswalk_id);
+    auto* polygon = crosswalk->mutable_polygon();
+    *polygon->add_point() = MakePoint(i * kLaneLength + 5, -1e3, 0);
+    *polygon->add_point() = MakePoint(i * kLaneLength + 8, -1e3, 0);
+    *polygon->add_point() = MakePoint(i * kLaneLength + 8, 1e3, 0);
+    *polygon->add_point() = MakePoint(i * kLaneLength + 5, 1e3, 0);
+    Overlap* overlap = map.add_overlap();
+    overlap->mutable_id()->set_id(absl::StrCat("overlap_", crosswalk_id));
+    lane->add_overlap_id()->set_id(overlap->id().id());
+    auto* lane_object = overlap->add_object();
+    lane_object->mutable_id()->set_id(id);
+    lane_object->mutable_lane_overlap_info()->set_start_s(5.0);
+    lane_object->mutable_lane_overlap_info()->set_end_s(8.0 + i % 3);
+    auto* crosswalk_object = overlap->add_object();
+    crosswalk_object->mutable_id()->set_id(crosswalk_id);
+    crosswalk_object->mutable_crosswalk_overlap_info();
+  }
+  Lane* cross_lane = map.add_lane();
+  cross_lane->mutable_id()->set_id("cross_lane");
+  auto* cross_segment = cross_lane->mutable_central_curve()
+                            ->add_segment()
+                            ->mutable_line_segment();
+  *cross_segment->add_point() = MakePoint(50, -20, 0);
+  *cross_segment->add_point() = MakePoint(50, 20, 0);
+  cross_lane->add_overlap_id()->set_id("overlap_cross_lane");
+  Overlap* cross_overlap = map.add_overlap();
+  cross_overlap->mutable_id()->set_id("overlap_cross_lane");
+  for (const auto& id : {"lane_2", "cross_lane"}) {
+    auto* object = cross_overlap->add_object();
+    object->mutable_id()->set_id(id);
+    object->mutable_lane_overlap_info()->set_start_s(9.0);
+    object->mutable_lane_overlap_info()->set_end_s(11.0);
+  }
+  map.mutable_lane(2)->add_overlap_id()->set_id("overlap_cross_lane");
+
+  HDMap hdmap;
+  ASSERT_EQ(0, hdmap.LoadMapFromProto(map));
+  std::vector<LaneInfoConstPtr> lanes;
+  for (int i = 0; i < kNumLanes; ++i) {
+    lanes.push_back(hdmap.GetLaneById(MakeMapId(absl::StrCat("lane_", i))));
+    ASSERT_NE(nullptr, lanes.back());
+  }
+
+  auto expect_same_overlaps = [](const std::vector<PathOverlap>& expected,
+                                 const std::vector<PathOverlap>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(expected[i].object_id, actual[i].object_id);
+      EXPECT_EQ(expected[i].start_s, actual[i].start_s);
+      EXPECT_EQ(expected[i].end_s, actual[i].end_s);
+    }
+  };
+
+  // a window sliding along the road, as the reference line of each cycle
+  LaneSegmentCache cache(2);
+  constexpr double kWindowLength = 45.0;
+  for (double start_s = 0.0; start_s + kWindowLength <= kNumLanes * kLaneLength;
+       start_s += 0.7) {
+    std::vector<LaneSegment> segments;
+    for (int i = 0; i < kNumLanes; ++i) {
+      const double lane_start_s = i * kLaneLength;
+      const double begin = std::max(start_s, lane_start_s) - lane_start_s;
+      const double end =
+          std::min(start_s + kWindowLength, lane_start_s + kLaneLength) -
+          lane_start_s;
+      if (begin < end) {
+        segments.emplace_back(lanes[i], begin, end);
+      }
+    }
+    const Path expected(segments);
+    const Path path(segments, &cache);
+
+    ASSERT_EQ(expected.num_points(), path.num_points());
+    for (int i = 0; i < expected.num_points(); ++i) {
+      const MapPathPoint& expected_point = expected.path_points()[i];
+      const MapPathPoint& point = path.path_points()[i];
+      EXPECT_EQ(expected_point.x(), point.x());
+      EXPECT_EQ(expected_point.y(), point.y());
+      EXPECT_EQ(expected_point.heading(), point.heading());
+      ASSERT_EQ(expected_point.lane_waypoints().size(),
+                point.lane_waypoints().size());
+      for (size_t j = 0; j < point.lane_waypoints().size(); ++j) {
+        EXPECT_EQ(expected_point.lane_waypoints()[j].lane,
+                  point.lane_waypoints()[j].lane);
+        EXPECT_EQ(expected_point.lane_waypoints()[j].s,
+                  point.lane_waypoints()[j].s);
+      }
+      EXPECT_EQ(expected.accumulated_s()[i], path.accumulated_s()[i]);
+    }
+    ASSERT_EQ(expected.lane_segments().size(), path.lane_segments().size());
+    for (size_t i = 0; i < path.lane_segments().size(); ++i) {
+      EXPECT_EQ(expected.lane_segments()[i].lane, path.lane_segments()[i].lane);
+      EXPECT_EQ(expected.lane_segments()[i].start_s,
+                path.lane_segments()[i].start_s);
+      EXPECT_EQ(expected.lane_segments()[i].end_s,
+                path.lane_segments()[i].end_s);
+    }
+    for (double s = 0.0; s <= path.length(); s += 0.3) {
+      EXPECT_EQ(expected.GetLaneLeftWidth(s), path.GetLaneLeftWidth(s));
+      EXPECT_EQ(expected.GetLaneRightWidth(s), path.GetLaneRightWidth(s));
+    }
+    expect_same_overlaps(expected.crosswalk_overlaps(),
+                         path.crosswalk_overlaps());
+    expect_same_overlaps(expected.lane_overlaps(), path.lane_overlaps());
+    EXPECT_FALSE(path.crosswalk_overlaps().empty());
+    // only the segments of the last three paths, before and after joined
+    EXPECT_LE(cache.size(), 3 * 2 * 4);
+  }
+}
+
 TEST(TestSuite, lane_info) {
   Lane lane;
   lane.mutable_id()->set_id("test-id");
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -154,38 +155,65 @@ void ChannelMonitor::RunOnce(const double current_time) {
   auto manager = MonitorManager::Instance();
   const auto& mode = manager->GetHMIMode();
   auto* components = manager->GetStatus()->mutable_components();
+  const auto* statistics = cyber::transport::ChannelStatistics::Instance();
   for (const auto& iter : mode.monitored_components()) {
     const std::string& name = iter.first;
     const auto& config = iter.second;
-    if (config.has_channel()) {
-      double freq;
-      const auto update_freq =
-          latency_monitor_->GetFrequency(config.channel().name(), &freq);
-      UpdateStatus(config.channel(),
-                   components->at(name).mutable_channel_status(), update_freq,
-                   freq);
+    if (!config.has_channel()) {
+      continue;
     }
+    const std::string& channel = config.channel().name();
+    double freq = 0.0;
+    bool update_freq = false;
+    cyber::transport::ChannelStatistics::Snapshot snapshot;
+    const cyber::transport::ChannelStatistics::Snapshot* stats = nullptr;
+    if (statistics->IsEnabled()) {
+      statistics->GetSnapshot(channel, &snapshot);
+      stats = &snapshot;
+      auto& last = last_counts_[channel];
+      if (last.second > 0.0 && current_time > last.second &&
+          snapshot.msg_count >= last.first) {
+        freq = static_cast<double>(snapshot.msg_count - last.first) /
+               (current_time - last.second);
+        update_freq = true;
+      }
+      last = {snapshot.msg_count, current_time};
+    } else {
+      update_freq = latency_monitor_->GetFrequency(channel, &freq);
+    }
+    UpdateStatus(config.channel(), stats,
+                 components->at(name).mutable_channel_status(), update_freq,
+                 freq);
   }
 }
 
 void ChannelMonitor::UpdateStatus(
     const apollo::dreamview::ChannelMonitorConfig& config,
+    const cyber::transport::ChannelStatistics::Snapshot* stats,
     ComponentStatus* status, const bool update_freq, const double freq) {
   status->clear_status();
 
-  const auto reader_message_pair = GetReaderAndLatestMessage(config.name());
-  const auto reader = reader_message_pair.first;
-  const auto message = reader_message_pair.second;
-
-  if (reader == nullptr) {
-    SummaryMonitor::EscalateStatus(
-        ComponentStatus::UNKNOWN,
-        absl::StrCat(config.name(), " is not registered in ChannelMonitor."),
-        status);
-    return;
+  // The transport statistics tell whether and when the channel was written, so
+  // the channel is only subscribed to and deserialized to check its fields, or
+  // the delay of messages without a header time.
+  const bool timed = stats != nullptr && stats->last_time_ns > 0;
+  std::shared_ptr<cyber::ReaderBase> reader;
+  std::shared_ptr<google::protobuf::Message> message;
+  if (!timed || config.mandatory_fields_size() > 0) {
+    std::tie(reader, message) = GetReaderAndLatestMessage(config.name());
+    if (reader == nullptr) {
+      SummaryMonitor::EscalateStatus(
+          ComponentStatus::UNKNOWN,
+          absl::StrCat(config.name(), " is not registered in ChannelMonitor."),
+          status);
+      return;
+    }
   }
 
-  if (message == nullptr || message->ByteSize() == 0) {
+  const bool empty = stats != nullptr
+                         ? stats->msg_count == 0
+                         : message == nullptr || message->ByteSize() == 0;
+  if (empty) {
     SummaryMonitor::EscalateStatus(
         ComponentStatus::FATAL,
         absl::StrCat("the message ", config.name(), " reseived is empty."),
@@ -194,7 +222,9 @@ void ChannelMonitor::UpdateStatus(
   }
 
   // Check channel delay
-  const double delay = reader->GetDelaySec();
+  const double delay =
+      timed ? (cyber::Time::Now() - cyber::Time(stats->last_time_ns)).ToSecond()
+            : reader->GetDelaySec();
   if (delay < 0 || delay > config.delay_fatal()) {
     SummaryMonitor::EscalateStatus(
         ComponentStatus::FATAL,
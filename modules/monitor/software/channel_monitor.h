@@ -18,7 +18,9 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
+#include "cyber/transport/common/channel_statistics.h"
 #include "modules/dreamview/proto/hmi_mode.pb.h"
 #include "modules/monitor/common/recurrent_runner.h"
 #include "modules/common_msgs/monitor_msgs/system_status.pb.h"
@@ -34,10 +36,15 @@ class ChannelMonitor : public RecurrentRunner {
   void RunOnce(const double current_time) override;
 
  private:
+  // stats is nullptr if the transport statistics are disabled, in which case
+  // the channel is read to check it.
   static void UpdateStatus(
       const apollo::dreamview::ChannelMonitorConfig& config,
+      const cyber::transport::ChannelStatistics::Snapshot* stats,
       ComponentStatus* status, const bool update_freq, const double freq);
   std::shared_ptr<LatencyMonitor> latency_monitor_;
+  // Message count and time of the last check of each channel.
+  std::unordered_map<std::string, std::pair<uint64_t, double>> last_counts_;
 };
 
 }  // namespace monitor
@@ -50,6 +50,7 @@ namespace {
 using apollo::common::LatencyRecordMap;
 using apollo::common::LatencyReport;
 using apollo::common::LatencyStat;
+using apollo::common::LatencyTraceMap;
 using apollo::common::LatencyTrack;
 
 LatencyStat GenerateStat(const std::vector<uint64_t>& numbers) {
@@ -66,6 +67,12 @@ LatencyStat GenerateStat(const std::vector<uint64_t>& numbers) {
   stat.set_aver_duration(
       sample_size == 0 ? 0 : static_cast<uint64_t>(sum / sample_size));
   stat.set_sample_size(sample_size);
+  if (sample_size > 0) {
+    std::vector<uint64_t> sorted_numbers = numbers;
+    std::sort(sorted_numbers.begin(), sorted_numbers.end());
+    stat.set_p50_duration(sorted_numbers[(sample_size - 1) / 2]);
+    stat.set_p99_duration(sorted_numbers[(sample_size - 1) * 99 / 100]);
+  }
   return stat;
 }
 
@@ -74,6 +81,8 @@ void SetStat(const LatencyStat& src, LatencyStat* dst) {
   dst->set_max_duration(src.max_duration());
   dst->set_aver_duration(src.aver_duration());
   dst->set_sample_size(src.sample_size());
+  dst->set_p50_duration(src.p50_duration());
+  dst->set_p99_duration(src.p99_duration());
 }
 
 void SetLatency(const std::string& latency_name,
@@ -112,9 +121,30 @@ void LatencyMonitor::RunOnce(const double current_time) {
   }
   last_processed_key = first_key_of_current_round;
 
+  static auto trace_reader =
+      MonitorManager::Instance()->CreateReader<LatencyTraceMap>(
+          FLAGS_latency_trace_topic);
+  trace_reader->SetHistoryDepth(FLAGS_latency_reader_capacity);
+  trace_reader->Observe();
+
+  static std::string last_processed_trace_key;
+  first_key_of_current_round.clear();
+  for (auto it = trace_reader->Begin(); it != trace_reader->End(); ++it) {
+    const std::string current_key =
+        absl::StrCat((*it)->module_name(), (*it)->header().sequence_num());
+    if (it == trace_reader->Begin()) {
+      first_key_of_current_round = current_key;
+    }
+    if (current_key == last_processed_trace_key) {
+      break;
+    }
+    UpdateTraces(*it);
+  }
+  last_processed_trace_key = first_key_of_current_round;
+
   if (current_time - flush_time_ > FLAGS_latency_report_interval) {
     flush_time_ = current_time;
-    if (!track_map_.empty()) {
+    if (!track_map_.empty() || !trace_stages_.empty()) {
       PublishLatencyReport();
     }
   }
@@ -139,6 +169,47 @@ void LatencyMonitor::UpdateStat(
   }
 }
 
+void LatencyMonitor::UpdateTraces(
+    const std::shared_ptr<LatencyTraceMap>& traces) {
+  // The critical path of a frame: the wait before each module, from the
+  // measurement for the first one, and the time in the module.
+  static const std::string kMeasurement = "measurement";
+  for (const auto& trace : traces->latency_traces()) {
+    if (trace.span().empty()) {
+      continue;
+    }
+    const std::string* previous_stage = &kMeasurement;
+    uint64_t previous_end_time = trace.trace_id();
+    for (const auto& span : trace.span()) {
+      AddTraceLatency(
+          absl::StrCat(*previous_stage, " -> ", span.module_name()),
+          previous_end_time, span.begin_time());
+      AddTraceLatency(span.module_name(), span.begin_time(), span.end_time());
+      previous_stage = &span.module_name();
+      previous_end_time = span.end_time();
+    }
+    AddTraceLatency(absl::StrCat(kMeasurement, " => ", *previous_stage),
+                    trace.trace_id(), previous_end_time);
+  }
+}
+
+void LatencyMonitor::AddTraceLatency(const std::string& stage,
+                                     const uint64_t begin_time,
+                                     const uint64_t end_time) {
+  // Spans are all on the cyber clock, but the measurement is on the sensor's
+  // and the hosts a frame went through may disagree.
+  if (end_time < begin_time) {
+    AWARN_EVERY(100) << "Drop negative latency of " << stage << ": -"
+                     << begin_time - end_time << " ns";
+    return;
+  }
+  auto& latencies = trace_track_[stage];
+  if (latencies.empty()) {
+    trace_stages_.push_back(stage);
+  }
+  latencies.push_back(end_time - begin_time);
+}
+
 void LatencyMonitor::PublishLatencyReport() {
   static auto writer = MonitorManager::Instance()->CreateWriter<LatencyReport>(
       FLAGS_latency_reporting_topic);
@@ -147,8 +218,11 @@ void LatencyMonitor::PublishLatencyReport() {
   writer->Write(latency_report_);
   latency_report_.clear_header();
   track_map_.clear();
+  trace_stages_.clear();
+  trace_track_.clear();
   latency_report_.clear_modules_latency();
   latency_report_.clear_e2es_latency();
+  latency_report_.clear_trace_latency();
 }
 
 void LatencyMonitor::AggregateLatency() {
@@ -211,6 +285,15 @@ void LatencyMonitor::AggregateLatency() {
     SetLatency(absl::StrCat(kE2EStartPoint, " -> ", e2e.first), e2e.second,
                e2es_latency);
   }
+
+  // Traced frames, stage by stage along the critical path:
+  // measurement -> lidar_compensator, lidar_compensator,
+  // lidar_compensator -> perception, perception, ... canbus,
+  // measurement => canbus
+  auto* trace_latency = latency_report_.mutable_trace_latency();
+  for (const auto& stage : trace_stages_) {
+    SetLatency(stage, trace_track_[stage], trace_latency);
+  }
 }
 
 bool LatencyMonitor::GetFrequency(const std::string& channel_name,
@@ -21,6 +21,7 @@
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <vector>
 
 #include "modules/common/latency_recorder/proto/latency_record.pb.h"
 #include "modules/monitor/common/recurrent_runner.h"
@@ -37,6 +38,10 @@ class LatencyMonitor : public RecurrentRunner {
  private:
   void UpdateStat(
       const std::shared_ptr<apollo::common::LatencyRecordMap>& records);
+  void UpdateTraces(
+      const std::shared_ptr<apollo::common::LatencyTraceMap>& traces);
+  void AddTraceLatency(const std::string& stage, const uint64_t begin_time,
+                       const uint64_t end_time);
   void PublishLatencyReport();
   void AggregateLatency();
 
@@ -45,6 +50,9 @@ class LatencyMonitor : public RecurrentRunner {
                      std::set<std::tuple<uint64_t, uint64_t, std::string>>>
       track_map_;
   std::unordered_map<std::string, double> freq_map_;
+  // the stages of the traced frames in the order they were first seen
+  std::vector<std::string> trace_stages_;
+  std::unordered_map<std::string, std::vector<uint64_t>> trace_track_;
   double flush_time_ = 0.0;
 };
 
@@ -15,60 +15,75 @@
  *****************************************************************************/
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <deque>
 #include <list>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <vector>
 
 #include "modules/perception/base/object_pool.h"
 
+// The pools allocate plainly unless built with
+// -DPERCEPTION_BASE_ENABLE_LOCK_FREE_POOL, see object_pool_lock_free_test.
+#ifndef PERCEPTION_BASE_ENABLE_LOCK_FREE_POOL
 #define PERCEPTION_BASE_DISABLE_POOL
+#endif
+
 namespace apollo {
 namespace perception {
 namespace base {
 
 static const size_t kPoolDefaultExtendNum = 10;
 static const size_t kPoolDefaultSize = 100;
+// @brief the pool keeps at most this times its default size of objects,
+//        more are allocated and freed as without pool
+static const size_t kPoolMaxSizeFactor = 8;
+// @brief objects cached by each thread
+static const size_t kPoolMagazineSize = 32;
 
 // @brief default initializer used in concurrent object pool
 template <class T>
 struct ObjectPoolDefaultInitializer {
   void operator()(T* t) const {}
 };
+
+// @brief usage statistics of concurrent object pool
+struct ConcurrentObjectPoolStats {
+  // Get served by a cached object
+  size_t hit_num = 0;
+  // Get that had to allocate an object
+  size_t miss_num = 0;
+  // objects allocated beyond the maximum pool size, freed on release
+  size_t overflow_num = 0;
+  // most objects of the pool in use at once, published by each thread every
+  // kPoolMagazineSize / 2 gets or releases
+  size_t high_water_mark = 0;
+};
+
 // @brief concurrent object pool with dynamic size
+//        Each thread gets from and releases to its own magazine of at most
+//        kPoolMagazineSize objects, exchanging half magazines with a global
+//        lock-free stack. Only growing the pool takes a lock, as it allocates.
 template <class ObjectType, size_t N = kPoolDefaultSize,
           class Initializer = ObjectPoolDefaultInitializer<ObjectType>>
 class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
  public:
   // using ObjectTypePtr = typename BaseObjectPool<ObjectType>::ObjectTypePtr;
   using BaseObjectPool<ObjectType>::capacity_;
-  // @brief Only allow accessing from global instance
+  // @brief Only allow accessing from global instance, never destroyed as
+  //        objects may be released during static destruction
   static ConcurrentObjectPool& Instance() {
-    static ConcurrentObjectPool pool(N);
-    return pool;
+    static ConcurrentObjectPool* pool = new ConcurrentObjectPool(N);
+    return *pool;
   }
   // @brief overrided function to get object smart pointer
   std::shared_ptr<ObjectType> Get() override {
 // TODO(All): remove conditional build
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-    ObjectType* ptr = nullptr;
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.empty()) {
-        Add(1 + kPoolDefaultExtendNum);
-      }
-      ptr = queue_.front();
-      queue_.pop();
-    }
-    // For efficiency consideration, initialization should be invoked
-    // after releasing the mutex
-    kInitializer(ptr);
-    return std::shared_ptr<ObjectType>(ptr, [&](ObjectType* obj_ptr) {
-      std::lock_guard<std::mutex> lock(mutex_);
-      queue_.push(obj_ptr);
-    });
+    return GetShared();
 #else
     return std::shared_ptr<ObjectType>(new ObjectType);
 #endif
@@ -79,26 +94,8 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   void BatchGet(size_t num,
                 std::vector<std::shared_ptr<ObjectType>>* data) override {
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-    std::vector<ObjectType*> buffer(num, nullptr);
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.size() < num) {
-        Add(num - queue_.size() + kPoolDefaultExtendNum);
-      }
-      for (size_t i = 0; i < num; ++i) {
-        buffer[i] = queue_.front();
-        queue_.pop();
-      }
-    }
-    // For efficiency consideration, initialization should be invoked
-    // after releasing the mutex
     for (size_t i = 0; i < num; ++i) {
-      kInitializer(buffer[i]);
-      data->emplace_back(
-          std::shared_ptr<ObjectType>(buffer[i], [&](ObjectType* obj_ptr) {
-            std::lock_guard<std::mutex> lock(mutex_);
-            queue_.push(obj_ptr);
-          }));
+      data->emplace_back(GetShared());
     }
 #else
     for (size_t i = 0; i < num; ++i) {
@@ -113,32 +110,9 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   void BatchGet(size_t num, bool is_front,
                 std::list<std::shared_ptr<ObjectType>>* data) override {
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-    std::vector<ObjectType*> buffer(num, nullptr);
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.size() < num) {
-        Add(num - queue_.size() + kPoolDefaultExtendNum);
-      }
-      for (size_t i = 0; i < num; ++i) {
-        buffer[i] = queue_.front();
-        queue_.pop();
-      }
-    }
-    // For efficiency consideration, initialization should be invoked
-    // after releasing the mutex
     for (size_t i = 0; i < num; ++i) {
-      kInitializer(buffer[i]);
-      is_front ? data->emplace_front(std::shared_ptr<ObjectType>(
-                     buffer[i],
-                     [&](ObjectType* obj_ptr) {
-                       std::lock_guard<std::mutex> lock(mutex_);
-                       queue_.push(obj_ptr);
-                     }))
-               : data->emplace_back(std::shared_ptr<ObjectType>(
-                     buffer[i], [&](ObjectType* obj_ptr) {
-                       std::lock_guard<std::mutex> lock(mutex_);
-                       queue_.push(obj_ptr);
-                     }));
+      is_front ? data->emplace_front(GetShared())
+               : data->emplace_back(GetShared());
     }
 #else
     for (size_t i = 0; i < num; ++i) {
@@ -154,30 +128,9 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
   void BatchGet(size_t num, bool is_front,
                 std::deque<std::shared_ptr<ObjectType>>* data) override {
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-    std::vector<ObjectType*> buffer(num, nullptr);
-    {
-      std::lock_guard<std::mutex> lock(mutex_);
-      if (queue_.size() < num) {
-        Add(num - queue_.size() + kPoolDefaultExtendNum);
-      }
-      for (size_t i = 0; i < num; ++i) {
-        buffer[i] = queue_.front();
-        queue_.pop();
-      }
-    }
     for (size_t i = 0; i < num; ++i) {
-      kInitializer(buffer[i]);
-      is_front ? data->emplace_front(std::shared_ptr<ObjectType>(
-                     buffer[i],
-                     [&](ObjectType* obj_ptr) {
-                       std::lock_guard<std::mutex> lock(mutex_);
-                       queue_.push(obj_ptr);
-                     }))
-               : data->emplace_back(std::shared_ptr<ObjectType>(
-                     buffer[i], [&](ObjectType* obj_ptr) {
-                       std::lock_guard<std::mutex> lock(mutex_);
-                       queue_.push(obj_ptr);
-                     }));
+      is_front ? data->emplace_front(GetShared())
+               : data->emplace_back(GetShared());
     }
 #else
     for (size_t i = 0; i < num; ++i) {
@@ -187,15 +140,40 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
 #endif
   }
 #ifndef PERCEPTION_BASE_DISABLE_POOL
-  // @brief overrided function to set capacity
+  // @brief overrided function to set capacity, at most the maximum size
   void set_capacity(size_t capacity) override {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::mutex> lock(grow_mutex_);
+    capacity = std::min(capacity, kMaxCacheSize);
     if (capacity_ < capacity) {
-      Add(capacity - capacity_);
+      std::vector<uint32_t> indices;
+      Add(capacity - capacity_, &indices);
+      PushGlobal(indices.data(), indices.size());
     }
   }
   // @brief get remained object number
-  size_t RemainedNum() override { return queue_.size(); }
+  size_t RemainedNum() override {
+    size_t num = global_num_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(magazines_mutex_);
+    for (const Magazine* magazine : magazines_) {
+      num += magazine->size.load(std::memory_order_relaxed);
+    }
+    return num;
+  }
+  // @brief get usage statistics
+  ConcurrentObjectPoolStats GetStats() {
+    ConcurrentObjectPoolStats stats;
+    std::lock_guard<std::mutex> lock(magazines_mutex_);
+    stats.hit_num = retired_hit_num_;
+    stats.miss_num = retired_miss_num_;
+    for (const Magazine* magazine : magazines_) {
+      stats.hit_num += magazine->hit_num.load(std::memory_order_relaxed);
+      stats.miss_num += magazine->miss_num.load(std::memory_order_relaxed);
+    }
+    stats.overflow_num = overflow_num_.load(std::memory_order_relaxed);
+    stats.high_water_mark = static_cast<size_t>(
+        std::max<int64_t>(high_water_mark_.load(std::memory_order_relaxed), 0));
+    return stats;
+  }
 #endif
   // @brief destructor to release the cached memory
   ~ConcurrentObjectPool() override {
@@ -203,45 +181,246 @@ class ConcurrentObjectPool : public BaseObjectPool<ObjectType> {
       delete[] cache_;
       cache_ = nullptr;
     }
-    for (auto& ptr : extended_cache_) {
-      delete ptr;
+    for (size_t i = kDefaultCacheSize; i < capacity_; ++i) {
+      delete slots_[i].object;
     }
-    extended_cache_.clear();
   }
 
  protected:
-// @brief add num objects, should add lock before invoke this function
-#ifndef PERCEPTION_BASE_DISABLE_POOL
-  void Add(size_t num) {
-    for (size_t i = 0; i < num; ++i) {
-      ObjectType* ptr = new ObjectType;
-      extended_cache_.push_back(ptr);
-      queue_.push(ptr);
+  // @brief an object of the pool, linked in the global stack by index
+  struct Slot {
+    ObjectType* object = nullptr;
+    std::atomic<uint32_t> next{0};
+  };
+  // @brief objects cached by one thread, read by others for statistics
+  struct Magazine {
+    explicit Magazine(ConcurrentObjectPool* pool) : pool(pool) {
+      std::lock_guard<std::mutex> lock(pool->magazines_mutex_);
+      pool->magazines_.push_back(this);
     }
-    capacity_ = kDefaultCacheSize + extended_cache_.size();
-  }
-#endif
+    ~Magazine() {
+      const size_t num = size.load(std::memory_order_relaxed);
+      pool->PushGlobal(indices, num);
+      pool->UpdateInUse(in_use_delta);
+      std::lock_guard<std::mutex> lock(pool->magazines_mutex_);
+      pool->retired_hit_num_ += hit_num.load(std::memory_order_relaxed);
+      pool->retired_miss_num_ += miss_num.load(std::memory_order_relaxed);
+      pool->magazines_.erase(
+          std::find(pool->magazines_.begin(), pool->magazines_.end(), this));
+      MagazineDestroyed() = true;
+    }
+    // @brief single writer counter increment, cheaper than fetch_add
+    static void Increase(std::atomic<size_t>* counter) {
+      counter->store(counter->load(std::memory_order_relaxed) + 1,
+                     std::memory_order_relaxed);
+    }
+
+    ConcurrentObjectPool* pool;
+    uint32_t indices[kPoolMagazineSize];
+    std::atomic<size_t> size{0};
+    std::atomic<size_t> hit_num{0};
+    std::atomic<size_t> miss_num{0};
+    // objects got minus released since last published to in_use_
+    int64_t in_use_delta = 0;
+  };
+
   // @brief default constructor
   explicit ConcurrentObjectPool(const size_t default_size)
-      : kDefaultCacheSize(default_size) {
+      : kDefaultCacheSize(default_size),
+        kMaxCacheSize(std::max(default_size * kPoolMaxSizeFactor,
+                               kPoolDefaultExtendNum + 1)) {
 #ifndef PERCEPTION_BASE_DISABLE_POOL
+    slots_.reset(new Slot[kMaxCacheSize]);
     cache_ = new ObjectType[kDefaultCacheSize];
+    std::vector<uint32_t> indices(kDefaultCacheSize);
     for (size_t i = 0; i < kDefaultCacheSize; ++i) {
-      queue_.push(&cache_[i]);
+      slots_[i].object = &cache_[i];
+      indices[i] = static_cast<uint32_t>(i);
     }
+    PushGlobal(indices.data(), indices.size());
     capacity_ = kDefaultCacheSize;
 #endif
   }
-  std::mutex mutex_;
-  std::queue<ObjectType*> queue_;
+
+  // @brief whether the magazine of this thread is destroyed at its exit
+  static bool& MagazineDestroyed() {
+    static thread_local bool destroyed = false;
+    return destroyed;
+  }
+#ifndef PERCEPTION_BASE_DISABLE_POOL
+  Magazine& LocalMagazine() {
+    static thread_local Magazine magazine(this);
+    return magazine;
+  }
+
+  std::shared_ptr<ObjectType> GetShared() {
+    uint32_t index = 0;
+    if (!Acquire(&index)) {
+      overflow_num_.fetch_add(1, std::memory_order_relaxed);
+      ObjectType* ptr = new ObjectType;
+      kInitializer(ptr);
+      return std::shared_ptr<ObjectType>(ptr);
+    }
+    ObjectType* ptr = slots_[index].object;
+    kInitializer(ptr);
+    return std::shared_ptr<ObjectType>(
+        ptr, [this, index](ObjectType*) { Release(index); });
+  }
+  // @brief take an object from the magazine, refilled from the global stack
+  //        or new objects, false if the pool is at its maximum size
+  bool Acquire(uint32_t* index) {
+    Magazine& magazine = LocalMagazine();
+    size_t size = magazine.size.load(std::memory_order_relaxed);
+    bool hit = true;
+    if (size == 0) {
+      size = PopGlobal(magazine.indices, kPoolMagazineSize / 2);
+      if (size == 0) {
+        hit = false;
+        std::vector<uint32_t> indices;
+        {
+          std::lock_guard<std::mutex> lock(grow_mutex_);
+          Add(1 + kPoolDefaultExtendNum, &indices);
+        }
+        if (indices.empty()) {
+          return false;
+        }
+        // keep a magazine worth and share the rest
+        const size_t kept = std::min(indices.size(), kPoolMagazineSize);
+        std::copy(indices.end() - kept, indices.end(), magazine.indices);
+        PushGlobal(indices.data(), indices.size() - kept);
+        size = kept;
+      }
+      UpdateInUse(magazine.in_use_delta);
+      magazine.in_use_delta = 0;
+    }
+    *index = magazine.indices[--size];
+    magazine.size.store(size, std::memory_order_relaxed);
+    Magazine::Increase(hit ? &magazine.hit_num : &magazine.miss_num);
+    ++magazine.in_use_delta;
+    return true;
+  }
+  // @brief return an object to the magazine, half of a full one goes to the
+  //        global stack
+  void Release(uint32_t index) {
+    if (MagazineDestroyed()) {
+      PushGlobal(&index, 1);
+      UpdateInUse(-1);
+      return;
+    }
+    Magazine& magazine = LocalMagazine();
+    size_t size = magazine.size.load(std::memory_order_relaxed);
+    if (size == kPoolMagazineSize) {
+      size -= kPoolMagazineSize / 2;
+      PushGlobal(magazine.indices + size, kPoolMagazineSize / 2);
+      UpdateInUse(magazine.in_use_delta);
+      magazine.in_use_delta = 0;
+    }
+    magazine.indices[size++] = index;
+    magazine.size.store(size, std::memory_order_relaxed);
+    --magazine.in_use_delta;
+  }
+
+  // @brief push objects onto the global stack with one exchange
+  void PushGlobal(const uint32_t* indices, size_t num) {
+    if (num == 0) {
+      return;
+    }
+    for (size_t i = 0; i + 1 < num; ++i) {
+      slots_[indices[i]].next.store(indices[i + 1] + 1,
+                                    std::memory_order_relaxed);
+    }
+    Slot& last = slots_[indices[num - 1]];
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t new_head = 0;
+    do {
+      last.next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+      new_head = NextTag(head) | (indices[0] + 1);
+    } while (!head_.compare_exchange_weak(head, new_head,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+    global_num_.fetch_add(num, std::memory_order_relaxed);
+  }
+  // @brief pop at most num objects from the global stack with one exchange
+  size_t PopGlobal(uint32_t* indices, size_t num) {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    size_t popped = 0;
+    while (true) {
+      // the links read are valid only if the head, and so its tag, has not
+      // changed when exchanged
+      uint32_t link = static_cast<uint32_t>(head);
+      popped = 0;
+      while (link != 0 && popped < num) {
+        indices[popped++] = link - 1;
+        link = slots_[link - 1].next.load(std::memory_order_relaxed);
+      }
+      if (popped == 0) {
+        return 0;
+      }
+      if (head_.compare_exchange_weak(head, NextTag(head) | link,
+                                      std::memory_order_acquire,
+                                      std::memory_order_acquire)) {
+        break;
+      }
+    }
+    global_num_.fetch_sub(popped, std::memory_order_relaxed);
+    return popped;
+  }
+  static uint64_t NextTag(uint64_t head) {
+    return ((head >> 32) + 1) << 32;
+  }
+
+  // @brief publish the objects got minus released by a thread
+  void UpdateInUse(int64_t delta) {
+    if (delta == 0) {
+      return;
+    }
+    const int64_t in_use =
+        in_use_.fetch_add(delta, std::memory_order_relaxed) + delta;
+    int64_t high_water_mark = high_water_mark_.load(std::memory_order_relaxed);
+    while (in_use > high_water_mark &&
+           !high_water_mark_.compare_exchange_weak(
+               high_water_mark, in_use, std::memory_order_relaxed)) {
+    }
+  }
+
+  // @brief add at most num objects, should lock grow_mutex_ before invoke
+  //        this function
+  void Add(size_t num, std::vector<uint32_t>* indices) {
+    num = std::min(num, kMaxCacheSize - capacity_);
+    for (size_t i = 0; i < num; ++i) {
+      slots_[capacity_].object = new ObjectType;
+      indices->push_back(static_cast<uint32_t>(capacity_));
+      ++capacity_;
+    }
+  }
+#endif
+
   // @brief point to a continuous memory of default pool size
   ObjectType* cache_ = nullptr;
   const size_t kDefaultCacheSize;
-  // @brief list to store extended memory, not as efficient
-  std::list<ObjectType*> extended_cache_;
+  const size_t kMaxCacheSize;
+  // @brief objects of the pool, the first ones in cache_
+  std::unique_ptr<Slot[]> slots_;
+  // @brief global stack of free objects, the tag in the high 32 bits and
+  //        the top index plus one in the low ones
+  std::atomic<uint64_t> head_{0};
+  std::atomic<size_t> global_num_{0};
+  std::mutex grow_mutex_;
+
+  std::mutex magazines_mutex_;
+  std::vector<Magazine*> magazines_;
+  size_t retired_hit_num_ = 0;
+  size_t retired_miss_num_ = 0;
+  std::atomic<size_t> overflow_num_{0};
+  std::atomic<int64_t> in_use_{0};
+  std::atomic<int64_t> high_water_mark_{0};
   static const Initializer kInitializer;
 };
 
+template <class ObjectType, size_t N, class Initializer>
+const Initializer
+    ConcurrentObjectPool<ObjectType, N, Initializer>::kInitializer{};
+
 }  // namespace base
 }  // namespace perception
 }  // namespace apollo
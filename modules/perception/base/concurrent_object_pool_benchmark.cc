@@ -0,0 +1,220 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Throughput of ConcurrentObjectPool under contention, against a
+ * mutex and queue pool as ConcurrentObjectPool was before and against no
+ * pool. Pairs of threads run for 1 to max_pairs pairs: the producer gets
+ * objects one by one and in batches, and hands them in chunks to the
+ * consumer, which releases them, as frames and objects travel between
+ * perception components.
+ *
+ * Built with PERCEPTION_BASE_ENABLE_LOCK_FREE_POOL, so the lock-free numbers
+ * are those of the pool, which the rest of perception only uses when built
+ * with that define too.
+ *
+ * Usage: concurrent_object_pool_benchmark [objects_per_producer] [max_pairs]
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "modules/perception/base/concurrent_object_pool.h"
+
+namespace {
+
+using apollo::perception::base::BaseObjectPool;
+using apollo::perception::base::ConcurrentObjectPool;
+using apollo::perception::base::ConcurrentObjectPoolStats;
+using apollo::perception::base::DummyObjectPool;
+
+// About the size of a small perception object.
+struct Payload {
+  double values[64];
+};
+
+constexpr size_t kPoolSize = 1000;
+constexpr size_t kChunkSize = 64;
+
+// One lock for every get and release.
+class MutexObjectPool : public BaseObjectPool<Payload> {
+ public:
+  explicit MutexObjectPool(size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+      objects_.emplace_back(new Payload);
+      queue_.push(objects_.back().get());
+    }
+  }
+  std::shared_ptr<Payload> Get() override {
+    Payload* ptr = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (queue_.empty()) {
+        objects_.emplace_back(new Payload);
+        queue_.push(objects_.back().get());
+      }
+      ptr = queue_.front();
+      queue_.pop();
+    }
+    return std::shared_ptr<Payload>(ptr, [this](Payload* obj_ptr) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      queue_.push(obj_ptr);
+    });
+  }
+  void BatchGet(size_t num,
+                std::vector<std::shared_ptr<Payload>>* data) override {
+    for (size_t i = 0; i < num; ++i) {
+      data->push_back(Get());
+    }
+  }
+  void BatchGet(size_t num, bool is_front,
+                std::list<std::shared_ptr<Payload>>* data) override {
+    for (size_t i = 0; i < num; ++i) {
+      is_front ? data->push_front(Get()) : data->push_back(Get());
+    }
+  }
+  void BatchGet(size_t num, bool is_front,
+                std::deque<std::shared_ptr<Payload>>* data) override {
+    for (size_t i = 0; i < num; ++i) {
+      is_front ? data->push_front(Get()) : data->push_back(Get());
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::queue<Payload*> queue_;
+  std::vector<std::unique_ptr<Payload>> objects_;
+};
+
+// Chunks of objects from a producer to its consumer, at most kMaxChunks
+// in flight.
+class Channel {
+ public:
+  void Push(std::vector<std::shared_ptr<Payload>>* chunk) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_full_.wait(lock, [this] { return chunks_.size() < kMaxChunks; });
+      chunks_.push_back(std::move(*chunk));
+    }
+    chunk->clear();
+    not_empty_.notify_one();
+  }
+  std::vector<std::shared_ptr<Payload>> Pop() {
+    std::vector<std::shared_ptr<Payload>> chunk;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_empty_.wait(lock, [this] { return !chunks_.empty(); });
+      chunk = std::move(chunks_.front());
+      chunks_.pop_front();
+    }
+    not_full_.notify_one();
+    return chunk;
+  }
+
+ private:
+  static constexpr size_t kMaxChunks = 8;
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::deque<std::vector<std::shared_ptr<Payload>>> chunks_;
+};
+
+// Million objects got and released per second.
+double Run(BaseObjectPool<Payload>* pool, int num_pairs,
+           size_t objects_per_producer) {
+  std::vector<Channel> channels(num_pairs);
+  std::vector<std::thread> threads;
+  const auto start = std::chrono::steady_clock::now();
+  for (int p = 0; p < num_pairs; ++p) {
+    Channel* channel = &channels[p];
+    threads.emplace_back([pool, channel, objects_per_producer]() {
+      std::vector<std::shared_ptr<Payload>> chunk;
+      size_t num = 0;
+      while (num < objects_per_producer) {
+        if (num % 3 == 0) {
+          pool->BatchGet(8, &chunk);
+          num += 8;
+        } else {
+          chunk.push_back(pool->Get());
+          ++num;
+        }
+        chunk.back()->values[0] = static_cast<double>(num);
+        if (chunk.size() >= kChunkSize) {
+          channel->Push(&chunk);
+        }
+      }
+      if (!chunk.empty()) {
+        channel->Push(&chunk);
+      }
+      // empty as the end
+      channel->Push(&chunk);
+    });
+    threads.emplace_back([channel]() {
+      while (!channel->Pop().empty()) {
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const double seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+  return static_cast<double>(objects_per_producer) * num_pairs / seconds /
+         1e6;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int objects_per_producer = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  const int max_pairs = argc > 2 ? std::atoi(argv[2]) : 4;
+  if (objects_per_producer <= 0 || max_pairs <= 0) {
+    fprintf(stderr, "Usage: %s [objects_per_producer] [max_pairs]\n", argv[0]);
+    return 1;
+  }
+
+  auto& lock_free_pool = ConcurrentObjectPool<Payload, kPoolSize>::Instance();
+  auto& dummy_pool = DummyObjectPool<Payload>::Instance();
+  printf("%d objects per producer, Mobjects/s\n", objects_per_producer);
+  printf("pairs  lock-free    mutex  no pool\n");
+  for (int num_pairs = 1; num_pairs <= max_pairs; num_pairs *= 2) {
+    MutexObjectPool mutex_pool(kPoolSize);
+    const double lock_free = Run(&lock_free_pool, num_pairs,
+                                 objects_per_producer);
+    const double mutex = Run(&mutex_pool, num_pairs, objects_per_producer);
+    const double dummy = Run(&dummy_pool, num_pairs, objects_per_producer);
+    printf("%5d %10.2f %8.2f %8.2f\n", num_pairs, lock_free, mutex, dummy);
+  }
+#ifndef PERCEPTION_BASE_DISABLE_POOL
+  const ConcurrentObjectPoolStats stats = lock_free_pool.GetStats();
+  printf("lock-free pool: capacity %zu, hits %zu, misses %zu, overflows %zu, "
+         "high water mark %zu\n",
+         lock_free_pool.get_capacity(), stats.hit_num, stats.miss_num,
+         stats.overflow_num, stats.high_water_mark);
+#endif
+  return 0;
+}
@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "modules/perception/base/object_pool.h"
 
+#include <thread>
+
 #include "modules/perception/base/light_object_pool.h"
 #include "modules/perception/base/object.h"
 #include "modules/perception/base/object_pool_types.h"
@@ -253,7 +255,9 @@ TEST(ObjectPoolTest, concurrent_object_pool_initializer_test) {
   }
 #endif
   {
-    typedef ConcurrentObjectPool<Object> TestObjectPool;
+    // a pool of its own, as the default initializer leaves the objects
+    // released by the tests above as they are
+    typedef ConcurrentObjectPool<Object, kPoolDefaultSize + 1> TestObjectPool;
     std::shared_ptr<Object> ptr = TestObjectPool::Instance().Get();
     EXPECT_EQ(ptr->id, -1);
     {
@@ -282,6 +286,97 @@ TEST(ObjectPoolTest, concurrent_object_pool_initializer_test) {
   }
 }
 
+#ifndef PERCEPTION_BASE_DISABLE_POOL
+struct StatsTestInitializer {
+  void operator()(Object* t) const { t->id = -1; }
+};
+
+TEST(ObjectPoolTest, concurrent_object_pool_stats_test) {
+  typedef ConcurrentObjectPool<Object, 20, StatsTestInitializer>
+      TestObjectPool;
+  auto& pool = TestObjectPool::Instance();
+  {
+    std::vector<std::shared_ptr<Object>> objects;
+    pool.BatchGet(25, &objects);
+    EXPECT_EQ(pool.RemainedNum(), pool.get_capacity() - 25);
+    const ConcurrentObjectPoolStats stats = pool.GetStats();
+    EXPECT_EQ(stats.hit_num + stats.miss_num, 25);
+    EXPECT_GE(stats.hit_num, 20);
+    EXPECT_GE(stats.miss_num, 1);
+    EXPECT_EQ(stats.overflow_num, 0);
+    EXPECT_LE(stats.high_water_mark, 25);
+    EXPECT_GE(stats.high_water_mark + kPoolMagazineSize, 25);
+  }
+  EXPECT_EQ(pool.RemainedNum(), pool.get_capacity());
+}
+
+TEST(ObjectPoolTest, concurrent_object_pool_max_size_test) {
+  struct MaxSizeTestInitializer {
+    void operator()(Object* t) const {}
+  };
+  typedef ConcurrentObjectPool<Object, 2, MaxSizeTestInitializer>
+      TestObjectPool;
+  auto& pool = TestObjectPool::Instance();
+  const size_t max_size = std::max(2 * kPoolMaxSizeFactor,
+                                   kPoolDefaultExtendNum + 1);
+  pool.set_capacity(max_size + 10);
+  EXPECT_EQ(pool.get_capacity(), max_size);
+  {
+    std::vector<std::shared_ptr<Object>> objects;
+    pool.BatchGet(max_size + 5, &objects);
+    for (const auto& object : objects) {
+      EXPECT_NE(object, nullptr);
+    }
+    EXPECT_EQ(pool.RemainedNum(), 0);
+    EXPECT_EQ(pool.GetStats().overflow_num, 5);
+  }
+  // the objects beyond the maximum size are freed
+  EXPECT_EQ(pool.RemainedNum(), max_size);
+  EXPECT_EQ(pool.get_capacity(), max_size);
+}
+
+TEST(ObjectPoolTest, concurrent_object_pool_multi_thread_test) {
+  struct MultiThreadTestInitializer {
+    void operator()(Object* t) const { t->id = -1; }
+  };
+  typedef ConcurrentObjectPool<Object, 50, MultiThreadTestInitializer>
+      TestObjectPool;
+  auto& pool = TestObjectPool::Instance();
+  const int kThreadNum = 4;
+  std::vector<std::thread> threads;
+  std::vector<int> errors(kThreadNum, 0);
+  for (int t = 0; t < kThreadNum; ++t) {
+    threads.emplace_back([&pool, &errors, t]() {
+      std::deque<std::shared_ptr<Object>> objects;
+      for (int i = 0; i < 2000; ++i) {
+        pool.BatchGet(1 + i % 7, i % 2 == 0, &objects);
+        // an object given to two threads at once is overwritten
+        for (auto& object : objects) {
+          if (object->id != -1 && object->id != t) {
+            ++errors[t];
+          }
+          object->id = t;
+        }
+        while (objects.size() > static_cast<size_t>(i % 40)) {
+          objects.pop_front();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int t = 0; t < kThreadNum; ++t) {
+    EXPECT_EQ(errors[t], 0);
+  }
+  // the objects cached by the threads are returned on exit
+  EXPECT_EQ(pool.RemainedNum(), pool.get_capacity());
+  const ConcurrentObjectPoolStats stats = pool.GetStats();
+  EXPECT_GT(stats.hit_num, stats.miss_num);
+  EXPECT_GT(stats.high_water_mark, 0);
+}
+#endif
+
 TEST(ObjectPoolTest, light_object_pool_capacity_test) {
   typedef LightObjectPool<Object, kPoolDefaultSize, TestObjectPoolInitializer,
                           SensorType::UNKNOWN_SENSOR_TYPE>
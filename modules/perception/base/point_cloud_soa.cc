@@ -0,0 +1,192 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/base/point_cloud_soa.h"
+
+#include <cmath>
+#include <type_traits>
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+namespace {
+
+// Calls func with the stride as a compile time constant if it is 1, so that
+// the loops over separate arrays use packed loads and stores.
+template <typename Func>
+inline void DispatchStride(size_t stride, Func&& func) {
+  if (stride == 1) {
+    func(std::integral_constant<size_t, 1>());
+  } else {
+    func(stride);
+  }
+}
+
+}  // namespace
+
+template <typename InT, typename OutT>
+void TransformPoints(const Eigen::Affine3d& pose, const PointSpan<InT>& in,
+                     const MutablePointSpan<OutT>& out) {
+  const Eigen::Matrix<double, 3, 4> m = pose.matrix().topRows<3>();
+  const double r00 = m(0, 0), r01 = m(0, 1), r02 = m(0, 2), t0 = m(0, 3);
+  const double r10 = m(1, 0), r11 = m(1, 1), r12 = m(1, 2), t1 = m(1, 3);
+  const double r20 = m(2, 0), r21 = m(2, 1), r22 = m(2, 2), t2 = m(2, 3);
+  const InT* const in_x = in.x;
+  const InT* const in_y = in.y;
+  const InT* const in_z = in.z;
+  OutT* const out_x = out.x;
+  OutT* const out_y = out.y;
+  OutT* const out_z = out.z;
+  const size_t size = in.size;
+  DispatchStride(in.stride, [&](auto in_stride) {
+    DispatchStride(out.stride, [&](auto out_stride) {
+#pragma omp simd
+      for (size_t i = 0; i < size; ++i) {
+        const double x = static_cast<double>(in_x[i * in_stride]);
+        const double y = static_cast<double>(in_y[i * in_stride]);
+        const double z = static_cast<double>(in_z[i * in_stride]);
+        out_x[i * out_stride] =
+            static_cast<OutT>(r00 * x + r01 * y + r02 * z + t0);
+        out_y[i * out_stride] =
+            static_cast<OutT>(r10 * x + r11 * y + r12 * z + t1);
+        out_z[i * out_stride] =
+            static_cast<OutT>(r20 * x + r21 * y + r22 * z + t2);
+      }
+    });
+  });
+}
+
+template <typename T>
+void MaskFinite(const PointSpan<T>& in, T max_abs, uint8_t* mask) {
+  // Local copies, as stores through mask could alias the span otherwise.
+  const T* const in_x = in.x;
+  const T* const in_y = in.y;
+  const T* const in_z = in.z;
+  const size_t size = in.size;
+  DispatchStride(in.stride, [&](auto stride) {
+#pragma omp simd
+    for (size_t i = 0; i < size; ++i) {
+      // NaN fails every comparison.
+      mask[i] = static_cast<uint8_t>((std::abs(in_x[i * stride]) <= max_abs) &
+                                     (std::abs(in_y[i * stride]) <= max_abs) &
+                                     (std::abs(in_z[i * stride]) <= max_abs));
+    }
+  });
+}
+
+template <typename T>
+void MaskOutsideBox2d(const PointSpan<T>& in, T min_x, T max_x, T min_y,
+                      T max_y, uint8_t* mask) {
+  // Local copies, as stores through mask could alias the span otherwise.
+  const T* const in_x = in.x;
+  const T* const in_y = in.y;
+  const size_t size = in.size;
+  DispatchStride(in.stride, [&](auto stride) {
+#pragma omp simd
+    for (size_t i = 0; i < size; ++i) {
+      const T x = in_x[i * stride];
+      const T y = in_y[i * stride];
+      const bool inside =
+          (x > min_x) & (x < max_x) & (y > min_y) & (y < max_y);
+      mask[i] = static_cast<uint8_t>(mask[i] & !inside);
+    }
+  });
+}
+
+template <typename T>
+void MaskOutsideBox2d(const Eigen::Affine3d& pose, const PointSpan<T>& in,
+                      double min_x, double max_x, double min_y, double max_y,
+                      uint8_t* mask) {
+  const Eigen::Matrix<double, 3, 4> m = pose.matrix().topRows<3>();
+  const double r00 = m(0, 0), r01 = m(0, 1), r02 = m(0, 2), t0 = m(0, 3);
+  const double r10 = m(1, 0), r11 = m(1, 1), r12 = m(1, 2), t1 = m(1, 3);
+  const T* const in_x = in.x;
+  const T* const in_y = in.y;
+  const T* const in_z = in.z;
+  const size_t size = in.size;
+  DispatchStride(in.stride, [&](auto stride) {
+#pragma omp simd
+    for (size_t i = 0; i < size; ++i) {
+      const double x = static_cast<double>(in_x[i * stride]);
+      const double y = static_cast<double>(in_y[i * stride]);
+      const double z = static_cast<double>(in_z[i * stride]);
+      const double tx = r00 * x + r01 * y + r02 * z + t0;
+      const double ty = r10 * x + r11 * y + r12 * z + t1;
+      const bool inside =
+          (tx > min_x) & (tx < max_x) & (ty > min_y) & (ty < max_y);
+      mask[i] = static_cast<uint8_t>(mask[i] & !inside);
+    }
+  });
+}
+
+template <typename T>
+void MaskInsideRect2d(const PointSpan<T>& in, double min_x, double max_x,
+                      double min_y, double max_y, uint8_t* mask) {
+  // Local copies, as stores through mask could alias the span otherwise.
+  const T* const in_x = in.x;
+  const T* const in_y = in.y;
+  const size_t size = in.size;
+  DispatchStride(in.stride, [&](auto stride) {
+#pragma omp simd
+    for (size_t i = 0; i < size; ++i) {
+      const double x = static_cast<double>(in_x[i * stride]);
+      const double y = static_cast<double>(in_y[i * stride]);
+      const bool inside =
+          (x >= min_x) & (x < max_x) & (y >= min_y) & (y < max_y);
+      mask[i] = static_cast<uint8_t>(mask[i] & inside);
+    }
+  });
+}
+
+template <typename T>
+void MaskZNotAbove(const PointSpan<T>& in, T max_z, uint8_t* mask) {
+  // Local copies, as stores through mask could alias the span otherwise.
+  const T* const in_z = in.z;
+  const size_t size = in.size;
+  DispatchStride(in.stride, [&](auto stride) {
+#pragma omp simd
+    for (size_t i = 0; i < size; ++i) {
+      mask[i] = static_cast<uint8_t>(mask[i] & !(in_z[i * stride] > max_z));
+    }
+  });
+}
+
+template void TransformPoints(const Eigen::Affine3d&, const PointSpan<float>&,
+                              const MutablePointSpan<float>&);
+template void TransformPoints(const Eigen::Affine3d&, const PointSpan<float>&,
+                              const MutablePointSpan<double>&);
+template void TransformPoints(const Eigen::Affine3d&, const PointSpan<double>&,
+                              const MutablePointSpan<float>&);
+template void TransformPoints(const Eigen::Affine3d&, const PointSpan<double>&,
+                              const MutablePointSpan<double>&);
+
+#define INSTANTIATE_POINT_CLOUD_SOA_MASKS(T)                                  \
+  template void MaskFinite(const PointSpan<T>&, T, uint8_t*);                 \
+  template void MaskOutsideBox2d(const PointSpan<T>&, T, T, T, T, uint8_t*);  \
+  template void MaskOutsideBox2d(const Eigen::Affine3d&, const PointSpan<T>&, \
+                                 double, double, double, double, uint8_t*);   \
+  template void MaskInsideRect2d(const PointSpan<T>&, double, double, double, \
+                                 double, uint8_t*);                           \
+  template void MaskZNotAbove(const PointSpan<T>&, T, uint8_t*);
+
+INSTANTIATE_POINT_CLOUD_SOA_MASKS(float)
+INSTANTIATE_POINT_CLOUD_SOA_MASKS(double)
+
+#undef INSTANTIATE_POINT_CLOUD_SOA_MASKS
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,309 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <vector>
+
+#include "Eigen/Dense"
+
+#include "modules/perception/base/point_cloud.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+// @brief allocator of cache line aligned arrays
+template <typename T, size_t Alignment = 64>
+struct AlignedAllocator {
+  using value_type = T;
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  AlignedAllocator() = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}  // NOLINT
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(
+        ::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+  }
+  void deallocate(T* p, size_t) {
+    ::operator delete(p, std::align_val_t(Alignment));
+  }
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, Alignment>&) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const AlignedAllocator<U, Alignment>&) const {
+    return false;
+  }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// @brief view of the coordinates of points, either the separate arrays of a
+// PointCloudSoA (stride 1) or the interleaved points of a PointCloud, so that
+// kernels run on both without copies
+template <typename T>
+struct PointSpan {
+  const T* x = nullptr;
+  const T* y = nullptr;
+  const T* z = nullptr;
+  size_t size = 0;
+  // Distance between consecutive points, in T.
+  size_t stride = 1;
+};
+
+template <typename T>
+struct MutablePointSpan {
+  T* x = nullptr;
+  T* y = nullptr;
+  T* z = nullptr;
+  size_t size = 0;
+  size_t stride = 1;
+};
+
+// @brief view of the points of a PointCloud
+template <typename PointT>
+PointSpan<typename PointT::Type> MakePointSpan(
+    const std::vector<PointT>& points) {
+  using T = typename PointT::Type;
+  static_assert(sizeof(PointT) % sizeof(T) == 0, "point is not a T array");
+  PointSpan<T> span;
+  if (!points.empty()) {
+    span.x = &points[0].x;
+    span.y = &points[0].y;
+    span.z = &points[0].z;
+  }
+  span.size = points.size();
+  span.stride = sizeof(PointT) / sizeof(T);
+  return span;
+}
+
+template <typename PointT>
+MutablePointSpan<typename PointT::Type> MakeMutablePointSpan(
+    std::vector<PointT>* points) {
+  using T = typename PointT::Type;
+  static_assert(sizeof(PointT) % sizeof(T) == 0, "point is not a T array");
+  MutablePointSpan<T> span;
+  if (!points->empty()) {
+    span.x = &(*points)[0].x;
+    span.y = &(*points)[0].y;
+    span.z = &(*points)[0].z;
+  }
+  span.size = points->size();
+  span.stride = sizeof(PointT) / sizeof(T);
+  return span;
+}
+
+// @brief point cloud stored as one aligned array per attribute, without
+// virtual calls per point, for kernels that work on all points at once
+template <typename T>
+class PointCloudSoA {
+ public:
+  using Type = T;
+
+  PointCloudSoA() = default;
+
+  inline size_t size() const { return x_.size(); }
+  inline bool empty() const { return x_.empty(); }
+  void reserve(size_t size) {
+    x_.reserve(size);
+    y_.reserve(size);
+    z_.reserve(size);
+    intensity_.reserve(size);
+    timestamp_.reserve(size);
+    beam_id_.reserve(size);
+  }
+  void resize(size_t size) {
+    x_.resize(size);
+    y_.resize(size);
+    z_.resize(size);
+    intensity_.resize(size);
+    timestamp_.resize(size);
+    beam_id_.resize(size, -1);
+  }
+  void clear() { resize(0); }
+
+  const T* x() const { return x_.data(); }
+  const T* y() const { return y_.data(); }
+  const T* z() const { return z_.data(); }
+  const float* intensity() const { return intensity_.data(); }
+  const double* timestamp() const { return timestamp_.data(); }
+  const int32_t* beam_id() const { return beam_id_.data(); }
+  T* mutable_x() { return x_.data(); }
+  T* mutable_y() { return y_.data(); }
+  T* mutable_z() { return z_.data(); }
+  float* mutable_intensity() { return intensity_.data(); }
+  double* mutable_timestamp() { return timestamp_.data(); }
+  int32_t* mutable_beam_id() { return beam_id_.data(); }
+
+  PointSpan<T> span() const {
+    return {x_.data(), y_.data(), z_.data(), size(), 1};
+  }
+  MutablePointSpan<T> mutable_span() {
+    return {x_.data(), y_.data(), z_.data(), size(), 1};
+  }
+
+  // @brief keep the points with a nonzero mask, in order
+  // @return number of points kept
+  size_t Compact(const uint8_t* mask) {
+    size_t kept = 0;
+    for (size_t i = 0; i < size(); ++i) {
+      if (mask[i]) {
+        x_[kept] = x_[i];
+        y_[kept] = y_[i];
+        z_[kept] = z_[i];
+        intensity_[kept] = intensity_[i];
+        timestamp_[kept] = timestamp_[i];
+        beam_id_[kept] = beam_id_[i];
+        ++kept;
+      }
+    }
+    resize(kept);
+    return kept;
+  }
+
+  // @brief write all points to a PointCloud, replacing its points
+  template <typename PointT>
+  void ToPointCloud(AttributePointCloud<PointT>* cloud) const {
+    std::vector<uint8_t> mask(size(), 1);
+    ToPointCloud(mask.data(), cloud);
+  }
+
+  // @brief write the points with a nonzero mask to a PointCloud, in order,
+  // replacing its points; the same as Compact and ToPointCloud in one pass
+  template <typename PointT>
+  void ToPointCloud(const uint8_t* mask,
+                    AttributePointCloud<PointT>* cloud) const {
+    using OutT = typename PointT::Type;
+    size_t kept = 0;
+    for (size_t i = 0; i < size(); ++i) {
+      kept += mask[i] ? 1 : 0;
+    }
+    // Every attribute is overwritten, so the cloud is not cleared first.
+    cloud->resize(kept);
+    auto& points = *cloud->mutable_points();
+    auto& timestamps = *cloud->mutable_points_timestamp();
+    auto& beam_ids = *cloud->mutable_points_beam_id();
+    size_t j = 0;
+    for (size_t i = 0; i < size(); ++i) {
+      if (mask[i]) {
+        points[j].x = static_cast<OutT>(x_[i]);
+        points[j].y = static_cast<OutT>(y_[i]);
+        points[j].z = static_cast<OutT>(z_[i]);
+        points[j].intensity = static_cast<OutT>(intensity_[i]);
+        timestamps[j] = timestamp_[i];
+        beam_ids[j] = beam_id_[i];
+        ++j;
+      }
+    }
+    std::fill(cloud->mutable_points_height()->begin(),
+              cloud->mutable_points_height()->end(),
+              std::numeric_limits<float>::max());
+    std::fill(cloud->mutable_points_label()->begin(),
+              cloud->mutable_points_label()->end(), 0);
+  }
+
+ private:
+  AlignedVector<T> x_;
+  AlignedVector<T> y_;
+  AlignedVector<T> z_;
+  AlignedVector<float> intensity_;
+  AlignedVector<double> timestamp_;
+  AlignedVector<int32_t> beam_id_;
+};
+
+typedef PointCloudSoA<float> PointFCloudSoA;
+typedef PointCloudSoA<double> PointDCloudSoA;
+
+// The kernels below are compiled with OpenMP SIMD, for float and double
+// points. They run on PointCloudSoA spans as well as on the points of a
+// PointCloud, at a stride of 4, but are fastest on the separate arrays.
+
+// @brief out = pose * in, computed in double; in and out may be the same
+template <typename InT, typename OutT>
+void TransformPoints(const Eigen::Affine3d& pose, const PointSpan<InT>& in,
+                     const MutablePointSpan<OutT>& out);
+
+// @brief mask[i] = 1 if no coordinate of the point is NaN or larger than
+// max_abs in magnitude, 0 otherwise
+template <typename T>
+void MaskFinite(const PointSpan<T>& in, T max_abs, uint8_t* mask);
+
+// @brief clear mask[i] if the point is strictly inside the 2d box
+template <typename T>
+void MaskOutsideBox2d(const PointSpan<T>& in, T min_x, T max_x, T min_y,
+                      T max_y, uint8_t* mask);
+
+// @brief clear mask[i] if pose * point, computed in double, is strictly
+// inside the 2d box
+template <typename T>
+void MaskOutsideBox2d(const Eigen::Affine3d& pose, const PointSpan<T>& in,
+                      double min_x, double max_x, double min_y, double max_y,
+                      uint8_t* mask);
+
+// @brief clear mask[i] if the point is outside [min_x, max_x) x [min_y, max_y),
+// compared in double
+template <typename T>
+void MaskInsideRect2d(const PointSpan<T>& in, double min_x, double max_x,
+                      double min_y, double max_y, uint8_t* mask);
+
+// @brief clear mask[i] if z of the point is above max_z
+template <typename T>
+void MaskZNotAbove(const PointSpan<T>& in, T max_z, uint8_t* mask);
+
+// @brief keep the points of a PointCloud with a nonzero mask, in order
+// @return number of points kept
+template <typename PointT>
+size_t CompactPointCloud(const uint8_t* mask,
+                         AttributePointCloud<PointT>* cloud) {
+  size_t kept = 0;
+  for (size_t i = 0; i < cloud->size(); ++i) {
+    if (mask[i]) {
+      if (kept != i) {
+        cloud->CopyPoint(kept, i, *cloud);
+      }
+      ++kept;
+    }
+  }
+  cloud->resize(kept);
+  return kept;
+}
+
+// @brief indices of the nonzero entries of the mask
+inline void MaskToIndices(const uint8_t* mask, size_t size,
+                          std::vector<int>* indices) {
+  indices->clear();
+  for (size_t i = 0; i < size; ++i) {
+    if (mask[i]) {
+      indices->push_back(static_cast<int>(i));
+    }
+  }
+}
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,195 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/base/point_cloud_soa.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace base {
+
+namespace {
+
+// A cloud with points of all kinds, including NaN and far away ones.
+void MockPointCloud(size_t size, PointFCloud* cloud) {
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<float> dist(-50.f, 50.f);
+  cloud->clear();
+  for (size_t i = 0; i < size; ++i) {
+    PointF point;
+    point.x = dist(gen);
+    point.y = dist(gen);
+    point.z = dist(gen) * 0.1f;
+    point.intensity = static_cast<float>(i % 256);
+    cloud->push_back(point, static_cast<double>(i) * 1e-6,
+                     std::numeric_limits<float>::max(), static_cast<int>(i),
+                     0);
+  }
+  cloud->at(1).x = std::numeric_limits<float>::quiet_NaN();
+  cloud->at(2).z = std::numeric_limits<float>::infinity();
+  cloud->at(3).y = 2000.f;
+}
+
+void ToSoA(const PointFCloud& cloud, PointFCloudSoA* soa) {
+  soa->resize(cloud.size());
+  for (size_t i = 0; i < cloud.size(); ++i) {
+    soa->mutable_x()[i] = cloud[i].x;
+    soa->mutable_y()[i] = cloud[i].y;
+    soa->mutable_z()[i] = cloud[i].z;
+    soa->mutable_intensity()[i] = cloud[i].intensity;
+    soa->mutable_timestamp()[i] = cloud.points_timestamp(i);
+    soa->mutable_beam_id()[i] = cloud.points_beam_id()[i];
+  }
+}
+
+}  // namespace
+
+TEST(PointCloudSoATest, Alignment) {
+  PointFCloudSoA soa;
+  soa.resize(3);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(soa.x()) % 64);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(soa.timestamp()) % 64);
+  EXPECT_EQ(-1, soa.beam_id()[2]);
+  EXPECT_EQ(4, MakePointSpan(std::vector<PointF>(1)).stride);
+  EXPECT_EQ(4, MakePointSpan(std::vector<PointD>(1)).stride);
+}
+
+TEST(PointCloudSoATest, TransformPoints) {
+  PointFCloud cloud;
+  // Not a multiple of the block size.
+  MockPointCloud(1000, &cloud);
+  Eigen::Affine3d pose = Eigen::Affine3d::Identity();
+  pose.rotate(
+      Eigen::AngleAxisd(0.3, Eigen::Vector3d(0.1, 0.2, 1.0).normalized()));
+  pose.pretranslate(Eigen::Vector3d(100.0, -20.0, 1.5));
+
+  PointDCloud world_cloud;
+  world_cloud.resize(cloud.size());
+  TransformPoints(pose, MakePointSpan(cloud.points()),
+                  MakeMutablePointSpan(world_cloud.mutable_points()));
+  PointFCloudSoA soa;
+  ToSoA(cloud, &soa);
+  TransformPoints(pose, soa.span(), soa.mutable_span());
+
+  for (size_t i = 4; i < cloud.size(); ++i) {
+    const Eigen::Vector3d expected =
+        pose * Eigen::Vector3d(cloud[i].x, cloud[i].y, cloud[i].z);
+    EXPECT_NEAR(expected(0), world_cloud[i].x, 1e-9);
+    EXPECT_NEAR(expected(1), world_cloud[i].y, 1e-9);
+    EXPECT_NEAR(expected(2), world_cloud[i].z, 1e-9);
+    EXPECT_FLOAT_EQ(static_cast<float>(expected(0)), soa.x()[i]);
+    EXPECT_FLOAT_EQ(static_cast<float>(expected(1)), soa.y()[i]);
+    EXPECT_FLOAT_EQ(static_cast<float>(expected(2)), soa.z()[i]);
+  }
+}
+
+TEST(PointCloudSoATest, Masks) {
+  PointFCloud cloud;
+  MockPointCloud(1000, &cloud);
+  PointFCloudSoA soa;
+  ToSoA(cloud, &soa);
+
+  std::vector<uint8_t> aos_mask(cloud.size());
+  std::vector<uint8_t> soa_mask(cloud.size());
+  const PointSpan<float> aos_span = MakePointSpan(cloud.points());
+  MaskFinite(aos_span, 1e3f, aos_mask.data());
+  MaskOutsideBox2d(aos_span, -10.f, 20.f, -5.f, 5.f, aos_mask.data());
+  MaskZNotAbove(aos_span, 3.f, aos_mask.data());
+  MaskInsideRect2d(aos_span, -40.f, 40.f, -40.f, 40.f, aos_mask.data());
+  MaskFinite(soa.span(), 1e3f, soa_mask.data());
+  MaskOutsideBox2d(soa.span(), -10.f, 20.f, -5.f, 5.f, soa_mask.data());
+  MaskZNotAbove(soa.span(), 3.f, soa_mask.data());
+  MaskInsideRect2d(soa.span(), -40.f, 40.f, -40.f, 40.f, soa_mask.data());
+
+  std::vector<int> expected_indices;
+  for (size_t i = 0; i < cloud.size(); ++i) {
+    const auto& pt = cloud[i];
+    if (std::isnan(pt.x) || std::isnan(pt.y) || std::isnan(pt.z) ||
+        std::fabs(pt.x) > 1e3f || std::fabs(pt.y) > 1e3f ||
+        std::fabs(pt.z) > 1e3f) {
+      continue;
+    }
+    if (pt.x < 20.f && pt.x > -10.f && pt.y < 5.f && pt.y > -5.f) {
+      continue;
+    }
+    if (pt.z > 3.f) {
+      continue;
+    }
+    if (pt.x < -40.f || pt.x >= 40.f || pt.y < -40.f || pt.y >= 40.f) {
+      continue;
+    }
+    expected_indices.push_back(static_cast<int>(i));
+  }
+  EXPECT_EQ(aos_mask, soa_mask);
+  std::vector<int> indices;
+  MaskToIndices(soa_mask.data(), soa_mask.size(), &indices);
+  EXPECT_EQ(expected_indices, indices);
+  ASSERT_FALSE(indices.empty());
+
+  EXPECT_EQ(indices.size(), soa.Compact(soa_mask.data()));
+  EXPECT_EQ(indices.size(), CompactPointCloud(aos_mask.data(), &cloud));
+  PointFCloud out_cloud;
+  soa.ToPointCloud(&out_cloud);
+  ASSERT_EQ(indices.size(), out_cloud.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    EXPECT_EQ(cloud[i].x, out_cloud[i].x);
+    EXPECT_EQ(cloud[i].y, out_cloud[i].y);
+    EXPECT_EQ(cloud[i].z, out_cloud[i].z);
+    EXPECT_EQ(cloud[i].intensity, out_cloud[i].intensity);
+    EXPECT_EQ(indices[i], cloud.points_beam_id()[i]);
+    EXPECT_EQ(indices[i], out_cloud.points_beam_id()[i]);
+    EXPECT_EQ(cloud.points_timestamp(i), out_cloud.points_timestamp(i));
+    EXPECT_EQ(std::numeric_limits<float>::max(), out_cloud.points_height(i));
+  }
+}
+
+TEST(PointCloudSoATest, MaskOutsideTransformedBox2d) {
+  PointFCloud cloud;
+  MockPointCloud(1000, &cloud);
+  Eigen::Affine3d pose = Eigen::Affine3d::Identity();
+  pose.rotate(Eigen::AngleAxisd(M_PI / 2, Eigen::Vector3d::UnitZ()));
+  pose.pretranslate(Eigen::Vector3d(1.0, 0.0, 1.9));
+
+  std::vector<uint8_t> mask(cloud.size(), 1);
+  MaskOutsideBox2d(pose, MakePointSpan(cloud.points()), -20.0, 20.0, -10.0,
+                   10.0, mask.data());
+  size_t num_inside = 0;
+  for (size_t i = 0; i < cloud.size(); ++i) {
+    const Eigen::Vector3d pt =
+        pose * Eigen::Vector3d(cloud[i].x, cloud[i].y, cloud[i].z);
+    const bool inside =
+        pt.x() > -20.0 && pt.x() < 20.0 && pt.y() > -10.0 && pt.y() < 10.0;
+    EXPECT_EQ(!inside, mask[i] != 0) << i;
+    num_inside += inside ? 1 : 0;
+  }
+  EXPECT_GT(num_inside, 0);
+
+  PointFCloudSoA soa;
+  ToSoA(cloud, &soa);
+  PointDCloud out_cloud;
+  soa.ToPointCloud(mask.data(), &out_cloud);
+  EXPECT_EQ(cloud.size() - num_inside, out_cloud.size());
+}
+
+}  // namespace base
+}  // namespace perception
+}  // namespace apollo
@@ -62,7 +62,22 @@ class GatedHungarianMatcher {
              std::vector<size_t>* unassigned_rows,
              std::vector<size_t>* unassigned_cols);
 
+  /* @brief: match with the pairs which may have valid costs given, sorted by
+   * row then col, so that the global costs are not scanned. the costs of
+   * the other pairs must be invalid. */
+  void Match(T cost_thresh, T bound_value, OptimizeFlag opt_flag,
+             const std::vector<std::pair<size_t, size_t>>& candidate_pairs,
+             std::vector<std::pair<size_t, size_t>>* assignments,
+             std::vector<size_t>* unassigned_rows,
+             std::vector<size_t>* unassigned_cols);
+
  private:
+  void MatchImpl(T cost_thresh, T bound_value, OptimizeFlag opt_flag,
+                 const std::vector<std::pair<size_t, size_t>>* candidate_pairs,
+                 std::vector<std::pair<size_t, size_t>>* assignments,
+                 std::vector<size_t>* unassigned_rows,
+                 std::vector<size_t>* unassigned_cols);
+
   /* Step 1:
    * a. get number of rows & cols
    * b. determine function of comparison */
@@ -72,6 +87,7 @@ class GatedHungarianMatcher {
    * to acclerate matching process, split input cost graph into several
    * small sub-parts. */
   void ComputeConnectedComponents(
+      const std::vector<std::pair<size_t, size_t>>* candidate_pairs,
       std::vector<std::vector<size_t>>* row_components,
       std::vector<std::vector<size_t>>* col_components) const;
 
@@ -136,6 +152,28 @@ void GatedHungarianMatcher<T>::Match(
     std::vector<std::pair<size_t, size_t>>* assignments,
     std::vector<size_t>* unassigned_rows,
     std::vector<size_t>* unassigned_cols) {
+  MatchImpl(cost_thresh, bound_value, opt_flag, nullptr, assignments,
+            unassigned_rows, unassigned_cols);
+}
+
+template <typename T>
+void GatedHungarianMatcher<T>::Match(
+    T cost_thresh, T bound_value, OptimizeFlag opt_flag,
+    const std::vector<std::pair<size_t, size_t>>& candidate_pairs,
+    std::vector<std::pair<size_t, size_t>>* assignments,
+    std::vector<size_t>* unassigned_rows,
+    std::vector<size_t>* unassigned_cols) {
+  MatchImpl(cost_thresh, bound_value, opt_flag, &candidate_pairs, assignments,
+            unassigned_rows, unassigned_cols);
+}
+
+template <typename T>
+void GatedHungarianMatcher<T>::MatchImpl(
+    T cost_thresh, T bound_value, OptimizeFlag opt_flag,
+    const std::vector<std::pair<size_t, size_t>>* candidate_pairs,
+    std::vector<std::pair<size_t, size_t>>* assignments,
+    std::vector<size_t>* unassigned_rows,
+    std::vector<size_t>* unassigned_cols) {
   CHECK_NOTNULL(assignments);
   CHECK_NOTNULL(unassigned_rows);
   CHECK_NOTNULL(unassigned_cols);
@@ -150,7 +188,8 @@ void GatedHungarianMatcher<T>::Match(
   /* compute components */
   std::vector<std::vector<size_t>> row_components;
   std::vector<std::vector<size_t>> col_components;
-  this->ComputeConnectedComponents(&row_components, &col_components);
+  this->ComputeConnectedComponents(candidate_pairs, &row_components,
+                                   &col_components);
   CHECK_EQ(row_components.size(), col_components.size());
 
   /* compute assignments */
@@ -185,6 +224,7 @@ void GatedHungarianMatcher<T>::MatchInit() {
 
 template <typename T>
 void GatedHungarianMatcher<T>::ComputeConnectedComponents(
+    const std::vector<std::pair<size_t, size_t>>* candidate_pairs,
     std::vector<std::vector<size_t>>* row_components,
     std::vector<std::vector<size_t>>* col_components) const {
   CHECK_NOTNULL(row_components);
@@ -192,11 +232,21 @@ void GatedHungarianMatcher<T>::ComputeConnectedComponents(
 
   std::vector<std::vector<int>> nb_graph;
   nb_graph.resize(rows_num_ + cols_num_);
-  for (size_t i = 0; i < rows_num_; ++i) {
-    for (size_t j = 0; j < cols_num_; ++j) {
-      if (is_valid_cost_(global_costs_(i, j))) {
-        nb_graph[i].push_back(static_cast<int>(rows_num_) + j);
-        nb_graph[j + rows_num_].push_back(i);
+  auto add_edge = [&](size_t i, size_t j) {
+    if (is_valid_cost_(global_costs_(i, j))) {
+      nb_graph[i].push_back(static_cast<int>(rows_num_) + j);
+      nb_graph[j + rows_num_].push_back(i);
+    }
+  };
+  /* in row-major order either way, so the graph is the same */
+  if (candidate_pairs != nullptr) {
+    for (const auto& pair : *candidate_pairs) {
+      add_edge(pair.first, pair.second);
+    }
+  } else {
+    for (size_t i = 0; i < rows_num_; ++i) {
+      for (size_t j = 0; j < cols_num_; ++j) {
+        add_edge(i, j);
       }
     }
   }
@@ -16,6 +16,8 @@
 
 #include "modules/perception/common/graph/gated_hungarian_bigraph_matcher.h"
 
+#include <random>
+
 #include "Eigen/Core"
 #include "gtest/gtest.h"
 
@@ -551,6 +553,47 @@ TEST_F(GatedHungarianMatcherTest, test_Match_Maximize) {
   EXPECT_EQ(0, unassigned_rows.size());
 }
 
+TEST_F(GatedHungarianMatcherTest, test_Match_Minimize_candidate_pairs) {
+  SecureMat<float>* global_costs = optimizer_->mutable_global_costs();
+  const float bound_value = 10.0f;
+  const float cost_thresh = 2.0f;
+  GatedHungarianMatcher<float>::OptimizeFlag opt_flag =
+      GatedHungarianMatcher<float>::OptimizeFlag::OPTMIN;
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<float> cost(0.f, 2.5f);
+  std::uniform_int_distribution<int> gated(0, 3);
+  for (size_t rows : {1, 17, 60}) {
+    const size_t cols = rows + 5;
+    global_costs->Resize(rows, cols);
+    // candidates are all valid pairs and some invalid ones
+    std::vector<std::pair<size_t, size_t>> candidate_pairs;
+    for (size_t i = 0; i < rows; ++i) {
+      for (size_t j = 0; j < cols; ++j) {
+        (*global_costs)(i, j) = gated(gen) == 0 ? cost(gen) : bound_value;
+        if ((*global_costs)(i, j) < cost_thresh || (i + j) % 5 == 0) {
+          candidate_pairs.emplace_back(i, j);
+        }
+      }
+    }
+
+    std::vector<std::pair<size_t, size_t>> assignments;
+    std::vector<size_t> unassigned_rows;
+    std::vector<size_t> unassigned_cols;
+    optimizer_->Match(cost_thresh, bound_value, opt_flag, &assignments,
+                      &unassigned_rows, &unassigned_cols);
+    std::vector<std::pair<size_t, size_t>> sparse_assignments;
+    std::vector<size_t> sparse_unassigned_rows;
+    std::vector<size_t> sparse_unassigned_cols;
+    optimizer_->Match(cost_thresh, bound_value, opt_flag, candidate_pairs,
+                      &sparse_assignments, &sparse_unassigned_rows,
+                      &sparse_unassigned_cols);
+    EXPECT_FALSE(assignments.empty());
+    EXPECT_EQ(assignments, sparse_assignments);
+    EXPECT_EQ(unassigned_rows, sparse_unassigned_rows);
+    EXPECT_EQ(unassigned_cols, sparse_unassigned_cols);
+  }
+}
+
 }  // namespace common
 }  // namespace perception
 }  // namespace apollo
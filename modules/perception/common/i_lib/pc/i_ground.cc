@@ -15,6 +15,8 @@
  *****************************************************************************/
 #include "modules/perception/common/i_lib/pc/i_ground.h"
 
+#include <omp.h>
+
 #include <algorithm>
 #include <limits>
 
@@ -44,6 +46,7 @@ void PlaneFitGroundDetectorParam::SetDefault() {
   nr_ransac_iter_threshold = 32;
   candidate_filter_threshold = 1.0f;  // 1 meter
   nr_smooth_iter = 1;
+  nr_threads = 1;
 }
 
 bool PlaneFitGroundDetectorParam::Validate() const {
@@ -51,7 +54,7 @@ bool PlaneFitGroundDetectorParam::Validate() const {
       nr_grids_coarse > nr_grids_fine || nr_points_max == 0 ||
       nr_samples_min_threshold == 0 || nr_samples_max_threshold == 0 ||
       nr_inliers_min_threshold == 0 || nr_ransac_iter_threshold == 0 ||
-      roi_region_rad_x <= 0.f || roi_region_rad_y <= 0.f ||
+      nr_threads < 1 || roi_region_rad_x <= 0.f || roi_region_rad_y <= 0.f ||
       roi_region_rad_z <= 0.f ||
       planefit_dist_threshold_near > planefit_dist_threshold_far) {
     std::cerr << "Invalid ground detector parameters... " << std::endl;
@@ -129,6 +132,50 @@ void PlaneFitGroundDetector::InitOrderTable(const VoxelGridXY<float> *vg,
   }
 }
 
+// Split the order table into wavefronts
+void PlaneFitGroundDetector::InitWavefronts() {
+  const int n = static_cast<int>(param_.nr_grids_coarse);
+  const unsigned int nr_cells = vg_coarse_->NrVoxel();
+  std::vector<int> wavefront(nr_cells, -1);
+  std::vector<std::pair<int, int>> neighbors;
+  int nr_wavefronts = 0;
+  for (unsigned int i = 0; i < nr_cells; ++i) {
+    const int r = order_table_[i].first;
+    const int c = order_table_[i].second;
+    neighbors.clear();
+    GetNeighbors(r, c, n, n, &neighbors);
+    // one after the last neighbor fitted before this cell
+    int w = 0;
+    for (const auto &neighbor : neighbors) {
+      w = IMax(w, wavefront[neighbor.first * n + neighbor.second] + 1);
+    }
+    wavefront[r * n + c] = w;
+    nr_wavefronts = IMax(nr_wavefronts, w + 1);
+  }
+  // stable counting sort, cells keep the order table order in a wavefront
+  wavefront_begin_.assign(nr_wavefronts + 1, 0);
+  for (unsigned int i = 0; i < nr_cells; ++i) {
+    ++wavefront_begin_[wavefront[i] + 1];
+  }
+  for (int w = 0; w < nr_wavefronts; ++w) {
+    wavefront_begin_[w + 1] += wavefront_begin_[w];
+  }
+  std::vector<unsigned int> next(wavefront_begin_.begin(),
+                                 wavefront_begin_.end() - 1);
+  wavefront_cells_.resize(nr_cells);
+  for (unsigned int i = 0; i < nr_cells; ++i) {
+    const auto &cell = order_table_[i];
+    wavefront_cells_[next[wavefront[cell.first * n + cell.second]]++] = cell;
+  }
+}
+
+float *PlaneFitGroundDetector::GetThreeDs() {
+  // with more than one thread, fitting only runs in the parallel regions of
+  // Fit and FitInOrder, so the thread number indexes the buffers
+  const int thread = param_.nr_threads > 1 ? omp_get_thread_num() : 0;
+  return pf_threeds_ + thread * param_.nr_samples_max_threshold * dim_point_;
+}
+
 bool PlaneFitGroundDetector::Init() {
   unsigned int r = 0;
   unsigned int c = 0;
@@ -207,14 +254,17 @@ bool PlaneFitGroundDetector::Init() {
       local_candis_[r][c].Reserve(capacity);
     }
   }
-  // threeds in ransac, in inhomogeneous coordinates:
-  pf_threeds_ =
-      IAllocAligned<float>(param_.nr_samples_max_threshold * dim_point_, 4);
+  InitWavefronts();
+
+  // threeds in ransac, in inhomogeneous coordinates, one buffer per thread:
+  pf_threeds_ = IAllocAligned<float>(
+      param_.nr_samples_max_threshold * dim_point_ * param_.nr_threads, 4);
   if (!pf_threeds_) {
     return false;
   }
   memset(reinterpret_cast<void *>(pf_threeds_), 0,
-         param_.nr_samples_max_threshold * dim_point_ * sizeof(float));
+         param_.nr_samples_max_threshold * dim_point_ * param_.nr_threads *
+             sizeof(float));
   // labels:
   labels_ = IAllocAligned<char>(param_.nr_points_max, 4);
   if (!labels_) {
@@ -623,6 +673,7 @@ int PlaneFitGroundDetector::FitGrid(const float *point_cloud,
   if (candi->Size() < param_.nr_inliers_min_threshold) {
     return 0;
   }
+  float *threeds = GetThreeDs();
   GroundPlaneLiDAR plane;
   float ptp_dist = 0.0f;
   float fit_cost = 0.0f;
@@ -641,7 +692,7 @@ int PlaneFitGroundDetector::FitGrid(const float *point_cloud,
   float samples[9];
   // copy 3D points
   float *psrc = nullptr;
-  float *pdst = pf_threeds_;
+  float *pdst = threeds;
   for (i = 0; i < nr_samples; ++i) {
     assert((*candi)[i] < static_cast<int>(nr_points));
     ICopy3(point_cloud + (nr_point_element * (*candi)[i]), pdst);
@@ -651,9 +702,9 @@ int PlaneFitGroundDetector::FitGrid(const float *point_cloud,
   for (i = 0; i < param_.nr_ransac_iter_threshold; ++i) {
     IRandomSample(indices_trial, 3, nr_samples, &rseed);
     IScale3(indices_trial, dim_point_);
-    ICopy3(pf_threeds_ + indices_trial[0], samples);
-    ICopy3(pf_threeds_ + indices_trial[1], samples + 3);
-    ICopy3(pf_threeds_ + indices_trial[2], samples + 6);
+    ICopy3(threeds + indices_trial[0], samples);
+    ICopy3(threeds + indices_trial[1], samples + 3);
+    ICopy3(threeds + indices_trial[2], samples + 6);
     IPlaneFitDestroyed(samples, plane.params);
     // check if the plane hypothesis has valid geometry
     if (plane.GetDegreeNormalToZ() > param_.planefit_orien_threshold) {
@@ -661,7 +712,7 @@ int PlaneFitGroundDetector::FitGrid(const float *point_cloud,
     }
     // iterate samples and check if the point to plane distance is below
     // threshold
-    psrc = pf_threeds_;
+    psrc = threeds;
     nr_inliers = 0;
     fit_cost = 0;
     for (j = 0; j < nr_samples; ++j) {
@@ -708,8 +759,8 @@ int PlaneFitGroundDetector::FitGrid(const float *point_cloud,
   // iterate samples and check if the point to plane distance is within
   // threshold
   nr_inliers = 0;
-  psrc = pf_threeds_;
-  pdst = pf_threeds_;
+  psrc = threeds;
+  pdst = threeds;
   for (i = 0; i < nr_samples; ++i) {
     ptp_dist = IPlaneToPointDistanceWUnitNorm(groundplane->params, psrc);
     if (ptp_dist < dist_thre) {
@@ -720,8 +771,8 @@ int PlaneFitGroundDetector::FitGrid(const float *point_cloud,
     psrc += dim_point_;
   }
   groundplane->SetNrSupport(nr_inliers);
-  // note that pf_threeds_ will be destroyed after calling this routine
-  IPlaneFitTotalLeastSquare(pf_threeds_, groundplane->params, nr_inliers);
+  // note that threeds will be destroyed after calling this routine
+  IPlaneFitTotalLeastSquare(threeds, groundplane->params, nr_inliers);
   // filtering: the best plane orientation is not valid*/
   // std::cout << groundplane->GetDegreeNormalToZ() << std::endl;
   if (groundplane->GetDegreeNormalToZ() > param_.planefit_orien_threshold) {
@@ -754,7 +805,10 @@ int PlaneFitGroundDetector::FitLine(unsigned int r) {
 
 int PlaneFitGroundDetector::Fit() {
   int nr_grids = 0;
-  for (unsigned int r = 0; r < param_.nr_grids_coarse; ++r) {
+  const int rows = static_cast<int>(param_.nr_grids_coarse);
+#pragma omp parallel for num_threads(param_.nr_threads) schedule(dynamic) \
+    reduction(+ : nr_grids)
+  for (int r = 0; r < rows; ++r) {
     nr_grids += FitLine(r);
   }
   return nr_grids;
@@ -824,6 +878,7 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
   if (candi.Size() < param_.nr_inliers_min_threshold) {
     return 0;
   }
+  float *threeds = GetThreeDs();
 
   GroundPlaneLiDAR plane;
   int kNr_iter =
@@ -850,7 +905,7 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
   float samples[9];
   // copy 3D points
   float *psrc = nullptr;
-  float *pdst = pf_threeds_;
+  float *pdst = threeds;
   int r_n = 0;
   int c_n = 0;
   float angle = -1.f;
@@ -863,9 +918,9 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
   for (int i = 0; i < param_.nr_ransac_iter_threshold; ++i) {
     IRandomSample(indices_trial, 3, nr_samples, &rseed);
     IScale3(indices_trial, dim_point_);
-    ICopy3(pf_threeds_ + indices_trial[0], samples);
-    ICopy3(pf_threeds_ + indices_trial[1], samples + 3);
-    ICopy3(pf_threeds_ + indices_trial[2], samples + 6);
+    ICopy3(threeds + indices_trial[0], samples);
+    ICopy3(threeds + indices_trial[1], samples + 3);
+    ICopy3(threeds + indices_trial[2], samples + 6);
     IPlaneFitDestroyed(samples, hypothesis[i].params);
     // check if the plane hypothesis has valid geometry
     if (hypothesis[i].GetDegreeNormalToZ() > param_.planefit_orien_threshold) {
@@ -873,7 +928,7 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
     }
     // iterate samples and check if the point to plane distance is below
     // threshold
-    psrc = pf_threeds_;
+    psrc = threeds;
     nr_inliers = 0;
     for (int j = 0; j < nr_samples; ++j) {
       ptp_dist = IPlaneToPointDistanceWUnitNorm(hypothesis[i].params, psrc);
@@ -896,7 +951,7 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
     if (ground_planes_[r_n][c_n].IsValid()) {
       hypothesis[i + param_.nr_ransac_iter_threshold] =
           ground_planes_[r_n][c_n];
-      psrc = pf_threeds_;
+      psrc = threeds;
       nr_inliers = 0;
       for (int j = 0; j < nr_samples; ++j) {
         ptp_dist = IPlaneToPointDistanceWUnitNorm(
@@ -949,8 +1004,8 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
   // iterate samples and check if the point to plane distance is within
   // threshold
   nr_inliers = 0;
-  psrc = pf_threeds_;
-  pdst = pf_threeds_;
+  psrc = threeds;
+  pdst = threeds;
   for (int i = 0; i < nr_samples; ++i) {
     ptp_dist = IPlaneToPointDistanceWUnitNorm(groundplane->params, psrc);
     if (ptp_dist < dist_thre) {
@@ -962,8 +1017,8 @@ int PlaneFitGroundDetector::FitGridWithNeighbors(
   }
   groundplane->SetNrSupport(nr_inliers);
 
-  // note that pf_threeds_ will be destroyed after calling this routine
-  IPlaneFitTotalLeastSquare(pf_threeds_, groundplane->params, nr_inliers);
+  // note that threeds will be destroyed after calling this routine
+  IPlaneFitTotalLeastSquare(threeds, groundplane->params, nr_inliers);
   if (angle_best <= CalculateAngleDist(*groundplane, neighbors)) {
     *groundplane = hypothesis[best];
     groundplane->SetStatus(true);
@@ -1009,32 +1064,51 @@ float PlaneFitGroundDetector::CalculateAngleDist(
   return angle_dist / static_cast<float>(count);
 }
 
+int PlaneFitGroundDetector::FitGridInOrder(int r, int c) {
+  GroundPlaneLiDAR gp;
+  if (FitGridWithNeighbors(r, c, vg_coarse_->const_data(), &gp,
+                           vg_coarse_->NrPoints(), vg_coarse_->NrPointElement(),
+                           pf_thresholds_[r][c]) >=
+      static_cast<int>(param_.nr_inliers_min_threshold)) {
+    IPlaneEucliToSpher(gp, &ground_planes_sphe_[r][c]);
+    ground_planes_[r][c] = gp;
+    return 1;
+  }
+  ground_planes_sphe_[r][c].ForceInvalid();
+  ground_planes_[r][c].ForceInvalid();
+  return 0;
+}
+
 int PlaneFitGroundDetector::FitInOrder() {
   int nr_grids = 0;
   unsigned int i = 0;
   unsigned int j = 0;
-  int r = 0;
-  int c = 0;
-  GroundPlaneLiDAR gp;
   for (i = 0; i < param_.nr_grids_coarse; ++i) {
     for (j = 0; j < param_.nr_grids_coarse; ++j) {
       ground_z_[i][j].first = 0.f;
       ground_z_[i][j].second = false;
     }
   }
-  for (i = 0; i < vg_coarse_->NrVoxel(); ++i) {
-    r = order_table_[i].first;
-    c = order_table_[i].second;
-    if (FitGridWithNeighbors(
-            r, c, vg_coarse_->const_data(), &gp, vg_coarse_->NrPoints(),
-            vg_coarse_->NrPointElement(), pf_thresholds_[r][c]) >=
-        static_cast<int>(param_.nr_inliers_min_threshold)) {
-      IPlaneEucliToSpher(gp, &ground_planes_sphe_[r][c]);
-      ground_planes_[r][c] = gp;
-      nr_grids++;
-    } else {
-      ground_planes_sphe_[r][c].ForceInvalid();
-      ground_planes_[r][c].ForceInvalid();
+  if (param_.nr_threads <= 1) {
+    for (i = 0; i < vg_coarse_->NrVoxel(); ++i) {
+      nr_grids += FitGridInOrder(order_table_[i].first, order_table_[i].second);
+    }
+    return nr_grids;
+  }
+  // A cell reads the planes of its neighbors, fitted in this frame if they
+  // come earlier in the order table and left from the last frame otherwise.
+  // Fitting a wavefront after all earlier ones keeps both, so the planes are
+  // the same as in order. The ransac seeds are per cell as well.
+  const size_t nr_wavefronts = wavefront_begin_.size() - 1;
+#pragma omp parallel num_threads(param_.nr_threads) reduction(+ : nr_grids)
+  for (size_t w = 0; w < nr_wavefronts; ++w) {
+    const int begin = static_cast<int>(wavefront_begin_[w]);
+    const int end = static_cast<int>(wavefront_begin_[w + 1]);
+    // the implicit barrier finishes a wavefront before the next
+#pragma omp for schedule(dynamic)
+    for (int k = begin; k < end; ++k) {
+      nr_grids += FitGridInOrder(wavefront_cells_[k].first,
+                                 wavefront_cells_[k].second);
     }
   }
   return nr_grids;
@@ -1217,13 +1291,13 @@ int PlaneFitGroundDetector::Smooth() {
   int nr_grids = 0;
   unsigned int r = 0;
   unsigned int c = 0;
-  unsigned int nm1 = param_.nr_grids_coarse - 1;
+  const int nm1 = static_cast<int>(param_.nr_grids_coarse) - 1;
   assert(param_.nr_grids_coarse >= 2);
-  nr_grids += SmoothLine(0, 0, 1);
-  for (r = 1; r < nm1; ++r) {
-    nr_grids += SmoothLine(r - 1, r, r + 1);
+  // lines read the spherical planes and write the euclidean ones only
+#pragma omp parallel for num_threads(param_.nr_threads) reduction(+ : nr_grids)
+  for (int line = 0; line <= nm1; ++line) {
+    nr_grids += SmoothLine(IMax(line - 1, 0), line, IMin(line + 1, nm1));
   }
-  nr_grids += SmoothLine(nm1 - 1, nm1, nm1);
   for (r = 0; r < param_.nr_grids_coarse; ++r) {
     for (c = 0; c < param_.nr_grids_coarse; ++c) {
       IPlaneEucliToSpher(ground_planes_[r][c], &ground_planes_sphe_[r][c]);
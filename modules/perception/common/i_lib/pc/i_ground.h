@@ -189,6 +189,9 @@ struct PlaneFitGroundDetectorParam {
   float candidate_filter_threshold;
   int nr_ransac_iter_threshold;
   int nr_smooth_iter;
+  // Threads that fit and smooth grid cells, 1 to run serially. The planes do
+  // not depend on it.
+  int nr_threads;
 };
 
 struct PlaneFitPointCandIndices {
@@ -257,12 +260,15 @@ class PlaneFitGroundDetector : public BaseGroundDetector {
  protected:
   void CleanUp();
   void InitOrderTable(const VoxelGridXY<float> *vg, std::pair<int, int> *order);
+  void InitWavefronts();
+  float *GetThreeDs();
   int Fit();
   int FitLine(unsigned int r);
   int FitGrid(const float *point_cloud, PlaneFitPointCandIndices *candi,
               GroundPlaneLiDAR *groundplane, unsigned int nr_points,
               unsigned int nr_point_element, float dist_thre);
   int FitInOrder();
+  int FitGridInOrder(int r, int c);
   int FilterCandidates(int r, int c, const float *point_cloud,
                        PlaneFitPointCandIndices *candi,
                        std::vector<std::pair<int, int>> *neighbors,
@@ -320,6 +326,11 @@ class PlaneFitGroundDetector : public BaseGroundDetector {
   float *pf_threeds_;
   int *sampled_indices_;
   std::pair<int, int> *order_table_;
+  // order_table_ split into wavefronts: a cell comes after all its neighbors
+  // that precede it in order_table_, and the cells of a wavefront are not
+  // neighbors, so that they can be fitted concurrently.
+  std::vector<std::pair<int, int>> wavefront_cells_;
+  std::vector<unsigned int> wavefront_begin_;
 };
 
 }  // namespace common
@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Per-frame time of PlaneFitGroundDetector::Detect on a synthetic
+ * street scene for 1 to max_threads threads, with the grid settings of
+ * SpatioTemporalGroundDetector. The heights above ground of every thread
+ * count are checked against the serial ones.
+ *
+ * Usage: i_ground_benchmark [num_frames] [max_threads]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "modules/perception/common/i_lib/pc/i_ground.h"
+
+namespace {
+
+using apollo::perception::common::PlaneFitGroundDetector;
+using apollo::perception::common::PlaneFitGroundDetectorParam;
+
+constexpr unsigned int kNumPoints = 200000;
+
+// Ground rising along x, with buildings along the street and a few cars.
+void MockFrame(unsigned int seed, std::vector<float>* points) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> uniform(0.f, 1.f);
+  std::normal_distribution<float> noise(0.f, 0.02f);
+  points->resize(kNumPoints * 3);
+  for (unsigned int i = 0; i < kNumPoints; ++i) {
+    // denser near the sensor, as for a spinning lidar
+    const float range = 2.f + 100.f * uniform(gen) * uniform(gen);
+    const float azimuth = 2.f * static_cast<float>(M_PI) * uniform(gen);
+    const float x = range * std::cos(azimuth);
+    const float y = range * std::sin(azimuth);
+    float z = -1.9f + 0.03f * x + noise(gen);
+    if (std::abs(y) > 12.f && uniform(gen) < 0.5f) {
+      z += 10.f * uniform(gen);
+    } else if (std::fmod(std::abs(x), 15.f) < 4.f && std::abs(y) < 5.f &&
+               uniform(gen) < 0.3f) {
+      z += 1.5f * uniform(gen);
+    }
+    (*points)[i * 3] = x;
+    (*points)[i * 3 + 1] = y;
+    (*points)[i * 3 + 2] = z;
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int num_frames = argc > 1 ? std::atoi(argv[1]) : 20;
+  const int max_threads = argc > 2 ? std::atoi(argv[2]) : 8;
+  if (num_frames <= 0 || max_threads <= 0) {
+    fprintf(stderr, "Usage: %s [num_frames] [max_threads]\n", argv[0]);
+    return 1;
+  }
+
+  std::vector<std::vector<float>> frames(num_frames);
+  for (int i = 0; i < num_frames; ++i) {
+    MockFrame(static_cast<unsigned int>(i), &frames[i]);
+  }
+
+  printf("%u points, %d frames\n", kNumPoints, num_frames);
+  std::vector<std::vector<float>> serial_heights;
+  double serial_ms = 0.0;
+  for (int nr_threads = 1; nr_threads <= max_threads; nr_threads *= 2) {
+    // the settings of spatio_temporal_ground_detector.conf
+    PlaneFitGroundDetectorParam param;
+    param.roi_region_rad_x = 120.f;
+    param.roi_region_rad_y = 120.f;
+    param.roi_region_rad_z = 100.f;
+    param.nr_grids_coarse = 16;
+    param.nr_smooth_iter = 5;
+    param.nr_threads = nr_threads;
+    PlaneFitGroundDetector detector(param);
+    if (!detector.Init()) {
+      fprintf(stderr, "Failed to init the detector\n");
+      return 1;
+    }
+    std::vector<float> heights(kNumPoints);
+    double total_ms = 0.0;
+    for (int i = 0; i < num_frames; ++i) {
+      const auto start = std::chrono::steady_clock::now();
+      detector.Detect(frames[i].data(), heights.data(), kNumPoints, 3);
+      total_ms += std::chrono::duration<double, std::milli>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+      if (nr_threads == 1) {
+        serial_heights.push_back(heights);
+      } else if (heights != serial_heights[i]) {
+        fprintf(stderr, "Heights of frame %d differ with %d threads\n", i,
+                nr_threads);
+        return 1;
+      }
+    }
+    const double mean_ms = total_ms / num_frames;
+    if (nr_threads == 1) {
+      serial_ms = mean_ms;
+    }
+    printf("%2d threads: %.2f ms/frame, speedup %.2f\n", nr_threads, mean_ms,
+           serial_ms / mean_ms);
+  }
+  return 0;
+}
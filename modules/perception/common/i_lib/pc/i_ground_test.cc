@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/common/i_lib/pc/i_ground.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace common {
+
+namespace {
+
+// Sloped ground with noise and a few walls, as x, y, z triples.
+void MockPointCloud(unsigned int seed, unsigned int nr_points,
+                    std::vector<float> *points) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> xy(-70.f, 70.f);
+  std::uniform_real_distribution<float> noise(-0.03f, 0.03f);
+  std::uniform_real_distribution<float> height(0.f, 3.f);
+  points->resize(nr_points * 3);
+  for (unsigned int i = 0; i < nr_points; ++i) {
+    const float x = xy(gen);
+    const float y = xy(gen);
+    float z = -1.8f + 0.02f * x - 0.01f * y + noise(gen);
+    if (i % 5 == 0 && std::fmod(std::abs(x), 20.f) < 1.f) {
+      z += height(gen);
+    }
+    (*points)[i * 3] = x;
+    (*points)[i * 3 + 1] = y;
+    (*points)[i * 3 + 2] = z;
+  }
+}
+
+PlaneFitGroundDetectorParam MockParam(int nr_threads) {
+  PlaneFitGroundDetectorParam param;
+  param.roi_region_rad_x = 72.f;
+  param.roi_region_rad_y = 72.f;
+  param.nr_grids_coarse = 16;
+  param.nr_smooth_iter = 5;
+  param.nr_threads = nr_threads;
+  return param;
+}
+
+}  // namespace
+
+TEST(PlaneFitGroundDetectorTest, ParallelFitIsDeterministic) {
+  const PlaneFitGroundDetectorParam serial_param = MockParam(1);
+  const PlaneFitGroundDetectorParam parallel_param = MockParam(4);
+  PlaneFitGroundDetector serial(serial_param);
+  PlaneFitGroundDetector parallel(parallel_param);
+  ASSERT_TRUE(serial.Init());
+  ASSERT_TRUE(parallel.Init());
+
+  const unsigned int nr_points = 60000;
+  std::vector<float> points;
+  std::vector<float> serial_height(nr_points);
+  std::vector<float> parallel_height(nr_points);
+  // Several frames, as the planes of the last frame are used by the next.
+  for (unsigned int frame = 0; frame < 3; ++frame) {
+    MockPointCloud(frame, nr_points, &points);
+    ASSERT_TRUE(serial.Detect(points.data(), serial_height.data(), nr_points,
+                              3));
+    ASSERT_TRUE(parallel.Detect(points.data(), parallel_height.data(),
+                                nr_points, 3));
+    int nr_valid = 0;
+    for (unsigned int r = 0; r < serial.GetGridDimY(); ++r) {
+      for (unsigned int c = 0; c < serial.GetGridDimX(); ++c) {
+        const GroundPlaneLiDAR *expected = serial.GetGroundPlane(r, c);
+        const GroundPlaneLiDAR *actual = parallel.GetGroundPlane(r, c);
+        ASSERT_NE(expected, nullptr);
+        ASSERT_NE(actual, nullptr);
+        EXPECT_EQ(expected->IsValid(), actual->IsValid());
+        for (int k = 0; k < 4; ++k) {
+          EXPECT_EQ(expected->params[k], actual->params[k]);
+        }
+        nr_valid += expected->IsValid() ? 1 : 0;
+      }
+    }
+    EXPECT_GT(nr_valid, 0);
+    EXPECT_EQ(serial_height, parallel_height);
+  }
+}
+
+}  // namespace common
+}  // namespace perception
+}  // namespace apollo
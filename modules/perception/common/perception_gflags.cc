@@ -191,5 +191,15 @@ DEFINE_string(torch_detector_model,
 
 // lidar sensor name
 DEFINE_string(lidar_sensor_name, "velodyne128", "lidar sensor name");
+
+// fusion
+DEFINE_int32(fusion_association_num_threads, 1,
+             "Number of threads computing track object distances of the "
+             "fusion association, 1 to compute them serially.");
+
+// cpu inference
+DEFINE_int32(cpu_inference_batch_timeout_us, 0,
+             "Time the cpu inference backend waits for more requests to "
+             "batch with the first one, 0 to run the queued ones at once.");
 }  // namespace perception
 }  // namespace apollo
@@ -95,5 +95,11 @@ DECLARE_string(torch_detector_model);
 
 // lidar sensor name
 DECLARE_string(lidar_sensor_name);
+
+// fusion
+DECLARE_int32(fusion_association_num_threads);
+
+// cpu inference
+DECLARE_int32(cpu_inference_batch_timeout_us);
 }  // namespace perception
 }  // namespace apollo
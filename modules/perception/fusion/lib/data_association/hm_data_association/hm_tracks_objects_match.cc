@@ -15,11 +15,13 @@
  *****************************************************************************/
 #include "modules/perception/fusion/lib/data_association/hm_data_association/hm_tracks_objects_match.h"
 
+#include <algorithm>
 #include <map>
 #include <numeric>
 #include <utility>
 
 #include "modules/perception/common/graph/secure_matrix.h"
+#include "modules/perception/common/perception_gflags.h"
 
 namespace apollo {
 namespace perception {
@@ -32,6 +34,7 @@ double HMTrackersObjectsAssociation::s_match_distance_bound_ = 100.0;
  * is 2 times of ave error around 200m. */
 double HMTrackersObjectsAssociation::s_association_center_dist_threshold_ =
     30.0;
+size_t HMTrackersObjectsAssociation::s_min_parallel_pairs_ = 16;
 
 template <typename T>
 void extract_vector(const std::vector<T>& vec,
@@ -50,7 +53,7 @@ bool HMTrackersObjectsAssociation::Associate(
   const std::vector<SensorObjectPtr>& sensor_objects =
       sensor_measurements->GetForegroundObjects();
   const std::vector<TrackPtr>& fusion_tracks = scene->GetForegroundTracks();
-  std::vector<std::vector<double>> association_mat;
+  AssociationMat association_mat;
 
   if (fusion_tracks.empty() || sensor_objects.empty()) {
     association_result->unassigned_tracks.resize(fusion_tracks.size());
@@ -177,7 +180,7 @@ void HMTrackersObjectsAssociation::PostIdAssign(
 }
 
 bool HMTrackersObjectsAssociation::MinimizeAssignment(
-    const std::vector<std::vector<double>>& association_mat,
+    const AssociationMat& association_mat,
     const std::vector<size_t>& track_ind_l2g,
     const std::vector<size_t>& measurement_ind_l2g,
     std::vector<TrackMeasurmentPair>* assignments,
@@ -192,7 +195,7 @@ bool HMTrackersObjectsAssociation::MinimizeAssignment(
   global_costs->Resize(rows, cols);
   for (int r_i = 0; r_i < rows; r_i++) {
     for (int c_i = 0; c_i < cols; c_i++) {
-      (*global_costs)(r_i, c_i) = static_cast<float>(association_mat[r_i][c_i]);
+      (*global_costs)(r_i, c_i) = static_cast<float>(association_mat(r_i, c_i));
     }
   }
   std::vector<TrackMeasurmentPair> local_assignments;
@@ -224,7 +227,7 @@ void HMTrackersObjectsAssociation::ComputeDistance(
     const std::vector<int>& track_ind_g2l,
     const std::vector<int>& measurement_ind_g2l,
     const std::vector<size_t>& measurement_ind_l2g,
-    const std::vector<std::vector<double>>& association_mat,
+    const AssociationMat& association_mat,
     AssociationResult* association_result) {
   for (size_t i = 0; i < association_result->assignments.size(); ++i) {
     int track_ind = static_cast<int>(association_result->assignments[i].first);
@@ -234,22 +237,22 @@ void HMTrackersObjectsAssociation::ComputeDistance(
     int measurement_ind_loc = measurement_ind_g2l[measurement_ind];
     if (track_ind_loc >= 0 && measurement_ind_loc >= 0) {
       association_result->track2measurements_dist[track_ind] =
-          association_mat[track_ind_loc][measurement_ind_loc];
+          association_mat(track_ind_loc, measurement_ind_loc);
       association_result->measurement2track_dist[measurement_ind] =
-          association_mat[track_ind_loc][measurement_ind_loc];
+          association_mat(track_ind_loc, measurement_ind_loc);
     }
   }
   for (size_t i = 0; i < association_result->unassigned_tracks.size(); ++i) {
     int track_ind = static_cast<int>(unassigned_fusion_tracks[i]);
     int track_ind_loc = track_ind_g2l[track_ind];
     association_result->track2measurements_dist[track_ind] =
-        association_mat[track_ind_loc][0];
+        association_mat(track_ind_loc, 0);
     int min_m_loc = 0;
-    for (size_t j = 1; j < association_mat[track_ind_loc].size(); j++) {
+    for (size_t j = 1; j < static_cast<size_t>(association_mat.cols()); j++) {
       if (association_result->track2measurements_dist[track_ind] >
-          association_mat[track_ind_loc][j]) {
+          association_mat(track_ind_loc, j)) {
         association_result->track2measurements_dist[track_ind] =
-            association_mat[track_ind_loc][j];
+            association_mat(track_ind_loc, j);
         min_m_loc = static_cast<int>(j);
       }
     }
@@ -263,7 +266,7 @@ void HMTrackersObjectsAssociation::ComputeDistance(
       // just for return dist score, the dist score is
       // a similarity probability [0, 1] 1 is the best
       association_result->track2measurements_dist[track_ind] = 0.0;
-      for (size_t j = 0; j < association_mat[track_ind_loc].size(); ++j) {
+      for (size_t j = 0; j < static_cast<size_t>(association_mat.cols()); ++j) {
         double dist_score = 0.0;
         if (lidar_object != nullptr) {
           dist_score = track_object_distance_.ComputeLidarCameraSimilarity(
@@ -284,12 +287,12 @@ void HMTrackersObjectsAssociation::ComputeDistance(
         static_cast<int>(association_result->unassigned_measurements[i]);
     int m_ind_loc = measurement_ind_g2l[m_ind];
     association_result->measurement2track_dist[m_ind] =
-        association_mat[0][m_ind_loc];
-    for (size_t j = 1; j < association_mat.size(); j++) {
+        association_mat(0, m_ind_loc);
+    for (size_t j = 1; j < static_cast<size_t>(association_mat.rows()); j++) {
       if (association_result->measurement2track_dist[m_ind] >
-          association_mat[j][m_ind_loc]) {
+          association_mat(j, m_ind_loc)) {
         association_result->measurement2track_dist[m_ind] =
-            association_mat[j][m_ind_loc];
+            association_mat(j, m_ind_loc);
       }
     }
   }
@@ -301,28 +304,31 @@ void HMTrackersObjectsAssociation::ComputeAssociationDistanceMat(
     const Eigen::Vector3d& ref_point,
     const std::vector<size_t>& unassigned_tracks,
     const std::vector<size_t>& unassigned_measurements,
-    std::vector<std::vector<double>>* association_mat) {
+    AssociationMat* association_mat) {
   // if (sensor_objects.empty()) return;
   TrackObjectDistanceOptions opt;
   // TODO(linjian) ref_point
   Eigen::Vector3d tmp = Eigen::Vector3d::Zero();
   opt.ref_point = &tmp;
-  association_mat->resize(unassigned_tracks.size());
+  association_mat->setConstant(unassigned_tracks.size(),
+                               unassigned_measurements.size(),
+                               s_match_distance_thresh_);
+  // 1. gate pairs by center distance, pairs out of the gate keep the
+  // match threshold as distance
+  std::vector<std::pair<size_t, size_t>> gated_pairs;
+  gated_pairs.reserve(unassigned_tracks.size() *
+                      unassigned_measurements.size());
   for (size_t i = 0; i < unassigned_tracks.size(); ++i) {
-    size_t fusion_idx = unassigned_tracks[i];
-    (*association_mat)[i].resize(unassigned_measurements.size());
-    const TrackPtr& fusion_track = fusion_tracks[fusion_idx];
+    const TrackPtr& fusion_track = fusion_tracks[unassigned_tracks[i]];
+    const Eigen::Vector3d track_center =
+        fusion_track->GetFusedObject()->GetBaseObject()->center;
     for (size_t j = 0; j < unassigned_measurements.size(); ++j) {
-      size_t sensor_idx = unassigned_measurements[j];
-      const SensorObjectPtr& sensor_object = sensor_objects[sensor_idx];
-      double distance = s_match_distance_thresh_;
+      const SensorObjectPtr& sensor_object =
+          sensor_objects[unassigned_measurements[j]];
       double center_dist =
-          (sensor_object->GetBaseObject()->center -
-           fusion_track->GetFusedObject()->GetBaseObject()->center)
-              .norm();
+          (sensor_object->GetBaseObject()->center - track_center).norm();
       if (center_dist < s_association_center_dist_threshold_) {
-        distance =
-            track_object_distance_.Compute(fusion_track, sensor_object, opt);
+        gated_pairs.emplace_back(i, j);
       } else {
         ADEBUG << "center_distance " << center_dist
                << " exceeds slack threshold "
@@ -330,12 +336,29 @@ void HMTrackersObjectsAssociation::ComputeAssociationDistanceMat(
                << ", track_id: " << fusion_track->GetTrackId()
                << ", obs_id: " << sensor_object->GetBaseObject()->track_id;
       }
-      (*association_mat)[i][j] = distance;
-      ADEBUG << "track_id: " << fusion_track->GetTrackId()
-             << ", obs_id: " << sensor_object->GetBaseObject()->track_id
-             << ", distance: " << distance;
     }
   }
+  // 2. compute full distance of the pairs in the gate. each pair writes its
+  // own cell, the projection cache of track_object_distance_ is shared
+  const int num_pairs = static_cast<int>(gated_pairs.size());
+  const int num_threads = std::max(FLAGS_fusion_association_num_threads, 1);
+  const bool parallel =
+      num_threads > 1 && gated_pairs.size() >= s_min_parallel_pairs_;
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads) \
+    if (parallel)
+  for (int k = 0; k < num_pairs; ++k) {
+    const size_t i = gated_pairs[k].first;
+    const size_t j = gated_pairs[k].second;
+    const TrackPtr& fusion_track = fusion_tracks[unassigned_tracks[i]];
+    const SensorObjectPtr& sensor_object =
+        sensor_objects[unassigned_measurements[j]];
+    double distance =
+        track_object_distance_.Compute(fusion_track, sensor_object, opt);
+    (*association_mat)(i, j) = distance;
+    ADEBUG << "track_id: " << fusion_track->GetTrackId()
+           << ", obs_id: " << sensor_object->GetBaseObject()->track_id
+           << ", distance: " << distance;
+  }
 }
 
 void HMTrackersObjectsAssociation::IdAssign(
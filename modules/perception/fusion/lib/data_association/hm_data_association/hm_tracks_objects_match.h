@@ -18,6 +18,8 @@
 #include <string>
 #include <vector>
 
+#include "Eigen/Dense"
+
 #include "cyber/common/macros.h"
 #include "modules/perception/common/graph/gated_hungarian_bigraph_matcher.h"
 #include "modules/perception/fusion/lib/data_association/hm_data_association/track_object_distance.h"
@@ -29,6 +31,10 @@ namespace fusion {
 
 class HMTrackersObjectsAssociation : public BaseDataAssociation {
  public:
+  // distances of unassigned tracks (rows) to unassigned measurements (cols)
+  using AssociationMat =
+      Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
   HMTrackersObjectsAssociation() = default;
   ~HMTrackersObjectsAssociation() = default;
 
@@ -49,7 +55,7 @@ class HMTrackersObjectsAssociation : public BaseDataAssociation {
       const Eigen::Vector3d& ref_point,
       const std::vector<size_t>& unassigned_tracks,
       const std::vector<size_t>& unassigned_measurements,
-      std::vector<std::vector<double>>* association_mat);
+      AssociationMat* association_mat);
 
   void IdAssign(const std::vector<TrackPtr>& fusion_tracks,
                 const std::vector<SensorObjectPtr>& sensor_objects,
@@ -64,13 +70,12 @@ class HMTrackersObjectsAssociation : public BaseDataAssociation {
                     const std::vector<size_t>& unassigned_sensor_objects,
                     std::vector<TrackMeasurmentPair>* post_assignments);
 
-  bool MinimizeAssignment(
-      const std::vector<std::vector<double>>& association_mat,
-      const std::vector<size_t>& track_ind_l2g,
-      const std::vector<size_t>& measurement_ind_l2g,
-      std::vector<TrackMeasurmentPair>* assignments,
-      std::vector<size_t>* unassigned_tracks,
-      std::vector<size_t>* unassigned_measurements);
+  bool MinimizeAssignment(const AssociationMat& association_mat,
+                          const std::vector<size_t>& track_ind_l2g,
+                          const std::vector<size_t>& measurement_ind_l2g,
+                          std::vector<TrackMeasurmentPair>* assignments,
+                          std::vector<size_t>* unassigned_tracks,
+                          std::vector<size_t>* unassigned_measurements);
 
   void ComputeDistance(const std::vector<TrackPtr>& fusion_tracks,
                        const std::vector<SensorObjectPtr>& sensor_objects,
@@ -78,7 +83,7 @@ class HMTrackersObjectsAssociation : public BaseDataAssociation {
                        const std::vector<int>& track_ind_g2l,
                        const std::vector<int>& measurement_ind_g2l,
                        const std::vector<size_t>& measurement_ind_l2g,
-                       const std::vector<std::vector<double>>& association_mat,
+                       const AssociationMat& association_mat,
                        AssociationResult* association_result);
 
   void GenerateUnassignedData(
@@ -93,6 +98,8 @@ class HMTrackersObjectsAssociation : public BaseDataAssociation {
   static double s_match_distance_thresh_;
   static double s_match_distance_bound_;
   static double s_association_center_dist_threshold_;
+  // below it the gated pairs are not worth a parallel region
+  static size_t s_min_parallel_pairs_;
 
   DISALLOW_COPY_AND_ASSIGN(HMTrackersObjectsAssociation);
 };
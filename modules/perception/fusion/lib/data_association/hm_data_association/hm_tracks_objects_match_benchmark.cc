@@ -0,0 +1,150 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Per-frame time of HMTrackersObjectsAssociation::Associate on a
+ * synthetic dense traffic scene of lidar tracks against lidar measurements,
+ * for 1 to max_threads threads. The association results of every thread
+ * count are checked against the serial ones.
+ *
+ * Usage: hm_tracks_objects_match_benchmark [num_objects] [max_threads]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "modules/perception/common/perception_gflags.h"
+#include "modules/perception/fusion/base/scene.h"
+#include "modules/perception/fusion/base/sensor_frame.h"
+#include "modules/perception/fusion/base/track.h"
+#include "modules/perception/fusion/lib/data_association/hm_data_association/hm_tracks_objects_match.h"
+
+namespace {
+
+using apollo::perception::base::Frame;
+using apollo::perception::base::FramePtr;
+using apollo::perception::base::Object;
+using apollo::perception::base::ObjectPtr;
+using apollo::perception::base::SensorType;
+using apollo::perception::fusion::AssociationOptions;
+using apollo::perception::fusion::AssociationResult;
+using apollo::perception::fusion::HMTrackersObjectsAssociation;
+using apollo::perception::fusion::Scene;
+using apollo::perception::fusion::ScenePtr;
+using apollo::perception::fusion::SensorFrame;
+using apollo::perception::fusion::SensorFramePtr;
+using apollo::perception::fusion::Track;
+using apollo::perception::fusion::TrackPtr;
+
+constexpr int kNumFrames = 20;
+
+// A lidar frame of boxes on a 40m wide road ahead of and behind the car,
+// with a polygon of 16 points per object.
+SensorFramePtr MockFrame(unsigned int seed, double timestamp, int num_objects,
+                         int first_track_id) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> x(-100.0, 100.0);
+  std::uniform_real_distribution<double> y(-20.0, 20.0);
+  FramePtr frame(new Frame);
+  frame->sensor_info.name = "velodyne64";
+  frame->sensor_info.type = SensorType::VELODYNE_64;
+  frame->timestamp = timestamp;
+  frame->sensor2world_pose = Eigen::Affine3d::Identity();
+  for (int i = 0; i < num_objects; ++i) {
+    ObjectPtr object(new Object);
+    object->id = first_track_id + i;
+    object->track_id = first_track_id + i;
+    object->center = Eigen::Vector3d(x(gen), y(gen), 0.0);
+    object->anchor_point = object->center;
+    object->polygon.resize(16);
+    for (size_t k = 0; k < object->polygon.size(); ++k) {
+      const double angle = 2.0 * M_PI * static_cast<double>(k) / 16.0;
+      object->polygon[k].x = object->center.x() + 2.0 * std::cos(angle);
+      object->polygon[k].y = object->center.y() + 1.0 * std::sin(angle);
+      object->polygon[k].z = 0.0;
+    }
+    frame->objects.push_back(object);
+  }
+  return SensorFramePtr(new SensorFrame(frame));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int num_objects = argc > 1 ? std::atoi(argv[1]) : 200;
+  const int max_threads = argc > 2 ? std::atoi(argv[2]) : 8;
+  if (num_objects <= 0 || max_threads <= 0) {
+    fprintf(stderr, "Usage: %s [num_objects] [max_threads]\n", argv[0]);
+    return 1;
+  }
+
+  // the same objects as tracks and as measurements, with other track ids
+  ScenePtr scene(new Scene);
+  SensorFramePtr track_frame = MockFrame(0, 100.0, num_objects, 0);
+  for (const auto& object : track_frame->GetForegroundObjects()) {
+    TrackPtr track(new Track);
+    track->Initialize(object);
+    scene->AddForegroundTrack(track);
+  }
+  std::vector<SensorFramePtr> frames;
+  for (int i = 0; i < kNumFrames; ++i) {
+    frames.push_back(
+        MockFrame(i % 2, 100.1 + 0.1 * i, num_objects, num_objects));
+  }
+
+  printf("%d tracks, %d measurements, %d frames\n", num_objects, num_objects,
+         kNumFrames);
+  std::vector<AssociationResult> serial_results;
+  double serial_ms = 0.0;
+  for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    apollo::perception::FLAGS_fusion_association_num_threads = num_threads;
+    HMTrackersObjectsAssociation matcher;
+    matcher.Init();
+    double total_ms = 0.0;
+    for (int i = 0; i < kNumFrames; ++i) {
+      AssociationOptions options;
+      AssociationResult result;
+      const auto start = std::chrono::steady_clock::now();
+      matcher.Associate(options, frames[i], scene, &result);
+      total_ms += std::chrono::duration<double, std::milli>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+      if (num_threads == 1) {
+        serial_results.push_back(result);
+      } else if (result.assignments != serial_results[i].assignments ||
+                 result.track2measurements_dist !=
+                     serial_results[i].track2measurements_dist ||
+                 result.measurement2track_dist !=
+                     serial_results[i].measurement2track_dist) {
+        fprintf(stderr, "Association of frame %d differs with %d threads\n", i,
+                num_threads);
+        return 1;
+      }
+    }
+    const double mean_ms = total_ms / kNumFrames;
+    if (num_threads == 1) {
+      serial_ms = mean_ms;
+    }
+    printf("%2d threads: %.2f ms/frame, speedup %.2f\n", num_threads, mean_ms,
+           serial_ms / mean_ms);
+  }
+  return 0;
+}
@@ -0,0 +1,229 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/fusion/lib/data_association/hm_data_association/hm_tracks_objects_match.h"
+
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/perception/base/frame.h"
+#include "modules/perception/common/perception_gflags.h"
+#include "modules/perception/fusion/base/scene.h"
+#include "modules/perception/fusion/base/sensor_frame.h"
+#include "modules/perception/fusion/base/track.h"
+
+namespace apollo {
+namespace perception {
+namespace fusion {
+
+namespace {
+
+// A square footprint of half size 1m around center.
+base::ObjectPtr MockObject(const Eigen::Vector3d& center, int track_id) {
+  base::ObjectPtr object(new base::Object);
+  object->id = track_id;
+  object->track_id = track_id;
+  object->center = center;
+  object->anchor_point = center;
+  object->polygon.resize(4);
+  for (size_t i = 0; i < 4; ++i) {
+    object->polygon[i].x = center.x() + ((i & 1) ? 1.0 : -1.0);
+    object->polygon[i].y = center.y() + ((i & 2) ? 1.0 : -1.0);
+    object->polygon[i].z = center.z();
+  }
+  return object;
+}
+
+SensorFramePtr MockFrame(const std::string& sensor_name,
+                         base::SensorType sensor_type, double timestamp,
+                         const std::vector<Eigen::Vector3d>& centers,
+                         int first_track_id) {
+  base::FramePtr frame(new base::Frame);
+  frame->sensor_info.name = sensor_name;
+  frame->sensor_info.type = sensor_type;
+  frame->timestamp = timestamp;
+  frame->sensor2world_pose = Eigen::Affine3d::Identity();
+  for (size_t i = 0; i < centers.size(); ++i) {
+    frame->objects.push_back(
+        MockObject(centers[i], first_track_id + static_cast<int>(i)));
+  }
+  return SensorFramePtr(new SensorFrame(frame));
+}
+
+// Tracks spread over the road, measurements near most of them, with some
+// clutter, so that gating keeps only a part of the pairs.
+void MockScene(unsigned int seed, size_t num_tracks, size_t num_objects,
+               ScenePtr* scene, SensorFramePtr* lidar_frame,
+               SensorFramePtr* radar_frame) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> x(-80.0, 80.0);
+  std::uniform_real_distribution<double> y(-20.0, 20.0);
+  std::normal_distribution<double> noise(0.0, 0.8);
+  std::vector<Eigen::Vector3d> track_centers;
+  for (size_t i = 0; i < num_tracks; ++i) {
+    track_centers.emplace_back(x(gen), y(gen), 0.0);
+  }
+  std::vector<Eigen::Vector3d> object_centers;
+  for (size_t i = 0; i < num_objects; ++i) {
+    if (i % 4 == 3 || i >= num_tracks) {
+      object_centers.emplace_back(x(gen), y(gen), 0.0);
+    } else {
+      const Eigen::Vector3d& c = track_centers[(i * 7) % num_tracks];
+      object_centers.emplace_back(c.x() + noise(gen), c.y() + noise(gen), 0.0);
+    }
+  }
+
+  SensorFramePtr track_frame = MockFrame(
+      "velodyne64", base::SensorType::VELODYNE_64, 100.0, track_centers, 0);
+  scene->reset(new Scene);
+  for (const auto& object : track_frame->GetForegroundObjects()) {
+    TrackPtr track(new Track);
+    track->Initialize(object);
+    (*scene)->AddForegroundTrack(track);
+  }
+  // other track ids than the tracks, so that nothing is id assigned
+  *lidar_frame = MockFrame("velodyne64", base::SensorType::VELODYNE_64, 100.1,
+                           object_centers, 1000);
+  *radar_frame =
+      MockFrame("radar_rear", base::SensorType::LONG_RANGE_RADAR, 100.1,
+                object_centers, 2000);
+}
+
+HMTrackersObjectsAssociation::AssociationMat ComputeMat(
+    HMTrackersObjectsAssociation* matcher, const ScenePtr& scene,
+    const SensorFramePtr& frame) {
+  const std::vector<TrackPtr>& tracks = scene->GetForegroundTracks();
+  const std::vector<SensorObjectPtr>& objects = frame->GetForegroundObjects();
+  std::vector<size_t> unassigned_tracks(tracks.size());
+  std::vector<size_t> unassigned_objects(objects.size());
+  std::iota(unassigned_tracks.begin(), unassigned_tracks.end(), 0);
+  std::iota(unassigned_objects.begin(), unassigned_objects.end(), 0);
+  matcher->track_object_distance_.ResetProjectionCache(
+      objects[0]->GetSensorId(), objects[0]->GetTimestamp());
+  HMTrackersObjectsAssociation::AssociationMat mat;
+  matcher->ComputeAssociationDistanceMat(tracks, objects,
+                                         Eigen::Vector3d::Zero(),
+                                         unassigned_tracks, unassigned_objects,
+                                         &mat);
+  return mat;
+}
+
+}  // namespace
+
+class HMTrackersObjectsAssociationTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    num_threads_ = FLAGS_fusion_association_num_threads;
+  }
+  void TearDown() override {
+    FLAGS_fusion_association_num_threads = num_threads_;
+  }
+
+ private:
+  int num_threads_ = 1;
+};
+
+TEST_F(HMTrackersObjectsAssociationTest, DistanceMatMatchesPairwise) {
+  ScenePtr scene;
+  SensorFramePtr lidar_frame;
+  SensorFramePtr radar_frame;
+  MockScene(1, 40, 50, &scene, &lidar_frame, &radar_frame);
+  const std::vector<TrackPtr>& tracks = scene->GetForegroundTracks();
+
+  for (const SensorFramePtr& frame : {lidar_frame, radar_frame}) {
+    const std::vector<SensorObjectPtr>& objects =
+        frame->GetForegroundObjects();
+    // the computation before the gating pass, pair by pair
+    TrackObjectDistance distance;
+    distance.set_distance_thresh(static_cast<float>(
+        HMTrackersObjectsAssociation::s_match_distance_thresh_));
+    Eigen::Vector3d ref_point = Eigen::Vector3d::Zero();
+    TrackObjectDistanceOptions options;
+    options.ref_point = &ref_point;
+
+    for (int num_threads : {1, 4}) {
+      FLAGS_fusion_association_num_threads = num_threads;
+      HMTrackersObjectsAssociation matcher;
+      ASSERT_TRUE(matcher.Init());
+      const HMTrackersObjectsAssociation::AssociationMat mat =
+          ComputeMat(&matcher, scene, frame);
+      ASSERT_EQ(static_cast<int>(tracks.size()), mat.rows());
+      ASSERT_EQ(static_cast<int>(objects.size()), mat.cols());
+      size_t num_gated = 0;
+      for (size_t i = 0; i < tracks.size(); ++i) {
+        for (size_t j = 0; j < objects.size(); ++j) {
+          double expected =
+              HMTrackersObjectsAssociation::s_match_distance_thresh_;
+          const double center_dist =
+              (objects[j]->GetBaseObject()->center -
+               tracks[i]->GetFusedObject()->GetBaseObject()->center)
+                  .norm();
+          if (center_dist < HMTrackersObjectsAssociation::
+                                s_association_center_dist_threshold_) {
+            expected = distance.Compute(tracks[i], objects[j], options);
+            ++num_gated;
+          }
+          EXPECT_EQ(expected, mat(i, j)) << i << ", " << j;
+        }
+      }
+      EXPECT_GT(num_gated, HMTrackersObjectsAssociation::s_min_parallel_pairs_);
+      EXPECT_LT(num_gated, tracks.size() * objects.size());
+    }
+  }
+}
+
+TEST_F(HMTrackersObjectsAssociationTest, ParallelAssociationIsEquivalent) {
+  for (unsigned int seed = 0; seed < 5; ++seed) {
+    ScenePtr scene;
+    SensorFramePtr lidar_frame;
+    SensorFramePtr radar_frame;
+    MockScene(seed, 30 + 5 * seed, 36, &scene, &lidar_frame, &radar_frame);
+    for (const SensorFramePtr& frame : {lidar_frame, radar_frame}) {
+      AssociationOptions options;
+      AssociationResult serial_result;
+      AssociationResult parallel_result;
+
+      FLAGS_fusion_association_num_threads = 1;
+      HMTrackersObjectsAssociation serial;
+      ASSERT_TRUE(serial.Init());
+      ASSERT_TRUE(serial.Associate(options, frame, scene, &serial_result));
+
+      FLAGS_fusion_association_num_threads = 4;
+      HMTrackersObjectsAssociation parallel;
+      ASSERT_TRUE(parallel.Init());
+      ASSERT_TRUE(
+          parallel.Associate(options, frame, scene, &parallel_result));
+
+      EXPECT_FALSE(serial_result.assignments.empty());
+      EXPECT_EQ(serial_result.assignments, parallel_result.assignments);
+      EXPECT_EQ(serial_result.unassigned_tracks,
+                parallel_result.unassigned_tracks);
+      EXPECT_EQ(serial_result.unassigned_measurements,
+                parallel_result.unassigned_measurements);
+      EXPECT_EQ(serial_result.track2measurements_dist,
+                parallel_result.track2measurements_dist);
+      EXPECT_EQ(serial_result.measurement2track_dist,
+                parallel_result.measurement2track_dist);
+    }
+  }
+}
+
+}  // namespace fusion
+}  // namespace perception
+}  // namespace apollo
@@ -215,11 +215,9 @@ ProjectionCacheObject* TrackObjectDistance::BuildProjectionCacheObject(
   return cache_object;
 }
 
-ProjectionCacheObject* TrackObjectDistance::QueryProjectionCacheObject(
+ProjectionCacheObject* TrackObjectDistance::FindProjectionCacheObject(
     const SensorObjectConstPtr& lidar, const SensorObjectConstPtr& camera,
-    const base::BaseCameraModelPtr& camera_model,
     const bool measurement_is_lidar) {
-  // 1. try to query existed projection cache object
   const std::string& measurement_sensor_id =
       measurement_is_lidar ? lidar->GetSensorId() : camera->GetSensorId();
   const double measurement_timestamp =
@@ -229,17 +227,62 @@ ProjectionCacheObject* TrackObjectDistance::QueryProjectionCacheObject(
   const double projection_timestamp =
       measurement_is_lidar ? camera->GetTimestamp() : lidar->GetTimestamp();
   const int lidar_object_id = lidar->GetBaseObject()->id;
-  ProjectionCacheObject* cache_object = projection_cache_.QueryObject(
+  return projection_cache_.QueryObject(
       measurement_sensor_id, measurement_timestamp, projection_sensor_id,
       projection_timestamp, lidar_object_id);
+}
+
+ProjectionCacheObject* TrackObjectDistance::QueryProjectionCacheObject(
+    const SensorObjectConstPtr& lidar, const SensorObjectConstPtr& camera,
+    const base::BaseCameraModelPtr& camera_model,
+    const bool measurement_is_lidar) {
+  // 1. try to query existed projection cache object
+  ProjectionCacheObject* cache_object =
+      FindProjectionCacheObject(lidar, camera, measurement_is_lidar);
   if (cache_object != nullptr) {
     return cache_object;
   }  // 2. if query failed, build projection and cache it
+  const std::string& measurement_sensor_id =
+      measurement_is_lidar ? lidar->GetSensorId() : camera->GetSensorId();
+  const double measurement_timestamp =
+      measurement_is_lidar ? lidar->GetTimestamp() : camera->GetTimestamp();
+  const std::string& projection_sensor_id =
+      measurement_is_lidar ? camera->GetSensorId() : lidar->GetSensorId();
+  const double projection_timestamp =
+      measurement_is_lidar ? camera->GetTimestamp() : lidar->GetTimestamp();
   return BuildProjectionCacheObject(
       lidar, camera, camera_model, measurement_sensor_id, measurement_timestamp,
       projection_sensor_id, projection_timestamp);
 }
 
+bool TrackObjectDistance::QueryPtsBoxSimilarity(
+    const SensorObjectConstPtr& lidar, const SensorObjectConstPtr& camera,
+    const base::BaseCameraModelPtr& camera_model,
+    const bool measurement_is_lidar, double* similarity) {
+  const base::BBox2DF& camera_bbox =
+      camera->GetBaseObject()->camera_supplement.box;
+  {
+    std::shared_lock<std::shared_mutex> lock(projection_cache_mutex_);
+    const ProjectionCacheObject* cache_object =
+        FindProjectionCacheObject(lidar, camera, measurement_is_lidar);
+    if (cache_object != nullptr) {
+      *similarity = ComputePtsBoxSimilarity(&projection_cache_, cache_object,
+                                            camera_bbox);
+      return true;
+    }
+  }
+  // another thread may have built it in between, so query again
+  std::unique_lock<std::shared_mutex> lock(projection_cache_mutex_);
+  const ProjectionCacheObject* cache_object = QueryProjectionCacheObject(
+      lidar, camera, camera_model, measurement_is_lidar);
+  if (cache_object == nullptr) {
+    return false;
+  }
+  *similarity =
+      ComputePtsBoxSimilarity(&projection_cache_, cache_object, camera_bbox);
+  return true;
+}
+
 void TrackObjectDistance::QueryProjectedVeloCtOnCamera(
     const SensorObjectConstPtr& velodyne64, const SensorObjectConstPtr& camera,
     const Eigen::Matrix4d& lidar2camera_pose, Eigen::Vector3d* projected_ct) {
@@ -478,14 +521,12 @@ float TrackObjectDistance::ComputeLidarCamera(
   if (cloud.size() > 0) {
     // 2.1 if cloud is not empty, calculate distance according to pts box
     // similarity
-    ProjectionCacheObject* cache_object = QueryProjectionCacheObject(
-        lidar, camera, camera_model, measurement_is_lidar);
-    if (cache_object == nullptr) {
+    double similarity = 0.0;
+    if (!QueryPtsBoxSimilarity(lidar, camera, camera_model,
+                               measurement_is_lidar, &similarity)) {
       AERROR << "Failed to query projection cached object";
       return distance;
     }
-    double similarity =
-        ComputePtsBoxSimilarity(&projection_cache_, cache_object, camera_bbox);
     distance =
         distance_thresh_ * ((1.0f - static_cast<float>(similarity)) /
                             (1.0f - vc_similarity2distance_penalize_thresh_));
@@ -637,16 +678,9 @@ double TrackObjectDistance::ComputeLidarCameraSimilarity(
   // 2. compute similarity of camera vs. velodyne64 observation
   const base::PointFCloud& cloud =
       lidar->GetBaseObject()->lidar_supplement.cloud;
-  const base::BBox2DF& camera_bbox =
-      camera->GetBaseObject()->camera_supplement.box;
   if (cloud.size() > 0) {
-    ProjectionCacheObject* cache_object = QueryProjectionCacheObject(
-        lidar, camera, camera_model, measurement_is_lidar);
-    if (cache_object == nullptr) {
-      return similarity;
-    }
-    similarity =
-        ComputePtsBoxSimilarity(&projection_cache_, cache_object, camera_bbox);
+    QueryPtsBoxSimilarity(lidar, camera, camera_model, measurement_is_lidar,
+                          &similarity);
   }
   return similarity;
 }
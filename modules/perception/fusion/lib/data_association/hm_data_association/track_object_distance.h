@@ -15,6 +15,7 @@
  *****************************************************************************/
 #pragma once
 
+#include <shared_mutex>
 #include <string>
 
 #include "cyber/common/macros.h"
@@ -53,10 +54,13 @@ class TrackObjectDistance {
     distance_thresh_ = distance_thresh;
   }
   void ResetProjectionCache(std::string sensor_id, double timestamp) {
+    std::unique_lock<std::shared_mutex> lock(projection_cache_mutex_);
     projection_cache_.Reset(sensor_id, timestamp);
   }
 
   // @brief: compute the distance between input fused track and sensor object
+  // @NOTE: may be called from several threads at once for the same
+  // measurement frame, the projection cache is shared between them
   // @params [in] fused_track: maintained fused track
   // @params [in] sensor_object: sensor observation
   // @params [in] options: options of track object distanace computation
@@ -164,16 +168,29 @@ class TrackObjectDistance {
       const base::BaseCameraModelPtr& camera_model,
       const std::string& measurement_sensor_id, double measurement_timestamp,
       const std::string& projection_sensor_id, double projection_timestamp);
+  ProjectionCacheObject* FindProjectionCacheObject(
+      const SensorObjectConstPtr& lidar, const SensorObjectConstPtr& camera,
+      const bool measurement_is_lidar);
   ProjectionCacheObject* QueryProjectionCacheObject(
       const SensorObjectConstPtr& lidar, const SensorObjectConstPtr& camera,
       const base::BaseCameraModelPtr& camera_model,
       const bool measurement_is_lidar);
+  // @brief: compute the similarity between the cached projection of lidar
+  // cloud and the camera box, building the projection if not cached yet.
+  // Lookups share the cache lock, only a build holds it exclusively.
+  // @return false if the projection can not be built
+  bool QueryPtsBoxSimilarity(const SensorObjectConstPtr& lidar,
+                             const SensorObjectConstPtr& camera,
+                             const base::BaseCameraModelPtr& camera_model,
+                             const bool measurement_is_lidar,
+                             double* similarity);
   bool IsTrackIdConsistent(const SensorObjectConstPtr& object1,
                            const SensorObjectConstPtr& object2);
   bool LidarCameraCenterDistanceExceedDynamicThreshold(
       const SensorObjectConstPtr& lidar, const SensorObjectConstPtr& camera);
 
   ProjectionCache projection_cache_;
+  std::shared_mutex projection_cache_mutex_;
   float distance_thresh_ = 4.0f;
   const float vc_similarity2distance_penalize_thresh_ = 0.07f;
   const float vc_diff2distance_scale_factor_ = 0.8f;
@@ -16,6 +16,7 @@
 
 #include "modules/perception/inference/inference_factory.h"
 
+#include "modules/perception/inference/libtorch/torch_cpu_net.h"
 #include "modules/perception/inference/libtorch/torch_net.h"
 #include "modules/perception/inference/onnx/libtorch_obstacle_detector.h"
 #include "modules/perception/inference/paddlepaddle/paddle_net.h"
@@ -38,6 +39,8 @@ Inference *CreateInferenceByName(const std::string &name,
   } else if (name == "TorchNet") {
     // PyTorch just have model file, we use proto_file as model file
     return new TorchNet(proto_file, outputs, inputs);
+  } else if (name == "TorchCpuNet") {
+    return new TorchCpuNet(proto_file, outputs, inputs);
   } else if (name == "Obstacle") {
     return new ObstacleDetector(proto_file, weight_file, outputs, inputs);
   } else if (name == "PaddleNet") {
@@ -0,0 +1,233 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/inference/libtorch/torch_cpu_net.h"
+
+#include <ATen/Parallel.h>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <utility>
+
+#include "cyber/common/log.h"
+#include "modules/perception/common/perception_gflags.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+using apollo::perception::base::Blob;
+
+struct TorchCpuNet::SharedNet {
+  torch::jit::script::Module module;
+  // destroyed first, as its worker runs the module
+  std::unique_ptr<DynamicBatcher> batcher;
+};
+
+namespace {
+
+// whether the requests can be concatenated along the first axis
+bool SameSampleShapes(const DynamicBatcher::Request &a,
+                      const DynamicBatcher::Request &b) {
+  if (a.inputs.size() != b.inputs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.inputs.size(); ++i) {
+    const std::vector<int> &shape_a = a.inputs[i]->shape();
+    const std::vector<int> &shape_b = b.inputs[i]->shape();
+    if (shape_a.size() != shape_b.size() ||
+        !std::equal(shape_a.begin() + 1, shape_a.end(), shape_b.begin() + 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+TorchCpuNet::TorchCpuNet(const std::string &model_file,
+                         const std::vector<std::string> &outputs,
+                         const std::vector<std::string> &inputs)
+    : model_file_(model_file), output_names_(outputs), input_names_(inputs) {}
+
+bool TorchCpuNet::Init(const std::map<std::string, std::vector<int>> &shapes) {
+  // add blobs
+  request_.inputs.clear();
+  request_.outputs.clear();
+  for (const auto &name : input_names_) {
+    auto iter = shapes.find(name);
+    if (iter == shapes.end() || iter->second.empty()) {
+      AERROR << "No shape of input " << name;
+      return false;
+    }
+    auto blob = std::make_shared<Blob<float>>(iter->second);
+    blobs_.emplace(name, blob);
+    request_.inputs.push_back(blob);
+  }
+  for (const auto &name : output_names_) {
+    auto iter = shapes.find(name);
+    auto blob = iter == shapes.end()
+                    ? std::make_shared<Blob<float>>()
+                    : std::make_shared<Blob<float>>(iter->second);
+    blobs_.emplace(name, blob);
+    request_.outputs.push_back(blob);
+  }
+
+  net_ = GetSharedNet(model_file_, max_batch_size_);
+  return net_ != nullptr;
+}
+
+std::shared_ptr<TorchCpuNet::SharedNet> TorchCpuNet::GetSharedNet(
+    const std::string &model_file, int max_batch_size) {
+  static std::once_flag threads_flag;
+  std::call_once(threads_flag, []() {
+    // the batches are the parallelism across calls
+    try {
+      at::set_num_interop_threads(1);
+    } catch (const c10::Error &e) {
+      // torch has run inter-op work already in this process
+      AWARN << "Keeping the torch inter-op threads: " << e.what();
+    }
+  });
+
+  static std::mutex mutex;
+  static std::map<std::pair<std::string, int>, std::weak_ptr<SharedNet>> nets;
+  std::lock_guard<std::mutex> lock(mutex);
+  const auto key = std::make_pair(model_file, max_batch_size);
+  std::shared_ptr<SharedNet> net = nets[key].lock();
+  if (net != nullptr) {
+    return net;
+  }
+  net = std::make_shared<SharedNet>();
+  try {
+    net->module = torch::jit::load(model_file, torch::Device(torch::kCPU));
+  } catch (const c10::Error &e) {
+    AERROR << "Failed to load " << model_file << ": " << e.what();
+    return nullptr;
+  }
+  net->module.eval();
+  torch::jit::script::Module *module = &net->module;
+  net->batcher.reset(new DynamicBatcher(
+      max_batch_size, FLAGS_cpu_inference_batch_timeout_us,
+      [module](const std::vector<DynamicBatcher::Request *> &requests) {
+        // requests of other sample shapes run apart
+        bool success = true;
+        size_t begin = 0;
+        while (begin < requests.size()) {
+          size_t end = begin + 1;
+          while (end < requests.size() &&
+                 SameSampleShapes(*requests[begin], *requests[end])) {
+            ++end;
+          }
+          success &= Forward(
+              module, std::vector<DynamicBatcher::Request *>(
+                          requests.begin() + begin, requests.begin() + end));
+          begin = end;
+        }
+        return success;
+      }));
+  nets[key] = net;
+  AINFO << "Loaded " << model_file << " for cpu inference, max batch size "
+        << max_batch_size;
+  return net;
+}
+
+bool TorchCpuNet::Forward(
+    torch::jit::script::Module *module,
+    const std::vector<DynamicBatcher::Request *> &requests) {
+  torch::NoGradGuard no_grad;
+  // Get input data from blobs, concatenated along the batch axis.
+  std::vector<torch::jit::IValue> torch_inputs;
+  int64_t batch_size = 0;
+  for (const auto *request : requests) {
+    batch_size += request->batch_size;
+  }
+  for (size_t i = 0; i < requests[0]->inputs.size(); ++i) {
+    std::vector<torch::Tensor> parts;
+    for (const auto *request : requests) {
+      const auto &blob = request->inputs[i];
+      std::vector<int64_t> shape(blob->shape().begin(), blob->shape().end());
+      parts.push_back(torch::from_blob(blob->mutable_cpu_data(), shape,
+                                       torch::kFloat32));
+    }
+    torch_inputs.push_back(parts.size() == 1 ? parts[0]
+                                             : torch::cat(parts, 0));
+  }
+
+  // Infer
+  torch::jit::IValue result = module->forward(torch_inputs);
+  std::vector<torch::Tensor> outputs;
+  if (result.isTensor()) {
+    outputs.push_back(result.toTensor());
+  } else if (result.isTuple()) {
+    for (const auto &element : result.toTuple()->elements()) {
+      outputs.push_back(element.toTensor());
+    }
+  } else {
+    outputs = result.toTensorVector();
+  }
+
+  // Fill output, split along the batch axis
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    torch::Tensor output = outputs[i].to(torch::kFloat32);
+    if (output.dim() == 0 || output.size(0) != batch_size) {
+      AERROR << "Output " << i << " is not batched, first axis "
+             << (output.dim() == 0 ? 0 : output.size(0)) << " for batch "
+             << batch_size;
+      return false;
+    }
+    int64_t offset = 0;
+    for (auto *request : requests) {
+      const int64_t begin = offset;
+      offset += request->batch_size;
+      if (i >= request->outputs.size()) {
+        continue;
+      }
+      torch::Tensor part =
+          output.narrow(0, begin, request->batch_size).contiguous();
+      std::vector<int64_t> part_size = part.sizes().vec();
+      auto &blob = request->outputs[i];
+      blob->Reshape(std::vector<int>(part_size.begin(), part_size.end()));
+      memcpy(blob->mutable_cpu_data(), part.data_ptr<float>(),
+             part.numel() * sizeof(float));
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<Blob<float>> TorchCpuNet::get_blob(const std::string &name) {
+  auto iter = blobs_.find(name);
+  if (iter == blobs_.end()) {
+    return nullptr;
+  }
+  return iter->second;
+}
+
+void TorchCpuNet::Infer() {
+  if (net_ == nullptr) {
+    AERROR << "TorchCpuNet of " << model_file_ << " is not initialized";
+    return;
+  }
+  request_.batch_size = request_.inputs[0]->shape(0);
+  if (!net_->batcher->Run(&request_)) {
+    AERROR << "Failed to infer " << model_file_;
+  }
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <torch/script.h>
+#include <torch/torch.h>
+
+#include "modules/perception/inference/inference.h"
+#include "modules/perception/inference/utils/dynamic_batcher.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+// TorchScript network on cpu. The TorchCpuNet of the same model file and
+// max batch size share one network, which runs the Infer() calls made at
+// the same time, e.g. by the detectors of several cameras, as one batch of
+// at most max_batch_size_ samples. The intra-op threads are left to the
+// process wide torch settings.
+class TorchCpuNet : public Inference {
+ public:
+  using BlobPtr = std::shared_ptr<apollo::perception::base::Blob<float>>;
+
+ public:
+  TorchCpuNet(const std::string &model_file,
+              const std::vector<std::string> &outputs,
+              const std::vector<std::string> &inputs);
+
+  virtual ~TorchCpuNet() {}
+
+  bool Init(const std::map<std::string, std::vector<int>> &shapes) override;
+
+  // Blocks until the batch of this call has run.
+  void Infer() override;
+  BlobPtr get_blob(const std::string &name) override;
+
+ private:
+  struct SharedNet;
+
+  static std::shared_ptr<SharedNet> GetSharedNet(const std::string &model_file,
+                                                 int max_batch_size);
+  // runs requests of the same sample shapes as one forward
+  static bool Forward(
+      torch::jit::script::Module *module,
+      const std::vector<DynamicBatcher::Request *> &requests);
+
+  std::string model_file_;
+  std::vector<std::string> output_names_;
+  std::vector<std::string> input_names_;
+  BlobMap blobs_;
+
+  std::shared_ptr<SharedNet> net_;
+  DynamicBatcher::Request request_;
+};
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
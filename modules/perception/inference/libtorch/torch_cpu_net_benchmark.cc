@@ -0,0 +1,133 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Latency and throughput of TorchCpuNet for several cameras sharing
+ * one model. Each camera thread runs its own TorchCpuNet on a C x H x W
+ * image, for max batch sizes of 1 up to max_batch, where 1 runs the
+ * cameras one by one.
+ *
+ * Usage: torch_cpu_net_benchmark model_file input_name output_name C H W
+ *            [max_batch] [num_cameras]
+ *            [--cpu_inference_batch_timeout_us=2000]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "modules/perception/common/perception_gflags.h"
+#include "modules/perception/inference/libtorch/torch_cpu_net.h"
+
+namespace {
+
+using apollo::perception::inference::TorchCpuNet;
+
+constexpr int kWarmupFrames = 5;
+constexpr int kFrames = 50;
+
+bool RunCameras(const std::string &model_file, const std::string &input_name,
+                const std::string &output_name, const std::vector<int> &shape,
+                int max_batch_size, int num_cameras) {
+  std::vector<std::unique_ptr<TorchCpuNet>> nets;
+  for (int i = 0; i < num_cameras; ++i) {
+    nets.emplace_back(new TorchCpuNet(model_file, {output_name}, {input_name}));
+    nets.back()->set_max_batch_size(max_batch_size);
+    std::map<std::string, std::vector<int>> shapes = {{input_name, shape}};
+    if (!nets.back()->Init(shapes)) {
+      return false;
+    }
+    auto input = nets.back()->get_blob(input_name);
+    std::fill(input->mutable_cpu_data(),
+              input->mutable_cpu_data() + input->count(), 0.5f);
+  }
+
+  std::vector<std::vector<double>> latencies(num_cameras);
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> cameras;
+  for (int i = 0; i < num_cameras; ++i) {
+    cameras.emplace_back([&, i]() {
+      for (int frame = 0; frame < kWarmupFrames + kFrames; ++frame) {
+        const auto frame_start = std::chrono::steady_clock::now();
+        nets[i]->Infer();
+        if (frame >= kWarmupFrames) {
+          latencies[i].push_back(
+              std::chrono::duration<double, std::milli>(
+                  std::chrono::steady_clock::now() - frame_start)
+                  .count());
+        }
+      }
+    });
+  }
+  for (auto &camera : cameras) {
+    camera.join();
+  }
+  const double seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+
+  std::vector<double> all;
+  for (const auto &camera_latencies : latencies) {
+    all.insert(all.end(), camera_latencies.begin(), camera_latencies.end());
+  }
+  std::sort(all.begin(), all.end());
+  double mean = 0.0;
+  for (double latency : all) {
+    mean += latency;
+  }
+  mean /= static_cast<double>(all.size());
+  const double p99 = all[std::min(all.size() - 1, all.size() * 99 / 100)];
+  printf("%9d %11.2f %11.2f %12.1f\n", max_batch_size, mean, p99,
+         num_cameras * (kWarmupFrames + kFrames) / seconds);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  if (argc < 7) {
+    fprintf(stderr,
+            "Usage: %s model_file input_name output_name C H W "
+            "[max_batch] [num_cameras]\n",
+            argv[0]);
+    return 1;
+  }
+  const std::vector<int> shape = {1, atoi(argv[4]), atoi(argv[5]),
+                                  atoi(argv[6])};
+  const int max_batch = argc > 7 ? atoi(argv[7]) : 8;
+  const int num_cameras = argc > 8 ? atoi(argv[8]) : 4;
+
+  printf("%d cameras, batch timeout %d us\n", num_cameras,
+         FLAGS_cpu_inference_batch_timeout_us);
+  printf("max_batch mean_ms     p99_ms      frames/s\n");
+  for (int max_batch_size = 1; max_batch_size <= max_batch;
+       max_batch_size *= 2) {
+    if (!RunCameras(argv[1], argv[2], argv[3], shape, max_batch_size,
+                    num_cameras)) {
+      fprintf(stderr, "Failed to load %s\n", argv[1]);
+      return 1;
+    }
+  }
+  return 0;
+}
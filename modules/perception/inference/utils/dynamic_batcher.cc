@@ -0,0 +1,112 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/inference/utils/dynamic_batcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+DynamicBatcher::DynamicBatcher(int max_batch_size, int timeout_us,
+                               BatchFunc batch_func)
+    : max_batch_size_(std::max(max_batch_size, 1)),
+      timeout_us_(std::max(timeout_us, 0)),
+      batch_func_(std::move(batch_func)) {
+  worker_ = std::thread(&DynamicBatcher::Work, this);
+}
+
+DynamicBatcher::~DynamicBatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  queue_cv_.notify_all();
+  worker_.join();
+}
+
+bool DynamicBatcher::Run(Request *request) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  request->done = false;
+  request->success = false;
+  queue_.push_back(request);
+  queue_cv_.notify_one();
+  done_cv_.wait(lock, [request] { return request->done; });
+  return request->success;
+}
+
+bool DynamicBatcher::NextBatch(std::vector<Request *> *batch) {
+  batch->clear();
+  std::unique_lock<std::mutex> lock(mutex_);
+  queue_cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+  if (queue_.empty()) {
+    return false;
+  }
+  // a request larger than the batch runs alone
+  int batch_size = 0;
+  auto take = [&]() {
+    while (!queue_.empty() &&
+           (batch->empty() ||
+            batch_size + queue_.front()->batch_size <= max_batch_size_)) {
+      batch_size += queue_.front()->batch_size;
+      batch->push_back(queue_.front());
+      queue_.pop_front();
+    }
+  };
+  take();
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::microseconds(timeout_us_);
+  while (batch_size < max_batch_size_ && queue_.empty() && !stop_) {
+    if (!queue_cv_.wait_until(lock, deadline, [this] {
+          return stop_ || !queue_.empty();
+        })) {
+      break;
+    }
+    take();
+  }
+  return true;
+}
+
+void DynamicBatcher::Work() {
+  std::vector<Request *> batch;
+  while (NextBatch(&batch)) {
+    bool success = false;
+    try {
+      success = batch_func_(batch);
+    } catch (const std::exception &e) {
+      AERROR << "Failed to run a batch of " << batch.size()
+             << " requests: " << e.what();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (Request *request : batch) {
+        request->success = success;
+        request->done = true;
+      }
+    }
+    done_cv_.notify_all();
+  }
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,81 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "modules/perception/base/blob.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+// Runs the requests of concurrent callers of one network together, in
+// batches of at most max_batch_size samples, on a worker thread.
+class DynamicBatcher {
+ public:
+  struct Request {
+    // samples of the request, the first axis of its inputs
+    int batch_size = 1;
+    std::vector<std::shared_ptr<base::Blob<float>>> inputs;
+    std::vector<std::shared_ptr<base::Blob<float>>> outputs;
+    // false if the batch of the request failed
+    bool success = false;
+
+   private:
+    friend class DynamicBatcher;
+    bool done = false;
+  };
+  // Runs a batch, the inputs of the requests concatenated along the first
+  // axis, and fills the outputs of each request. Returns false on failure.
+  using BatchFunc = std::function<bool(const std::vector<Request *> &)>;
+
+  // @param timeout_us: time to wait for more requests after the first one
+  // of a batch, 0 to batch only the requests already queued
+  DynamicBatcher(int max_batch_size, int timeout_us, BatchFunc batch_func);
+  ~DynamicBatcher();
+
+  // Blocks until the batch of the request has run.
+  bool Run(Request *request);
+
+  int max_batch_size() const { return max_batch_size_; }
+
+ private:
+  void Work();
+  // takes the requests of the next batch, false when stopped
+  bool NextBatch(std::vector<Request *> *batch);
+
+  const int max_batch_size_;
+  const int timeout_us_;
+  BatchFunc batch_func_;
+
+  std::mutex mutex_;
+  std::condition_variable queue_cv_;
+  std::condition_variable done_cv_;
+  std::deque<Request *> queue_;
+  bool stop_ = false;
+  std::thread worker_;
+};
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,145 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/inference/utils/dynamic_batcher.h"
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace inference {
+
+namespace {
+
+using Request = DynamicBatcher::Request;
+
+// Doubles the input of every request, recording the batch sizes.
+class DoubleBatchFunc {
+ public:
+  bool operator()(const std::vector<Request *> &requests) {
+    int batch_size = 0;
+    for (Request *request : requests) {
+      const base::Blob<float> &input = *request->inputs[0];
+      base::Blob<float> *output = request->outputs[0].get();
+      output->Reshape(input.shape());
+      for (int i = 0; i < input.count(); ++i) {
+        output->mutable_cpu_data()[i] = 2.f * input.cpu_data()[i];
+      }
+      batch_size += request->batch_size;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    batch_sizes_.push_back(batch_size);
+    return true;
+  }
+  std::vector<int> batch_sizes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return batch_sizes_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<int> batch_sizes_;
+};
+
+Request MockRequest(int batch_size, float value) {
+  Request request;
+  request.batch_size = batch_size;
+  request.inputs.emplace_back(
+      new base::Blob<float>(std::vector<int>{batch_size, 3}));
+  request.outputs.emplace_back(new base::Blob<float>());
+  for (int i = 0; i < request.inputs[0]->count(); ++i) {
+    request.inputs[0]->mutable_cpu_data()[i] = value;
+  }
+  return request;
+}
+
+}  // namespace
+
+TEST(DynamicBatcherTest, RunsSerialRequests) {
+  DoubleBatchFunc func;
+  DynamicBatcher batcher(4, 0, std::ref(func));
+  for (int i = 0; i < 3; ++i) {
+    Request request = MockRequest(1, static_cast<float>(i));
+    EXPECT_TRUE(batcher.Run(&request));
+    ASSERT_EQ(request.outputs[0]->count(), 3);
+    EXPECT_EQ(request.outputs[0]->cpu_data()[0], 2.f * static_cast<float>(i));
+  }
+  EXPECT_EQ(func.batch_sizes(), std::vector<int>(3, 1));
+}
+
+TEST(DynamicBatcherTest, BatchesConcurrentRequests) {
+  DoubleBatchFunc func;
+  // long enough for all the callers to queue
+  DynamicBatcher batcher(4, 200000, std::ref(func));
+  const int kCallerNum = 8;
+  std::vector<Request> requests;
+  for (int i = 0; i < kCallerNum; ++i) {
+    requests.push_back(MockRequest(1, static_cast<float>(i)));
+  }
+  std::vector<std::thread> callers;
+  std::vector<int> success(kCallerNum, 0);
+  for (int i = 0; i < kCallerNum; ++i) {
+    callers.emplace_back([&, i]() { success[i] = batcher.Run(&requests[i]); });
+  }
+  for (auto &caller : callers) {
+    caller.join();
+  }
+  int total = 0;
+  int max_batch_size = 0;
+  for (int batch_size : func.batch_sizes()) {
+    EXPECT_LE(batch_size, 4);
+    total += batch_size;
+    max_batch_size = std::max(max_batch_size, batch_size);
+  }
+  EXPECT_EQ(total, kCallerNum);
+  EXPECT_GT(max_batch_size, 1);
+  for (int i = 0; i < kCallerNum; ++i) {
+    EXPECT_TRUE(success[i]);
+    EXPECT_EQ(requests[i].outputs[0]->cpu_data()[2],
+              2.f * static_cast<float>(i));
+  }
+}
+
+TEST(DynamicBatcherTest, RunsLargeRequestAlone) {
+  DoubleBatchFunc func;
+  DynamicBatcher batcher(2, 0, std::ref(func));
+  Request request = MockRequest(5, 1.f);
+  EXPECT_TRUE(batcher.Run(&request));
+  EXPECT_EQ(request.outputs[0]->count(), 15);
+  EXPECT_EQ(func.batch_sizes(), std::vector<int>(1, 5));
+}
+
+TEST(DynamicBatcherTest, ReportsFailure) {
+  DynamicBatcher batcher(4, 0, [](const std::vector<Request *> &) -> bool {
+    throw std::runtime_error("no model");
+  });
+  Request request = MockRequest(1, 1.f);
+  EXPECT_FALSE(batcher.Run(&request));
+  DynamicBatcher failing(4, 0,
+                         [](const std::vector<Request *> &) { return false; });
+  EXPECT_FALSE(failing.Run(&request));
+}
+
+}  // namespace inference
+}  // namespace perception
+}  // namespace apollo
@@ -140,6 +140,7 @@ bool CNNSegmentation::Init(const LidarDetectorInitOptions& options) {
   st_feature_param.use_intensity_feature =
       feature_param.use_intensity_feature();
   st_feature_param.use_constant_feature = feature_param.use_constant_feature();
+  st_feature_param.num_threads = feature_param.num_threads();
   ACHECK(feature_generator_->Init(st_feature_param, feature_blob_.get()))
       << "Failed to init feature generator.";
 
@@ -255,6 +256,7 @@ bool CNNSegmentation::Init(const StageConfig& stage_config) {
   st_feature_param.use_intensity_feature =
       feature_param.use_intensity_feature();
   st_feature_param.use_constant_feature = feature_param.use_constant_feature();
+  st_feature_param.num_threads = feature_param.num_threads();
   ACHECK(feature_generator_->Init(st_feature_param, feature_blob_.get()))
       << "Failed to init feature generator.";
 
@@ -15,6 +15,9 @@
  *****************************************************************************/
 #include "modules/perception/lidar/lib/detector/cnn_segmentation/feature_generator.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <limits>
 #include <vector>
 
@@ -40,6 +43,7 @@ bool FeatureGenerator::Init(const StFeatureParam& feature_param,
       << "Current implementation version requires input_width == input_height.";
   use_intensity_feature_ = feature_param.use_intensity_feature;
   use_constant_feature_ = feature_param.use_constant_feature;
+  num_threads_ = std::max(feature_param.num_threads, 1);
 
   // set log lookup table
   log_table_.resize(kMaxLogNum);
@@ -120,18 +124,14 @@ void FeatureGenerator::GenerateCPU(const base::PointFCloudPtr& pc_ptr,
   // It marks the head at cpu for blob.
   out_blob_->mutable_cpu_data();
 
+  if (num_threads_ > 1) {
+    GenerateCPUParallel(pc_ptr, point2grid);
+    return;
+  }
+
   // fill initial value for feature blob
   const int map_size = height_ * width_;
-  for (int i = 0; i < map_size; ++i) {
-    max_height_data_[i] = -5.f;
-  }
-  memset(mean_height_data_, 0, map_size * sizeof(float));
-  memset(count_data_, 0, map_size * sizeof(float));
-  memset(nonempty_data_, 0, map_size * sizeof(float));
-  if (use_intensity_feature_) {
-    memset(top_intensity_data_, 0, map_size * sizeof(float));
-    memset(mean_intensity_data_, 0, map_size * sizeof(float));
-  }
+  ResetCells(0, map_size);
 
   // compute features
   for (size_t i = 0; i < pc_ptr->size(); ++i) {
@@ -140,31 +140,129 @@ void FeatureGenerator::GenerateCPU(const base::PointFCloudPtr& pc_ptr,
       continue;
     }
     const auto& pt = pc_ptr->at(i);
-    float pz = pt.z;
-    float pi = pt.intensity / 255.0f;
-    if (max_height_data_[idx] < pz) {
-      max_height_data_[idx] = pz;
-      if (use_intensity_feature_) {
-        top_intensity_data_[idx] = pi;
+    AddPoint(idx, pt.z, pt.intensity / 255.0f);
+  }
+
+  FinalizeCells(0, map_size);
+}
+
+void FeatureGenerator::GenerateCPUParallel(const base::PointFCloudPtr& pc_ptr,
+                                           const std::vector<int>& point2grid) {
+  const int map_size = height_ * width_;
+  const int num_points = static_cast<int>(pc_ptr->size());
+  // as many point chunks as bands, whatever threads omp gives
+  const int num_bands = num_threads_;
+  const int band_size = (map_size + num_bands - 1) / num_bands;
+  band_offsets_.assign(num_bands * num_bands, 0);
+  band_begins_.resize(num_bands + 1);
+  band_points_.resize(num_points);
+
+#pragma omp parallel num_threads(num_threads_)
+  {
+    // count the points of each chunk in each band
+#pragma omp for schedule(static)
+    for (int chunk = 0; chunk < num_bands; ++chunk) {
+      int* counts = &band_offsets_[chunk * num_bands];
+      const int end = static_cast<int>(
+          static_cast<int64_t>(num_points) * (chunk + 1) / num_bands);
+      for (int i = static_cast<int>(static_cast<int64_t>(num_points) * chunk /
+                                    num_bands);
+           i < end; ++i) {
+        if (point2grid[i] != -1) {
+          ++counts[point2grid[i] / band_size];
+        }
       }
     }
-    mean_height_data_[idx] += static_cast<float>(pz);
-    if (use_intensity_feature_) {
-      mean_intensity_data_[idx] += static_cast<float>(pi);
+
+    // band by band, then chunk by chunk, so the points keep their order
+#pragma omp single
+    {
+      int offset = 0;
+      for (int band = 0; band < num_bands; ++band) {
+        band_begins_[band] = offset;
+        for (int chunk = 0; chunk < num_bands; ++chunk) {
+          int& count = band_offsets_[chunk * num_bands + band];
+          const int band_count = count;
+          count = offset;
+          offset += band_count;
+        }
+      }
+      band_begins_[num_bands] = offset;
     }
-    count_data_[idx] += 1.f;
-  }
 
-  for (int i = 0; i < map_size; ++i) {
-    if (count_data_[i] <= std::numeric_limits<float>::epsilon()) {
-      max_height_data_[i] = 0.f;
-    } else {
-      mean_height_data_[i] /= count_data_[i];
-      if (use_intensity_feature_) {
-        mean_intensity_data_[i] /= count_data_[i];
+#pragma omp for schedule(static)
+    for (int chunk = 0; chunk < num_bands; ++chunk) {
+      int* offsets = &band_offsets_[chunk * num_bands];
+      const int end = static_cast<int>(
+          static_cast<int64_t>(num_points) * (chunk + 1) / num_bands);
+      for (int i = static_cast<int>(static_cast<int64_t>(num_points) * chunk /
+                                    num_bands);
+           i < end; ++i) {
+        const int idx = point2grid[i];
+        if (idx == -1) {
+          continue;
+        }
+        const auto& pt = pc_ptr->at(i);
+        band_points_[offsets[idx / band_size]++] = {idx, pt.z,
+                                                    pt.intensity / 255.0f};
       }
-      nonempty_data_[i] = 1.f;
     }
+
+    // compute features
+#pragma omp for schedule(static)
+    for (int band = 0; band < num_bands; ++band) {
+      const int begin = std::min(band * band_size, map_size);
+      const int end = std::min(begin + band_size, map_size);
+      ResetCells(begin, end);
+      for (int i = band_begins_[band]; i < band_begins_[band + 1]; ++i) {
+        const GridPoint& point = band_points_[i];
+        AddPoint(point.idx, point.z, point.intensity);
+      }
+      FinalizeCells(begin, end);
+    }
+  }
+}
+
+void FeatureGenerator::ResetCells(int begin, int end) {
+  const size_t size = (end - begin) * sizeof(float);
+  std::fill(max_height_data_ + begin, max_height_data_ + end, -5.f);
+  memset(mean_height_data_ + begin, 0, size);
+  memset(count_data_ + begin, 0, size);
+  if (use_intensity_feature_) {
+    memset(top_intensity_data_ + begin, 0, size);
+    memset(mean_intensity_data_ + begin, 0, size);
+  }
+}
+
+void FeatureGenerator::FinalizeCells(int begin, int end) {
+  // Selects by masks and arithmetic, as float selects do not vectorize. The
+  // sums of empty cells are 0, and stay 0 divided by 1.
+  const float epsilon = std::numeric_limits<float>::epsilon();
+  const float* __restrict count_data = count_data_;
+  float* __restrict max_height_data = max_height_data_;
+  float* __restrict mean_height_data = mean_height_data_;
+  float* __restrict nonempty_data = nonempty_data_;
+#pragma omp simd
+  for (int i = begin; i < end; ++i) {
+    const float count = count_data[i];
+    const float nonempty = static_cast<float>(count > epsilon);
+    const int32_t mask = -static_cast<int32_t>(count > epsilon);
+    int32_t max_height_bits;
+    memcpy(&max_height_bits, &max_height_data[i], sizeof(max_height_bits));
+    max_height_bits &= mask;
+    memcpy(&max_height_data[i], &max_height_bits, sizeof(max_height_bits));
+    mean_height_data[i] /= count + (1.f - nonempty);
+    nonempty_data[i] = nonempty;
+  }
+  if (use_intensity_feature_) {
+    float* __restrict mean_intensity_data = mean_intensity_data_;
+#pragma omp simd
+    for (int i = begin; i < end; ++i) {
+      const float nonempty = static_cast<float>(count_data[i] > epsilon);
+      mean_intensity_data[i] /= count_data[i] + (1.f - nonempty);
+    }
+  }
+  for (int i = begin; i < end; ++i) {
     count_data_[i] = LogCount(static_cast<int>(count_data_[i]));
   }
 }
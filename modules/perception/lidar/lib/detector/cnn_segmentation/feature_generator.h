@@ -38,6 +38,9 @@ struct StFeatureParam {
 
   bool use_intensity_feature = true;
   bool use_constant_feature = true;
+
+  // threads of GenerateCPU, 1 for the serial loop
+  int num_threads = 1;
 };
 
 class FeatureGenerator {
@@ -79,6 +82,27 @@ class FeatureGenerator {
 #endif
   void GenerateCPU(const base::PointFCloudPtr& pc_ptr,
                    const std::vector<int>& point2grid);
+  // Splits the map into row bands of a thread each. The points of each band
+  // keep their order, so the features are the same as the serial ones.
+  void GenerateCPUParallel(const base::PointFCloudPtr& pc_ptr,
+                           const std::vector<int>& point2grid);
+
+  // feature computation of the cells in [begin, end)
+  void ResetCells(int begin, int end);
+  void AddPoint(int idx, float pz, float pi) {
+    if (max_height_data_[idx] < pz) {
+      max_height_data_[idx] = pz;
+      if (use_intensity_feature_) {
+        top_intensity_data_[idx] = pi;
+      }
+    }
+    mean_height_data_[idx] += pz;
+    if (use_intensity_feature_) {
+      mean_intensity_data_[idx] += pi;
+    }
+    count_data_[idx] += 1.f;
+  }
+  void FinalizeCells(int begin, int end);
 
   float LogCount(int count) {
     if (count < static_cast<int>(log_table_.size())) {
@@ -101,6 +125,7 @@ class FeatureGenerator {
   float max_height_ = 0.0f;
   bool use_intensity_feature_ = false;
   bool use_constant_feature_ = false;
+  int num_threads_ = 1;
 
   // raw feature data
   float* max_height_data_ = nullptr;
@@ -115,6 +140,18 @@ class FeatureGenerator {
   // 1-d index in feature map of each point
   std::vector<int> map_idx_;
 
+  // points sorted by band for GenerateCPUParallel
+  struct GridPoint {
+    int idx;
+    float z;
+    float intensity;
+  };
+  std::vector<GridPoint> band_points_;
+  // point count, then first position, of each [chunk][band]
+  std::vector<int> band_offsets_;
+  // first position of each band, and the end
+  std::vector<int> band_begins_;
+
   // output feature blob
   base::Blob<float>* out_blob_ = nullptr;
 
@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/perception/lidar/lib/detector/cnn_segmentation/feature_generator.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+namespace {
+
+// channels of the blob without constant features
+int NumChannels(bool use_intensity_feature) {
+  return use_intensity_feature ? 6 : 4;
+}
+
+std::vector<float> GenerateFeatures(const base::PointFCloudPtr& pc_ptr,
+                                    const std::vector<int>& point2grid,
+                                    int size, bool use_intensity_feature,
+                                    int num_threads) {
+  StFeatureParam param;
+  param.width = size;
+  param.height = size;
+  param.use_intensity_feature = use_intensity_feature;
+  param.use_constant_feature = false;
+  param.num_threads = num_threads;
+  base::Blob<float> blob(1, NumChannels(use_intensity_feature), size, size);
+  FeatureGenerator generator;
+  EXPECT_TRUE(generator.Init(param, &blob));
+  // twice, to check that the cells of the last frame are reset
+  generator.Generate(pc_ptr, point2grid);
+  generator.Generate(pc_ptr, point2grid);
+  return std::vector<float>(blob.cpu_data(), blob.cpu_data() + blob.count());
+}
+
+}  // namespace
+
+TEST(FeatureGeneratorCPUTest, cell_features) {
+  base::PointFCloudPtr pc_ptr(new base::PointFCloud);
+  base::PointF pt;
+  pt.z = 1.f;
+  pt.intensity = 51.f;
+  pc_ptr->push_back(pt);
+  pt.z = 3.f;
+  pt.intensity = 102.f;
+  pc_ptr->push_back(pt);
+  pc_ptr->push_back(pt);
+  const std::vector<int> point2grid = {5, 5, -1};
+
+  for (int num_threads : {1, 4}) {
+    std::vector<float> features =
+        GenerateFeatures(pc_ptr, point2grid, 4, true, num_threads);
+    const int map_size = 16;
+    // max height, mean height, count, top intensity, mean intensity, nonempty
+    EXPECT_FLOAT_EQ(features[5], 3.f);
+    EXPECT_FLOAT_EQ(features[map_size + 5], 2.f);
+    EXPECT_FLOAT_EQ(features[2 * map_size + 5], std::log(3.f));
+    EXPECT_FLOAT_EQ(features[3 * map_size + 5], 0.4f);
+    EXPECT_FLOAT_EQ(features[4 * map_size + 5], 0.3f);
+    EXPECT_FLOAT_EQ(features[5 * map_size + 5], 1.f);
+    // empty cell
+    for (int channel = 0; channel < 6; ++channel) {
+      EXPECT_EQ(features[channel * map_size + 6], 0.f);
+    }
+  }
+}
+
+TEST(FeatureGeneratorCPUTest, parallel_is_identical) {
+  const int size = 64;
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> z_dist(-5.f, 5.f);
+  std::uniform_real_distribution<float> intensity_dist(0.f, 255.f);
+  // a few cells hold most of the points, as around the car
+  std::uniform_int_distribution<int> cell_dist(-1, size * size - 1);
+  std::uniform_int_distribution<int> dense_dist(size * 10, size * 10 + 7);
+  base::PointFCloudPtr pc_ptr(new base::PointFCloud);
+  std::vector<int> point2grid;
+  for (int i = 0; i < 50000; ++i) {
+    base::PointF pt;
+    pt.z = z_dist(rng);
+    pt.intensity = intensity_dist(rng);
+    pc_ptr->push_back(pt);
+    point2grid.push_back(i % 3 == 0 ? dense_dist(rng) : cell_dist(rng));
+  }
+
+  for (bool use_intensity_feature : {true, false}) {
+    const std::vector<float> serial = GenerateFeatures(
+        pc_ptr, point2grid, size, use_intensity_feature, 1);
+    for (int num_threads : {2, 3, 4, 7}) {
+      const std::vector<float> parallel = GenerateFeatures(
+          pc_ptr, point2grid, size, use_intensity_feature, num_threads);
+      ASSERT_EQ(serial.size(), parallel.size());
+      EXPECT_EQ(memcmp(serial.data(), parallel.data(),
+                       serial.size() * sizeof(float)),
+                0)
+          << "num_threads " << num_threads;
+    }
+  }
+}
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
@@ -34,6 +34,10 @@ struct BipartiteGraphMatcherInitOptions {};
 struct BipartiteGraphMatcherOptions {
   float cost_thresh = 4.0f;
   float bound_value = 100.0f;
+  // pairs of the cost matrix that may cost less than cost_thresh, sorted
+  // by row then col. the other pairs must not. nullptr to scan the whole
+  // cost matrix
+  const std::vector<std::pair<size_t, size_t>> *candidate_pairs = nullptr;
 };
 
 class BaseBipartiteGraphMatcher {
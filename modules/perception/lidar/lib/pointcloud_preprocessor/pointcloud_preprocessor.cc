@@ -15,8 +15,9 @@
  *****************************************************************************/
 #include "modules/perception/lidar/lib/pointcloud_preprocessor/pointcloud_preprocessor.h"
 
+#include <algorithm>
 #include <limits>
-#include <unordered_map>
+#include <vector>
 
 #include "cyber/common/file.h"
 #include "modules/common/configs/vehicle_config_helper.h"
@@ -113,39 +114,31 @@ bool PointCloudPreprocessor::Preprocess(
   }
   frame->cloud->set_timestamp(message->measurement_time());
   if (message->point_size() > 0) {
-    frame->cloud->reserve(message->point_size());
-    base::PointF point;
-    for (int i = 0; i < message->point_size(); ++i) {
-      const apollo::drivers::PointXYZIT& pt = message->point(i);
-      if (filter_naninf_points_) {
-        if (std::isnan(pt.x()) || std::isnan(pt.y()) || std::isnan(pt.z())) {
-          continue;
-        }
-        if (fabs(pt.x()) > kPointInfThreshold ||
-            fabs(pt.y()) > kPointInfThreshold ||
-            fabs(pt.z()) > kPointInfThreshold) {
-          continue;
-        }
-      }
-      Eigen::Vector3d vec3d_lidar(pt.x(), pt.y(), pt.z());
-      Eigen::Vector3d vec3d_novatel =
-          options.sensor2novatel_extrinsics * vec3d_lidar;
-      if (filter_nearby_box_points_ && vec3d_novatel[0] < box_forward_x_ &&
-          vec3d_novatel[0] > box_backward_x_ &&
-          vec3d_novatel[1] < box_forward_y_ &&
-          vec3d_novatel[1] > box_backward_y_) {
-        continue;
-      }
-      if (filter_high_z_points_ && pt.z() > z_threshold_) {
-        continue;
-      }
-      point.x = pt.x();
-      point.y = pt.y();
-      point.z = pt.z();
-      point.intensity = static_cast<float>(pt.intensity());
-      frame->cloud->push_back(point, static_cast<double>(pt.timestamp()) * 1e-9,
-                              std::numeric_limits<float>::max(), i, 0);
+    // Reused across frames, per thread, as frames may be preprocessed
+    // concurrently.
+    thread_local base::PointFCloudSoA cloud;
+    thread_local std::vector<uint8_t> mask;
+    const size_t size = static_cast<size_t>(message->point_size());
+    cloud.resize(size);
+    float* x = cloud.mutable_x();
+    float* y = cloud.mutable_y();
+    float* z = cloud.mutable_z();
+    float* intensity = cloud.mutable_intensity();
+    double* timestamp = cloud.mutable_timestamp();
+    int32_t* beam_id = cloud.mutable_beam_id();
+    for (size_t i = 0; i < size; ++i) {
+      const apollo::drivers::PointXYZIT& pt =
+          message->point(static_cast<int>(i));
+      x[i] = pt.x();
+      y[i] = pt.y();
+      z[i] = pt.z();
+      intensity[i] = static_cast<float>(pt.intensity());
+      timestamp[i] = static_cast<double>(pt.timestamp()) * 1e-9;
+      beam_id[i] = static_cast<int32_t>(i);
     }
+    mask.resize(size);
+    FilterPoints(options, cloud.span(), mask.data());
+    cloud.ToPointCloud(mask.data(), frame->cloud.get());
     TransformCloud(frame->cloud, frame->lidar2world_pose, frame->world_cloud);
   }
   return true;
@@ -165,66 +158,63 @@ bool PointCloudPreprocessor::Preprocess(
     frame->world_cloud = base::PointDCloudPool::Instance().Get();
   }
 
-  size_t size = frame->cloud->size();
-  size_t i = 0;
-  while (i < size) {
-    auto& pt = frame->cloud->at(i);
-    if (filter_naninf_points_) {
-      if (std::isnan(pt.x) || std::isnan(pt.y) || std::isnan(pt.z)) {
-        frame->cloud->SwapPoint(i, size--);
-        continue;
-      }
-      if (fabs(pt.x) > kPointInfThreshold || fabs(pt.y) > kPointInfThreshold ||
-          fabs(pt.z) > kPointInfThreshold) {
-        frame->cloud->SwapPoint(i, size--);
-        continue;
-      }
-    }
-    Eigen::Vector3d vec3d_lidar(pt.x, pt.y, pt.z);
-    Eigen::Vector3d vec3d_novatel =
-        options.sensor2novatel_extrinsics * vec3d_lidar;
-    if (filter_nearby_box_points_ && vec3d_novatel[0] < box_forward_x_ &&
-        vec3d_novatel[0] > box_backward_x_ &&
-        vec3d_novatel[1] < box_forward_y_ &&
-        vec3d_novatel[1] > box_backward_y_) {
-      frame->cloud->SwapPoint(i, size--);
-      continue;
-    }
-    if (filter_high_z_points_ && pt.z > z_threshold_) {
-      frame->cloud->SwapPoint(i, size--);
-      continue;
-    }
-    ++i;
-  }
-  AINFO << "Preprocessor filter points: " << frame->cloud->size() << " to "
-        << size;
-  frame->cloud->resize(size);
+  const size_t size = frame->cloud->size();
+  thread_local std::vector<uint8_t> mask;
+  mask.resize(size);
+  FilterPoints(options, base::MakePointSpan(frame->cloud->points()),
+               mask.data());
+  const size_t kept = base::CompactPointCloud(mask.data(), frame->cloud.get());
+  AINFO << "Preprocessor filter points: " << size << " to " << kept;
 
   TransformCloud(frame->cloud, frame->lidar2world_pose, frame->world_cloud);
   return true;
 }
 
+void PointCloudPreprocessor::FilterPoints(
+    const PointCloudPreprocessorOptions& options,
+    const base::PointSpan<float>& points, uint8_t* mask) const {
+  if (filter_naninf_points_) {
+    base::MaskFinite(points, kPointInfThreshold, mask);
+  } else {
+    std::fill(mask, mask + points.size, 1);
+  }
+  if (filter_nearby_box_points_) {
+    // The box is in the novatel frame.
+    base::MaskOutsideBox2d(options.sensor2novatel_extrinsics, points,
+                           static_cast<double>(box_backward_x_),
+                           static_cast<double>(box_forward_x_),
+                           static_cast<double>(box_backward_y_),
+                           static_cast<double>(box_forward_y_), mask);
+  }
+  if (filter_high_z_points_) {
+    base::MaskZNotAbove(points, z_threshold_, mask);
+  }
+}
+
 bool PointCloudPreprocessor::TransformCloud(
     const base::PointFCloudPtr& local_cloud, const Eigen::Affine3d& pose,
     base::PointDCloudPtr world_cloud) const {
   if (local_cloud == nullptr) {
     return false;
   }
-  world_cloud->clear();
-  world_cloud->reserve(local_cloud->size());
-  for (size_t i = 0; i < local_cloud->size(); ++i) {
-    auto& pt = local_cloud->at(i);
-    Eigen::Vector3d trans_point(pt.x, pt.y, pt.z);
-    trans_point = pose * trans_point;
-    base::PointD world_point;
-    world_point.x = trans_point(0);
-    world_point.y = trans_point(1);
-    world_point.z = trans_point(2);
-    world_point.intensity = pt.intensity;
-    world_cloud->push_back(world_point, local_cloud->points_timestamp(i),
-                           std::numeric_limits<float>::max(),
-                           local_cloud->points_beam_id()[i], 0);
+  // Every attribute is overwritten, so the cloud is not cleared first.
+  const size_t size = local_cloud->size();
+  world_cloud->resize(size);
+  base::TransformPoints(pose, base::MakePointSpan(local_cloud->points()),
+                        base::MakeMutablePointSpan(
+                            world_cloud->mutable_points()));
+  const auto& local_points = local_cloud->points();
+  auto& world_points = *world_cloud->mutable_points();
+  for (size_t i = 0; i < size; ++i) {
+    world_points[i].intensity = local_points[i].intensity;
   }
+  *world_cloud->mutable_points_timestamp() = local_cloud->points_timestamp();
+  *world_cloud->mutable_points_beam_id() = local_cloud->points_beam_id();
+  std::fill(world_cloud->mutable_points_height()->begin(),
+            world_cloud->mutable_points_height()->end(),
+            std::numeric_limits<float>::max());
+  std::fill(world_cloud->mutable_points_label()->begin(),
+            world_cloud->mutable_points_label()->end(), 0);
   return true;
 }
 
@@ -15,9 +15,11 @@
  *****************************************************************************/
 #pragma once
 
-#include <string>
+#include <cstdint>
 #include <memory>
+#include <string>
 
+#include "modules/perception/base/point_cloud_soa.h"
 #include "modules/perception/lidar/lib/interface/base_pointcloud_preprocessor.h"
 #include "modules/perception/pipeline/proto/stage/pointcloud_preprocessor_config.pb.h"
 #include "modules/perception/pipeline/stage.h"
@@ -51,6 +53,9 @@ class PointCloudPreprocessor : public BasePointCloudPreprocessor {
   std::string Name() const override { return name_; }
 
  private:
+  // Sets mask[i] to 1 for the points to keep, 0 for the filtered ones.
+  void FilterPoints(const PointCloudPreprocessorOptions& options,
+                    const base::PointSpan<float>& points, uint8_t* mask) const;
   bool TransformCloud(const base::PointFCloudPtr& local_cloud,
                       const Eigen::Affine3d& pose,
                       base::PointDCloudPtr world_cloud) const;
@@ -0,0 +1,283 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Preprocessing time of a synthetic 128-beam frame, with the per-point
+ * loop the preprocessor used to run and with PointCloudPreprocessor, which
+ * filters and transforms the points with the kernels of point_cloud_soa.h,
+ * and the time of the world transform alone on PointCloud and PointCloudSoA.
+ *
+ * Usage: pointcloud_preprocessor_benchmark [num_frames]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "modules/perception/lidar/lib/pointcloud_preprocessor/pointcloud_preprocessor.h"
+
+namespace {
+
+using apollo::drivers::PointCloud;
+using apollo::perception::base::MakeMutablePointSpan;
+using apollo::perception::base::MakePointSpan;
+using apollo::perception::base::PointD;
+using apollo::perception::base::PointDCloud;
+using apollo::perception::base::PointDCloudSoA;
+using apollo::perception::base::PointF;
+using apollo::perception::base::PointFCloud;
+using apollo::perception::base::PointFCloudSoA;
+using apollo::perception::base::TransformPoints;
+using apollo::perception::lidar::LidarFrame;
+using apollo::perception::lidar::PointCloudPreprocessor;
+using apollo::perception::lidar::PointCloudPreprocessorOptions;
+using apollo::perception::lidar::PointcloudPreprocessorConfig;
+using apollo::perception::pipeline::StageConfig;
+
+constexpr int kNumBeams = 128;
+constexpr int kNumColumns = 1800;
+constexpr float kInfThreshold = 1e3f;
+
+// A 128-beam spinning lidar at 0.2 degree resolution, in a street: ground,
+// buildings on both sides, the ego car and a few percent of lost returns.
+void MockFrame(PointCloud* message) {
+  std::mt19937 gen(17);
+  std::uniform_real_distribution<float> noise(-0.05f, 0.05f);
+  std::uniform_real_distribution<float> uniform(0.f, 1.f);
+  const float height = 1.9f;
+  message->set_measurement_time(1.0);
+  for (int column = 0; column < kNumColumns; ++column) {
+    const float azimuth = static_cast<float>(column) * 2.f *
+                          static_cast<float>(M_PI) / kNumColumns;
+    for (int beam = 0; beam < kNumBeams; ++beam) {
+      const float elevation =
+          (-25.f + 40.f * static_cast<float>(beam) / (kNumBeams - 1)) *
+          static_cast<float>(M_PI) / 180.f;
+      auto* point = message->add_point();
+      point->set_timestamp(1000000000ULL + column * 55000ULL);
+      if (uniform(gen) < 0.03f) {
+        continue;  // No return, x, y and z stay NaN.
+      }
+      const float dx = std::cos(elevation) * std::cos(azimuth);
+      const float dy = std::cos(elevation) * std::sin(azimuth);
+      const float dz = std::sin(elevation);
+      float range = 120.f;
+      if (dz < 0.f) {
+        range = std::min(range, height / -dz);
+      }
+      if (std::abs(dy) > 1e-3f) {
+        range = std::min(range, 12.f / std::abs(dy));
+      }
+      if (column < 40 || column > kNumColumns - 40) {
+        range = std::min(range, 1.2f);  // The ego car.
+      }
+      range += noise(gen);
+      point->set_x(range * dx);
+      point->set_y(range * dy);
+      point->set_z(range * dz);
+      point->set_intensity(static_cast<uint32_t>(uniform(gen) * 255.f));
+    }
+  }
+}
+
+// The per-point loop of PointCloudPreprocessor before it used the kernels.
+void LegacyPreprocess(const PointcloudPreprocessorConfig& config,
+                      const PointCloudPreprocessorOptions& options,
+                      const PointCloud& message, LidarFrame* frame) {
+  frame->cloud->clear();
+  frame->cloud->reserve(message.point_size());
+  PointF point;
+  for (int i = 0; i < message.point_size(); ++i) {
+    const apollo::drivers::PointXYZIT& pt = message.point(i);
+    if (std::isnan(pt.x()) || std::isnan(pt.y()) || std::isnan(pt.z())) {
+      continue;
+    }
+    if (fabs(pt.x()) > kInfThreshold || fabs(pt.y()) > kInfThreshold ||
+        fabs(pt.z()) > kInfThreshold) {
+      continue;
+    }
+    Eigen::Vector3d vec3d_lidar(pt.x(), pt.y(), pt.z());
+    Eigen::Vector3d vec3d_novatel =
+        options.sensor2novatel_extrinsics * vec3d_lidar;
+    if (vec3d_novatel[0] < config.box_forward_x() &&
+        vec3d_novatel[0] > config.box_backward_x() &&
+        vec3d_novatel[1] < config.box_forward_y() &&
+        vec3d_novatel[1] > config.box_backward_y()) {
+      continue;
+    }
+    if (pt.z() > config.z_threshold()) {
+      continue;
+    }
+    point.x = pt.x();
+    point.y = pt.y();
+    point.z = pt.z();
+    point.intensity = static_cast<float>(pt.intensity());
+    frame->cloud->push_back(point, static_cast<double>(pt.timestamp()) * 1e-9,
+                            std::numeric_limits<float>::max(), i, 0);
+  }
+  frame->world_cloud->clear();
+  frame->world_cloud->reserve(frame->cloud->size());
+  for (size_t i = 0; i < frame->cloud->size(); ++i) {
+    const auto& pt = frame->cloud->at(i);
+    Eigen::Vector3d trans_point(pt.x, pt.y, pt.z);
+    trans_point = frame->lidar2world_pose * trans_point;
+    PointD world_point;
+    world_point.x = trans_point(0);
+    world_point.y = trans_point(1);
+    world_point.z = trans_point(2);
+    world_point.intensity = pt.intensity;
+    frame->world_cloud->push_back(world_point,
+                                  frame->cloud->points_timestamp(i),
+                                  std::numeric_limits<float>::max(),
+                                  frame->cloud->points_beam_id()[i], 0);
+  }
+}
+
+template <typename Func>
+double MeanMs(int num_frames, Func&& func) {
+  func();  // Warm up the allocations.
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_frames; ++i) {
+    func();
+  }
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+             .count() /
+         num_frames;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int num_frames = argc > 1 ? std::atoi(argv[1]) : 50;
+
+  StageConfig stage_config;
+  stage_config.set_stage_type(
+      apollo::perception::pipeline::POINTCLOUD_PREPROCESSOR);
+  stage_config.set_enabled(true);
+  auto* config = stage_config.mutable_pointcloud_preprocessor_config();
+  config->set_filter_naninf_points(true);
+  config->set_filter_nearby_box_points(true);
+  config->set_box_forward_x(2.5f);
+  config->set_box_backward_x(-2.5f);
+  config->set_box_forward_y(1.2f);
+  config->set_box_backward_y(-1.2f);
+  config->set_filter_high_z_points(true);
+  config->set_z_threshold(5.f);
+  PointCloudPreprocessor preprocessor;
+  if (!preprocessor.Init(stage_config)) {
+    fprintf(stderr, "Failed to init the preprocessor\n");
+    return 1;
+  }
+
+  auto message = std::make_shared<PointCloud>();
+  MockFrame(message.get());
+  PointCloudPreprocessorOptions options;
+  options.sensor2novatel_extrinsics =
+      Eigen::Translation3d(0.0, 0.0, 1.9) *
+      Eigen::AngleAxisd(M_PI / 2, Eigen::Vector3d::UnitZ());
+
+  LidarFrame legacy_frame;
+  legacy_frame.cloud = std::make_shared<PointFCloud>();
+  legacy_frame.world_cloud = std::make_shared<PointDCloud>();
+  legacy_frame.lidar2world_pose =
+      Eigen::Translation3d(587000.0, 4141000.0, 20.0) *
+      options.sensor2novatel_extrinsics;
+  LidarFrame frame;
+  frame.cloud = std::make_shared<PointFCloud>();
+  frame.world_cloud = std::make_shared<PointDCloud>();
+  frame.lidar2world_pose = legacy_frame.lidar2world_pose;
+
+  const double legacy_ms = MeanMs(num_frames, [&] {
+    LegacyPreprocess(*config, options, *message, &legacy_frame);
+  });
+  const double kernel_ms = MeanMs(num_frames, [&] {
+    preprocessor.Preprocess(options, message, &frame);
+  });
+  // The frame the lidar detection component passes on, already converted.
+  const double frame_ms = MeanMs(num_frames, [&] {
+    *frame.cloud = *legacy_frame.cloud;
+    preprocessor.Preprocess(options, &frame);
+  });
+
+  // The world transform alone, on the kept points.
+  const PointFCloud& local_cloud = *legacy_frame.cloud;
+  PointDCloud world_cloud;
+  const double legacy_transform_ms = MeanMs(num_frames, [&] {
+    world_cloud.clear();
+    world_cloud.reserve(local_cloud.size());
+    for (size_t i = 0; i < local_cloud.size(); ++i) {
+      const auto& pt = local_cloud[i];
+      const Eigen::Vector3d world_pt =
+          frame.lidar2world_pose * Eigen::Vector3d(pt.x, pt.y, pt.z);
+      PointD world_point;
+      world_point.x = world_pt(0);
+      world_point.y = world_pt(1);
+      world_point.z = world_pt(2);
+      world_cloud.push_back(world_point);
+    }
+  });
+  PointFCloudSoA local_soa;
+  local_soa.resize(local_cloud.size());
+  for (size_t i = 0; i < local_cloud.size(); ++i) {
+    local_soa.mutable_x()[i] = local_cloud[i].x;
+    local_soa.mutable_y()[i] = local_cloud[i].y;
+    local_soa.mutable_z()[i] = local_cloud[i].z;
+  }
+  PointDCloudSoA world_soa;
+  world_soa.resize(local_cloud.size());
+  const double aos_transform_ms = MeanMs(num_frames, [&] {
+    TransformPoints(frame.lidar2world_pose, MakePointSpan(local_cloud.points()),
+                    MakeMutablePointSpan(world_cloud.mutable_points()));
+  });
+  const double soa_transform_ms = MeanMs(num_frames, [&] {
+    TransformPoints(frame.lidar2world_pose, local_soa.span(),
+                    world_soa.mutable_span());
+  });
+
+  printf("%d beams x %d columns, %d points, %zu kept, %d frames\n", kNumBeams,
+         kNumColumns, message->point_size(), legacy_frame.cloud->size(),
+         num_frames);
+  if (frame.cloud->size() != legacy_frame.cloud->size()) {
+    fprintf(stderr, "Kept %zu points instead of %zu\n", frame.cloud->size(),
+            legacy_frame.cloud->size());
+    return 1;
+  }
+  for (size_t i = 0; i < frame.cloud->size(); ++i) {
+    if (frame.cloud->points_beam_id()[i] !=
+            legacy_frame.cloud->points_beam_id()[i] ||
+        std::abs(frame.world_cloud->at(i).x -
+                 legacy_frame.world_cloud->at(i).x) > 1e-6) {
+      fprintf(stderr, "Point %zu differs\n", i);
+      return 1;
+    }
+  }
+  printf("per-point loop:                 %.2f ms/frame\n", legacy_ms);
+  printf("PointCloudPreprocessor message: %.2f ms/frame\n", kernel_ms);
+  printf("PointCloudPreprocessor frame:   %.2f ms/frame (with a cloud copy)\n",
+         frame_ms);
+  printf("world transform, per point:     %.2f ms/frame\n",
+         legacy_transform_ms);
+  printf("world transform, PointCloud:    %.2f ms/frame\n", aos_transform_ms);
+  printf("world transform, PointCloudSoA: %.2f ms/frame\n", soa_transform_ms);
+  return 0;
+}
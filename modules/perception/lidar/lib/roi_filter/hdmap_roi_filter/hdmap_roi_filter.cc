@@ -17,6 +17,7 @@
 #include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/hdmap_roi_filter.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "cyber/common/file.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
@@ -52,6 +53,7 @@ bool HdmapROIFilter::Init(const ROIFilterInitOptions& options) {
   extend_dist_ = config.extend_dist();
   no_edge_table_ = config.no_edge_table();
   set_roi_service_ = config.set_roi_service();
+  use_tile_cache_ = config.use_tile_cache();
 
   // reserve mem
   const size_t KPolygonMaxNum = 100;
@@ -63,13 +65,16 @@ bool HdmapROIFilter::Init(const ROIFilterInitOptions& options) {
   Eigen::Vector2d max_range(range_, range_);
   Eigen::Vector2d cell_size(cell_size_, cell_size_);
   bitmap_.Init(min_range, max_range, cell_size);
+  tile_cache_.Init(cell_size_, config.tile_cells(), config.max_tiles(),
+                   extend_dist_, no_edge_table_);
 
   // output input parameters
   AINFO << " HDMap Roi Filter Parameters: "
         << " range: " << range_ << " cell_size: " << cell_size_
         << " extend_dist: " << extend_dist_
         << " no_edge_table: " << no_edge_table_
-        << " set_roi_service: " << set_roi_service_;
+        << " set_roi_service: " << set_roi_service_
+        << " use_tile_cache: " << use_tile_cache_;
   return true;
 }
 
@@ -84,6 +89,7 @@ bool HdmapROIFilter::Init(const StageConfig& stage_config) {
   extend_dist_ = hdmap_roi_filter_config_.extend_dist();
   no_edge_table_ = hdmap_roi_filter_config_.no_edge_table();
   set_roi_service_ = hdmap_roi_filter_config_.set_roi_service();
+  use_tile_cache_ = hdmap_roi_filter_config_.use_tile_cache();
 
   // reserve mem
   const size_t KPolygonMaxNum = 100;
@@ -95,6 +101,9 @@ bool HdmapROIFilter::Init(const StageConfig& stage_config) {
   Eigen::Vector2d max_range(range_, range_);
   Eigen::Vector2d cell_size(cell_size_, cell_size_);
   bitmap_.Init(min_range, max_range, cell_size);
+  tile_cache_.Init(cell_size_, hdmap_roi_filter_config_.tile_cells(),
+                   hdmap_roi_filter_config_.max_tiles(), extend_dist_,
+                   no_edge_table_);
 
   // output input parameters
   AINFO << " HDMap Roi Filter Parameters: "
@@ -132,13 +141,27 @@ bool HdmapROIFilter::Filter(const ROIFilterOptions& options,
     polygons_world_[i++] = &polygon;
   }
 
-  // transform to local
+  // transform to local, the tile cache draws the world polygons itself
   base::PointFCloudPtr cloud_local = base::PointFCloudPool::Instance().Get();
   TransformFrame(frame->cloud, frame->lidar2world_pose, polygons_world_,
-                 &polygons_local_, &cloud_local);
-
-  bool ret = FilterWithPolygonMask(cloud_local, polygons_local_,
-                                   &(frame->roi_indices));
+                 use_tile_cache_ ? nullptr : &polygons_local_, &cloud_local);
+
+  bool ret = false;
+  const Eigen::Vector3d vel_location = frame->lidar2world_pose.translation();
+  if (use_tile_cache_) {
+    ret = tile_cache_.Update(polygons_world_, vel_location.head<2>(),
+                             range_) &&
+          FilterWithTileCache(cloud_local, vel_location,
+                              &(frame->roi_indices));
+    const RoiTileCacheStats& stats = tile_cache_.stats();
+    ADEBUG << "ROI tiles built: " << stats.tiles_built
+           << " reused: " << stats.tiles_reused
+           << " evicted: " << stats.tiles_evicted
+           << " cached: " << stats.tiles_cached;
+  } else {
+    ret = FilterWithPolygonMask(cloud_local, polygons_local_,
+                                &(frame->roi_indices));
+  }
 
   // set roi points label
   if (ret) {
@@ -152,23 +175,7 @@ bool HdmapROIFilter::Filter(const ROIFilterOptions& options,
 
   // set roi service
   if (set_roi_service_) {
-    auto roi_service = SceneManager::Instance().Service("ROIService");
-    if (roi_service != nullptr) {
-      roi_service_content_.range_ = range_;
-      roi_service_content_.cell_size_ = cell_size_;
-      roi_service_content_.map_size_ = bitmap_.map_size();
-      roi_service_content_.bitmap_ = bitmap_.bitmap();
-      roi_service_content_.major_dir_ =
-          static_cast<ROIServiceContent::DirectionMajor>(bitmap_.dir_major());
-      roi_service_content_.transform_ = frame->lidar2world_pose.translation();
-      if (!ret) {
-        std::fill(roi_service_content_.bitmap_.begin(),
-                  roi_service_content_.bitmap_.end(), -1);
-      }
-      roi_service->UpdateServiceContent(roi_service_content_);
-    } else {
-      AINFO << "Failed to find roi service and cannot update.";
-    }
+    SetROIService(vel_location, ret);
   }
   return ret;
 }
@@ -221,32 +228,31 @@ void HdmapROIFilter::TransformFrame(
     base::PointFCloudPtr* cloud_local) {
   Eigen::Vector3d vel_location = vel_pose.translation();
   Eigen::Matrix3d vel_rot = vel_pose.linear();
-  Eigen::Vector3d x_axis = vel_rot.row(0);
-  Eigen::Vector3d y_axis = vel_rot.row(1);
 
   // transform polygons
-  polygons_local->clear();
-  polygons_local->resize(polygons_world.size());
-  for (size_t i = 0; i < polygons_local->size(); ++i) {
-    const auto& polygon_world = *(polygons_world[i]);
-    auto& polygon_local = (*polygons_local)[i];
-    polygon_local.resize(polygon_world.size());
-    for (size_t j = 0; j < polygon_local.size(); ++j) {
-      polygon_local[j].x = polygon_world[j].x - vel_location.x();
-      polygon_local[j].y = polygon_world[j].y - vel_location.y();
+  if (polygons_local != nullptr) {
+    polygons_local->clear();
+    polygons_local->resize(polygons_world.size());
+    for (size_t i = 0; i < polygons_local->size(); ++i) {
+      const auto& polygon_world = *(polygons_world[i]);
+      auto& polygon_local = (*polygons_local)[i];
+      polygon_local.resize(polygon_world.size());
+      for (size_t j = 0; j < polygon_local.size(); ++j) {
+        polygon_local[j].x = polygon_world[j].x - vel_location.x();
+        polygon_local[j].y = polygon_world[j].y - vel_location.y();
+      }
     }
   }
 
-  // transform cloud
+  // transform cloud, only x and y are used
+  Eigen::Affine3d rotation = Eigen::Affine3d::Identity();
+  rotation.linear() = vel_rot;
+  rotation.linear().row(2).setZero();
   (*cloud_local)->clear();
   (*cloud_local)->resize(cloud->size());
-  for (size_t i = 0; i < (*cloud_local)->size(); ++i) {
-    const auto& pt = cloud->at(i);
-    auto& local_pt = (*cloud_local)->at(i);
-    Eigen::Vector3d e_pt(pt.x, pt.y, pt.z);
-    local_pt.x = static_cast<float>(x_axis.dot(e_pt));
-    local_pt.y = static_cast<float>(y_axis.dot(e_pt));
-  }
+  base::TransformPoints(rotation, base::MakePointSpan(cloud->points()),
+                        base::MakeMutablePointSpan(
+                            (*cloud_local)->mutable_points()));
 }
 
 bool HdmapROIFilter::Bitmap2dFilter(const base::PointFCloudPtr& in_cloud,
@@ -256,21 +262,85 @@ bool HdmapROIFilter::Bitmap2dFilter(const base::PointFCloudPtr& in_cloud,
     AWARN << " Car is not in roi!!.";
     return false;
   }
+  // Crop to the bitmap range first, as Bitmap2D::IsExists does.
+  std::vector<uint8_t> mask(in_cloud->size(), 1);
+  base::MaskInsideRect2d(base::MakePointSpan(in_cloud->points()),
+                         bitmap.min_range().x(), bitmap.max_range().x(),
+                         bitmap.min_range().y(), bitmap.max_range().y(),
+                         mask.data());
   roi_indices->indices.clear();
   roi_indices->indices.reserve(in_cloud->size());
   for (size_t i = 0; i < in_cloud->size(); ++i) {
+    if (!mask[i]) {
+      continue;
+    }
     const auto& pt = in_cloud->at(i);
-    Eigen::Vector2d e_pt(pt.x, pt.y);
-    if (!bitmap.IsExists(e_pt)) {
+    if (bitmap.Check(Eigen::Vector2d(pt.x, pt.y))) {
+      roi_indices->indices.push_back(static_cast<int>(i));
+    }
+  }
+  return true;
+}
+
+bool HdmapROIFilter::FilterWithTileCache(
+    const base::PointFCloudPtr& cloud_local,
+    const Eigen::Vector3d& vel_location, base::PointIndices* roi_indices) {
+  if (!tile_cache_.Check(vel_location.x(), vel_location.y())) {
+    AWARN << " Car is not in roi!!.";
+    return false;
+  }
+  // Crop to the range first, as Bitmap2dFilter does.
+  std::vector<uint8_t> mask(cloud_local->size(), 1);
+  base::MaskInsideRect2d(base::MakePointSpan(cloud_local->points()), -range_,
+                         range_, -range_, range_, mask.data());
+  roi_indices->indices.clear();
+  roi_indices->indices.reserve(cloud_local->size());
+  for (size_t i = 0; i < cloud_local->size(); ++i) {
+    if (!mask[i]) {
       continue;
     }
-    if (bitmap.Check(e_pt)) {
+    const auto& pt = cloud_local->at(i);
+    if (tile_cache_.Check(pt.x + vel_location.x(), pt.y + vel_location.y())) {
       roi_indices->indices.push_back(static_cast<int>(i));
     }
   }
   return true;
 }
 
+void HdmapROIFilter::SetROIService(const Eigen::Vector3d& vel_location,
+                                   bool valid) {
+  auto roi_service = SceneManager::Instance().Service("ROIService");
+  if (roi_service == nullptr) {
+    AINFO << "Failed to find roi service and cannot update.";
+    return;
+  }
+  roi_service_content_.range_ = range_;
+  roi_service_content_.cell_size_ = cell_size_;
+  if (use_tile_cache_) {
+    // the crop starts at a world cell, the bitmap centre is off the car by
+    // less than a cell
+    Eigen::Vector2d origin;
+    tile_cache_.Crop(vel_location.head<2>(), range_,
+                     &roi_service_content_.bitmap_,
+                     &roi_service_content_.map_size_, &origin);
+    roi_service_content_.major_dir_ =
+        ROIServiceContent::DirectionMajor::XMAJOR;
+    roi_service_content_.transform_ = Eigen::Vector3d(
+        origin.x() + range_, origin.y() + range_, vel_location.z());
+  } else {
+    roi_service_content_.map_size_ = bitmap_.map_size();
+    roi_service_content_.bitmap_ = bitmap_.bitmap();
+    roi_service_content_.major_dir_ =
+        static_cast<ROIServiceContent::DirectionMajor>(bitmap_.dir_major());
+    roi_service_content_.transform_ = vel_location;
+  }
+  if (!valid) {
+    std::fill(roi_service_content_.bitmap_.begin(),
+              roi_service_content_.bitmap_.end(), -1);
+  }
+  roi_service->UpdateServiceContent(roi_service_content_);
+}
+
 PERCEPTION_REGISTER_ROIFILTER(HdmapROIFilter);
 
 }  // namespace lidar
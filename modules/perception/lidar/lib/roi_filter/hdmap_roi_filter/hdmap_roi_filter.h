@@ -21,8 +21,10 @@
 
 #include "modules/common/util/eigen_defs.h"
 #include "modules/perception/base/point_cloud.h"
+#include "modules/perception/base/point_cloud_soa.h"
 #include "modules/perception/lidar/lib/interface/base_roi_filter.h"
 #include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/bitmap2d.h"
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/roi_tile_cache.h"
 #include "modules/perception/lidar/lib/scene_manager/roi_service/roi_service.h"
 #include "modules/perception/pipeline/stage.h"
 
@@ -61,6 +63,7 @@ class HdmapROIFilter : public BaseROIFilter {
   std::string Name() const override { return name_; }
 
  private:
+  // polygons_local may be nullptr to transform the cloud only
   void TransformFrame(
       const base::PointFCloudPtr& cloud, const Eigen::Affine3d& vel_pose,
       const EigenVector<base::PolygonDType*>& polygons_world,
@@ -75,15 +78,24 @@ class HdmapROIFilter : public BaseROIFilter {
   bool Bitmap2dFilter(const base::PointFCloudPtr& in_cloud,
                       const Bitmap2D& bitmap, base::PointIndices* roi_indices);
 
+  // looks the points up in tile_cache_, cloud_local rotated to world axes
+  bool FilterWithTileCache(const base::PointFCloudPtr& cloud_local,
+                           const Eigen::Vector3d& vel_location,
+                           base::PointIndices* roi_indices);
+
+  void SetROIService(const Eigen::Vector3d& vel_location, bool valid);
+
   // parameters for polygons scans convert
   double range_ = 120.0;
   double cell_size_ = 0.25;
   double extend_dist_ = 0.0;
   bool no_edge_table_ = false;
   bool set_roi_service_ = false;
+  bool use_tile_cache_ = false;
   EigenVector<base::PolygonDType*> polygons_world_;
   EigenVector<base::PolygonDType> polygons_local_;
   Bitmap2D bitmap_;
+  RoiTileCache tile_cache_;
   ROIServiceContent roi_service_content_;
 
   HDMapRoiFilterConfig hdmap_roi_filter_config_;
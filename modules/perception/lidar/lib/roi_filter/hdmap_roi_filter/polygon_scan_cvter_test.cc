@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/polygon_scan_cvter.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+namespace {
+
+using Cvter = PolygonScanCvter<double>;
+
+// A rectangle from min_x to max_x along x and from 1.0 to 3.0 along y.
+Cvter::Polygon MakeRectangle(const double min_x, const double max_x) {
+  Cvter::Polygon polygon;
+  polygon.push_back(Cvter::Point(min_x, 1.0));
+  polygon.push_back(Cvter::Point(max_x, 1.0));
+  polygon.push_back(Cvter::Point(max_x, 3.0));
+  polygon.push_back(Cvter::Point(min_x, 3.0));
+  return polygon;
+}
+
+std::vector<std::vector<Cvter::IntervalOut>> ScanRectangle(
+    const double min_x, const double max_x) {
+  Cvter cvter;
+  cvter.Init(MakeRectangle(min_x, max_x));
+  std::vector<std::vector<Cvter::IntervalOut>> scans_intervals;
+  cvter.ScansCvt(Cvter::IntervalIn(0.0, 10.0), Cvter::XMAJOR, 1.0,
+                 &scans_intervals);
+  return scans_intervals;
+}
+
+// Scans through the rectangle hit it from 1.0 to 3.0, vertical edges give
+// an interval of their own.
+void ExpectRectangleScan(const std::vector<Cvter::IntervalOut>& intervals) {
+  ASSERT_FALSE(intervals.empty());
+  for (const auto& interval : intervals) {
+    EXPECT_NEAR(1.0, interval.first, 1e-6);
+    EXPECT_NEAR(3.0, interval.second, 1e-6);
+  }
+}
+
+}  // namespace
+
+TEST(PolygonScanCvterTest, PolygonStartingBelowScans) {
+  const auto scans_intervals = ScanRectangle(-5.0, 5.0);
+  // No top scan for the edges below the scans.
+  ASSERT_EQ(10, scans_intervals.size());
+  for (size_t i = 0; i < scans_intervals.size(); ++i) {
+    if (i <= 5) {
+      SCOPED_TRACE(i);
+      ExpectRectangleScan(scans_intervals[i]);
+    } else {
+      EXPECT_TRUE(scans_intervals[i].empty()) << "scan " << i;
+    }
+  }
+}
+
+TEST(PolygonScanCvterTest, PolygonEndingAboveScans) {
+  const auto scans_intervals = ScanRectangle(2.0, 12.0);
+  // The edge above the scans goes to the top scan.
+  ASSERT_EQ(11, scans_intervals.size());
+  for (size_t i = 0; i < 10; ++i) {
+    if (i >= 2) {
+      SCOPED_TRACE(i);
+      ExpectRectangleScan(scans_intervals[i]);
+    } else {
+      EXPECT_TRUE(scans_intervals[i].empty()) << "scan " << i;
+    }
+  }
+  ExpectRectangleScan(scans_intervals[10]);
+}
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,295 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/roi_tile_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "modules/perception/lidar/common/lidar_log.h"
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/polygon_mask.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+namespace {
+
+inline int64_t FloorDiv(int64_t a, int64_t b) {
+  const int64_t q = a / b;
+  return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+inline int64_t TileKey(int64_t tx, int64_t ty) {
+  return static_cast<int64_t>((static_cast<uint64_t>(tx) << 32) ^
+                              (static_cast<uint64_t>(ty) & 0xffffffffULL));
+}
+
+// splitmix64 finalizer, so that the sum of polygon hashes mixes well
+inline uint64_t Mix(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+inline uint64_t HashDouble(uint64_t hash, double value) {
+  uint64_t bits = 0;
+  memcpy(&bits, &value, sizeof(bits));
+  return (hash ^ bits) * 0x100000001b3ULL;
+}
+
+}  // namespace
+
+void RoiTileCache::Init(double cell_size, int tile_cells, size_t max_tiles,
+                        double extend_dist, bool no_edge_table) {
+  CHECK_GT(cell_size, 0.0);
+  cell_size_ = cell_size;
+  tile_cells_ = std::max<int64_t>((tile_cells + 63) / 64, 1) * 64;
+  words_per_row_ = static_cast<size_t>(tile_cells_ / 64);
+  max_tiles_ = max_tiles;
+  extend_dist_ = extend_dist;
+  no_edge_table_ = no_edge_table;
+
+  tiles_.clear();
+  lru_.clear();
+  window_.clear();
+  window_nx_ = window_ny_ = 0;
+
+  // tile local, a cell more than the tile as DrawPolygonsMask leaves out
+  // the last scan
+  const double tile_size = static_cast<double>(tile_cells_ + 1) * cell_size_;
+  bitmap_.Init(Eigen::Vector2d(0.0, 0.0), Eigen::Vector2d(tile_size, tile_size),
+               Eigen::Vector2d(cell_size_, cell_size_));
+}
+
+bool RoiTileCache::Update(
+    const EigenVector<base::PolygonDType*>& polygons_world,
+    const Eigen::Vector2d& center, double range) {
+  stats_ = RoiTileCacheStats();
+  window_.clear();
+  window_nx_ = window_ny_ = 0;
+
+  // bounding boxes, as min x, min y, max x, max y, and hashes of polygons
+  const size_t polygon_num = polygons_world.size();
+  polygon_boxes_.resize(polygon_num);
+  polygon_hashes_.resize(polygon_num);
+  for (size_t i = 0; i < polygon_num; ++i) {
+    const auto& polygon = *polygons_world[i];
+    Eigen::Vector4d box(std::numeric_limits<double>::max(),
+                        std::numeric_limits<double>::max(),
+                        -std::numeric_limits<double>::max(),
+                        -std::numeric_limits<double>::max());
+    uint64_t hash = 0xcbf29ce484222325ULL ^ polygon.size();
+    for (size_t j = 0; j < polygon.size(); ++j) {
+      const auto& pt = polygon[j];
+      box[0] = std::min(box[0], pt.x);
+      box[1] = std::min(box[1], pt.y);
+      box[2] = std::max(box[2], pt.x);
+      box[3] = std::max(box[3], pt.y);
+      hash = HashDouble(HashDouble(hash, pt.x), pt.y);
+    }
+    polygon_boxes_[i] = box;
+    polygon_hashes_[i] = Mix(hash);
+  }
+
+  // tiles of the window
+  const double tile_size = static_cast<double>(tile_cells_) * cell_size_;
+  const int64_t tx_begin =
+      static_cast<int64_t>(std::floor((center.x() - range) / tile_size));
+  const int64_t tx_end =
+      static_cast<int64_t>(std::floor((center.x() + range) / tile_size)) + 1;
+  const int64_t ty_begin =
+      static_cast<int64_t>(std::floor((center.y() - range) / tile_size));
+  const int64_t ty_end =
+      static_cast<int64_t>(std::floor((center.y() + range) / tile_size)) + 1;
+  std::vector<const Tile*> window((tx_end - tx_begin) * (ty_end - ty_begin),
+                                  nullptr);
+  for (int64_t tx = tx_begin; tx < tx_end; ++tx) {
+    for (int64_t ty = ty_begin; ty < ty_end; ++ty) {
+      // polygons that may set cells of the tile
+      const double min_x = static_cast<double>(tx) * tile_size - extend_dist_;
+      const double min_y = static_cast<double>(ty) * tile_size - extend_dist_;
+      const double max_x = min_x + tile_size + 2.0 * extend_dist_;
+      const double max_y = min_y + tile_size + 2.0 * extend_dist_;
+      tile_polygons_.clear();
+      uint64_t signature = 0;
+      for (size_t i = 0; i < polygon_num; ++i) {
+        const Eigen::Vector4d& box = polygon_boxes_[i];
+        if (box[0] > max_x || box[2] < min_x || box[1] > max_y ||
+            box[3] < min_y) {
+          continue;
+        }
+        tile_polygons_.push_back(i);
+        signature += polygon_hashes_[i];
+      }
+
+      const int64_t key = TileKey(tx, ty);
+      auto iter = tiles_.find(key);
+      if (iter != tiles_.end() && iter->second.signature == signature) {
+        lru_.splice(lru_.begin(), lru_, iter->second.lru_iter);
+        ++stats_.tiles_reused;
+      } else {
+        const bool is_new = iter == tiles_.end();
+        if (is_new) {
+          iter = tiles_.emplace(key, Tile()).first;
+        }
+        if (!BuildTile(tx, ty, tile_polygons_, polygons_world, &iter->second)) {
+          if (!is_new) {
+            lru_.erase(iter->second.lru_iter);
+          }
+          tiles_.erase(iter);
+          stats_.tiles_cached = tiles_.size();
+          return false;
+        }
+        iter->second.signature = signature;
+        if (is_new) {
+          lru_.push_front(key);
+        } else {
+          lru_.splice(lru_.begin(), lru_, iter->second.lru_iter);
+        }
+        iter->second.lru_iter = lru_.begin();
+        ++stats_.tiles_built;
+      }
+      window[(tx - tx_begin) * (ty_end - ty_begin) + (ty - ty_begin)] =
+          &iter->second;
+    }
+  }
+
+  // the tiles of the window are the most recent, so they are never evicted
+  const size_t capacity = std::max(max_tiles_, window.size());
+  while (tiles_.size() > capacity) {
+    tiles_.erase(lru_.back());
+    lru_.pop_back();
+    ++stats_.tiles_evicted;
+  }
+  stats_.tiles_cached = tiles_.size();
+
+  window_.swap(window);
+  window_tx_ = tx_begin;
+  window_ty_ = ty_begin;
+  window_nx_ = tx_end - tx_begin;
+  window_ny_ = ty_end - ty_begin;
+  return true;
+}
+
+bool RoiTileCache::BuildTile(
+    int64_t tx, int64_t ty, const std::vector<size_t>& polygons,
+    const EigenVector<base::PolygonDType*>& polygons_world, Tile* tile) {
+  bitmap_.SetUp(Bitmap2D::DirectionMajor::XMAJOR);
+  if (!polygons.empty()) {
+    // tile local, as the car local polygons of HdmapROIFilter
+    const double tile_size = static_cast<double>(tile_cells_) * cell_size_;
+    const double origin_x = static_cast<double>(tx) * tile_size;
+    const double origin_y = static_cast<double>(ty) * tile_size;
+    std::vector<PolygonScanCvter<double>::Polygon> raw_polygons(
+        polygons.size());
+    for (size_t i = 0; i < polygons.size(); ++i) {
+      const auto& polygon = *polygons_world[polygons[i]];
+      auto& raw_polygon = raw_polygons[i];
+      raw_polygon.resize(polygon.size());
+      for (size_t j = 0; j < polygon.size(); ++j) {
+        raw_polygon[j].x() = polygon[j].x - origin_x;
+        raw_polygon[j].y() = polygon[j].y - origin_y;
+      }
+    }
+    if (!DrawPolygonsMask<double>(raw_polygons, &bitmap_, extend_dist_,
+                                  no_edge_table_)) {
+      return false;
+    }
+  }
+
+  const size_t stride = bitmap_.map_size()[1];
+  const std::vector<uint64_t>& bits = bitmap_.bitmap();
+  tile->words.resize(tile_cells_ * words_per_row_);
+  for (int64_t row = 0; row < tile_cells_; ++row) {
+    memcpy(&tile->words[row * words_per_row_], &bits[row * stride],
+           words_per_row_ * sizeof(uint64_t));
+  }
+  return true;
+}
+
+const RoiTileCache::Tile* RoiTileCache::WindowTile(int64_t tx,
+                                                   int64_t ty) const {
+  const int64_t ix = tx - window_tx_;
+  const int64_t iy = ty - window_ty_;
+  if (ix < 0 || ix >= window_nx_ || iy < 0 || iy >= window_ny_) {
+    return nullptr;
+  }
+  return window_[ix * window_ny_ + iy];
+}
+
+bool RoiTileCache::Check(double x, double y) const {
+  const int64_t cx = static_cast<int64_t>(std::floor(x / cell_size_));
+  const int64_t cy = static_cast<int64_t>(std::floor(y / cell_size_));
+  const int64_t tx = FloorDiv(cx, tile_cells_);
+  const int64_t ty = FloorDiv(cy, tile_cells_);
+  const Tile* tile = WindowTile(tx, ty);
+  if (tile == nullptr) {
+    return false;
+  }
+  const int64_t lx = cx - tx * tile_cells_;
+  const int64_t ly = cy - ty * tile_cells_;
+  return (tile->words[lx * words_per_row_ + (ly >> 6)] >> (ly & 63)) & 1;
+}
+
+uint64_t RoiTileCache::WorldWord(int64_t x, int64_t word_y) const {
+  const int64_t tx = FloorDiv(x, tile_cells_);
+  const int64_t ty = FloorDiv(word_y * 64, tile_cells_);
+  const Tile* tile = WindowTile(tx, ty);
+  if (tile == nullptr) {
+    return 0;
+  }
+  const int64_t lx = x - tx * tile_cells_;
+  const int64_t lw = (word_y * 64 - ty * tile_cells_) >> 6;
+  return tile->words[lx * words_per_row_ + lw];
+}
+
+void RoiTileCache::Crop(const Eigen::Vector2d& center, double range,
+                        std::vector<uint64_t>* bitmap, Vec2ui* map_size,
+                        Eigen::Vector2d* origin) const {
+  const int64_t ox =
+      static_cast<int64_t>(std::floor((center.x() - range) / cell_size_));
+  const int64_t oy =
+      static_cast<int64_t>(std::floor((center.y() - range) / cell_size_));
+  *origin = Eigen::Vector2d(static_cast<double>(ox) * cell_size_,
+                            static_cast<double>(oy) * cell_size_);
+  // as Bitmap2D::Init
+  const size_t dims = static_cast<size_t>(2.0 * range / cell_size_) + 1;
+  (*map_size)[0] = dims;
+  (*map_size)[1] = (dims >> 6) + 1;
+  bitmap->assign((*map_size)[0] * (*map_size)[1], 0);
+
+  // the words of the crop straddle two world words, shift bits in
+  const int64_t first_word = FloorDiv(oy, 64);
+  const int shift = static_cast<int>(oy - first_word * 64);
+  for (size_t i = 0; i < dims; ++i) {
+    const int64_t x = ox + static_cast<int64_t>(i);
+    uint64_t* row = &(*bitmap)[i * (*map_size)[1]];
+    uint64_t low = WorldWord(x, first_word);
+    for (size_t k = 0; k < (*map_size)[1]; ++k) {
+      const uint64_t high = WorldWord(x, first_word + k + 1);
+      row[k] = shift == 0 ? low : (low >> shift) | (high << (64 - shift));
+      low = high;
+    }
+  }
+}
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "Eigen/Core"
+
+#include "modules/common/util/eigen_defs.h"
+#include "modules/perception/base/point_cloud.h"
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/bitmap2d.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+struct RoiTileCacheStats {
+  // tiles of the last Update
+  size_t tiles_built = 0;
+  size_t tiles_reused = 0;
+  size_t tiles_evicted = 0;
+  // tiles in the cache after the last Update
+  size_t tiles_cached = 0;
+};
+
+// ROI bitmap of the map polygons, in square tiles aligned to the world
+// cells. Update rasterizes only the tiles of the window that are not cached
+// or whose overlapping polygons changed, so that as the car moves a few
+// tiles are built per frame, and evicts the least recently used tiles.
+class RoiTileCache {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+ public:
+  using Vec2ui = Bitmap2D::Vec2ui;
+  template <class EigenType>
+  using EigenVector = apollo::common::EigenVector<EigenType>;
+
+  RoiTileCache() = default;
+  ~RoiTileCache() = default;
+
+  // @param tile_cells: cells of a tile side, rounded up to a multiple of 64
+  // @param max_tiles: tiles kept, at least those of the window
+  void Init(double cell_size, int tile_cells, size_t max_tiles,
+            double extend_dist, bool no_edge_table);
+
+  // @brief: make the tiles of [center - range, center + range] current
+  // @return: false if a polygon cannot be rasterized
+  bool Update(const EigenVector<base::PolygonDType*>& polygons_world,
+              const Eigen::Vector2d& center, double range);
+
+  // @brief: whether the world point is in the roi, false outside the window
+  bool Check(double x, double y) const;
+
+  // @brief: bitmap of the window as Bitmap2D of major x would have it, of
+  // dims 2 * range / cell_size + 1 from the world cell at origin
+  void Crop(const Eigen::Vector2d& center, double range,
+            std::vector<uint64_t>* bitmap, Vec2ui* map_size,
+            Eigen::Vector2d* origin) const;
+
+  const RoiTileCacheStats& stats() const { return stats_; }
+  double cell_size() const { return cell_size_; }
+
+ private:
+  struct Tile {
+    // cell rows of x, words_per_row_ words of y cells each
+    std::vector<uint64_t> words;
+    // hash of the polygons it was built from
+    uint64_t signature = 0;
+    std::list<int64_t>::iterator lru_iter;
+  };
+
+  bool BuildTile(int64_t tx, int64_t ty, const std::vector<size_t>& polygons,
+                 const EigenVector<base::PolygonDType*>& polygons_world,
+                 Tile* tile);
+  // 64 cells of y from the world cell (x, 64 * word_y), 0 outside the window
+  uint64_t WorldWord(int64_t x, int64_t word_y) const;
+  const Tile* WindowTile(int64_t tx, int64_t ty) const;
+
+  double cell_size_ = 0.25;
+  int64_t tile_cells_ = 256;
+  size_t words_per_row_ = 4;
+  size_t max_tiles_ = 64;
+  double extend_dist_ = 0.0;
+  bool no_edge_table_ = false;
+
+  std::unordered_map<int64_t, Tile> tiles_;
+  // keys of tiles_, most recently used first
+  std::list<int64_t> lru_;
+
+  // tiles of the window of the last Update, by x then y
+  int64_t window_tx_ = 0;
+  int64_t window_ty_ = 0;
+  int64_t window_nx_ = 0;
+  int64_t window_ny_ = 0;
+  std::vector<const Tile*> window_;
+
+  // per polygon bounding boxes and hashes of the last Update
+  EigenVector<Eigen::Vector4d> polygon_boxes_;
+  std::vector<uint64_t> polygon_hashes_;
+  std::vector<size_t> tile_polygons_;
+  Bitmap2D bitmap_;
+
+  RoiTileCacheStats stats_;
+};
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,190 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Time per frame of the HDMap ROI bitmap along a drive through a
+ * grid of city blocks: drawn car local every frame as HdmapROIFilter did,
+ * against RoiTileCache. Reports the tiles built per frame and the share of
+ * cells on which the two bitmaps agree.
+ *
+ * Usage: roi_tile_cache_benchmark [num_frames] [speed_m_per_frame]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/polygon_mask.h"
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/roi_tile_cache.h"
+
+namespace {
+
+using apollo::perception::base::PointD;
+using apollo::perception::base::PolygonDType;
+using apollo::perception::lidar::Bitmap2D;
+using apollo::perception::lidar::DrawPolygonsMask;
+using apollo::perception::lidar::PolygonScanCvter;
+using apollo::perception::lidar::RoiTileCache;
+
+constexpr double kRange = 120.0;
+constexpr double kCellSize = 0.25;
+constexpr int kTileCells = 256;
+constexpr size_t kMaxTiles = 64;
+constexpr double kBlockSize = 150.0;
+constexpr double kRoadWidth = 14.0;
+constexpr double kMapOriginX = 438000.0;
+constexpr double kMapOriginY = 4432000.0;
+
+PolygonDType Rect(double min_x, double min_y, double max_x, double max_y) {
+  PolygonDType polygon;
+  const double xs[] = {min_x, max_x, max_x, min_x};
+  const double ys[] = {min_y, min_y, max_y, max_y};
+  for (int i = 0; i < 4; ++i) {
+    PointD pt;
+    pt.x = xs[i];
+    pt.y = ys[i];
+    pt.z = 0.0;
+    polygon.push_back(pt);
+  }
+  return polygon;
+}
+
+// Roads between the blocks and junctions where they cross, as the map
+// query returns them for the car at (x, y).
+void QueryMap(double x, double y,
+              apollo::common::EigenVector<PolygonDType>* polygons) {
+  polygons->clear();
+  const double reach = kRange + kBlockSize;
+  const int min_i =
+      static_cast<int>(std::floor((x - reach - kMapOriginX) / kBlockSize));
+  const int max_i =
+      static_cast<int>(std::ceil((x + reach - kMapOriginX) / kBlockSize));
+  const int min_j =
+      static_cast<int>(std::floor((y - reach - kMapOriginY) / kBlockSize));
+  const int max_j =
+      static_cast<int>(std::ceil((y + reach - kMapOriginY) / kBlockSize));
+  const double half = 0.5 * kRoadWidth;
+  for (int i = min_i; i <= max_i; ++i) {
+    for (int j = min_j; j <= max_j; ++j) {
+      const double cx = kMapOriginX + i * kBlockSize;
+      const double cy = kMapOriginY + j * kBlockSize;
+      polygons->push_back(Rect(cx - half, cy - half, cx + half, cy + half));
+      polygons->push_back(
+          Rect(cx + half, cy - half, cx + kBlockSize - half, cy + half));
+      polygons->push_back(
+          Rect(cx - half, cy + half, cx + half, cy + kBlockSize - half));
+    }
+  }
+}
+
+// Along the x road, then turning onto a y road after a few blocks.
+Eigen::Vector2d DrivePosition(int frame, double speed) {
+  const double distance = frame * speed;
+  const double turn = 4.0 * kBlockSize;
+  if (distance < turn) {
+    return Eigen::Vector2d(kMapOriginX + distance, kMapOriginY);
+  }
+  return Eigen::Vector2d(kMapOriginX + turn, kMapOriginY + distance - turn);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int num_frames = argc > 1 ? atoi(argv[1]) : 600;
+  const double speed = argc > 2 ? atof(argv[2]) : 1.5;
+
+  Bitmap2D bitmap;
+  bitmap.Init(Eigen::Vector2d(-kRange, -kRange),
+              Eigen::Vector2d(kRange, kRange),
+              Eigen::Vector2d(kCellSize, kCellSize));
+  RoiTileCache cache;
+  cache.Init(kCellSize, kTileCells, kMaxTiles, 0.0, false);
+
+  apollo::common::EigenVector<PolygonDType> polygons;
+  apollo::common::EigenVector<PolygonDType*> polygon_ptrs;
+  std::vector<PolygonScanCvter<double>::Polygon> local_polygons;
+  double local_ms = 0.0;
+  double cache_ms = 0.0;
+  size_t tiles_built = 0;
+  size_t max_tiles_built = 0;
+  size_t first_tiles_built = 0;
+  size_t cells = 0;
+  size_t agreed = 0;
+  for (int frame = 0; frame < num_frames; ++frame) {
+    const Eigen::Vector2d center = DrivePosition(frame, speed);
+    QueryMap(center.x(), center.y(), &polygons);
+    polygon_ptrs.clear();
+    for (auto& polygon : polygons) {
+      polygon_ptrs.push_back(&polygon);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    local_polygons.assign(polygons.size(), {});
+    for (size_t i = 0; i < polygons.size(); ++i) {
+      for (const auto& pt : polygons[i]) {
+        local_polygons[i].emplace_back(pt.x - center.x(), pt.y - center.y());
+      }
+    }
+    bitmap.SetUp(Bitmap2D::DirectionMajor::XMAJOR);
+    DrawPolygonsMask<double>(local_polygons, &bitmap);
+    local_ms += std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+
+    start = std::chrono::steady_clock::now();
+    if (!cache.Update(polygon_ptrs, center, kRange)) {
+      fprintf(stderr, "frame %d: failed to update the tiles\n", frame);
+      return 1;
+    }
+    cache_ms += std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+    const size_t built = cache.stats().tiles_built;
+    if (frame == 0) {
+      first_tiles_built = built;
+    } else {
+      tiles_built += built;
+      max_tiles_built = std::max(max_tiles_built, built);
+    }
+
+    if (frame % 50 == 0) {
+      for (double x = -kRange + 0.5 * kCellSize; x < kRange; x += kCellSize) {
+        for (double y = -kRange + 0.5 * kCellSize; y < kRange;
+             y += 4 * kCellSize) {
+          ++cells;
+          agreed += bitmap.Check(Eigen::Vector2d(x, y)) ==
+                    cache.Check(center.x() + x, center.y() + y);
+        }
+      }
+    }
+  }
+
+  const int later_frames = std::max(num_frames - 1, 1);
+  printf("%d frames at %.2f m per frame, range %.0f m, %d cell tiles\n",
+         num_frames, speed, kRange, kTileCells);
+  printf("car local bitmap  %8.3f ms per frame\n", local_ms / num_frames);
+  printf("tile cache        %8.3f ms per frame\n", cache_ms / num_frames);
+  printf("tiles built: %zu in the first frame, %.3f per frame after, max %zu\n",
+         first_tiles_built, static_cast<double>(tiles_built) / later_frames,
+         max_tiles_built);
+  printf("cells agreeing: %.4f%%\n",
+         100.0 * agreed / std::max<size_t>(cells, 1));
+  return 0;
+}
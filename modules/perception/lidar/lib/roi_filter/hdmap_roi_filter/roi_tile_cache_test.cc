@@ -0,0 +1,232 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/roi_tile_cache.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/perception/lidar/lib/roi_filter/hdmap_roi_filter/polygon_mask.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+namespace {
+
+using PolygonPtrs = apollo::common::EigenVector<base::PolygonDType*>;
+
+const double kCellSize = 0.25;
+const int kTileCells = 128;
+const double kTileSize = kTileCells * kCellSize;
+
+base::PolygonDType MakePolygon(const std::vector<Eigen::Vector2d>& points) {
+  base::PolygonDType polygon;
+  for (const auto& p : points) {
+    base::PointD pt;
+    pt.x = p.x();
+    pt.y = p.y();
+    pt.z = 0.0;
+    polygon.push_back(pt);
+  }
+  return polygon;
+}
+
+// A straight road along x and a slanted one crossing it, far from the
+// origin as map coordinates are.
+apollo::common::EigenVector<base::PolygonDType> MakeRoads() {
+  apollo::common::EigenVector<base::PolygonDType> roads;
+  roads.push_back(MakePolygon({{438000.0, 4432000.0},
+                               {438400.0, 4432000.0},
+                               {438400.0, 4432010.6},
+                               {438000.0, 4432010.6}}));
+  roads.push_back(MakePolygon({{438100.3, 4431900.0},
+                               {438112.7, 4431900.0},
+                               {438160.1, 4432100.0},
+                               {438147.9, 4432100.0}}));
+  return roads;
+}
+
+PolygonPtrs Pointers(apollo::common::EigenVector<base::PolygonDType>* roads) {
+  PolygonPtrs pointers;
+  for (auto& road : *roads) {
+    pointers.push_back(&road);
+  }
+  return pointers;
+}
+
+}  // namespace
+
+TEST(RoiTileCacheTest, matches_car_local_bitmap) {
+  auto roads = MakeRoads();
+  RoiTileCache cache;
+  cache.Init(kCellSize, kTileCells, 64, 0.0, false);
+  // on a cell corner, so the car local cells are world cells
+  const Eigen::Vector2d center(438120.0, 4432005.0);
+  const double range = 60.0;
+  ASSERT_TRUE(cache.Update(Pointers(&roads), center, range));
+
+  // as HdmapROIFilter::FilterWithPolygonMask draws them
+  Bitmap2D bitmap;
+  bitmap.Init(Eigen::Vector2d(-range, -range), Eigen::Vector2d(range, range),
+              Eigen::Vector2d(kCellSize, kCellSize));
+  bitmap.SetUp(Bitmap2D::DirectionMajor::XMAJOR);
+  std::vector<PolygonScanCvter<double>::Polygon> local_polygons;
+  for (const auto& road : roads) {
+    PolygonScanCvter<double>::Polygon polygon;
+    for (size_t i = 0; i < road.size(); ++i) {
+      polygon.emplace_back(road[i].x - center.x(), road[i].y - center.y());
+    }
+    local_polygons.push_back(polygon);
+  }
+  ASSERT_TRUE(DrawPolygonsMask<double>(local_polygons, &bitmap));
+
+  // Bitmap2D::Set leaves out the last cell of an interval that spans words,
+  // so the cells at the ends of the intervals may differ with the words.
+  int in_roi = 0;
+  int edge_mismatches = 0;
+  int mismatches = 0;
+  for (double x = -range + 0.5 * kCellSize; x < range; x += kCellSize) {
+    for (double y = -range + 1.5 * kCellSize; y < range - kCellSize;
+         y += kCellSize) {
+      const bool expected = bitmap.Check(Eigen::Vector2d(x, y));
+      in_roi += expected;
+      if (expected == cache.Check(center.x() + x, center.y() + y)) {
+        continue;
+      }
+      if (bitmap.Check(Eigen::Vector2d(x, y - kCellSize)) != expected ||
+          bitmap.Check(Eigen::Vector2d(x, y + kCellSize)) != expected) {
+        ++edge_mismatches;
+      } else {
+        ++mismatches;
+      }
+    }
+  }
+  EXPECT_GT(in_roi, 10000);
+  EXPECT_LT(edge_mismatches, in_roi / 10);
+  EXPECT_EQ(mismatches, 0);
+  EXPECT_TRUE(cache.Check(438050.0, 4432005.0));
+  EXPECT_FALSE(cache.Check(438050.0, 4432020.0));
+  // outside the window
+  EXPECT_FALSE(cache.Check(438300.0, 4432005.0));
+}
+
+TEST(RoiTileCacheTest, builds_new_tiles_only) {
+  auto roads = MakeRoads();
+  const PolygonPtrs polygons = Pointers(&roads);
+  RoiTileCache cache;
+  cache.Init(kCellSize, kTileCells, 64, 0.0, false);
+  Eigen::Vector2d center(438100.0 + 0.5 * kTileSize, 4432005.0);
+  const double range = 60.0;
+  ASSERT_TRUE(cache.Update(polygons, center, range));
+  const size_t window_tiles = cache.stats().tiles_built;
+  EXPECT_GT(window_tiles, 0);
+  EXPECT_EQ(cache.stats().tiles_reused, 0);
+
+  // a frame later, within the same tiles
+  center.x() += 1.0;
+  ASSERT_TRUE(cache.Update(polygons, center, range));
+  EXPECT_EQ(cache.stats().tiles_built, 0);
+  EXPECT_EQ(cache.stats().tiles_reused, window_tiles);
+
+  // a tile further, one new column of tiles
+  center.x() += kTileSize;
+  ASSERT_TRUE(cache.Update(polygons, center, range));
+  EXPECT_GT(cache.stats().tiles_built, 0);
+  EXPECT_LT(cache.stats().tiles_built, window_tiles / 2);
+  EXPECT_EQ(cache.stats().tiles_built + cache.stats().tiles_reused,
+            window_tiles);
+}
+
+TEST(RoiTileCacheTest, rebuilds_changed_tiles) {
+  auto roads = MakeRoads();
+  RoiTileCache cache;
+  cache.Init(kCellSize, kTileCells, 64, 0.0, false);
+  const Eigen::Vector2d center(438120.0, 4432005.0);
+  ASSERT_TRUE(cache.Update(Pointers(&roads), center, 60.0));
+  EXPECT_FALSE(cache.Check(438125.0, 4432040.0));
+
+  // a parking lot appears in one tile
+  roads.push_back(MakePolygon({{438121.0, 4432035.0},
+                               {438129.0, 4432035.0},
+                               {438129.0, 4432045.0},
+                               {438121.0, 4432045.0}}));
+  ASSERT_TRUE(cache.Update(Pointers(&roads), center, 60.0));
+  EXPECT_EQ(cache.stats().tiles_built, 1);
+  EXPECT_TRUE(cache.Check(438125.0, 4432040.0));
+
+  // and moves
+  for (size_t i = 0; i < roads.back().size(); ++i) {
+    roads.back()[i].x += 0.5;
+  }
+  ASSERT_TRUE(cache.Update(Pointers(&roads), center, 60.0));
+  EXPECT_EQ(cache.stats().tiles_built, 1);
+  EXPECT_FALSE(cache.Check(438121.2, 4432040.0));
+}
+
+TEST(RoiTileCacheTest, evicts_least_recently_used) {
+  auto roads = MakeRoads();
+  const PolygonPtrs polygons = Pointers(&roads);
+  RoiTileCache cache;
+  cache.Init(kCellSize, kTileCells, 20, 0.0, false);
+  Eigen::Vector2d center(437900.0, 4432005.0);
+  ASSERT_TRUE(cache.Update(polygons, center, 40.0));
+  const size_t window_tiles = cache.stats().tiles_built;
+  size_t evicted = 0;
+  for (int frame = 0; frame < 100; ++frame) {
+    center.x() += 5.0;
+    ASSERT_TRUE(cache.Update(polygons, center, 40.0));
+    EXPECT_LE(cache.stats().tiles_cached, std::max<size_t>(20, window_tiles));
+    evicted += cache.stats().tiles_evicted;
+  }
+  EXPECT_GT(evicted, 0);
+  EXPECT_TRUE(cache.Check(438390.0, 4432005.0));
+}
+
+TEST(RoiTileCacheTest, crop_matches_check) {
+  auto roads = MakeRoads();
+  RoiTileCache cache;
+  cache.Init(kCellSize, kTileCells, 64, 0.0, false);
+  // off the cells, the crop starts at the world cell below
+  const Eigen::Vector2d center(438120.13, 4431999.71);
+  const double range = 30.0;
+  ASSERT_TRUE(cache.Update(Pointers(&roads), center, range));
+
+  std::vector<uint64_t> bitmap;
+  RoiTileCache::Vec2ui map_size;
+  Eigen::Vector2d origin;
+  cache.Crop(center, range, &bitmap, &map_size, &origin);
+  EXPECT_EQ(map_size[0], 241);
+  EXPECT_EQ(map_size[1], 4);
+  EXPECT_LE(origin.x(), center.x() - range);
+  EXPECT_GT(origin.x(), center.x() - range - kCellSize);
+  int in_roi = 0;
+  for (size_t ix = 0; ix < map_size[0]; ++ix) {
+    for (size_t iy = 0; iy < map_size[0]; ++iy) {
+      const bool bit =
+          (bitmap[ix * map_size[1] + (iy >> 6)] >> (iy & 63)) & 1;
+      in_roi += bit;
+      ASSERT_EQ(bit, cache.Check(origin.x() + (ix + 0.5) * kCellSize,
+                                 origin.y() + (iy + 0.5) * kCellSize))
+          << ix << " " << iy;
+    }
+  }
+  EXPECT_GT(in_roi, 1000);
+}
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
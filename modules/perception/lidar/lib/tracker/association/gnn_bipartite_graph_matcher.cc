@@ -74,13 +74,23 @@ void GnnBipartiteGraphMatcher::Match(
   col_tag_.assign(num_cols, 0);
 
   std::vector<MatchCost> match_costs;
-  for (int r = 0; r < num_rows; r++) {
-    for (int c = 0; c < num_cols; c++) {
-      if ((*cost_matrix)(r, c) < max_dist) {
-        MatchCost item(r, c, (*cost_matrix)(r, c));
+  if (options.candidate_pairs != nullptr) {
+    for (const auto& pair : *options.candidate_pairs) {
+      if ((*cost_matrix)(pair.first, pair.second) < max_dist) {
+        MatchCost item(pair.first, pair.second,
+                       (*cost_matrix)(pair.first, pair.second));
         match_costs.push_back(item);
       }
     }
+  } else {
+    for (int r = 0; r < num_rows; r++) {
+      for (int c = 0; c < num_cols; c++) {
+        if ((*cost_matrix)(r, c) < max_dist) {
+          MatchCost item(r, c, (*cost_matrix)(r, c));
+          match_costs.push_back(item);
+        }
+      }
+    }
   }
 
   // sort costs in ascending order
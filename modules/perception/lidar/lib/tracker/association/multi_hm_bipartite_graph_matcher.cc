@@ -38,8 +38,14 @@ void MultiHmBipartiteGraphMatcher::Match(
     std::vector<size_t> *unassigned_cols) {
   common::GatedHungarianMatcher<float>::OptimizeFlag opt_flag =
       common::GatedHungarianMatcher<float>::OptimizeFlag::OPTMIN;
-  optimizer_.Match(options.cost_thresh, options.bound_value, opt_flag,
-                   assignments, unassigned_rows, unassigned_cols);
+  if (options.candidate_pairs != nullptr) {
+    optimizer_.Match(options.cost_thresh, options.bound_value, opt_flag,
+                     *options.candidate_pairs, assignments, unassigned_rows,
+                     unassigned_cols);
+  } else {
+    optimizer_.Match(options.cost_thresh, options.bound_value, opt_flag,
+                     assignments, unassigned_rows, unassigned_cols);
+  }
 }
 
 PERCEPTION_REGISTER_BIPARTITEGRAPHMATCHER(MultiHmBipartiteGraphMatcher);
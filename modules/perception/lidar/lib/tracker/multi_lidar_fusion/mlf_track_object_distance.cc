@@ -16,6 +16,9 @@
 
 #include "modules/perception/lidar/lib/tracker/multi_lidar_fusion/mlf_track_object_distance.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "cyber/common/file.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/lidar/lib/tracker/association/distance_collection.h"
@@ -161,6 +164,37 @@ float MlfTrackObjectDistance::ComputeDistance(
   return distance;
 }
 
+void MlfTrackObjectDistance::GetLocationBoundWeights(
+    bool is_background, float* location_weight,
+    float* centroid_shift_weight) const {
+  const auto& table =
+      is_background ? background_weight_table_ : foreground_weight_table_;
+  const std::vector<float>& default_weights =
+      is_background ? kBackgroundDefaultWeight : kForegroundDefaultWeight;
+  std::vector<const std::vector<float>*> all_weights = {&default_weights};
+  for (const auto& entry : table) {
+    all_weights.push_back(&entry.second);
+  }
+  *location_weight = std::numeric_limits<float>::max();
+  *centroid_shift_weight = std::numeric_limits<float>::max();
+  for (const std::vector<float>* weights : all_weights) {
+    // ComputeDistance rejects such weights with a huge distance
+    if (weights->size() < 7) {
+      continue;
+    }
+    // every term is non-negative, so is every weighted one
+    for (size_t i = 0; i < 7; ++i) {
+      if (weights->at(i) < 0.f) {
+        *location_weight = 0.f;
+        *centroid_shift_weight = 0.f;
+        return;
+      }
+    }
+    *location_weight = std::min(*location_weight, weights->at(0));
+    *centroid_shift_weight = std::min(*centroid_shift_weight, weights->at(5));
+  }
+}
+
 }  // namespace lidar
 }  // namespace perception
 }  // namespace apollo
@@ -43,6 +43,16 @@ class MlfTrackObjectDistance {
   float ComputeDistance(const TrackedObjectConstPtr& object,
                         const MlfTrackDataConstPtr& track) const;
 
+  // @brief: get the weights by which the location terms bound the distance
+  // from below for every sensor pair, i.e. distance >= location_weight *
+  // LocationDistance and distance >= centroid_shift_weight *
+  // CentroidShiftDistance
+  // @params [in]: whether the objects are background
+  // @params [out]: location dist weight, 0 if it gives no bound
+  // @params [out]: centroid shift dist weight, 0 if it gives no bound
+  void GetLocationBoundWeights(bool is_background, float* location_weight,
+                               float* centroid_shift_weight) const;
+
   std::string Name() const { return "MlfTrackObjectDistance"; }
 
  protected:
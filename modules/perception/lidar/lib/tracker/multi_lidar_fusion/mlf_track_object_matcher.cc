@@ -16,6 +16,9 @@
 
 #include "modules/perception/lidar/lib/tracker/multi_lidar_fusion/mlf_track_object_matcher.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <numeric>
 
 #include "cyber/common/file.h"
@@ -26,6 +29,104 @@ namespace apollo {
 namespace perception {
 namespace lidar {
 
+namespace {
+
+// Uniform grid over 2d points, answering which points are within a radius.
+class PointGrid {
+ public:
+  // @brief: bin the points into cells of at least min_cell_size, enlarged
+  // until there are not many more cells than points
+  void Build(const std::vector<Eigen::Vector2d> &points,
+             double min_cell_size) {
+    points_ = &points;
+    min_ = points[0];
+    Eigen::Vector2d max = points[0];
+    for (const auto &point : points) {
+      min_ = min_.cwiseMin(point);
+      max = max.cwiseMax(point);
+    }
+    cell_size_ = std::max(min_cell_size, 1e-3);
+    const double max_num_cells = 4.0 * static_cast<double>(points.size()) + 64;
+    while (true) {
+      const Eigen::Vector2d extent = (max - min_) / cell_size_;
+      if ((std::floor(extent(0)) + 1) * (std::floor(extent(1)) + 1) <=
+          max_num_cells) {
+        cols_ = static_cast<int>(extent(0)) + 1;
+        rows_ = static_cast<int>(extent(1)) + 1;
+        break;
+      }
+      cell_size_ *= 2.0;
+    }
+    // points sorted by cell, ascending in a cell
+    cell_begin_.assign(rows_ * cols_ + 1, 0);
+    point_cells_.resize(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+      const Eigen::Vector2d pos = (points[i] - min_) / cell_size_;
+      point_cells_[i] = std::min(static_cast<int>(pos(1)), rows_ - 1) * cols_ +
+                        std::min(static_cast<int>(pos(0)), cols_ - 1);
+      ++cell_begin_[point_cells_[i] + 1];
+    }
+    std::partial_sum(cell_begin_.begin(), cell_begin_.end(),
+                     cell_begin_.begin());
+    cell_points_.resize(points.size());
+    std::vector<size_t> cell_end(cell_begin_.begin(), cell_begin_.end() - 1);
+    for (size_t i = 0; i < points.size(); ++i) {
+      cell_points_[cell_end[point_cells_[i]]++] = i;
+    }
+  }
+
+  // @brief: get the points within radius of center, in ascending order
+  void Query(const Eigen::Vector2d &center, double radius,
+             std::vector<size_t> *indices) const {
+    indices->clear();
+    int min_col = 0;
+    int max_col = 0;
+    int min_row = 0;
+    int max_row = 0;
+    if (!CellRange(center(0) - min_(0), radius, cols_, &min_col, &max_col) ||
+        !CellRange(center(1) - min_(1), radius, rows_, &min_row, &max_row)) {
+      return;
+    }
+    const double sqr_radius = radius * radius;
+    for (int r = min_row; r <= max_row; ++r) {
+      for (int c = min_col; c <= max_col; ++c) {
+        const int cell = r * cols_ + c;
+        for (size_t k = cell_begin_[cell]; k < cell_begin_[cell + 1]; ++k) {
+          const size_t i = cell_points_[k];
+          if (((*points_)[i] - center).squaredNorm() <= sqr_radius) {
+            indices->push_back(i);
+          }
+        }
+      }
+    }
+    std::sort(indices->begin(), indices->end());
+  }
+
+ private:
+  bool CellRange(double offset, double radius, int num_cells, int *min_cell,
+                 int *max_cell) const {
+    const double lower = std::floor((offset - radius) / cell_size_);
+    const double upper = std::floor((offset + radius) / cell_size_);
+    if (upper < 0.0 || lower >= num_cells) {
+      return false;
+    }
+    *min_cell = static_cast<int>(std::max(lower, 0.0));
+    *max_cell = static_cast<int>(std::min(upper, num_cells - 1.0));
+    return true;
+  }
+
+  const std::vector<Eigen::Vector2d> *points_ = nullptr;
+  Eigen::Vector2d min_;
+  double cell_size_ = 1.0;
+  int rows_ = 0;
+  int cols_ = 0;
+  std::vector<int> point_cells_;
+  std::vector<size_t> cell_begin_;
+  std::vector<size_t> cell_points_;
+};
+
+}  // namespace
+
 MlfTrackObjectMatcher::MlfTrackObjectMatcher(
     const PluginConfig& plugin_config) {
   Init(plugin_config);
@@ -63,6 +164,8 @@ bool MlfTrackObjectMatcher::Init(
 
   bound_value_ = config.bound_value();
   max_match_distance_ = config.max_match_distance();
+  use_spatial_gate_ = config.use_spatial_gate();
+  num_threads_ = std::max(config.num_threads(), 1);
   return true;
 }
 
@@ -90,6 +193,8 @@ bool MlfTrackObjectMatcher::Init(const PluginConfig& plugin_config) {
 
   bound_value_ = config.bound_value();
   max_match_distance_ = config.max_match_distance();
+  use_spatial_gate_ = config.use_spatial_gate();
+  num_threads_ = std::max(config.num_threads(), 1);
   return true;
 }
 
@@ -121,7 +226,12 @@ void MlfTrackObjectMatcher::Match(
   common::SecureMat<float> *association_mat = matcher->cost_matrix();
 
   association_mat->Resize(tracks.size(), objects.size());
-  ComputeAssociateMatrix(tracks, objects, association_mat);
+  const bool gated =
+      use_spatial_gate_ && GateTrackObjectPairs(tracks, objects);
+  ComputeAssociateMatrix(tracks, objects, gated, association_mat);
+  if (gated) {
+    matcher_options.candidate_pairs = &candidate_pairs_;
+  }
   matcher->Match(matcher_options, assignments, unassigned_tracks,
                  unassigned_objects);
   for (size_t i = 0; i < assignments->size(); ++i) {
@@ -132,16 +242,120 @@ void MlfTrackObjectMatcher::Match(
   }
 }
 
+bool MlfTrackObjectMatcher::GateTrackObjectPairs(
+    const std::vector<MlfTrackDataPtr> &tracks,
+    const std::vector<TrackedObjectPtr> &new_objects) {
+  // gated pairs are given bound_value_, which must not be a match
+  if (bound_value_ < max_match_distance_) {
+    return false;
+  }
+  const bool is_background = new_objects[0]->is_background;
+  for (const auto &object : new_objects) {
+    if (object->is_background != is_background) {
+      return false;
+    }
+  }
+  float location_weight = 0.f;
+  float centroid_shift_weight = 0.f;
+  track_object_distance_->GetLocationBoundWeights(
+      is_background, &location_weight, &centroid_shift_weight);
+  // LocationDistance is at least sqrt(0.5) of the xy distance of the anchor
+  // point to the predicted one, CentroidShiftDistance is the xy distance of
+  // the barycenters
+  const bool use_location = location_weight > 0.f;
+  double radius = 0.0;
+  if (use_location) {
+    radius = max_match_distance_ / (location_weight * std::sqrt(0.5));
+  } else if (centroid_shift_weight > 0.f) {
+    radius = max_match_distance_ / centroid_shift_weight;
+  } else {
+    return false;
+  }
+  radius = radius * (1.0 + 1e-3) + 1e-3;
+  // The distances are computed from float coordinates, which are off by up
+  // to an ulp of the coordinate, i.e. half a meter at utm coordinates. The
+  // gate is widened by a few ulps of the largest coordinate.
+  constexpr double kFloatMargin = 4.0 * std::numeric_limits<float>::epsilon();
+
+  std::vector<Eigen::Vector2d> points(new_objects.size());
+  double max_coordinate = 0.0;
+  double min_time = std::numeric_limits<double>::max();
+  double max_time = std::numeric_limits<double>::lowest();
+  for (size_t j = 0; j < new_objects.size(); ++j) {
+    points[j] = use_location ? new_objects[j]->anchor_point.head<2>()
+                             : new_objects[j]->barycenter.head<2>();
+    if (!points[j].allFinite()) {
+      return false;
+    }
+    max_coordinate = std::max(max_coordinate, points[j].cwiseAbs().maxCoeff());
+    const double time = new_objects[j]->object_ptr->latest_tracked_time;
+    min_time = std::min(min_time, time);
+    max_time = std::max(max_time, time);
+  }
+  // the tracks are predicted to the middle time, each object is at most
+  // half the time range away from it
+  const double mid_time = 0.5 * (min_time + max_time);
+  const double half_time_range = 0.5 * (max_time - min_time);
+  PointGrid grid;
+  grid.Build(points, radius);
+
+  track_candidates_.resize(tracks.size());
+  for (size_t i = 0; i < tracks.size(); ++i) {
+    const auto latest = tracks[i]->GetLatestObject();
+    Eigen::Vector2d center;
+    double track_radius = radius;
+    if (use_location) {
+      const Eigen::Vector2d velocity =
+          latest.second->output_velocity.head<2>();
+      center = latest.second->belief_anchor_point.head<2>() +
+               velocity * (mid_time - latest.first);
+      track_radius += velocity.norm() * half_time_range;
+    } else {
+      center = latest.second->barycenter.head<2>();
+    }
+    track_radius +=
+        kFloatMargin * std::max(max_coordinate, center.cwiseAbs().maxCoeff());
+    if (center.allFinite() && std::isfinite(track_radius)) {
+      grid.Query(center, track_radius, &track_candidates_[i]);
+    } else {
+      track_candidates_[i].resize(new_objects.size());
+      std::iota(track_candidates_[i].begin(), track_candidates_[i].end(), 0);
+    }
+  }
+  return true;
+}
+
 void MlfTrackObjectMatcher::ComputeAssociateMatrix(
     const std::vector<MlfTrackDataPtr> &tracks,
-    const std::vector<TrackedObjectPtr> &new_objects,
+    const std::vector<TrackedObjectPtr> &new_objects, bool gated,
     common::SecureMat<float> *association_mat) {
+  // each track is predicted in its own row only
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_) \
+    if (num_threads_ > 1)
   for (size_t i = 0; i < tracks.size(); ++i) {
+    if (!gated) {
+      for (size_t j = 0; j < new_objects.size(); ++j) {
+        (*association_mat)(i, j) =
+            track_object_distance_->ComputeDistance(new_objects[j], tracks[i]);
+      }
+      continue;
+    }
     for (size_t j = 0; j < new_objects.size(); ++j) {
+      (*association_mat)(i, j) = bound_value_;
+    }
+    for (size_t j : track_candidates_[i]) {
       (*association_mat)(i, j) =
           track_object_distance_->ComputeDistance(new_objects[j], tracks[i]);
     }
   }
+  if (gated) {
+    candidate_pairs_.clear();
+    for (size_t i = 0; i < tracks.size(); ++i) {
+      for (size_t j : track_candidates_[i]) {
+        candidate_pairs_.emplace_back(i, j);
+      }
+    }
+  }
 }
 
 }  // namespace lidar
@@ -67,12 +67,24 @@ class MlfTrackObjectMatcher : public pipeline::Plugin {
   std::string Name() const override { return name_; }
 
  protected:
-  // @brief: compute association matrix
+  // @brief: find for each track the objects near enough to be matched,
+  // with a grid over the objects. the distance of the other pairs is not
+  // less than max_match_distance_
   // @params [in]: maintained tracks for matching
   // @params [in]: new detected objects for matching
+  // @return: false if the distance weights do not allow a spatial gate
+  bool GateTrackObjectPairs(const std::vector<MlfTrackDataPtr> &tracks,
+                            const std::vector<TrackedObjectPtr> &new_objects);
+
+  // @brief: compute association matrix, the rows in parallel
+  // @params [in]: maintained tracks for matching
+  // @params [in]: new detected objects for matching
+  // @params [in]: only compute the pairs passing GateTrackObjectPairs and
+  // fill candidate_pairs_ with them, the others get bound_value_
   // @params [out]: matrix of association distance
   void ComputeAssociateMatrix(const std::vector<MlfTrackDataPtr> &tracks,
                               const std::vector<TrackedObjectPtr> &new_objects,
+                              bool gated,
                               common::SecureMat<float> *association_mat);
 
  protected:
@@ -83,6 +95,13 @@ class MlfTrackObjectMatcher : public pipeline::Plugin {
   float bound_value_ = 100.f;
   float max_match_distance_ = 4.0f;
   bool use_semantic_map = false;
+  bool use_spatial_gate_ = false;
+  int num_threads_ = 1;
+
+  // objects passing the gate for each track, in ascending order
+  std::vector<std::vector<size_t>> track_candidates_;
+  // pairs passing the gate, sorted by track then object
+  std::vector<std::pair<size_t, size_t>> candidate_pairs_;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(MlfTrackObjectMatcher);
@@ -0,0 +1,179 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Per-frame time of MlfTrackObjectMatcher::Match on synthetic dense
+ * traffic scenes of 50 to max_objects foreground tracks and objects, for the
+ * full association matrix and for the spatial gate with 1 to max_threads
+ * threads. The assignments of the gated matcher are checked against the full
+ * matrix ones. Reads the production configs under FLAGS_work_root.
+ *
+ * Usage: mlf_track_object_matcher_benchmark [max_objects] [max_threads]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "modules/perception/lidar/lib/tracker/multi_lidar_fusion/mlf_track_object_matcher.h"
+
+namespace {
+
+using apollo::perception::base::Object;
+using apollo::perception::base::ObjectPtr;
+using apollo::perception::base::PointF;
+using apollo::perception::base::SensorInfo;
+using apollo::perception::lidar::MlfTrackData;
+using apollo::perception::lidar::MlfTrackDataPtr;
+using apollo::perception::lidar::MlfTrackObjectMatcher;
+using apollo::perception::lidar::MlfTrackObjectMatcherOptions;
+using apollo::perception::lidar::TrackedObject;
+using apollo::perception::lidar::TrackedObjectPtr;
+using apollo::perception::pipeline::PluginConfig;
+
+// The (track, object) pairs of a frame.
+using Assignments = std::vector<std::pair<size_t, size_t>>;
+
+constexpr int kNumFrames = 20;
+constexpr double kTrackTime = 100.0;
+constexpr double kFrameTime = 100.1;
+
+struct Frame {
+  std::vector<MlfTrackDataPtr> tracks;
+  std::vector<TrackedObjectPtr> objects;
+};
+
+// A foreground object of a 4m x 2m box of 20 points around center.
+TrackedObjectPtr MockObject(const Eigen::Vector3d& center, double timestamp,
+                            const Eigen::Vector3d& velocity) {
+  ObjectPtr object(new Object);
+  object->center = center;
+  object->direction = Eigen::Vector3f(1.f, 0.f, 0.f);
+  object->size = Eigen::Vector3f(4.f, 2.f, 1.5f);
+  object->latest_tracked_time = timestamp;
+  for (int k = 0; k < 20; ++k) {
+    PointF point;
+    point.x = static_cast<float>(center.x() + 0.2 * (k % 10) - 0.9);
+    point.y = static_cast<float>(center.y() + (k < 10 ? -0.9 : 0.9));
+    point.z = static_cast<float>(center.z());
+    object->lidar_supplement.cloud.push_back(point);
+  }
+  SensorInfo sensor;
+  sensor.name = "velodyne64";
+  TrackedObjectPtr tracked_object(new TrackedObject);
+  tracked_object->AttachObject(object, Eigen::Affine3d::Identity(),
+                               Eigen::Vector3d::Zero(), sensor);
+  tracked_object->output_velocity = velocity;
+  return tracked_object;
+}
+
+// Tracks moving along a 200m x 40m road, objects near the prediction of
+// most of them and some clutter.
+Frame MockFrame(unsigned int seed, int num_objects) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> x(-100.0, 100.0);
+  std::uniform_real_distribution<double> y(-20.0, 20.0);
+  std::uniform_real_distribution<double> speed(-15.0, 15.0);
+  std::normal_distribution<double> noise(0.0, 0.3);
+  Frame frame;
+  std::vector<Eigen::Vector3d> predictions;
+  for (int i = 0; i < num_objects; ++i) {
+    const Eigen::Vector3d center(x(gen), y(gen), 0.0);
+    const Eigen::Vector3d velocity(speed(gen), 0.0, 0.0);
+    MlfTrackDataPtr track(new MlfTrackData);
+    track->track_id_ = i;
+    track->PushTrackedObjectToTrack(MockObject(center, kTrackTime, velocity));
+    frame.tracks.push_back(track);
+    predictions.push_back(center + velocity * (kFrameTime - kTrackTime));
+  }
+  for (int i = 0; i < num_objects; ++i) {
+    Eigen::Vector3d center(x(gen), y(gen), 0.0);
+    if (i % 5 != 4) {
+      center = predictions[(i * 7) % num_objects] +
+               Eigen::Vector3d(noise(gen), noise(gen), 0.0);
+    }
+    frame.objects.push_back(
+        MockObject(center, kFrameTime, Eigen::Vector3d::Zero()));
+  }
+  return frame;
+}
+
+// Mean time per frame, with the assignments of every frame.
+double RunMatcher(bool use_spatial_gate, int num_threads,
+                  const std::vector<Frame>& frames,
+                  std::vector<Assignments>* results) {
+  PluginConfig plugin_config;
+  plugin_config.set_plugin_type(
+      apollo::perception::pipeline::MLF_TRACK_OBJECT_MATCHER);
+  plugin_config.set_enabled(true);
+  auto* config = plugin_config.mutable_mlf_track_object_matcher_config();
+  config->set_use_spatial_gate(use_spatial_gate);
+  config->set_num_threads(num_threads);
+  MlfTrackObjectMatcher matcher(plugin_config);
+
+  results->resize(frames.size());
+  double total_ms = 0.0;
+  for (size_t i = 0; i < frames.size(); ++i) {
+    std::vector<size_t> unassigned_tracks;
+    std::vector<size_t> unassigned_objects;
+    const auto start = std::chrono::steady_clock::now();
+    matcher.Match(MlfTrackObjectMatcherOptions(), frames[i].objects,
+                  frames[i].tracks, &(*results)[i], &unassigned_tracks,
+                  &unassigned_objects);
+    total_ms += std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+  }
+  return total_ms / static_cast<double>(frames.size());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int max_objects = argc > 1 ? std::atoi(argv[1]) : 400;
+  const int max_threads = argc > 2 ? std::atoi(argv[2]) : 8;
+  if (max_objects <= 0 || max_threads <= 0) {
+    fprintf(stderr, "Usage: %s [max_objects] [max_threads]\n", argv[0]);
+    return 1;
+  }
+
+  for (int num_objects = 50; num_objects <= max_objects; num_objects *= 2) {
+    std::vector<Frame> frames;
+    for (int i = 0; i < kNumFrames; ++i) {
+      frames.push_back(MockFrame(static_cast<unsigned int>(i), num_objects));
+    }
+    std::vector<Assignments> full_results;
+    const double full_ms = RunMatcher(false, 1, frames, &full_results);
+    printf("%d tracks x %d objects: full matrix %.2f ms/frame\n", num_objects,
+           num_objects, full_ms);
+    for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+      std::vector<Assignments> results;
+      const double mean_ms = RunMatcher(true, num_threads, frames, &results);
+      if (results != full_results) {
+        fprintf(stderr, "Gated assignments differ with %d threads\n",
+                num_threads);
+        return 1;
+      }
+      printf("  gated, %2d threads: %.2f ms/frame, speedup %.2f\n",
+             num_threads, mean_ms, full_ms / mean_ms);
+    }
+  }
+  return 0;
+}
@@ -1,5 +1,7 @@
 #include "modules/perception/onboard/component/collision_guardian_component.h"
 
+#include <algorithm>
+
 #include "cyber/common/log.h"
 #include "cyber/time/clock.h"
 #include "modules/common/adapters/adapter_gflags.h"
@@ -25,22 +27,20 @@ bool CollisionGuardianComponent::Init() {
   vehicle_frame_id_ = comp_config.vehicle_frame_id();
 
   // Load Ego Vehicle Dimensions
-  ego_box_forward_ = static_cast<float>(comp_config.ego_box_forward());
-  ego_box_backward_ = -static_cast<float>(comp_config.ego_box_backward());
-  ego_box_side_ = static_cast<float>(comp_config.ego_box_side());
+  params_.ego_box_forward = static_cast<float>(comp_config.ego_box_forward());
+  params_.ego_box_backward =
+      -static_cast<float>(comp_config.ego_box_backward());
+  params_.ego_box_side = static_cast<float>(comp_config.ego_box_side());
 
   // Load ROI Dimensions
-  roi_forward_distance_ =
-      static_cast<float>(comp_config.roi_forward_distance());
-  roi_backward_distance_ =
+  params_.roi_forward = static_cast<float>(comp_config.roi_forward_distance());
+  params_.roi_backward =
       -static_cast<float>(comp_config.roi_backward_distance());
-  roi_side_distance_ = static_cast<float>(comp_config.roi_side_distance());
+  params_.roi_side = static_cast<float>(comp_config.roi_side_distance());
 
   // Load Filter and Trigger Logic Params
-  height_min_threshold_ =
-      static_cast<float>(comp_config.height_min_threshold());
-  height_max_threshold_ =
-      static_cast<float>(comp_config.height_max_threshold());
+  params_.height_min = static_cast<float>(comp_config.height_min_threshold());
+  params_.height_max = static_cast<float>(comp_config.height_max_threshold());
   min_points_in_roi_to_trigger_ = comp_config.min_points_in_roi_to_trigger();
   min_consecutive_frames_to_trigger_ =
       comp_config.min_consecutive_frames_to_trigger();
@@ -50,6 +50,8 @@ bool CollisionGuardianComponent::Init() {
   // The `GetTrans` method will handle the lookup.
   transform_wrapper_ = std::make_unique<TransformWrapper>();
 
+  kernel_ = std::make_unique<CollisionGuardianKernel>(params_);
+
   AINFO << "CollisionGuardianComponent Init SUCCESS";
   return true;
 }
@@ -70,8 +72,16 @@ bool CollisionGuardianComponent::Proc(
     return false;
   }
 
-  bool risk_in_current_frame =
-      CheckCollisionRisk(message, sensor2vehicle_transform);
+  const double check_start_time = Clock::NowInSeconds();
+  uint32_t points_in_roi_count = 0;
+  bool risk_in_current_frame = CheckCollisionRisk(
+      message, sensor2vehicle_transform, &points_in_roi_count);
+  const double check_time_ms =
+      (Clock::NowInSeconds() - check_start_time) * 1e3;
+  ADEBUG << "[CollisionGuardian] points: " << message->point_size()
+         << " candidates: " << kernel_->last_candidates()
+         << " hits: " << points_in_roi_count
+         << " check_time_ms: " << check_time_ms;
 
   if (risk_in_current_frame) {
     consecutive_hit_counter_++;
@@ -81,6 +91,9 @@ bool CollisionGuardianComponent::Proc(
 
   auto out_message = std::make_shared<apollo::perception::CollisionWarning>();
   out_message->mutable_header()->set_timestamp_sec(start_time);
+  out_message->set_points_num(static_cast<int32_t>(points_in_roi_count));
+  out_message->set_confirmed_frames(
+      static_cast<int32_t>(consecutive_hit_counter_));
 
   if (consecutive_hit_counter_ >= min_consecutive_frames_to_trigger_) {
     out_message->set_is_collision(true);
@@ -90,6 +103,7 @@ bool CollisionGuardianComponent::Proc(
     out_message->set_is_collision(false);
   }
 
+  out_message->set_latency_ms((Clock::NowInSeconds() - start_time) * 1e3);
   writer_->Write(out_message);
 
   return true;
@@ -97,48 +111,13 @@ bool CollisionGuardianComponent::Proc(
 
 bool CollisionGuardianComponent::CheckCollisionRisk(
     const std::shared_ptr<PointCloud>& message,
-    Eigen::Affine3d& sensor2vehicle_transform) {
-  uint32_t points_in_roi_count = 0;
-
-  for (const auto& pt : message->point()) {
-    // Layer 1: Filter invalid points
-    if (std::isnan(pt.x()) || std::isnan(pt.y()) || std::isnan(pt.z())) {
-      continue;
-    }
-
-    // Transform point to the vehicle coordinate frame for consistent filtering
-    Eigen::Vector3d point_in_vehicle_frame =
-        sensor2vehicle_transform * Eigen::Vector3d(pt.x(), pt.y(), pt.z());
-
-    // Remove any point that falls within the precise bounding box of our own
-    // vehicle.
-    if (point_in_vehicle_frame.y() < ego_box_forward_ &&
-        point_in_vehicle_frame.y() > ego_box_backward_ &&
-        std::abs(point_in_vehicle_frame.x()) < ego_box_side_) {
-      continue;  // This point is on our car, ignore it.
-    }
-
-    // Layer 3: Height Filter
-    if (point_in_vehicle_frame.z() < height_min_threshold_ ||
-        point_in_vehicle_frame.z() > height_max_threshold_) {
-      continue;
-    }
-
-    // Layer 4: ROI (Protective Field) Filter
-    if (point_in_vehicle_frame.y() > roi_forward_distance_ ||
-        point_in_vehicle_frame.y() < roi_backward_distance_ ||
-        std::abs(point_in_vehicle_frame.x()) > roi_side_distance_) {
-      continue;
-    }
-
-    points_in_roi_count++;
-
-    if (points_in_roi_count >= min_points_in_roi_to_trigger_) {
-      return true;
-    }
-  }
-
-  return false;
+    const Eigen::Affine3d& sensor2vehicle_transform,
+    uint32_t* points_in_roi_count) {
+  // A single point is a risk when the trigger count is 0.
+  const uint32_t min_hits = std::max(min_points_in_roi_to_trigger_, 1u);
+  kernel_->SetTransform(sensor2vehicle_transform);
+  *points_in_roi_count = kernel_->CountHits(*message, min_hits);
+  return *points_in_roi_count >= min_hits;
 }
 
 }  // namespace lidar
@@ -10,6 +10,7 @@
 #include "modules/perception/onboard/proto/collision_guardian_component.pb.h"
 
 #include "cyber/component/component.h"
+#include "modules/perception/onboard/component/collision_guardian_kernel.h"
 #include "modules/perception/onboard/transform_wrapper/transform_wrapper.h"
 
 namespace apollo {
@@ -30,23 +31,19 @@ class CollisionGuardianComponent : public cyber::Component<PointCloud> {
 
  private:
   // The core logic function that performs filtering and point counting on a
-  // single frame.
+  // single frame. Sets the number of points found in the ROI, which stops
+  // growing once it reaches the trigger count.
   bool CheckCollisionRisk(const std::shared_ptr<PointCloud>& message,
-                          Eigen::Affine3d& sensor2vehicle_transform);
+                          const Eigen::Affine3d& sensor2vehicle_transform,
+                          uint32_t* points_in_roi_count);
 
   // Member variables loaded from the config proto.
   std::string vehicle_frame_id_;
 
-  // Ego Vehicle Dimensions
-  float ego_box_forward_ = 0.0f;
-  float ego_box_backward_ = 0.0f;
-  float ego_box_side_ = 0.0f;
+  // Ego box, ROI and height band, in the vehicle frame.
+  CollisionGuardianParams params_;
+  std::unique_ptr<CollisionGuardianKernel> kernel_ = nullptr;
 
-  float roi_forward_distance_ = 0.0f;
-  float roi_backward_distance_ = 0.0f;
-  float roi_side_distance_ = 0.0f;
-  float height_min_threshold_ = 0.0f;
-  float height_max_threshold_ = 0.0f;
   uint32_t min_points_in_roi_to_trigger_ = 0;
   uint32_t min_consecutive_frames_to_trigger_ = 0;
 
@@ -0,0 +1,161 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/onboard/component/collision_guardian_kernel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+namespace {
+
+// Padding of the sensor frame bounding box, large against the rounding of
+// the float transform at lidar ranges.
+constexpr double kBoundAbsPadding = 1e-3;
+constexpr double kBoundRelPadding = 1e-5;
+
+}  // namespace
+
+void CollisionGuardianKernel::SetTransform(
+    const Eigen::Affine3d& sensor2vehicle) {
+  const Eigen::Matrix<double, 3, 4> m = sensor2vehicle.matrix().topRows<3>();
+  for (int r = 0; r < 3; ++r) {
+    for (int c = 0; c < 4; ++c) {
+      m_[r][c] = static_cast<float>(m(r, c));
+    }
+  }
+
+  // Only the part of the field inside the height band can hit, the ego box
+  // only removes points.
+  const double min_v[3] = {-params_.roi_side, params_.roi_backward,
+                           params_.height_min};
+  const double max_v[3] = {params_.roi_side, params_.roi_forward,
+                           params_.height_max};
+  empty_ = false;
+  for (int k = 0; k < 3; ++k) {
+    empty_ = empty_ || !(min_v[k] <= max_v[k]);
+  }
+  if (empty_) {
+    return;
+  }
+
+  const Eigen::Affine3d vehicle2sensor = sensor2vehicle.inverse();
+  Eigen::Vector3d lo = Eigen::Vector3d::Constant(
+      std::numeric_limits<double>::max());
+  Eigen::Vector3d hi = -lo;
+  for (int corner = 0; corner < 8; ++corner) {
+    const Eigen::Vector3d v((corner & 1) ? max_v[0] : min_v[0],
+                            (corner & 2) ? max_v[1] : min_v[1],
+                            (corner & 4) ? max_v[2] : min_v[2]);
+    const Eigen::Vector3d s = vehicle2sensor * v;
+    lo = lo.cwiseMin(s);
+    hi = hi.cwiseMax(s);
+  }
+  for (int k = 0; k < 3; ++k) {
+    const double pad =
+        kBoundAbsPadding +
+        kBoundRelPadding * std::max(std::abs(lo[k]), std::abs(hi[k]));
+    bound_min_[k] = static_cast<float>(lo[k] - pad);
+    bound_max_[k] = static_cast<float>(hi[k] + pad);
+  }
+}
+
+uint32_t CollisionGuardianKernel::CountHits(
+    const apollo::drivers::PointCloud& cloud, uint32_t max_hits) {
+  last_candidates_ = 0;
+  if (empty_) {
+    return 0;
+  }
+  alignas(64) float x[kTileSize];
+  alignas(64) float y[kTileSize];
+  alignas(64) float z[kTileSize];
+
+  const auto& points = cloud.point();
+  const size_t size = static_cast<size_t>(points.size());
+  uint32_t hits = 0;
+  for (size_t begin = 0; begin < size; begin += kTileSize) {
+    const size_t tile = std::min(kTileSize, size - begin);
+    for (size_t i = 0; i < tile; ++i) {
+      const auto& pt = points.Get(static_cast<int>(begin + i));
+      x[i] = pt.x();
+      y[i] = pt.y();
+      z[i] = pt.z();
+    }
+    hits += CountTile(x, y, z, tile);
+    if (max_hits > 0 && hits >= max_hits) {
+      break;
+    }
+  }
+  return hits;
+}
+
+uint32_t CollisionGuardianKernel::CountTile(const float* x, const float* y,
+                                            const float* z, size_t size) {
+  alignas(64) uint8_t candidate[kTileSize];
+
+  // Bounding box in the sensor frame. NaN fails every comparison, so invalid
+  // points are rejected here as well.
+  const float min_x = bound_min_[0], max_x = bound_max_[0];
+  const float min_y = bound_min_[1], max_y = bound_max_[1];
+  const float min_z = bound_min_[2], max_z = bound_max_[2];
+  uint32_t candidates = 0;
+#pragma omp simd reduction(+ : candidates)
+  for (size_t i = 0; i < size; ++i) {
+    const uint8_t inside = (x[i] >= min_x) & (x[i] <= max_x) &
+                           (y[i] >= min_y) & (y[i] <= max_y) &
+                           (z[i] >= min_z) & (z[i] <= max_z);
+    candidate[i] = inside;
+    candidates += inside;
+  }
+  last_candidates_ += candidates;
+  if (candidates == 0) {
+    return 0;
+  }
+
+  const float r00 = m_[0][0], r01 = m_[0][1], r02 = m_[0][2], t0 = m_[0][3];
+  const float r10 = m_[1][0], r11 = m_[1][1], r12 = m_[1][2], t1 = m_[1][3];
+  const float r20 = m_[2][0], r21 = m_[2][1], r22 = m_[2][2], t2 = m_[2][3];
+  const float ego_forward = params_.ego_box_forward;
+  const float ego_backward = params_.ego_box_backward;
+  const float ego_side = params_.ego_box_side;
+  const float roi_forward = params_.roi_forward;
+  const float roi_backward = params_.roi_backward;
+  const float roi_side = params_.roi_side;
+  const float height_min = params_.height_min;
+  const float height_max = params_.height_max;
+  uint32_t hits = 0;
+#pragma omp simd reduction(+ : hits)
+  for (size_t i = 0; i < size; ++i) {
+    const float vx = r00 * x[i] + r01 * y[i] + r02 * z[i] + t0;
+    const float vy = r10 * x[i] + r11 * y[i] + r12 * z[i] + t1;
+    const float vz = r20 * x[i] + r21 * y[i] + r22 * z[i] + t2;
+    const float abs_vx = std::fabs(vx);
+    const uint32_t on_ego = (vy < ego_forward) & (vy > ego_backward) &
+                            (abs_vx < ego_side);
+    const uint32_t in_band = (vz >= height_min) & (vz <= height_max);
+    const uint32_t in_roi = (vy <= roi_forward) & (vy >= roi_backward) &
+                            (abs_vx <= roi_side);
+    hits += candidate[i] & (on_ego ^ 1u) & in_band & in_roi;
+  }
+  return hits;
+}
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
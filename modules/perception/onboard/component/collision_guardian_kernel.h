@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <Eigen/Geometry>
+
+#include "modules/common_msgs/sensor_msgs/pointcloud.pb.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+// Boxes of the collision guardian, in the vehicle frame. y points forward,
+// x to the side. The backward bounds are y values, not distances.
+struct CollisionGuardianParams {
+  float ego_box_forward = 0.0f;
+  float ego_box_backward = 0.0f;
+  float ego_box_side = 0.0f;
+  float roi_forward = 0.0f;
+  float roi_backward = 0.0f;
+  float roi_side = 0.0f;
+  float height_min = 0.0f;
+  float height_max = 0.0f;
+};
+
+// @brief counts the points of a cloud that are inside the protective field,
+// outside the ego box and inside the height band, in the vehicle frame.
+// Points are read in tiles. A tile is first tested against the bounding box
+// of the field in the sensor frame, so that most points are rejected without
+// a transform, and the rest of the tile is transformed and tested with float
+// SIMD loops.
+class CollisionGuardianKernel {
+ public:
+  static constexpr size_t kTileSize = 256;
+
+  explicit CollisionGuardianKernel(const CollisionGuardianParams& params)
+      : params_(params) {}
+
+  // @brief set the transform from the sensor to the vehicle frame and
+  // update the sensor frame bounding box of the field
+  void SetTransform(const Eigen::Affine3d& sensor2vehicle);
+
+  // @brief count the points in the field
+  // @param max_hits stop after the tile in which the count reaches max_hits,
+  // 0 to count all points
+  // @return number of points in the field, at least max_hits if the count
+  // stopped early
+  uint32_t CountHits(const apollo::drivers::PointCloud& cloud,
+                     uint32_t max_hits);
+
+  // @brief number of points tested in the vehicle frame by the last
+  // CountHits, i.e. those not rejected by the bounding box
+  size_t last_candidates() const { return last_candidates_; }
+
+ private:
+  uint32_t CountTile(const float* x, const float* y, const float* z,
+                     size_t size);
+
+  CollisionGuardianParams params_;
+
+  // Top rows of sensor2vehicle, in float.
+  float m_[3][4] = {};
+  // Bounding box of the field in the sensor frame, padded for rounding.
+  float bound_min_[3] = {};
+  float bound_max_[3] = {};
+  // An empty field, no point can hit.
+  bool empty_ = true;
+
+  size_t last_candidates_ = 0;
+};
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/onboard/component/collision_guardian_kernel.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace lidar {
+
+namespace {
+
+// Component defaults, with the backward bounds negated as in Init.
+CollisionGuardianParams DefaultParams() {
+  CollisionGuardianParams params;
+  params.ego_box_forward = 2.5f;
+  params.ego_box_backward = -1.0f;
+  params.ego_box_side = 1.1f;
+  params.roi_forward = 3.0f;
+  params.roi_backward = -2.0f;
+  params.roi_side = 1.2f;
+  params.height_min = -0.1f;
+  params.height_max = 2.0f;
+  return params;
+}
+
+// The per-point loop the component used before the kernel, in double.
+uint32_t ReferenceCountHits(const CollisionGuardianParams& params,
+                            const Eigen::Affine3d& sensor2vehicle,
+                            const apollo::drivers::PointCloud& cloud) {
+  uint32_t hits = 0;
+  for (const auto& pt : cloud.point()) {
+    if (std::isnan(pt.x()) || std::isnan(pt.y()) || std::isnan(pt.z())) {
+      continue;
+    }
+    const Eigen::Vector3d p =
+        sensor2vehicle * Eigen::Vector3d(pt.x(), pt.y(), pt.z());
+    if (p.y() < params.ego_box_forward && p.y() > params.ego_box_backward &&
+        std::abs(p.x()) < params.ego_box_side) {
+      continue;
+    }
+    if (p.z() < params.height_min || p.z() > params.height_max) {
+      continue;
+    }
+    if (p.y() > params.roi_forward || p.y() < params.roi_backward ||
+        std::abs(p.x()) > params.roi_side) {
+      continue;
+    }
+    ++hits;
+  }
+  return hits;
+}
+
+// Points around the vehicle and far away, with some NaN coordinates.
+void MockPointCloud(size_t size, unsigned seed,
+                    apollo::drivers::PointCloud* cloud) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> near(-5.f, 5.f);
+  std::uniform_real_distribution<float> far(-80.f, 80.f);
+  std::uniform_real_distribution<float> height(-2.f, 3.f);
+  cloud->Clear();
+  for (size_t i = 0; i < size; ++i) {
+    auto* pt = cloud->add_point();
+    const bool is_near = i % 4 == 0;
+    pt->set_x(is_near ? near(gen) : far(gen));
+    pt->set_y(is_near ? near(gen) : far(gen));
+    pt->set_z(height(gen));
+    if (i % 97 == 0) {
+      pt->set_y(std::numeric_limits<float>::quiet_NaN());
+    }
+  }
+}
+
+std::vector<Eigen::Affine3d> MockTransforms() {
+  std::vector<Eigen::Affine3d> transforms;
+  transforms.push_back(Eigen::Affine3d::Identity());
+  Eigen::Affine3d yawed = Eigen::Affine3d::Identity();
+  yawed.translate(Eigen::Vector3d(0.3, 1.2, 1.8));
+  yawed.rotate(Eigen::AngleAxisd(M_PI / 2, Eigen::Vector3d::UnitZ()));
+  transforms.push_back(yawed);
+  Eigen::Affine3d tilted = Eigen::Affine3d::Identity();
+  tilted.translate(Eigen::Vector3d(-0.5, 2.0, 1.5));
+  tilted.rotate(Eigen::AngleAxisd(0.3, Eigen::Vector3d(0.2, 0.1, 1.0)
+                                           .normalized()));
+  transforms.push_back(tilted);
+  return transforms;
+}
+
+}  // namespace
+
+TEST(CollisionGuardianKernelTest, MatchesReference) {
+  const CollisionGuardianParams params = DefaultParams();
+  CollisionGuardianKernel kernel(params);
+  apollo::drivers::PointCloud cloud;
+  // Sizes that are not multiples of the tile size.
+  for (size_t size : {0, 1, 255, 1000, 120000}) {
+    MockPointCloud(size, static_cast<unsigned>(size), &cloud);
+    for (const auto& transform : MockTransforms()) {
+      kernel.SetTransform(transform);
+      const uint32_t expected = ReferenceCountHits(params, transform, cloud);
+      EXPECT_EQ(expected, kernel.CountHits(cloud, 0)) << size;
+      EXPECT_LE(expected, kernel.last_candidates());
+    }
+  }
+}
+
+TEST(CollisionGuardianKernelTest, RejectsMostPointsBeforeTransform) {
+  CollisionGuardianKernel kernel(DefaultParams());
+  apollo::drivers::PointCloud cloud;
+  MockPointCloud(20000, 3, &cloud);
+  kernel.SetTransform(MockTransforms()[1]);
+  kernel.CountHits(cloud, 0);
+  EXPECT_GT(kernel.last_candidates(), 0);
+  EXPECT_LT(kernel.last_candidates(),
+            static_cast<size_t>(cloud.point_size()) / 4);
+}
+
+TEST(CollisionGuardianKernelTest, StopsEarly) {
+  const CollisionGuardianParams params = DefaultParams();
+  CollisionGuardianKernel kernel(params);
+  apollo::drivers::PointCloud cloud;
+  MockPointCloud(120000, 5, &cloud);
+  const Eigen::Affine3d transform = MockTransforms()[2];
+  kernel.SetTransform(transform);
+  const uint32_t total = ReferenceCountHits(params, transform, cloud);
+  ASSERT_GT(total, 10);
+
+  const uint32_t hits = kernel.CountHits(cloud, 5);
+  EXPECT_GE(hits, 5);
+  EXPECT_LT(hits, total);
+  EXPECT_EQ(total, kernel.CountHits(cloud, total));
+  EXPECT_EQ(total, kernel.CountHits(cloud, total + 1));
+}
+
+TEST(CollisionGuardianKernelTest, EmptyField) {
+  CollisionGuardianParams params = DefaultParams();
+  params.height_min = 1.0f;
+  params.height_max = 0.0f;
+  CollisionGuardianKernel kernel(params);
+  apollo::drivers::PointCloud cloud;
+  MockPointCloud(1000, 1, &cloud);
+  // No transform set yet.
+  EXPECT_EQ(0, kernel.CountHits(cloud, 0));
+  kernel.SetTransform(Eigen::Affine3d::Identity());
+  EXPECT_EQ(0, kernel.CountHits(cloud, 0));
+  EXPECT_EQ(0, ReferenceCountHits(params, Eigen::Affine3d::Identity(), cloud));
+}
+
+}  // namespace lidar
+}  // namespace perception
+}  // namespace apollo
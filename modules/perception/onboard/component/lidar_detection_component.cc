@@ -16,6 +16,7 @@
 #include "modules/perception/onboard/component/lidar_detection_component.h"
 
 #include "cyber/time/clock.h"
+#include "modules/common/latency_recorder/latency_tracer.h"
 #include "modules/common/util/string_util.h"
 #include "modules/perception/common/sensor_manager/sensor_manager.h"
 #include "modules/perception/lidar/common/lidar_error_code.h"
@@ -79,15 +80,45 @@ bool LidarDetectionComponent::Proc(
         << "Enter detection component, message timestamp: "
         << message->measurement_time()
         << " current timestamp: " << Clock::NowInSeconds();
+  // the fusion component continues the trace in the perception obstacles
+  apollo::common::LatencyTracer::StashTrace(message->header(), Clock::Now());
 
   auto out_message = std::make_shared<LidarFrameMessage>();
+  if (!InternalProc(message, out_message)) {
+    return false;
+  }
+
+  // A pipelined detection pipeline overlaps consecutive frames, and writes
+  // each one once it is done, after Proc returns. Its failures are then
+  // returned by the next Proc.
+  auto data_frame = std::make_shared<pipeline::DataFrame>();
+  data_frame->lidar_frame = out_message->lidar_frame_.get();
+  const bool submitted = lidar_detection_pipeline_->Submit(
+      data_frame.get(),
+      [this, data_frame, out_message](pipeline::DataFrame*, bool success) {
+        if (!success) {
+          out_message->error_code_ =
+              apollo::common::ErrorCode::PERCEPTION_ERROR_PROCESS;
+          AERROR << "Lidar detection process error!";
+          ++failed_frames_;
+          return;
+        }
+        writer_->Write(out_message);
+        AINFO << "Send lidar detect output message.";
+      });
+  const uint32_t failed_frames = failed_frames_.exchange(0);
+  if (failed_frames > 0) {
+    AERROR << "Lidar detection failed on " << failed_frames << " frames.";
+    return false;
+  }
+  return submitted;
+}
 
-  bool status = InternalProc(message, out_message);
-  if (status) {
-    writer_->Write(out_message);
-    AINFO << "Send lidar detect output message.";
+LidarDetectionComponent::~LidarDetectionComponent() {
+  // Pending frames are written before the writer goes away.
+  if (lidar_detection_pipeline_ != nullptr) {
+    lidar_detection_pipeline_->Flush();
   }
-  return status;
 }
 
 bool LidarDetectionComponent::InitAlgorithmPlugin() {
@@ -185,18 +216,6 @@ bool LidarDetectionComponent::InternalProc(
   // Add point cloud to frame
   ConvertCloud(in_message, frame->cloud);
   frame->lidar2novatel_extrinsics = detect_opts.sensor2novatel_extrinsics;
-
-  pipeline::DataFrame data_frame;
-  data_frame.lidar_frame = frame.get();
-  bool res = lidar_detection_pipeline_->Process(&data_frame);
-
-  if (!res) {
-    out_message->error_code_ =
-        apollo::common::ErrorCode::PERCEPTION_ERROR_PROCESS;
-    AERROR << "Lidar detection process error!";
-    return false;
-  }
-
   return true;
 }
 
@@ -39,7 +39,7 @@ class LidarDetectionComponent : public cyber::Component<drivers::PointCloud> {
 
  public:
   LidarDetectionComponent() = default;
-  virtual ~LidarDetectionComponent() = default;
+  virtual ~LidarDetectionComponent();
 
   bool Init() override;
   bool Proc(const std::shared_ptr<drivers::PointCloud>& message) override;
@@ -67,6 +67,8 @@ class LidarDetectionComponent : public cyber::Component<drivers::PointCloud> {
   // std::unique_ptr<lidar::BaseLidarObstacleDetection> detector_;
 
   std::unique_ptr<lidar::BaseLidarObstacleDetection> lidar_detection_pipeline_;
+  // frames the pipeline failed on, not yet reported by Proc
+  std::atomic<uint32_t> failed_frames_{0};
 
   pipeline::PipelineConfig lidar_detection_config_;
 
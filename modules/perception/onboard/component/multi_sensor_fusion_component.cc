@@ -16,6 +16,7 @@
 #include "modules/perception/onboard/component/multi_sensor_fusion_component.h"
 
 #include "cyber/time/clock.h"
+#include "modules/common/latency_recorder/latency_tracer.h"
 #include "modules/common/util/perf_util.h"
 #include "modules/perception/base/object_pool_types.h"
 #include "modules/perception/onboard/common_flags/common_flags.h"
@@ -218,6 +219,8 @@ bool MultiSensorFusionComponent::InternalProc(
     AERROR << "Failed to gen PerceptionObstacles object.";
     return false;
   }
+  apollo::common::LatencyTracer::ContinueStashedTrace(
+      lidar_timestamp, "perception", out_message->mutable_header());
   PERF_BLOCK_END_WITH_INDICATOR("fusion_serialize_message",
                                 in_message->sensor_id_);
 
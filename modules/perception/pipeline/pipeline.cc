@@ -91,9 +91,34 @@ bool Pipeline::Initialize(const PipelineConfig& pipeline_config) {
   name_ = PipelineType_Name(pipeline_config.pipeline_type());
   pipeline_config_.CopyFrom(pipeline_config);
 
+  if (pipeline_config.max_in_flight_frames() > 1) {
+    executor_.reset(new PipelinedExecutor(
+        name_, stage_ptrs_, pipeline_config.max_in_flight_frames()));
+  }
+
+  return true;
+}
+
+bool Pipeline::Submit(DataFrame* data_frame,
+                      const PipelinedExecutor::DoneCallback& done) {
+  if (executor_ == nullptr) {
+    const bool res = Process(data_frame);
+    done(data_frame, res);
+    return res;
+  }
+  if (data_frame == nullptr) {
+    return false;
+  }
+  executor_->Submit(data_frame, done);
   return true;
 }
 
+void Pipeline::Flush() {
+  if (executor_ != nullptr) {
+    executor_->Flush();
+  }
+}
+
 bool Pipeline::CheckRepeatedStage(const std::string& stage_name) {
   bool res = false;
   for (auto created_state_ptr : stage_ptrs_) {
@@ -227,6 +252,7 @@ std::shared_ptr<Stage> Pipeline::CreateStage(const StageType& stage_type) {
 }
 
 void Pipeline::Clear() {
+  executor_.reset();
   stage_ptrs_.clear();
   stage_config_map_.clear();
 }
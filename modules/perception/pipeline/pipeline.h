@@ -24,6 +24,7 @@
 
 #include "modules/perception/pipeline/proto/pipeline_config.pb.h"
 
+#include "modules/perception/pipeline/pipelined_executor.h"
 #include "modules/perception/pipeline/stage.h"
 
 namespace apollo {
@@ -41,6 +42,21 @@ class Pipeline {
 
   virtual std::string Name() const = 0;
 
+  /**
+   * @brief Processes the frame and calls done with the result. If
+   * max_in_flight_frames in the config is more than 1, the stages run on the
+   * workers of a PipelinedExecutor, done is called later on one of them, and
+   * the frame has to stay valid until then. Otherwise this is Process.
+   * @return False if the frame is processed right away and fails.
+   */
+  bool Submit(DataFrame* data_frame,
+              const PipelinedExecutor::DoneCallback& done);
+
+  /**
+   * @brief Waits until all submitted frames are done.
+   */
+  void Flush();
+
  protected:
   bool Initialize(const PipelineConfig& pipeline_config);
   bool InnerProcess(DataFrame* data_frame);
@@ -60,6 +76,9 @@ class Pipeline {
   std::unordered_map<StageType, StageConfig, std::hash<int>> stage_config_map_;
 
   std::vector<std::shared_ptr<Stage>> stage_ptrs_;
+
+  // Declared after the stages, so that it stops before they are destroyed.
+  std::unique_ptr<PipelinedExecutor> executor_;
 };
 
 }  // namespace pipeline
@@ -0,0 +1,248 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/pipeline/pipelined_executor.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace perception {
+namespace pipeline {
+
+namespace {
+
+double ElapsedMs(std::chrono::steady_clock::time_point start,
+                 std::chrono::steady_clock::time_point end) {
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+}  // namespace
+
+PipelinedExecutor::PipelinedExecutor(
+    const std::string& name, const std::vector<std::shared_ptr<Stage>>& stages,
+    size_t max_in_flight_frames)
+    : name_(name), max_in_flight_frames_(std::max<size_t>(max_in_flight_frames,
+                                                          1)) {
+  // A stage object may be listed more than once, and must not run on two
+  // workers unless it is stateless, so the stages in between stay together.
+  const size_t num_stages = stages.size();
+  std::vector<size_t> last_index(num_stages);
+  for (size_t i = 0; i < num_stages; ++i) {
+    last_index[i] = i;
+    for (size_t j = i + 1; j < num_stages; ++j) {
+      if (stages[j] == stages[i]) {
+        last_index[i] = j;
+      }
+    }
+  }
+
+  std::vector<bool> group_stateless;
+  for (size_t begin = 0; begin < num_stages;) {
+    size_t end = begin + 1;
+    for (size_t i = begin; i < end; ++i) {
+      end = std::max(end, last_index[i] + 1);
+    }
+    bool stateless = true;
+    for (size_t i = begin; i < end; ++i) {
+      stateless = stateless && stages[i]->stage_config_.stateless();
+    }
+    if (!stateless || groups_.empty() || !group_stateless.back()) {
+      groups_.emplace_back(new Group);
+      group_stateless.push_back(stateless);
+    }
+    Group* group = groups_.back().get();
+    for (size_t i = begin; i < end; ++i) {
+      group->stages.push_back(stages[i]);
+      if (!group->metrics.name.empty()) {
+        group->metrics.name += "+";
+      }
+      group->metrics.name += stages[i]->Name();
+    }
+    begin = end;
+  }
+  groups_.emplace_back(new Group);
+  group_stateless.push_back(false);
+
+  for (size_t i = 0; i < groups_.size(); ++i) {
+    const size_t num_workers = group_stateless[i] ? max_in_flight_frames_ : 1;
+    for (size_t j = 0; j < num_workers; ++j) {
+      groups_[i]->workers.emplace_back(&PipelinedExecutor::RunWorker, this, i);
+    }
+    AINFO << "Pipeline: " << name_ << " stage group: "
+          << groups_[i]->metrics.name << " workers: " << num_workers;
+  }
+}
+
+PipelinedExecutor::~PipelinedExecutor() {
+  Flush();
+  const Metrics metrics = GetMetrics();
+  for (const auto& stage : metrics.stages) {
+    const double stage_frames =
+        static_cast<double>(std::max<uint64_t>(stage.num_frames, 1));
+    AINFO << "Pipeline: " << name_ << " stage group: " << stage.name
+          << " frames: " << stage.num_frames
+          << " mean wait ms: " << stage.total_wait_ms / stage_frames
+          << " mean process ms: " << stage.total_process_ms / stage_frames
+          << " max queue size: " << stage.max_queue_size;
+  }
+  const double num_frames =
+      static_cast<double>(std::max<uint64_t>(metrics.num_frames, 1));
+  AINFO << "Pipeline: " << name_ << " frames: " << metrics.num_frames
+        << " mean latency ms: " << metrics.total_latency_ms / num_frames
+        << " max latency ms: " << metrics.max_latency_ms;
+  for (auto& group : groups_) {
+    {
+      std::lock_guard<std::mutex> lock(group->mutex);
+      group->stop = true;
+    }
+    group->cv.notify_all();
+  }
+  for (auto& group : groups_) {
+    for (auto& worker : group->workers) {
+      worker.join();
+    }
+  }
+}
+
+void PipelinedExecutor::Submit(DataFrame* data_frame, DoneCallback done) {
+  Job job;
+  job.data_frame = data_frame;
+  job.done = std::move(done);
+  job.submit_time = std::chrono::steady_clock::now();
+  uint64_t seq = 0;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock,
+             [this] { return num_in_flight_ < max_in_flight_frames_; });
+    ++num_in_flight_;
+    seq = next_seq_++;
+  }
+  Push(groups_.front().get(), seq, std::move(job));
+}
+
+void PipelinedExecutor::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this] { return num_in_flight_ == 0; });
+}
+
+void PipelinedExecutor::Push(Group* group, uint64_t seq, Job job) {
+  job.enqueue_time = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> lock(group->mutex);
+  group->queue.emplace(seq, std::move(job));
+  group->metrics.max_queue_size =
+      std::max(group->metrics.max_queue_size, group->queue.size());
+  if (group->queue.begin()->first == group->next_seq) {
+    group->cv.notify_one();
+  }
+}
+
+void PipelinedExecutor::RunWorker(size_t group_index) {
+  Group* group = groups_[group_index].get();
+  const bool is_output = group_index + 1 == groups_.size();
+  while (true) {
+    uint64_t seq = 0;
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(group->mutex);
+      group->cv.wait(lock, [group] {
+        return group->stop || (!group->queue.empty() &&
+                               group->queue.begin()->first == group->next_seq);
+      });
+      if (group->stop) {
+        return;
+      }
+      auto iter = group->queue.begin();
+      seq = iter->first;
+      job = std::move(iter->second);
+      group->queue.erase(iter);
+      ++group->next_seq;
+      if (!group->queue.empty() &&
+          group->queue.begin()->first == group->next_seq) {
+        group->cv.notify_one();
+      }
+    }
+
+    if (is_output) {
+      Finish(&job);
+      continue;
+    }
+
+    const auto start_time = std::chrono::steady_clock::now();
+    for (const auto& stage : group->stages) {
+      if (!job.success) {
+        break;
+      }
+      if (!stage->IsEnabled()) {
+        continue;
+      }
+      if (!stage->Process(job.data_frame)) {
+        AERROR << "Pipeline: " << name_ << " Stage : " << stage->Name()
+               << " failed!";
+        job.success = false;
+      }
+    }
+    const auto end_time = std::chrono::steady_clock::now();
+    const double wait_ms = ElapsedMs(job.enqueue_time, start_time);
+    const double process_ms = ElapsedMs(start_time, end_time);
+    ADEBUG << "Pipeline: " << name_ << " Stage: " << group->metrics.name
+           << " Wait: " << wait_ms << " ms Cost: " << process_ms << " ms";
+    {
+      std::lock_guard<std::mutex> lock(group->mutex);
+      auto& metrics = group->metrics;
+      ++metrics.num_frames;
+      metrics.total_wait_ms += wait_ms;
+      metrics.max_wait_ms = std::max(metrics.max_wait_ms, wait_ms);
+      metrics.total_process_ms += process_ms;
+      metrics.max_process_ms = std::max(metrics.max_process_ms, process_ms);
+    }
+    Push(groups_[group_index + 1].get(), seq, std::move(job));
+  }
+}
+
+void PipelinedExecutor::Finish(Job* job) {
+  if (job->done) {
+    job->done(job->data_frame, job->success);
+  }
+  const double latency_ms =
+      ElapsedMs(job->submit_time, std::chrono::steady_clock::now());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --num_in_flight_;
+    ++num_frames_;
+    total_latency_ms_ += latency_ms;
+    max_latency_ms_ = std::max(max_latency_ms_, latency_ms);
+  }
+  cv_.notify_all();
+}
+
+PipelinedExecutor::Metrics PipelinedExecutor::GetMetrics() const {
+  Metrics metrics;
+  for (size_t i = 0; i + 1 < groups_.size(); ++i) {
+    std::lock_guard<std::mutex> lock(groups_[i]->mutex);
+    metrics.stages.push_back(groups_[i]->metrics);
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  metrics.num_frames = num_frames_;
+  metrics.total_latency_ms = total_latency_ms_;
+  metrics.max_latency_ms = max_latency_ms_;
+  return metrics;
+}
+
+}  // namespace pipeline
+}  // namespace perception
+}  // namespace apollo
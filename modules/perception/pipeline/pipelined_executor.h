@@ -0,0 +1,143 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "modules/perception/pipeline/data_frame.h"
+#include "modules/perception/pipeline/stage.h"
+
+namespace apollo {
+namespace perception {
+namespace pipeline {
+
+/**
+ * @class PipelinedExecutor
+ * @brief Runs the stages of a pipeline on their own workers, so that
+ * consecutive frames overlap.
+ *
+ * Stages are split into groups, each with its own input queue and workers. A
+ * stateful stage gets a group with one worker, so it sees the frames one at a
+ * time and in order. Consecutive stateless stages share a group with as many
+ * workers as frames in flight. A stage object that appears more than once in
+ * the pipeline keeps everything in between in one group. Queues hand out
+ * frames in submission order, and frames are done in that order too.
+ */
+class PipelinedExecutor {
+ public:
+  using DoneCallback =
+      std::function<void(DataFrame* data_frame, bool success)>;
+
+  struct StageMetrics {
+    // Names of the stages of the group, joined by '+'.
+    std::string name;
+    uint64_t num_frames = 0;
+    // Time the frames wait in the input queue of the group.
+    double total_wait_ms = 0.0;
+    double max_wait_ms = 0.0;
+    // Time the stages of the group take.
+    double total_process_ms = 0.0;
+    double max_process_ms = 0.0;
+    size_t max_queue_size = 0;
+  };
+
+  struct Metrics {
+    std::vector<StageMetrics> stages;
+    uint64_t num_frames = 0;
+    // Time from Submit to the done callback.
+    double total_latency_ms = 0.0;
+    double max_latency_ms = 0.0;
+  };
+
+  PipelinedExecutor(const std::string& name,
+                    const std::vector<std::shared_ptr<Stage>>& stages,
+                    size_t max_in_flight_frames);
+  ~PipelinedExecutor();
+
+  /**
+   * @brief Queues a frame, blocking while max_in_flight_frames frames are in
+   * flight. done is called on a worker thread once all stages have processed
+   * the frame, or one of them failed, in the order frames are submitted. The
+   * frame has to stay valid until then, and done must not call Submit.
+   */
+  void Submit(DataFrame* data_frame, DoneCallback done);
+
+  /**
+   * @brief Waits until all submitted frames are done.
+   */
+  void Flush();
+
+  /**
+   * @brief Gets the metrics of the frames run so far. They are also logged
+   * when the executor is destroyed.
+   */
+  Metrics GetMetrics() const;
+
+  size_t num_groups() const { return groups_.size(); }
+
+ private:
+  using TimePoint = std::chrono::steady_clock::time_point;
+
+  struct Job {
+    DataFrame* data_frame = nullptr;
+    DoneCallback done;
+    bool success = true;
+    TimePoint submit_time;
+    TimePoint enqueue_time;
+  };
+
+  struct Group {
+    std::vector<std::shared_ptr<Stage>> stages;
+    std::mutex mutex;
+    std::condition_variable cv;
+    // Keyed by frame sequence, so that jobs leave in submission order.
+    std::map<uint64_t, Job> queue;
+    uint64_t next_seq = 0;
+    bool stop = false;
+    std::vector<std::thread> workers;
+    StageMetrics metrics;
+  };
+
+  void Push(Group* group, uint64_t seq, Job job);
+  void RunWorker(size_t group_index);
+  void Finish(Job* job);
+
+  const std::string name_;
+  const size_t max_in_flight_frames_;
+  // The last group has no stages and calls the done callbacks.
+  std::vector<std::unique_ptr<Group>> groups_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  uint64_t next_seq_ = 0;
+  size_t num_in_flight_ = 0;
+  uint64_t num_frames_ = 0;
+  double total_latency_ms_ = 0.0;
+  double max_latency_ms_ = 0.0;
+};
+
+}  // namespace pipeline
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,188 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/pipeline/pipelined_executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace pipeline {
+
+namespace {
+
+// Sleeps as long as a real stage takes, and records the frames it sees.
+class FakeStage : public Stage {
+ public:
+  FakeStage(const std::string& name, int cost_ms, bool stateless)
+      : cost_ms_(cost_ms) {
+    name_ = name;
+    enable_ = true;
+    stage_config_.set_stateless(stateless);
+  }
+
+  bool Init(const StageConfig& stage_config) override { return true; }
+
+  bool Process(DataFrame* data_frame) override {
+    const int active = ++num_active_;
+    int max_active = max_active_.load();
+    while (active > max_active &&
+           !max_active_.compare_exchange_weak(max_active, active)) {
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(cost_ms_));
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      frames_.push_back(data_frame);
+    }
+    --num_active_;
+    return data_frame != fail_frame_;
+  }
+
+  bool IsEnabled() const override { return enable_; }
+
+  std::string Name() const override { return name_; }
+
+  std::vector<DataFrame*> frames() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return frames_;
+  }
+  int max_active() const { return max_active_; }
+  void set_fail_frame(DataFrame* frame) { fail_frame_ = frame; }
+
+ private:
+  const int cost_ms_;
+  DataFrame* fail_frame_ = nullptr;
+  std::atomic<int> num_active_{0};
+  std::atomic<int> max_active_{0};
+  std::mutex mutex_;
+  std::vector<DataFrame*> frames_;
+};
+
+double ElapsedMs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+TEST(PipelinedExecutorTest, OrderedOutput) {
+  auto preprocessor = std::make_shared<FakeStage>("pre", 2, true);
+  auto builder = std::make_shared<FakeStage>("builder", 1, true);
+  auto tracker = std::make_shared<FakeStage>("tracker", 3, false);
+  auto filter = std::make_shared<FakeStage>("filter", 1, true);
+  std::vector<DataFrame> frames(30);
+  tracker->set_fail_frame(&frames[5]);
+
+  std::vector<DataFrame*> done_frames;
+  std::vector<bool> results;
+  {
+    PipelinedExecutor executor(
+        "test", {preprocessor, builder, tracker, filter}, 4);
+    // {pre, builder}, {tracker}, {filter} and the output.
+    EXPECT_EQ(4, executor.num_groups());
+    for (auto& frame : frames) {
+      executor.Submit(&frame, [&](DataFrame* data_frame, bool success) {
+        done_frames.push_back(data_frame);
+        results.push_back(success);
+      });
+    }
+    executor.Flush();
+    const auto metrics = executor.GetMetrics();
+    EXPECT_EQ(frames.size(), metrics.num_frames);
+    ASSERT_EQ(3, metrics.stages.size());
+    EXPECT_EQ("pre+builder", metrics.stages[0].name);
+    EXPECT_EQ(frames.size(), metrics.stages[1].num_frames);
+    EXPECT_LE(metrics.stages[0].max_queue_size, 4);
+  }
+
+  ASSERT_EQ(frames.size(), done_frames.size());
+  for (size_t i = 0; i < frames.size(); ++i) {
+    EXPECT_EQ(&frames[i], done_frames[i]);
+    EXPECT_EQ(i != 5, results[i]);
+  }
+  // The stateful stage sees one frame at a time, in order.
+  const auto tracked = tracker->frames();
+  ASSERT_EQ(frames.size(), tracked.size());
+  for (size_t i = 0; i < frames.size(); ++i) {
+    EXPECT_EQ(&frames[i], tracked[i]);
+  }
+  EXPECT_EQ(1, tracker->max_active());
+  EXPECT_LE(preprocessor->max_active(), 4);
+  // The failed frame skips the remaining stages.
+  const auto filtered = filter->frames();
+  EXPECT_EQ(frames.size() - 1, filtered.size());
+  EXPECT_EQ(filtered.end(),
+            std::find(filtered.begin(), filtered.end(), &frames[5]));
+}
+
+TEST(PipelinedExecutorTest, RepeatedStage) {
+  auto detector = std::make_shared<FakeStage>("detector", 0, false);
+  auto builder = std::make_shared<FakeStage>("builder", 0, true);
+  PipelinedExecutor executor("test", {detector, builder, detector, builder},
+                             3);
+  EXPECT_EQ(2, executor.num_groups());
+}
+
+TEST(PipelinedExecutorTest, Throughput) {
+  const int kNumFrames = 20;
+  const int kStageCostMs = 5;
+  std::vector<std::shared_ptr<Stage>> stages = {
+      std::make_shared<FakeStage>("pre", kStageCostMs, false),
+      std::make_shared<FakeStage>("detector", kStageCostMs, false),
+      std::make_shared<FakeStage>("builder", kStageCostMs, false)};
+  std::vector<DataFrame> frames(kNumFrames);
+
+  auto start = std::chrono::steady_clock::now();
+  for (auto& frame : frames) {
+    for (const auto& stage : stages) {
+      stage->Process(&frame);
+    }
+  }
+  const double sequential_ms = ElapsedMs(start);
+
+  PipelinedExecutor executor("test", stages, 3);
+  start = std::chrono::steady_clock::now();
+  for (auto& frame : frames) {
+    executor.Submit(&frame, nullptr);
+  }
+  executor.Flush();
+  const double pipelined_ms = ElapsedMs(start);
+  const auto metrics = executor.GetMetrics();
+  const double mean_latency_ms =
+      metrics.total_latency_ms / static_cast<double>(metrics.num_frames);
+
+  // Stages overlap, so frames finish about one stage cost apart, while each
+  // frame still takes about the cost of all stages.
+  EXPECT_LT(pipelined_ms * 1.5, sequential_ms);
+  EXPECT_GE(mean_latency_ms, 3 * kStageCostMs);
+  std::cout << "sequential " << sequential_ms << " ms, pipelined "
+            << pipelined_ms << " ms, mean latency " << mean_latency_ms
+            << " ms" << std::endl;
+}
+
+}  // namespace pipeline
+}  // namespace perception
+}  // namespace apollo
@@ -31,16 +31,29 @@ class DependencyInjector {
   DependencyInjector() = default;
   ~DependencyInjector() = default;
 
+  /**
+   * @brief Create an injector that shares every dependency of |parent| except
+   * the planning context, which is private to the new injector. Tasks of a
+   * reference line planned concurrently with others are bound to such an
+   * injector so that their context writes do not race.
+   */
+  explicit DependencyInjector(DependencyInjector* parent) : parent_(parent) {}
+
   PlanningContext* planning_context() { return &planning_context_; }
-  FrameHistory* frame_history() { return &frame_history_; }
-  History* history() { return &history_; }
-  EgoInfo* ego_info() { return &ego_info_; }
+  FrameHistory* frame_history() {
+    return parent_ ? parent_->frame_history() : &frame_history_;
+  }
+  History* history() { return parent_ ? parent_->history() : &history_; }
+  EgoInfo* ego_info() { return parent_ ? parent_->ego_info() : &ego_info_; }
   apollo::common::VehicleStateProvider* vehicle_state() {
-    return &vehicle_state_;
+    return parent_ ? parent_->vehicle_state() : &vehicle_state_;
+  }
+  LearningBasedData* learning_based_data() {
+    return parent_ ? parent_->learning_based_data() : &learning_based_data_;
   }
-  LearningBasedData* learning_based_data() { return &learning_based_data_; }
 
  private:
+  DependencyInjector* parent_ = nullptr;
   PlanningContext planning_context_;
   FrameHistory frame_history_;
   History history_;
@@ -16,6 +16,8 @@
 
 #include "modules/planning/common/planning_context.h"
 
+#include "google/protobuf/util/message_differencer.h"
+
 namespace apollo {
 namespace planning {
 
@@ -23,5 +25,31 @@ void PlanningContext::Init() {}
 
 void PlanningContext::Clear() { planning_status_.Clear(); }
 
+void PlanningContext::ApplyStatusChanges(const PlanningStatus& base,
+                                         const PlanningStatus& updated) {
+  using google::protobuf::util::MessageDifferencer;
+  const auto* descriptor = PlanningStatus::descriptor();
+  const auto* reflection = PlanningStatus::GetReflection();
+  for (int i = 0; i < descriptor->field_count(); ++i) {
+    const auto* field = descriptor->field(i);
+    const bool base_has = reflection->HasField(base, field);
+    const bool updated_has = reflection->HasField(updated, field);
+    if (!updated_has) {
+      if (base_has) {
+        reflection->ClearField(&planning_status_, field);
+      }
+      continue;
+    }
+    const auto& updated_field = reflection->GetMessage(updated, field);
+    if (base_has &&
+        MessageDifferencer::Equals(reflection->GetMessage(base, field),
+                                   updated_field)) {
+      continue;
+    }
+    reflection->MutableMessage(&planning_status_, field)
+        ->CopyFrom(updated_field);
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -45,6 +45,15 @@ class PlanningContext {
   const PlanningStatus& planning_status() const { return planning_status_; }
   PlanningStatus* mutable_planning_status() { return &planning_status_; }
 
+  /**
+   * @brief Apply the top-level status fields that differ between |base| and
+   * |updated| to this context. Used to fold the private context of a
+   * reference line planned concurrently back into the shared one; fields
+   * left untouched by that line keep their current value.
+   */
+  void ApplyStatusChanges(const PlanningStatus& base,
+                          const PlanningStatus& updated);
+
  private:
   PlanningStatus planning_status_;
 };
@@ -326,6 +326,9 @@ DEFINE_bool(use_multi_thread_to_add_obstacles, false,
             "use multiple thread to add obstacles.");
 DEFINE_bool(enable_multi_thread_in_dp_st_graph, false,
             "Enable multiple thread to calculation curve cost in dp_st_graph.");
+DEFINE_bool(enable_parallel_reference_line_planning, false,
+            "Run the task pipelines of independent reference lines "
+            "concurrently.");
 
 /// Lattice Planner
 DEFINE_double(numerical_epsilon, 1e-6, "Epsilon in lattice planner.");
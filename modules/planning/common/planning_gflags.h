@@ -150,6 +150,7 @@ DECLARE_bool(enable_sqp_solver);
 /// thread pool
 DECLARE_bool(use_multi_thread_to_add_obstacles);
 DECLARE_bool(enable_multi_thread_in_dp_st_graph);
+DECLARE_bool(enable_parallel_reference_line_planning);
 
 DECLARE_double(numerical_epsilon);
 DECLARE_double(default_cruise_speed);
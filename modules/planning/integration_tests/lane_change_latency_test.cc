@@ -0,0 +1,127 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <vector>
+
+#include "cyber/common/log.h"
+#include "modules/common/util/util.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/integration_tests/planning_test_base.h"
+
+DEFINE_int32(lane_change_latency_test_cycles, 20,
+             "Number of planning cycles measured for each mode.");
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class LaneChangeLatencyTest
+ * @brief Measures planning latency on the sunnyvale_big_loop lane change
+ * recording with sequential and parallel reference line planning, and checks
+ * that both modes produce the same trajectory.
+ */
+class LaneChangeLatencyTest : public PlanningTestBase {
+ public:
+  virtual void SetUp() {
+    FLAGS_use_navigation_mode = false;
+    FLAGS_map_dir = "modules/map/data/sunnyvale_big_loop";
+    FLAGS_test_base_map_filename = "base_map.bin";
+    FLAGS_test_data_dir = "modules/planning/testdata/sunnyvale_big_loop_test";
+    FLAGS_planning_upper_speed_limit = 20.0;
+
+    FLAGS_enable_scenario_pull_over = false;
+    FLAGS_enable_scenario_stop_sign = false;
+    FLAGS_enable_scenario_traffic_light = false;
+    FLAGS_enable_rss_info = false;
+
+    ENABLE_RULE(TrafficRuleConfig::CROSSWALK, false);
+    ENABLE_RULE(TrafficRuleConfig::DESTINATION, false);
+    ENABLE_RULE(TrafficRuleConfig::KEEP_CLEAR, false);
+    ENABLE_RULE(TrafficRuleConfig::TRAFFIC_LIGHT, true);
+
+    const std::string seq_num = "400";
+    FLAGS_test_routing_response_file = seq_num + "_routing.pb.txt";
+    FLAGS_test_localization_file = seq_num + "_localization.pb.txt";
+    FLAGS_test_chassis_file = seq_num + "_chassis.pb.txt";
+    FLAGS_test_prediction_file = seq_num + "_prediction.pb.txt";
+  }
+
+ protected:
+  // Runs the recording with a fresh planner and returns the per-cycle
+  // latency in ms. The trajectory of every cycle is appended to
+  // |trajectories|.
+  std::vector<double> RunCycles(const bool parallel,
+                                std::vector<ADCTrajectory>* trajectories) {
+    FLAGS_enable_parallel_reference_line_planning = parallel;
+    PlanningTestBase::SetUp();
+
+    std::vector<double> latencies;
+    for (int i = 0; i < FLAGS_lane_change_latency_test_cycles; ++i) {
+      ADCTrajectory trajectory;
+      const auto start = std::chrono::steady_clock::now();
+      planning_->RunOnce(local_view_, &trajectory);
+      const auto end = std::chrono::steady_clock::now();
+      latencies.push_back(
+          std::chrono::duration<double, std::milli>(end - start).count());
+      TrimPlanning(&trajectory, false);
+      trajectory.clear_header();
+      trajectories->push_back(trajectory);
+    }
+    return latencies;
+  }
+
+  static void Report(const std::string& name, std::vector<double> latencies) {
+    std::sort(latencies.begin(), latencies.end());
+    const double mean =
+        std::accumulate(latencies.begin(), latencies.end(), 0.0) /
+        static_cast<double>(latencies.size());
+    const auto percentile = [&latencies](const double p) {
+      const size_t index = std::min(
+          latencies.size() - 1,
+          static_cast<size_t>(p * static_cast<double>(latencies.size())));
+      return latencies[index];
+    };
+    AINFO << name << " planning latency (ms): mean " << mean << ", p50 "
+          << percentile(0.5) << ", p99 " << percentile(0.99) << ", max "
+          << latencies.back();
+  }
+};
+
+TEST_F(LaneChangeLatencyTest, parallel_reference_line_planning) {
+  std::vector<ADCTrajectory> sequential_trajectories;
+  std::vector<ADCTrajectory> parallel_trajectories;
+  const auto sequential_latencies = RunCycles(false, &sequential_trajectories);
+  const auto parallel_latencies = RunCycles(true, &parallel_trajectories);
+  FLAGS_enable_parallel_reference_line_planning = false;
+
+  Report("sequential", sequential_latencies);
+  Report("parallel", parallel_latencies);
+
+  ASSERT_EQ(sequential_trajectories.size(), parallel_trajectories.size());
+  for (size_t i = 0; i < sequential_trajectories.size(); ++i) {
+    EXPECT_TRUE(common::util::IsProtoEqual(sequential_trajectories[i],
+                                           parallel_trajectories[i]))
+        << "trajectories differ at cycle " << i;
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
+
+TMAIN;
@@ -19,6 +19,7 @@
 #include "modules/common_msgs/planning_msgs/planning_internal.pb.h"
 
 #include "cyber/time/clock.h"
+#include "modules/common/latency_recorder/latency_tracer.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/planning/common/planning_context.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -50,6 +51,9 @@ void PlanningBase::FillPlanningPb(const double timestamp,
         local_view_.prediction_obstacles->header().camera_timestamp());
     trajectory_pb->mutable_header()->set_radar_timestamp(
         local_view_.prediction_obstacles->header().radar_timestamp());
+    common::LatencyTracer::ContinueTrace(
+        local_view_.prediction_obstacles->header(), "planning",
+        cyber::Time(timestamp), trajectory_pb->mutable_header());
   }
   trajectory_pb->mutable_routing_header()->CopyFrom(
       local_view_.routing->header());
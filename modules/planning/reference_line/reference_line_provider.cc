@@ -684,7 +684,7 @@ bool ReferenceLineProvider::ExtendReferenceLine(const VehicleState &state,
     ADEBUG << "Could not further extend reference line";
     return true;
   }
-  hdmap::Path path(shifted_segments);
+  hdmap::Path path(shifted_segments, &lane_segment_cache_);
   ReferenceLine new_ref(path);
   if (!SmoothPrefixedReferenceLine(*prev_ref, new_ref, reference_line)) {
     AWARN << "Failed to smooth forward shifted reference line";
@@ -877,7 +877,7 @@ void ReferenceLineProvider::GetAnchorPoints(
 
 bool ReferenceLineProvider::SmoothRouteSegment(const RouteSegments &segments,
                                                ReferenceLine *reference_line) {
-  hdmap::Path path(segments);
+  hdmap::Path path(segments, &lane_segment_cache_);
   return SmoothReferenceLine(ReferenceLine(path), reference_line);
 }
 
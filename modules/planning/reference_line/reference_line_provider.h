@@ -164,6 +164,8 @@ class ReferenceLineProvider {
 
   std::mutex pnc_map_mutex_;
   std::unique_ptr<hdmap::PncMap> pnc_map_;
+  // the lane segments of the last reference lines, to build the next ones
+  hdmap::LaneSegmentCache lane_segment_cache_;
 
   // Used in Navigation mode
   std::shared_ptr<relative_map::MapMsg> relative_map_;
@@ -20,6 +20,7 @@
 
 #include "modules/planning/scenarios/lane_follow/lane_follow_stage.h"
 
+#include <unordered_map>
 #include <utility>
 
 #include "cyber/common/log.h"
@@ -32,6 +33,7 @@
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/planning/common/ego_info.h"
 #include "modules/planning/common/frame.h"
+#include "modules/planning/common/planning_context.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/constraint_checker/constraint_checker.h"
 #include "modules/planning/tasks/deciders/lane_change_decider/lane_change_decider.h"
@@ -92,6 +94,11 @@ void LaneFollowStage::RecordObstacleDebugInfo(
 
 Stage::StageStatus LaneFollowStage::Process(
     const TrajectoryPoint& planning_start_point, Frame* frame) {
+  if (FLAGS_enable_parallel_reference_line_planning &&
+      frame->reference_line_info().size() > 1) {
+    return ProcessInParallel(planning_start_point, frame);
+  }
+
   bool has_drivable_reference_line = false;
 
   ADEBUG << "Number of reference lines:\t"
@@ -115,41 +122,107 @@ Stage::StageStatus LaneFollowStage::Process(
     auto cur_status =
         PlanOnReferenceLine(planning_start_point, frame, &reference_line_info);
 
-    if (cur_status.ok()) {
-      if (reference_line_info.IsChangeLanePath()) {
-        ADEBUG << "reference line is lane change ref.";
-        ADEBUG << "FLAGS_enable_smarter_lane_change: "
-               << FLAGS_enable_smarter_lane_change;
-        if (reference_line_info.Cost() < kStraightForwardLineCost &&
-            (LaneChangeDecider::IsClearToChangeLane(&reference_line_info) ||
-             FLAGS_enable_smarter_lane_change)) {
-          // If the path and speed optimization succeed on target lane while
-          // under smart lane-change or IsClearToChangeLane under older version
-          has_drivable_reference_line = true;
-          reference_line_info.SetDrivable(true);
-          LaneChangeDecider::UpdatePreparationDistance(
-              true, frame, &reference_line_info, injector_->planning_context());
-          ADEBUG << "\tclear for lane change";
-        } else {
-          LaneChangeDecider::UpdatePreparationDistance(
-              false, frame, &reference_line_info,
-              injector_->planning_context());
-          reference_line_info.SetDrivable(false);
-          ADEBUG << "\tlane change failed";
-        }
-      } else {
-        ADEBUG << "reference line is NOT lane change ref.";
-        has_drivable_reference_line = true;
+    has_drivable_reference_line =
+        UpdateDrivable(cur_status, frame, &reference_line_info);
+  }
+
+  return has_drivable_reference_line ? StageStatus::RUNNING
+                                     : StageStatus::ERROR;
+}
+
+Stage::StageStatus LaneFollowStage::ProcessInParallel(
+    const TrajectoryPoint& planning_start_point, Frame* frame) {
+  ADEBUG << "Number of reference lines planned in parallel:\t"
+         << frame->reference_line_info().size();
+
+  auto* planning_context = injector_->planning_context();
+  const PlanningStatus base_status = planning_context->planning_status();
+
+  // Cost and drivability of every line before planning, to restore the lines
+  // the sequential loop would not have reached.
+  std::unordered_map<const ReferenceLineInfo*, std::pair<double, bool>>
+      unplanned_states;
+  for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
+    unplanned_states[&reference_line_info] = {reference_line_info.Cost(),
+                                              reference_line_info.IsDrivable()};
+    if (!reference_line_info.IsChangeLanePath()) {
+      reference_line_info.AddCost(kStraightForwardLineCost);
+    }
+  }
+
+  const auto task_results = ExecuteTaskListOnReferenceLines(frame);
+
+  // Every reference line has been planned; walk them as the sequential loop
+  // does so the result does not depend on timing or on the number of lines.
+  // A line only counts, and only keeps its planning status changes, if the
+  // sequential loop would have planned it. The lines after the first were
+  // planned from the status before any task ran, not from the changes of
+  // the lines before them.
+  bool has_drivable_reference_line = false;
+  bool passed_next_line = false;
+  for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
+    if (has_drivable_reference_line) {
+      // The sequential loop marks the line after the drivable one as not
+      // drivable and leaves the others as they were.
+      const auto& state = unplanned_states[&reference_line_info];
+      reference_line_info.SetCost(state.first);
+      reference_line_info.SetDrivable(passed_next_line && state.second);
+      passed_next_line = true;
+      continue;
+    }
+    Status task_status = Status::OK();
+    const auto iter = task_results.find(&reference_line_info);
+    if (iter != task_results.end()) {
+      task_status = iter->second.status;
+      if (iter->second.planning_status != nullptr) {
+        planning_context->ApplyStatusChanges(base_status,
+                                             *iter->second.planning_status);
       }
-    } else {
-      reference_line_info.SetDrivable(false);
     }
+    auto cur_status = BuildTrajectoryOnReferenceLine(
+        planning_start_point, frame, &reference_line_info, task_status);
+
+    has_drivable_reference_line =
+        UpdateDrivable(cur_status, frame, &reference_line_info);
   }
 
   return has_drivable_reference_line ? StageStatus::RUNNING
                                      : StageStatus::ERROR;
 }
 
+bool LaneFollowStage::UpdateDrivable(const Status& plan_status, Frame* frame,
+                                     ReferenceLineInfo* reference_line_info) {
+  if (!plan_status.ok()) {
+    reference_line_info->SetDrivable(false);
+    return false;
+  }
+  if (!reference_line_info->IsChangeLanePath()) {
+    ADEBUG << "reference line is NOT lane change ref.";
+    return true;
+  }
+
+  ADEBUG << "reference line is lane change ref.";
+  ADEBUG << "FLAGS_enable_smarter_lane_change: "
+         << FLAGS_enable_smarter_lane_change;
+  if (reference_line_info->Cost() < kStraightForwardLineCost &&
+      (LaneChangeDecider::IsClearToChangeLane(reference_line_info) ||
+       FLAGS_enable_smarter_lane_change)) {
+    // If the path and speed optimization succeed on target lane while
+    // under smart lane-change or IsClearToChangeLane under older version
+    reference_line_info->SetDrivable(true);
+    LaneChangeDecider::UpdatePreparationDistance(
+        true, frame, reference_line_info, injector_->planning_context());
+    ADEBUG << "\tclear for lane change";
+    return true;
+  }
+  LaneChangeDecider::UpdatePreparationDistance(false, frame,
+                                               reference_line_info,
+                                               injector_->planning_context());
+  reference_line_info->SetDrivable(false);
+  ADEBUG << "\tlane change failed";
+  return false;
+}
+
 Status LaneFollowStage::PlanOnReferenceLine(
     const TrajectoryPoint& planning_start_point, Frame* frame,
     ReferenceLineInfo* reference_line_info) {
@@ -187,11 +260,18 @@ Status LaneFollowStage::PlanOnReferenceLine(
     //        << reference_line_info->IsChangeLanePath();
   }
 
+  return BuildTrajectoryOnReferenceLine(planning_start_point, frame,
+                                        reference_line_info, ret);
+}
+
+Status LaneFollowStage::BuildTrajectoryOnReferenceLine(
+    const TrajectoryPoint& planning_start_point, Frame* frame,
+    ReferenceLineInfo* reference_line_info, const Status& task_status) {
   RecordObstacleDebugInfo(reference_line_info);
 
   // check path and speed results for path or speed fallback
   reference_line_info->set_trajectory_type(ADCTrajectory::NORMAL);
-  if (!ret.ok()) {
+  if (!task_status.ok()) {
     PlanFallbackTrajectory(planning_start_point, frame, reference_line_info);
   }
 
@@ -54,6 +54,15 @@ class LaneFollowStage : public Stage {
       const common::TrajectoryPoint& planning_start_point, Frame* frame,
       ReferenceLineInfo* reference_line_info);
 
+  /**
+   * @brief Apply fallbacks and costs after the task list has run on the
+   * reference line, and set the resulting trajectory.
+   */
+  common::Status BuildTrajectoryOnReferenceLine(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame,
+      ReferenceLineInfo* reference_line_info,
+      const common::Status& task_status);
+
   void PlanFallbackTrajectory(
       const common::TrajectoryPoint& planning_start_point, Frame* frame,
       ReferenceLineInfo* reference_line_info);
@@ -71,6 +80,16 @@ class LaneFollowStage : public Stage {
   void RecordObstacleDebugInfo(ReferenceLineInfo* reference_line_info);
 
  private:
+  StageStatus ProcessInParallel(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame);
+
+  /**
+   * @brief Decide whether the planned reference line can be driven on.
+   * @return true if the line is selected as the drivable one.
+   */
+  bool UpdateDrivable(const common::Status& plan_status, Frame* frame,
+                      ReferenceLineInfo* reference_line_info);
+
   ScenarioConfig config_;
   std::unique_ptr<Stage> stage_;
 };
@@ -20,10 +20,13 @@
 
 #include "modules/planning/scenarios/stage.h"
 
+#include <future>
 #include <unordered_map>
 #include <utility>
 
+#include "cyber/task/task.h"
 #include "cyber/time/clock.h"
+#include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/common/planning_context.h"
 #include "modules/planning/common/speed_profile_generator.h"
 #include "modules/planning/common/trajectory/publishable_trajectory.h"
@@ -33,12 +36,37 @@ namespace apollo {
 namespace planning {
 namespace scenario {
 
+using apollo::common::Status;
 using apollo::cyber::Clock;
 
 namespace {
 // constexpr double kPathOptimizationFallbackCost = 2e4;
 constexpr double kSpeedOptimizationFallbackCost = 2e4;
 // constexpr double kStraightForwardLineCost = 10.0;
+
+// Tasks checked to touch only their own reference line, the planning
+// context they are bound to and read-only shared state, so that they can run
+// concurrently on different reference lines. Any other task runs line by
+// line, in reference line order.
+bool IsReferenceLineLocal(const TaskConfig::TaskType task_type) {
+  switch (task_type) {
+    case TaskConfig::PATH_LANE_BORROW_DECIDER:
+    case TaskConfig::PATH_BOUNDS_DECIDER:
+    case TaskConfig::PIECEWISE_JERK_PATH_OPTIMIZER:
+    case TaskConfig::PATH_ASSESSMENT_DECIDER:
+    case TaskConfig::PATH_DECIDER:
+    case TaskConfig::ST_BOUNDS_DECIDER:
+    case TaskConfig::SPEED_BOUNDS_PRIORI_DECIDER:
+    case TaskConfig::SPEED_BOUNDS_FINAL_DECIDER:
+    case TaskConfig::SPEED_HEURISTIC_OPTIMIZER:
+    case TaskConfig::SPEED_DECIDER:
+    case TaskConfig::PIECEWISE_JERK_SPEED_OPTIMIZER:
+    case TaskConfig::PIECEWISE_JERK_NONLINEAR_SPEED_OPTIMIZER:
+      return true;
+    default:
+      return false;
+  }
+}
 }  // namespace
 
 Stage::Stage(const ScenarioConfig::StageConfig& config,
@@ -212,6 +240,138 @@ bool Stage::ExecuteTaskOnOpenSpace(Frame* frame) {
   return true;
 }
 
+std::unordered_map<const ReferenceLineInfo*, Stage::ReferenceLineTaskResult>
+Stage::ExecuteTaskListOnReferenceLines(Frame* frame) {
+  // Snapshot the line order: LANE_CHANGE_DECIDER may reorder the list.
+  std::vector<ReferenceLineInfo*> reference_line_infos;
+  for (auto& reference_line_info : *frame->mutable_reference_line_info()) {
+    reference_line_infos.push_back(&reference_line_info);
+  }
+  const size_t num_lines = reference_line_infos.size();
+  std::vector<Status> statuses(num_lines, Status::OK());
+
+  const bool parallel =
+      FLAGS_enable_parallel_reference_line_planning && num_lines > 1;
+  if (!parallel) {
+    for (size_t i = 0; i < num_lines; ++i) {
+      ExecuteTaskRange(task_list_, 0, task_list_.size(), frame,
+                       reference_line_infos[i], &statuses[i]);
+    }
+  } else {
+    PrepareReferenceLineWorkers(num_lines);
+    // The first line works on the shared context with the stage's own tasks;
+    // every other line starts from a private copy of the context as it is
+    // before any task ran.
+    const PlanningStatus& base_status =
+        injector_->planning_context()->planning_status();
+    for (size_t i = 1; i < num_lines; ++i) {
+      reference_line_workers_[i - 1]
+          ->injector->planning_context()
+          ->mutable_planning_status()
+          ->CopyFrom(base_status);
+    }
+
+    size_t begin = 0;
+    while (begin < task_list_.size()) {
+      const bool local =
+          IsReferenceLineLocal(task_list_[begin]->Config().task_type());
+      size_t end = begin + 1;
+      while (end < task_list_.size() &&
+             IsReferenceLineLocal(task_list_[end]->Config().task_type()) ==
+                 local) {
+        ++end;
+      }
+
+      if (!local) {
+        ExecuteTaskRange(task_list_, begin, end, frame,
+                         reference_line_infos[0], &statuses[0]);
+        for (size_t i = 1; i < num_lines; ++i) {
+          ExecuteTaskRange(reference_line_workers_[i - 1]->task_list, begin,
+                           end, frame, reference_line_infos[i], &statuses[i]);
+        }
+        begin = end;
+        continue;
+      }
+
+      std::vector<std::future<void>> futures;
+      for (size_t i = 1; i < num_lines; ++i) {
+        auto* worker = reference_line_workers_[i - 1].get();
+        futures.push_back(cyber::Async([this, worker, begin, end, frame,
+                                        &reference_line_infos, &statuses, i] {
+          ExecuteTaskRange(worker->task_list, begin, end, frame,
+                           reference_line_infos[i], &statuses[i]);
+        }));
+      }
+      ExecuteTaskRange(task_list_, begin, end, frame, reference_line_infos[0],
+                       &statuses[0]);
+      for (auto& future : futures) {
+        future.get();
+      }
+      begin = end;
+    }
+  }
+
+  std::unordered_map<const ReferenceLineInfo*, ReferenceLineTaskResult>
+      results;
+  for (size_t i = 0; i < num_lines; ++i) {
+    ReferenceLineTaskResult result;
+    result.status = statuses[i];
+    if (parallel && i > 0) {
+      result.planning_status = &reference_line_workers_[i - 1]
+                                    ->injector->planning_context()
+                                    ->planning_status();
+    }
+    results.emplace(reference_line_infos[i], result);
+  }
+  return results;
+}
+
+void Stage::PrepareReferenceLineWorkers(const size_t num_reference_lines) {
+  while (reference_line_workers_.size() + 1 < num_reference_lines) {
+    auto worker = std::make_unique<ReferenceLineWorker>();
+    worker->injector = std::make_shared<DependencyInjector>(injector_.get());
+    // Every task is bound to the private context, including those that never
+    // run concurrently, so that no line but the first writes the shared one.
+    for (auto* task : task_list_) {
+      const auto task_type = task->Config().task_type();
+      auto iter = worker->tasks.find(task_type);
+      if (iter == worker->tasks.end()) {
+        auto ptr = TaskFactory::CreateTask(task->Config(), worker->injector);
+        worker->task_list.push_back(ptr.get());
+        worker->tasks[task_type] = std::move(ptr);
+      } else {
+        worker->task_list.push_back(iter->second.get());
+      }
+    }
+    reference_line_workers_.push_back(std::move(worker));
+  }
+}
+
+void Stage::ExecuteTaskRange(const std::vector<Task*>& task_list,
+                             const size_t begin, const size_t end,
+                             Frame* frame,
+                             ReferenceLineInfo* reference_line_info,
+                             Status* status) {
+  for (size_t i = begin; i < end && status->ok(); ++i) {
+    auto* task = task_list[i];
+    const double start_timestamp = Clock::NowInSeconds();
+
+    *status = task->Execute(frame, reference_line_info);
+
+    const double end_timestamp = Clock::NowInSeconds();
+    const double time_diff_ms = (end_timestamp - start_timestamp) * 1000;
+    ADEBUG << "after task[" << task->Name()
+           << "]:" << reference_line_info->PathSpeedDebugString();
+    ADEBUG << task->Name() << " time spend: " << time_diff_ms << " ms.";
+    RecordDebugInfo(reference_line_info, task->Name(), time_diff_ms);
+
+    if (!status->ok()) {
+      AERROR << "Failed to run tasks[" << task->Name()
+             << "], Error message: " << status->error_message();
+    }
+  }
+}
+
 Stage::StageStatus Stage::FinishScenario() {
   next_stage_ = StageType::NO_STAGE;
   return Stage::FINISHED;
@@ -23,9 +23,11 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "modules/planning/proto/planning_config.pb.h"
+#include "modules/planning/proto/planning_status.pb.h"
 
 #include "modules/common/status/status.h"
 #include "modules/common/util/factory.h"
@@ -90,11 +92,52 @@ class Stage {
 
   bool ExecuteTaskOnOpenSpace(Frame* frame);
 
+  /**
+   * @brief Outcome of the task list on one reference line.
+   */
+  struct ReferenceLineTaskResult {
+    // first failure (or OK) of the task list
+    common::Status status;
+    // planning status written by the line's tasks, or nullptr if the line was
+    // planned on the stage's own planning context
+    const PlanningStatus* planning_status = nullptr;
+  };
+
+  /**
+   * @brief Run the task list on every reference line of the frame. With
+   * FLAGS_enable_parallel_reference_line_planning, reference lines are
+   * processed concurrently; tasks not known to be local to their reference
+   * line still run line by line, in reference line order. Only the first line
+   * writes the stage's planning context, every other line works on a private
+   * copy taken before any task ran. The caller decides which of those copies
+   * to keep.
+   */
+  std::unordered_map<const ReferenceLineInfo*, ReferenceLineTaskResult>
+  ExecuteTaskListOnReferenceLines(Frame* frame);
+
   virtual Stage::StageStatus FinishScenario();
 
   void RecordDebugInfo(ReferenceLineInfo* reference_line_info,
                        const std::string& name, const double time_diff_ms);
 
+ private:
+  /**
+   * @brief Task instances and planning context private to one of the
+   * additional reference lines planned concurrently.
+   */
+  struct ReferenceLineWorker {
+    std::shared_ptr<DependencyInjector> injector;
+    std::map<TaskConfig::TaskType, std::unique_ptr<Task>> tasks;
+    std::vector<Task*> task_list;
+  };
+
+  void PrepareReferenceLineWorkers(const size_t num_reference_lines);
+
+  void ExecuteTaskRange(const std::vector<Task*>& task_list,
+                        const size_t begin, const size_t end, Frame* frame,
+                        ReferenceLineInfo* reference_line_info,
+                        common::Status* status);
+
  protected:
   std::map<TaskConfig::TaskType, std::unique_ptr<Task>> tasks_;
   std::vector<Task*> task_list_;
@@ -103,6 +146,9 @@ class Stage {
   void* context_ = nullptr;
   std::string name_;
   std::shared_ptr<DependencyInjector> injector_;
+
+ private:
+  std::vector<std::unique_ptr<ReferenceLineWorker>> reference_line_workers_;
 };
 
 #define DECLARE_STAGE(NAME, CONTEXT)                          \
@@ -0,0 +1,163 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/planning/scenarios/stage.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/tasks/task_factory.h"
+
+namespace apollo {
+namespace planning {
+namespace scenario {
+
+namespace {
+
+constexpr int kNumReferenceLines = 3;
+
+// Folds its task type into the cost of the reference line, so that the cost
+// tells which tasks ran on the line and in which order, and counts its runs
+// in the planning context it is bound to.
+class FoldCostTask : public Task {
+ public:
+  FoldCostTask(const TaskConfig& config,
+               const std::shared_ptr<DependencyInjector>& injector)
+      : Task(config, injector) {}
+
+  common::Status Execute(Frame* frame,
+                         ReferenceLineInfo* reference_line_info) override {
+    Task::Execute(frame, reference_line_info);
+    reference_line_info->SetCost(reference_line_info->Cost() * 31.0 +
+                                 static_cast<double>(config_.task_type()));
+    auto* path_decider = injector_->planning_context()
+                             ->mutable_planning_status()
+                             ->mutable_path_decider();
+    path_decider->set_front_static_obstacle_cycle_counter(
+        path_decider->front_static_obstacle_cycle_counter() + 1);
+    return common::Status::OK();
+  }
+};
+
+Task* CreateFoldCostTask(const TaskConfig& config,
+                         const std::shared_ptr<DependencyInjector>& injector) {
+  return new FoldCostTask(config, injector);
+}
+
+class TestStage : public Stage {
+ public:
+  TestStage(const ScenarioConfig::StageConfig& config,
+            const std::shared_ptr<DependencyInjector>& injector)
+      : Stage(config, injector) {}
+
+  Stage::StageStatus Process(const common::TrajectoryPoint& planning_init_point,
+                             Frame* frame) override {
+    return Stage::RUNNING;
+  }
+};
+
+}  // namespace
+
+class StageTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    // Reference line local tasks between tasks that run line by line.
+    const TaskConfig::TaskType task_types[] = {
+        TaskConfig::LANE_CHANGE_DECIDER, TaskConfig::PATH_BOUNDS_DECIDER,
+        TaskConfig::PATH_DECIDER, TaskConfig::RULE_BASED_STOP_DECIDER,
+        TaskConfig::SPEED_DECIDER};
+    config_.set_stage_type(StageType::LANE_FOLLOW_DEFAULT_STAGE);
+    for (const auto task_type : task_types) {
+      config_.add_task_type(task_type);
+      config_.add_task_config()->set_task_type(task_type);
+      if (!TaskFactory::task_factory_.Contains(task_type)) {
+        TaskFactory::task_factory_.Register(task_type, &CreateFoldCostTask);
+      }
+    }
+  }
+
+  virtual void TearDown() {
+    FLAGS_enable_parallel_reference_line_planning = false;
+  }
+
+ protected:
+  // Runs the stage's tasks on a frame of kNumReferenceLines lines and returns
+  // the cost of every line, in frame order. |counters| gets the runs counted
+  // in the stage's context first, then in the context of every line planned
+  // on a private one.
+  std::vector<double> Run(const bool parallel, std::vector<int>* counters) {
+    FLAGS_enable_parallel_reference_line_planning = parallel;
+    auto injector = std::make_shared<DependencyInjector>();
+    TestStage stage(config_, injector);
+    Frame frame(1);
+    for (int i = 0; i < kNumReferenceLines; ++i) {
+      frame.mutable_reference_line_info()->emplace_back();
+      frame.mutable_reference_line_info()->back().SetCost(i + 1.0);
+    }
+
+    const auto results = stage.ExecuteTaskListOnReferenceLines(&frame);
+
+    std::vector<double> costs;
+    counters->push_back(injector->planning_context()
+                            ->planning_status()
+                            .path_decider()
+                            .front_static_obstacle_cycle_counter());
+    for (const auto& reference_line_info : frame.reference_line_info()) {
+      costs.push_back(reference_line_info.Cost());
+      const auto iter = results.find(&reference_line_info);
+      EXPECT_TRUE(iter != results.end());
+      if (iter == results.end()) {
+        continue;
+      }
+      EXPECT_TRUE(iter->second.status.ok());
+      if (iter->second.planning_status != nullptr) {
+        counters->push_back(iter->second.planning_status->path_decider()
+                                .front_static_obstacle_cycle_counter());
+      }
+    }
+    return costs;
+  }
+
+  ScenarioConfig::StageConfig config_;
+};
+
+TEST_F(StageTest, ParallelMatchesSequential) {
+  std::vector<int> sequential_counters;
+  std::vector<int> parallel_counters;
+  const auto sequential_costs = Run(false, &sequential_counters);
+  const auto parallel_costs = Run(true, &parallel_counters);
+
+  ASSERT_EQ(kNumReferenceLines, sequential_costs.size());
+  ASSERT_EQ(kNumReferenceLines, parallel_costs.size());
+  for (int i = 0; i < kNumReferenceLines; ++i) {
+    EXPECT_DOUBLE_EQ(sequential_costs[i], parallel_costs[i]);
+  }
+
+  // Sequentially every line runs on the stage's context. In parallel only the
+  // first line does, the others run on a private context each.
+  const int num_tasks = config_.task_type_size();
+  EXPECT_EQ(std::vector<int>({kNumReferenceLines * num_tasks}),
+            sequential_counters);
+  EXPECT_EQ(std::vector<int>(kNumReferenceLines, num_tasks),
+            parallel_counters);
+}
+
+}  // namespace scenario
+}  // namespace planning
+}  // namespace apollo
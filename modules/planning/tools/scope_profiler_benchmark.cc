@@ -0,0 +1,117 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * Overhead of the scope profiler on the lattice planner's evaluation loop:
+ * the jerk and offset costs of quintic lateral candidates, sampled like
+ * TrajectoryEvaluator, with each candidate timed as a scope. The loop runs
+ * without a scope, with PERF_FUNCTION and the profiler disabled or enabled,
+ * and with the TimerWrapper the macros expanded to before.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/util/perf_util.h"
+#include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
+
+DEFINE_int32(candidates, 200000, "lateral candidates to evaluate");
+DEFINE_int32(samples, 40, "samples per candidate");
+
+namespace {
+
+using apollo::planning::QuinticPolynomialCurve1d;
+
+std::vector<QuinticPolynomialCurve1d> MakeCandidates() {
+  std::vector<QuinticPolynomialCurve1d> candidates;
+  for (int i = 0; i < 64; ++i) {
+    const double l = -1.5 + 3.0 * i / 63.0;
+    candidates.emplace_back(0.3, 0.05, 0.0, l, 0.0, 0.0, 40.0 + i % 8 * 5.0);
+  }
+  return candidates;
+}
+
+double Cost(const QuinticPolynomialCurve1d& curve) {
+  const double step = curve.ParamLength() / FLAGS_samples;
+  double cost = 0.0;
+  for (int i = 0; i < FLAGS_samples; ++i) {
+    const double s = step * i;
+    const double l = curve.Evaluate(0, s);
+    const double dddl = curve.Evaluate(3, s);
+    cost += l * l + dddl * dddl;
+  }
+  return cost;
+}
+
+double CostWithPerfFunction(const QuinticPolynomialCurve1d& curve) {
+  PERF_FUNCTION();
+  return Cost(curve);
+}
+
+// What PERF_FUNCTION expanded to with ENABLE_PERF.
+double CostWithTimerWrapper(const QuinticPolynomialCurve1d& curve) {
+  apollo::common::util::TimerWrapper timer(
+      apollo::common::util::function_signature(AFUNC));
+  return Cost(curve);
+}
+
+template <typename CostFunction>
+void Run(const char* name, const std::vector<QuinticPolynomialCurve1d>& curves,
+         CostFunction cost_function, double* base_ns) {
+  double sum = 0.0;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < FLAGS_candidates; ++i) {
+    sum += cost_function(curves[i % curves.size()]);
+  }
+  const double ns = std::chrono::duration<double, std::nano>(
+                        std::chrono::steady_clock::now() - start)
+                        .count() /
+                    FLAGS_candidates;
+  if (*base_ns == 0.0) {
+    *base_ns = ns;
+  }
+  printf("%-24s %8.1f ns per candidate, %+6.1f ns, %+5.1f%%  (%g)\n", name,
+         ns, ns - *base_ns, 100.0 * (ns - *base_ns) / *base_ns, sum);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  const auto curves = MakeCandidates();
+  double base_ns = 0.0;
+  printf("%d candidates of %d samples\n", FLAGS_candidates, FLAGS_samples);
+  Run("no scope", curves, Cost, &base_ns);
+  FLAGS_enable_scope_profiler = false;
+  Run("profiler disabled", curves, CostWithPerfFunction, &base_ns);
+  FLAGS_enable_scope_profiler = true;
+  Run("profiler enabled", curves, CostWithPerfFunction, &base_ns);
+  Run("TimerWrapper", curves, CostWithTimerWrapper, &base_ns);
+
+  const auto stats = apollo::common::ScopeProfiler::Instance()->Collect();
+  for (const auto& scope : stats) {
+    printf("%s: count %lu, p50 %.1f us, p99 %.1f us, max %.1f us\n",
+           scope.first.c_str(),
+           static_cast<unsigned long>(scope.second.count),  // NOLINT
+           static_cast<double>(scope.second.Percentile(0.5)) / 1e3,
+           static_cast<double>(scope.second.Percentile(0.99)) / 1e3,
+           static_cast<double>(scope.second.max_ns) / 1e3);
+  }
+  return 0;
+}
@@ -61,6 +61,14 @@ DEFINE_double(base_image_half_range, 100.0, "The half range of base image.");
 DEFINE_bool(enable_draw_adc_trajectory, true,
             "If draw adc trajectory in semantic map");
 DEFINE_bool(img_show_semantic_map, false, "If show the image of semantic map.");
+DEFINE_bool(enable_semantic_map_tiles, false,
+            "If draw the static map layers of the semantic map in world "
+            "aligned tiles cached across frames, and crop the obstacles "
+            "by warping only the cropped area.");
+DEFINE_int32(semantic_map_tile_size, 512,
+             "The side in pixels of a semantic map tile.");
+DEFINE_int32(semantic_map_max_tiles, 48,
+             "Maximal number of semantic map tiles cached.");
 
 // Scenario
 DEFINE_double(junction_distance_threshold, 10.0,
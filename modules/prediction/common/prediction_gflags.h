@@ -47,6 +47,9 @@ DECLARE_double(surrounding_lane_search_radius);
 DECLARE_double(base_image_half_range);
 DECLARE_bool(enable_draw_adc_trajectory);
 DECLARE_bool(img_show_semantic_map);
+DECLARE_bool(enable_semantic_map_tiles);
+DECLARE_int32(semantic_map_tile_size);
+DECLARE_int32(semantic_map_max_tiles);
 
 // Scenario
 DECLARE_double(junction_distance_threshold);
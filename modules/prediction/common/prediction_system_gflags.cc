@@ -61,6 +61,9 @@ DEFINE_int32(max_caution_thread_num, 2,
 DEFINE_bool(enable_async_draw_base_image, true,
             "If enable async to draw base image");
 DEFINE_bool(use_cuda, true, "If use cuda for torch.");
+DEFINE_bool(enable_batched_evaluation, false,
+            "If run the models of the evaluators once per frame "
+            "on the obstacles of all threads.");
 
 // Bag replay timestamp gap
 DEFINE_double(replay_timestamp_gap, 10.0,
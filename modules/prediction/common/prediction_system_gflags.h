@@ -37,6 +37,7 @@ DECLARE_int32(max_thread_num);
 DECLARE_int32(max_caution_thread_num);
 DECLARE_bool(enable_async_draw_base_image);
 DECLARE_bool(use_cuda);
+DECLARE_bool(enable_batched_evaluation);
 
 // Bag replay timestamp gap
 DECLARE_double(replay_timestamp_gap);
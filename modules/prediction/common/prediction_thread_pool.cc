@@ -19,65 +19,122 @@
 namespace apollo {
 namespace prediction {
 
-thread_local int PredictionThreadPool::s_thread_pool_level = 0;
-std::vector<int> BaseThreadPool::THREAD_POOL_CAPACITY = {20, 20, 20};
+int BaseThreadPool::THREAD_POOL_CAPACITY = 20;
 
-BaseThreadPool::BaseThreadPool(int thread_num, int next_thread_pool_level)
-    : stopped_(false) {
-  if (!task_queue_.Init(thread_num,
-                        new apollo::cyber::base::BlockWaitStrategy())) {
-    throw std::runtime_error("Task queue init failed.");
-  }
+BaseThreadPool::BaseThreadPool(int thread_num) {
   for (int i = 0; i < thread_num; ++i) {
-    workers_.emplace_back([this, next_thread_pool_level, i] {
-      PredictionThreadPool::s_thread_pool_level = next_thread_pool_level;
-      while (!stopped_) {
-        std::function<void()> task;
-        if (task_queue_.WaitDequeue(&task)) {
-          task();
-        }
-      }
-    });
+    workers_.emplace_back([this] { WorkerLoop(); });
   }
 }
 
 void BaseThreadPool::Stop() {
-  task_queue_.BreakAllWait();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) {
+      return;
+    }
+    stopped_ = true;
+  }
+  work_cv_.notify_all();
   for (std::thread& worker : workers_) {
     worker.join();
   }
-  stopped_ = true;
 }
 
-BaseThreadPool::~BaseThreadPool() {
-  if (stopped_.exchange(true)) {
-    return;
+BaseThreadPool::~BaseThreadPool() { Stop(); }
+
+void BaseThreadPool::Run(Job* job) {
+  // a few chunks per thread, so that uneven elements still balance
+  const size_t num_threads = workers_.size() + 1;
+  job->chunk_size = std::max<size_t>(1, job->size / (num_threads * 4));
+  const size_t num_chunks = (job->size + job->chunk_size - 1) / job->chunk_size;
+
+  bool shared = false;
+  if (num_chunks > 1) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!stopped_ && !workers_.empty()) {
+      job->next_job = jobs_;
+      jobs_ = job;
+      shared = true;
+    }
   }
-  task_queue_.BreakAllWait();
-  for (std::thread& worker : workers_) {
-    worker.join();
+  if (shared) {
+    // the caller runs chunks too
+    const size_t num_helpers = std::min(num_chunks - 1, workers_.size());
+    for (size_t i = 0; i < num_helpers; ++i) {
+      work_cv_.notify_one();
+    }
+  }
+
+  RunChunks(job);
+
+  if (shared) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (Job** link = &jobs_; *link != nullptr; link = &(*link)->next_job) {
+      if (*link == job) {
+        *link = job->next_job;
+        break;
+      }
+    }
+    // all the chunks are claimed, wait for the workers still running some
+    done_cv_.wait(lock, [job] { return job->active == 0; });
+  }
+  if (job->error) {
+    std::rethrow_exception(job->error);
   }
 }
 
-BaseThreadPool* PredictionThreadPool::Instance() {
-  int pool_level = s_thread_pool_level;
-  int max_thread_pool_level =
-      static_cast<int>(BaseThreadPool::THREAD_POOL_CAPACITY.size());
-  CHECK_LT(pool_level, max_thread_pool_level);
-  int index = s_thread_pool_level;
-  switch (index) {
-    case 0: {
-      return LevelThreadPool<0>::Instance();
+void BaseThreadPool::RunChunks(Job* job) {
+  while (true) {
+    const size_t first = job->next.fetch_add(job->chunk_size);
+    if (first >= job->size) {
+      return;
     }
-    case 1: {
-      return LevelThreadPool<1>::Instance();
+    const size_t last = std::min(first + job->chunk_size, job->size);
+    for (size_t i = first; i < last; ++i) {
+      // an element that throws does not skip the rest of its chunk
+      try {
+        job->run(job->context, i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!job->error) {
+          job->error = std::current_exception();
+        }
+      }
     }
-    case 2: {
-      return LevelThreadPool<2>::Instance();
+  }
+}
+
+BaseThreadPool::Job* BaseThreadPool::OpenJob() const {
+  for (Job* job = jobs_; job != nullptr; job = job->next_job) {
+    if (job->next.load() < job->size) {
+      return job;
     }
   }
-  AERROR << "Should not hit here";
-  return LevelThreadPool<0>::Instance();
+  return nullptr;
+}
+
+void BaseThreadPool::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    work_cv_.wait(lock, [this] { return stopped_ || OpenJob() != nullptr; });
+    if (stopped_) {
+      return;
+    }
+    Job* job = OpenJob();
+    ++job->active;
+    lock.unlock();
+    RunChunks(job);
+    lock.lock();
+    if (--job->active == 0) {
+      done_cv_.notify_all();
+    }
+  }
+}
+
+BaseThreadPool* PredictionThreadPool::Instance() {
+  static BaseThreadPool pool(BaseThreadPool::THREAD_POOL_CAPACITY);
+  return &pool;
 }
 
 }  // namespace prediction
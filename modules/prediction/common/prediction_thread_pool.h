@@ -20,89 +20,117 @@
 
 #pragma once
 
-#include <future>
-#include <memory>
-#include <utility>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
-#include "cyber/base/bounded_queue.h"
-#include "cyber/common/log.h"
-
 namespace apollo {
 namespace prediction {
 
+/**
+ * @class BaseThreadPool
+ * @brief Runs the elements of a range in chunks claimed by the workers and
+ *        the calling thread. A ForEach called from inside another one runs
+ *        its own chunks while the workers help, so nesting cannot run out of
+ *        threads, and no task is allocated.
+ */
 class BaseThreadPool {
  public:
-  BaseThreadPool(int thread_num, int next_thread_pool_level);
+  explicit BaseThreadPool(int thread_num);
 
   void Stop();
 
   ~BaseThreadPool();
 
+  /**
+   * @brief Call f on every element of [begin, end) and return when all the
+   *        calls are done. f is called on every element even if it throws
+   *        on some, and the first exception thrown is then rethrown.
+   */
   template <typename InputIter, typename F>
   void ForEach(InputIter begin, InputIter end, F f) {
-    std::vector<std::future<void>> futures;
+    using Category =
+        typename std::iterator_traits<InputIter>::iterator_category;
+    ForEach(begin, end, f, Category());
+  }
+
+  static int THREAD_POOL_CAPACITY;
+
+ private:
+  // A ForEach call, on the stack of its caller.
+  struct Job {
+    void (*run)(void* context, size_t index) = nullptr;
+    void* context = nullptr;
+    size_t size = 0;
+    size_t chunk_size = 1;
+    // next element to claim
+    std::atomic<size_t> next{0};
+    // workers inside RunChunks, guarded by mutex_
+    int active = 0;
+    std::exception_ptr error;
+    Job* next_job = nullptr;
+  };
+
+  template <typename RandomIter, typename F>
+  void ForEach(RandomIter begin, RandomIter end, F& f,
+               std::random_access_iterator_tag) {
+    auto run = [&f, begin](size_t i) { f(*(begin + i)); };
+    Run(static_cast<size_t>(std::distance(begin, end)), &run);
+  }
+
+  template <typename InputIter, typename F, typename Category>
+  void ForEach(InputIter begin, InputIter end, F& f, Category) {
+    std::vector<InputIter> iters;
     for (auto iter = begin; iter != end; ++iter) {
-      auto& elem = *iter;
-      futures.emplace_back(this->Post([&] { f(elem); }));
-    }
-    for (auto& future : futures) {
-      if (future.valid()) {
-        future.get();
-      } else {
-        AERROR << "Future is invalid.";
-      }
+      iters.push_back(iter);
     }
+    auto run = [&f, &iters](size_t i) { f(*iters[i]); };
+    Run(iters.size(), &run);
   }
 
-  template <typename FuncType>
-  std::future<typename std::result_of<FuncType()>::type> Post(FuncType&& func) {
-    typedef typename std::result_of<FuncType()>::type ReturnType;
-    typedef typename std::packaged_task<ReturnType()> TaskType;
-    // Post requires that the functions in it are copy-constructible.
-    // We used a shared pointer for the packaged_task,
-    // Since it's only movable and non-copyable
-    std::shared_ptr<TaskType> task =
-        std::make_shared<TaskType>(std::move(func));
-    std::future<ReturnType> returned_future = task->get_future();
-
-    // Note: variables eg. `task` must be copied here because of the lifetime
-    if (stopped_) {
-      return std::future<ReturnType>();
+  template <typename Element>
+  void Run(size_t size, Element* element) {
+    if (size == 0) {
+      return;
     }
-    task_queue_.Enqueue([task]() { (*task)(); });
-    return returned_future;
+    Job job;
+    job.run = [](void* context, size_t index) {
+      (*static_cast<Element*>(context))(index);
+    };
+    job.context = element;
+    job.size = size;
+    Run(&job);
   }
 
-  static std::vector<int> THREAD_POOL_CAPACITY;
+  void Run(Job* job);
 
- private:
-  std::vector<std::thread> workers_;
-  apollo::cyber::base::BoundedQueue<std::function<void()>> task_queue_;
-  std::atomic_bool stopped_;
-};
+  // Claim and run the chunks of job until none is left.
+  void RunChunks(Job* job);
 
-template <int LEVEL>
-class LevelThreadPool : public BaseThreadPool {
- public:
-  static LevelThreadPool* Instance() {
-    static LevelThreadPool<LEVEL> pool;
-    return &pool;
-  }
+  Job* OpenJob() const;
 
- private:
-  LevelThreadPool() : BaseThreadPool(THREAD_POOL_CAPACITY[LEVEL], LEVEL + 1) {
-    ADEBUG << "Level = " << LEVEL
-           << "; thread pool capacity = " << THREAD_POOL_CAPACITY[LEVEL];
-  }
+  void WorkerLoop();
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  // signaled when a job is added or the pool stops
+  std::condition_variable work_cv_;
+  // signaled when a worker leaves a job
+  std::condition_variable done_cv_;
+  Job* jobs_ = nullptr;
+  bool stopped_ = false;
 };
 
 class PredictionThreadPool {
  public:
   static BaseThreadPool* Instance();
 
-  static thread_local int s_thread_pool_level;
-
   template <typename InputIter, typename F>
   static void ForEach(InputIter begin, InputIter end, F f) {
     Instance()->ForEach(begin, end, f);
@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * Latency of the ForEach fan-outs of a prediction frame: the evaluators and
+ * the predictors run over the obstacles grouped by id modulo --groups, and
+ * each obstacle runs a nested ForEach over its lane sequences. The work of
+ * a lane sequence is a busy loop of --work_us microseconds.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/prediction/common/prediction_thread_pool.h"
+
+DEFINE_int32(frames, 200, "frames to run");
+DEFINE_int32(obstacles, 60, "obstacles per frame");
+DEFINE_int32(groups, 8, "obstacle groups, as max_thread_num");
+DEFINE_int32(lane_sequences, 3, "lane sequences per obstacle");
+DEFINE_double(work_us, 20.0, "work per lane sequence, in microseconds");
+
+namespace {
+
+using apollo::prediction::PredictionThreadPool;
+
+struct Obstacle {
+  int id = 0;
+  std::vector<double> lane_sequences;
+};
+
+void Work(double* value) {
+  const auto end = std::chrono::steady_clock::now() +
+                   std::chrono::nanoseconds(
+                       static_cast<int64_t>(FLAGS_work_us * 1000.0));
+  while (std::chrono::steady_clock::now() < end) {
+    *value += 1.0;
+  }
+}
+
+// One fan-out as EvaluatorManager::Run and PredictorManager::Run.
+void FanOut(std::vector<Obstacle>* obstacles, bool nested) {
+  std::unordered_map<int, std::list<Obstacle*>> groups;
+  for (auto& obstacle : *obstacles) {
+    groups[obstacle.id % FLAGS_groups].push_back(&obstacle);
+  }
+  PredictionThreadPool::ForEach(
+      groups.begin(), groups.end(),
+      [nested](std::unordered_map<int, std::list<Obstacle*>>::value_type&
+                   group) {
+        for (Obstacle* obstacle : group.second) {
+          if (nested) {
+            PredictionThreadPool::ForEach(obstacle->lane_sequences.begin(),
+                                          obstacle->lane_sequences.end(),
+                                          [](double& value) { Work(&value); });
+          } else {
+            for (double& value : obstacle->lane_sequences) {
+              Work(&value);
+            }
+          }
+        }
+      });
+}
+
+void Measure(const char* name, bool nested) {
+  std::vector<Obstacle> obstacles(FLAGS_obstacles);
+  for (int i = 0; i < FLAGS_obstacles; ++i) {
+    obstacles[i].id = i;
+    obstacles[i].lane_sequences.assign(FLAGS_lane_sequences, 0.0);
+  }
+  std::vector<double> ms;
+  for (int frame = 0; frame < FLAGS_frames; ++frame) {
+    const auto start = std::chrono::steady_clock::now();
+    // evaluators, then predictors
+    FanOut(&obstacles, nested);
+    FanOut(&obstacles, nested);
+    ms.push_back(std::chrono::duration<double, std::milli>(
+                     std::chrono::steady_clock::now() - start)
+                     .count());
+  }
+  std::sort(ms.begin(), ms.end());
+  double sum = 0.0;
+  for (double t : ms) {
+    sum += t;
+  }
+  printf("%-8s mean %7.3f ms, p50 %7.3f ms, p99 %7.3f ms\n", name,
+         sum / static_cast<double>(ms.size()), ms[ms.size() / 2],
+         ms[std::min(ms.size() - 1, ms.size() * 99 / 100)]);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  const double serial_ms = 2.0 * FLAGS_obstacles * FLAGS_lane_sequences *
+                           FLAGS_work_us / 1000.0;
+  printf("%d obstacles in %d groups, %d x %.0f us each, %.3f ms serial\n",
+         FLAGS_obstacles, FLAGS_groups, FLAGS_lane_sequences, FLAGS_work_us,
+         serial_ms);
+  Measure("flat", false);
+  Measure("nested", true);
+  return 0;
+}
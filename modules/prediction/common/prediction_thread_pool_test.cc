@@ -16,6 +16,11 @@
 
 #include "modules/prediction/common/prediction_thread_pool.h"
 
+#include <list>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+
 #include "gtest/gtest.h"
 
 namespace apollo {
@@ -33,7 +38,6 @@ TEST(PredictionThreadPoolTest, global_for_each) {
   EXPECT_EQ(expect, real);
 }
 
-/* TODO(kechxu) uncomment this when deadlock issue is fixed
 TEST(PredictionThreadPoolTest, avoid_deadlock) {
   std::vector<int> expect = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
   std::vector<int> real = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13};
@@ -44,21 +48,84 @@ TEST(PredictionThreadPoolTest, avoid_deadlock) {
     input = std::accumulate(vec.begin(), vec.end(), input);
   });
 
-  EXPECT_EQ(0, PredictionThreadPool::s_thread_pool_level);
-
   PredictionThreadPool::ForEach(real.begin(), real.end(), [](int& input) {
-    EXPECT_EQ(1, PredictionThreadPool::s_thread_pool_level);
     std::vector<int> vec = {1, 2, 3, 4};
     PredictionThreadPool::ForEach(vec.begin(), vec.end(), [](int& v) {
-      ++v;
-      EXPECT_EQ(2, PredictionThreadPool::s_thread_pool_level);
+      std::vector<int> inner = {1, 2};
+      PredictionThreadPool::ForEach(inner.begin(), inner.end(),
+                                    [](int& i) { i = 0; });
+      v += 1 + std::accumulate(inner.begin(), inner.end(), 0);
     });
     input = std::accumulate(vec.begin(), vec.end(), input);
   });
 
   EXPECT_EQ(expect, real);
 }
-*/
+
+TEST(PredictionThreadPoolTest, many_elements) {
+  std::vector<int> real(10000);
+  std::iota(real.begin(), real.end(), 0);
+  PredictionThreadPool::ForEach(real.begin(), real.end(),
+                                [](int& input) { input *= 2; });
+  for (int i = 0; i < static_cast<int>(real.size()); ++i) {
+    EXPECT_EQ(2 * i, real[i]);
+  }
+}
+
+TEST(PredictionThreadPoolTest, forward_iterator) {
+  std::unordered_map<int, std::list<int>> groups;
+  for (int i = 0; i < 100; ++i) {
+    groups[i % 8].push_back(i);
+  }
+  std::atomic<int> sum(0);
+  PredictionThreadPool::ForEach(
+      groups.begin(), groups.end(),
+      [&sum](std::unordered_map<int, std::list<int>>::value_type& group) {
+        for (int value : group.second) {
+          sum += value;
+        }
+      });
+  EXPECT_EQ(4950, sum.load());
+}
+
+TEST(PredictionThreadPoolTest, rethrow_exception) {
+  std::vector<int> real = {1, 2, 3, 4, 5, 6, 7, 8};
+  std::atomic<int> count(0);
+  EXPECT_THROW(PredictionThreadPool::ForEach(real.begin(), real.end(),
+                                             [&count](int& input) {
+                                               ++count;
+                                               if (input == 5) {
+                                                 throw std::runtime_error(
+                                                     "failed");
+                                               }
+                                             }),
+               std::runtime_error);
+  EXPECT_EQ(8, count.load());
+}
+
+TEST(PredictionThreadPoolTest, rethrow_exception_in_chunk) {
+  BaseThreadPool pool(2);
+  std::vector<int> real(1000);
+  std::iota(real.begin(), real.end(), 0);
+  std::atomic<int> count(0);
+  EXPECT_THROW(pool.ForEach(real.begin(), real.end(),
+                            [&count](int& input) {
+                              if (input == 500) {
+                                throw std::runtime_error("failed");
+                              }
+                              ++count;
+                            }),
+               std::runtime_error);
+  EXPECT_EQ(999, count.load());
+}
+
+TEST(PredictionThreadPoolTest, stopped_pool) {
+  BaseThreadPool pool(4);
+  pool.Stop();
+  std::vector<int> real = {1, 2, 3, 4, 5, 6, 7, 8};
+  pool.ForEach(real.begin(), real.end(), [](int& input) { ++input; });
+  EXPECT_EQ(std::vector<int>({2, 3, 4, 5, 6, 7, 8, 9}), real);
+}
 
 }  // namespace prediction
 }  // namespace apollo
@@ -16,6 +16,7 @@
 
 #include "modules/prediction/common/semantic_map.h"
 
+#include <cmath>
 #include <utility>
 #include <vector>
 
@@ -36,6 +37,35 @@ namespace prediction {
 
 namespace {
 
+// meters per pixel and side in pixels of the base image
+constexpr double kResolution = 0.1;
+constexpr int kImageSize = 2000;
+// extra search radius for the map objects of a tile whose lanes are off it
+constexpr double kTileSearchMargin = 10.0;
+
+int FloorDiv(const int a, const int b) {
+  return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+void FillPolygon(std::vector<cv::Point> polygon, const cv::Scalar& color,
+                 const cv::Matx23d* transform, cv::Mat* img) {
+  if (transform == nullptr) {
+    cv::fillPoly(*img,
+                 std::vector<std::vector<cv::Point>>({std::move(polygon)}),
+                 color);
+    return;
+  }
+  // keep the fractions of the transformed points
+  constexpr int kShift = 4;
+  for (auto& point : polygon) {
+    const cv::Vec2d p = (*transform) * cv::Vec3d(point.x, point.y, 1.0);
+    point = cv::Point(cvRound(p[0] * (1 << kShift)),
+                      cvRound(p[1] * (1 << kShift)));
+  }
+  cv::fillPoly(*img, std::vector<std::vector<cv::Point>>({std::move(polygon)}),
+               color, cv::LINE_8, kShift);
+}
+
 bool ValidFeatureHistory(const ObstacleHistory& obstacle_history,
                          const double curr_base_x, const double curr_base_y) {
   if (obstacle_history.feature_size() == 0) {
@@ -59,6 +89,8 @@ SemanticMap::SemanticMap() {}
 void SemanticMap::Init() {
   curr_img_ = cv::Mat(2000, 2000, CV_8UC3, cv::Scalar(0, 0, 0));
   obstacle_id_history_map_.clear();
+  tiles_.reset(new common::util::LRUCache<std::pair<int, int>, cv::Mat>(
+      FLAGS_semantic_map_max_tiles));
 }
 
 void SemanticMap::RunCurrFrame(
@@ -72,8 +104,7 @@ void SemanticMap::RunCurrFrame(
   if (!FLAGS_enable_async_draw_base_image) {
     double x = ego_feature_.position().x();
     double y = ego_feature_.position().y();
-    curr_base_x_ = x - FLAGS_base_image_half_range;
-    curr_base_y_ = y - FLAGS_base_image_half_range;
+    GetBasePosition(x, y, &curr_base_x_, &curr_base_y_);
     DrawBaseMap(x, y, curr_base_x_, curr_base_y_);
     base_img_.copyTo(curr_img_);
   } else {
@@ -113,30 +144,96 @@ void SemanticMap::RunCurrFrame(
   }
 }
 
+void SemanticMap::GetBasePosition(const double x, const double y,
+                                  double* base_x, double* base_y) {
+  *base_x = x - FLAGS_base_image_half_range;
+  *base_y = y - FLAGS_base_image_half_range;
+  if (FLAGS_enable_semantic_map_tiles) {
+    *base_x = std::round(*base_x / kResolution) * kResolution;
+    *base_y = std::round(*base_y / kResolution) * kResolution;
+  }
+}
+
 void SemanticMap::DrawBaseMap(const double x, const double y,
                               const double base_x, const double base_y) {
+  if (FLAGS_enable_semantic_map_tiles) {
+    DrawBaseMapFromTiles(base_x, base_y);
+    return;
+  }
   base_img_ = cv::Mat(2000, 2000, CV_8UC3, cv::Scalar(0, 0, 0));
   common::PointENU center_point = common::util::PointFactory::ToPointENU(x, y);
-  DrawRoads(center_point, base_x, base_y);
-  DrawJunctions(center_point, base_x, base_y);
-  DrawCrosswalks(center_point, base_x, base_y);
-  DrawLanes(center_point, base_x, base_y);
+  DrawStaticLayers(center_point, 141.4, base_x, base_y, &base_img_);
 }
 
 void SemanticMap::DrawBaseMapThread() {
   std::lock_guard<std::mutex> lock(draw_base_map_thread_mutex_);
   double x = ego_feature_.position().x();
   double y = ego_feature_.position().y();
-  base_x_ = x - FLAGS_base_image_half_range;
-  base_y_ = y - FLAGS_base_image_half_range;
+  GetBasePosition(x, y, &base_x_, &base_y_);
   DrawBaseMap(x, y, base_x_, base_y_);
 }
 
+void SemanticMap::DrawBaseMapFromTiles(const double base_x,
+                                       const double base_y) {
+  const int tile_size = FLAGS_semantic_map_tile_size;
+  // the pixel of the world at the bottom left corner of the image, a tile
+  // (i, j) spans the pixels from (i, j) * tile_size
+  const int base_col = static_cast<int>(std::lround(base_x / kResolution));
+  const int base_row = static_cast<int>(std::lround(base_y / kResolution));
+  base_img_ = cv::Mat(kImageSize, kImageSize, CV_8UC3, cv::Scalar(0, 0, 0));
+  const cv::Rect image_rect(0, 0, kImageSize, kImageSize);
+  for (int i = FloorDiv(base_col, tile_size);
+       i <= FloorDiv(base_col + kImageSize - 1, tile_size); ++i) {
+    for (int j = FloorDiv(base_row, tile_size);
+         j <= FloorDiv(base_row + kImageSize - 1, tile_size); ++j) {
+      const std::pair<int, int> key(i, j);
+      cv::Mat* tile = tiles_->Get(key);
+      if (tile == nullptr) {
+        tiles_->Put(key, DrawTile(i, j));
+        tile = tiles_->Get(key);
+      }
+      // image rows grow southward
+      const cv::Rect tile_rect(i * tile_size - base_col,
+                               kImageSize + base_row - (j + 1) * tile_size,
+                               tile_size, tile_size);
+      const cv::Rect rect = tile_rect & image_rect;
+      (*tile)(rect - tile_rect.tl()).copyTo(base_img_(rect));
+    }
+  }
+}
+
+cv::Mat SemanticMap::DrawTile(const int tile_x, const int tile_y) {
+  const int tile_size = FLAGS_semantic_map_tile_size;
+  const double tile_range = tile_size * kResolution;
+  cv::Mat tile(tile_size, tile_size, CV_8UC3, cv::Scalar(0, 0, 0));
+  const double tile_base_x = tile_x * tile_range;
+  const double tile_base_y = tile_y * tile_range;
+  common::PointENU center_point = common::util::PointFactory::ToPointENU(
+      tile_base_x + tile_range / 2.0, tile_base_y + tile_range / 2.0);
+  // GetTransPoint puts base_y on the row kImageSize, below the tile
+  DrawStaticLayers(center_point, tile_range * M_SQRT1_2 + kTileSearchMargin,
+                   tile_base_x,
+                   tile_base_y - (kImageSize - tile_size) * kResolution,
+                   &tile);
+  ADEBUG << "Drew semantic map tile (" << tile_x << ", " << tile_y << ").";
+  return tile;
+}
+
+void SemanticMap::DrawStaticLayers(const common::PointENU& center_point,
+                                   const double radius, const double base_x,
+                                   const double base_y, cv::Mat* img) {
+  DrawRoads(center_point, radius, base_x, base_y, img);
+  DrawJunctions(center_point, radius, base_x, base_y, img);
+  DrawCrosswalks(center_point, radius, base_x, base_y, img);
+  DrawLanes(center_point, radius, base_x, base_y, img);
+}
+
 void SemanticMap::DrawRoads(const common::PointENU& center_point,
-                            const double base_x, const double base_y,
+                            const double radius, const double base_x,
+                            const double base_y, cv::Mat* img,
                             const cv::Scalar& color) {
   std::vector<apollo::hdmap::RoadInfoConstPtr> roads;
-  apollo::hdmap::HDMapUtil::BaseMap().GetRoads(center_point, 141.4, &roads);
+  apollo::hdmap::HDMapUtil::BaseMap().GetRoads(center_point, radius, &roads);
   for (const auto& road : roads) {
     for (const auto& section : road->road().section()) {
       std::vector<cv::Point> polygon;
@@ -158,7 +255,7 @@ void SemanticMap::DrawRoads(const common::PointENU& center_point,
           }
         }
       }
-      cv::fillPoly(base_img_,
+      cv::fillPoly(*img,
                    std::vector<std::vector<cv::Point>>({std::move(polygon)}),
                    color);
     }
@@ -166,10 +263,11 @@ void SemanticMap::DrawRoads(const common::PointENU& center_point,
 }
 
 void SemanticMap::DrawJunctions(const common::PointENU& center_point,
-                                const double base_x, const double base_y,
+                                const double radius, const double base_x,
+                                const double base_y, cv::Mat* img,
                                 const cv::Scalar& color) {
   std::vector<apollo::hdmap::JunctionInfoConstPtr> junctions;
-  apollo::hdmap::HDMapUtil::BaseMap().GetJunctions(center_point, 141.4,
+  apollo::hdmap::HDMapUtil::BaseMap().GetJunctions(center_point, radius,
                                                    &junctions);
   for (const auto& junction : junctions) {
     std::vector<cv::Point> polygon;
@@ -177,17 +275,18 @@ void SemanticMap::DrawJunctions(const common::PointENU& center_point,
       polygon.push_back(
           std::move(GetTransPoint(point.x(), point.y(), base_x, base_y)));
     }
-    cv::fillPoly(base_img_,
+    cv::fillPoly(*img,
                  std::vector<std::vector<cv::Point>>({std::move(polygon)}),
                  color);
   }
 }
 
 void SemanticMap::DrawCrosswalks(const common::PointENU& center_point,
-                                 const double base_x, const double base_y,
+                                 const double radius, const double base_x,
+                                 const double base_y, cv::Mat* img,
                                  const cv::Scalar& color) {
   std::vector<apollo::hdmap::CrosswalkInfoConstPtr> crosswalks;
-  apollo::hdmap::HDMapUtil::BaseMap().GetCrosswalks(center_point, 141.4,
+  apollo::hdmap::HDMapUtil::BaseMap().GetCrosswalks(center_point, radius,
                                                     &crosswalks);
   for (const auto& crosswalk : crosswalks) {
     std::vector<cv::Point> polygon;
@@ -195,17 +294,18 @@ void SemanticMap::DrawCrosswalks(const common::PointENU& center_point,
       polygon.push_back(
           std::move(GetTransPoint(point.x(), point.y(), base_x, base_y)));
     }
-    cv::fillPoly(base_img_,
+    cv::fillPoly(*img,
                  std::vector<std::vector<cv::Point>>({std::move(polygon)}),
                  color);
   }
 }
 
 void SemanticMap::DrawLanes(const common::PointENU& center_point,
-                            const double base_x, const double base_y,
+                            const double radius, const double base_x,
+                            const double base_y, cv::Mat* img,
                             const cv::Scalar& color) {
   std::vector<apollo::hdmap::LaneInfoConstPtr> lanes;
-  apollo::hdmap::HDMapUtil::BaseMap().GetLanes(center_point, 141.4, &lanes);
+  apollo::hdmap::HDMapUtil::BaseMap().GetLanes(center_point, radius, &lanes);
   for (const auto& lane : lanes) {
     // Draw lane_central first
     for (const auto& segment : lane->lane().central_curve().segment()) {
@@ -229,7 +329,7 @@ void SemanticMap::DrawLanes(const common::PointENU& center_point,
         //     cv::Scalar(rgb.at<float>(0, 0) * 255, rgb.at<float>(0, 1) * 255,
         //                rgb.at<float>(0, 2) * 255);
 
-        cv::line(base_img_, p0, p1, HSVtoRGB(H), 4);
+        cv::line(*img, p0, p1, HSVtoRGB(H), 4);
       }
     }
     // Not drawing boundary for virtual city_driving lane
@@ -246,7 +346,7 @@ void SemanticMap::DrawLanes(const common::PointENU& center_point,
         const auto& p1 = GetTransPoint(segment.line_segment().point(i + 1).x(),
                                        segment.line_segment().point(i + 1).y(),
                                        base_x, base_y);
-        cv::line(base_img_, p0, p1, color, 2);
+        cv::line(*img, p0, p1, color, 2);
       }
     }
     // Draw lane's right_boundary
@@ -259,7 +359,7 @@ void SemanticMap::DrawLanes(const common::PointENU& center_point,
         const auto& p1 = GetTransPoint(segment.line_segment().point(i + 1).x(),
                                        segment.line_segment().point(i + 1).y(),
                                        base_x, base_y);
-        cv::line(base_img_, p0, p1, color, 2);
+        cv::line(*img, p0, p1, color, 2);
       }
     }
   }
@@ -289,7 +389,7 @@ cv::Scalar SemanticMap::HSVtoRGB(double H, double S, double V) {
 
 void SemanticMap::DrawRect(const Feature& feature, const cv::Scalar& color,
                            const double base_x, const double base_y,
-                           cv::Mat* img) {
+                           cv::Mat* img, const cv::Matx23d* transform) {
   double obs_l = feature.length();
   double obs_w = feature.width();
   double obs_x = feature.position().x();
@@ -313,37 +413,36 @@ void SemanticMap::DrawRect(const Feature& feature, const cv::Scalar& color,
   polygon.push_back(std::move(GetTransPoint(
       obs_x + (cos(theta) * obs_l - sin(theta) * -obs_w) / 2,
       obs_y + (sin(theta) * obs_l + cos(theta) * -obs_w) / 2, base_x, base_y)));
-  cv::fillPoly(*img, std::vector<std::vector<cv::Point>>({std::move(polygon)}),
-               color);
+  FillPolygon(std::move(polygon), color, transform, img);
 }
 
 void SemanticMap::DrawPoly(const Feature& feature, const cv::Scalar& color,
                            const double base_x, const double base_y,
-                           cv::Mat* img) {
+                           cv::Mat* img, const cv::Matx23d* transform) {
   std::vector<cv::Point> polygon;
   for (auto& polygon_point : feature.polygon_point()) {
     polygon.push_back(std::move(
         GetTransPoint(polygon_point.x(), polygon_point.y(), base_x, base_y)));
   }
-  cv::fillPoly(*img, std::vector<std::vector<cv::Point>>({std::move(polygon)}),
-               color);
+  FillPolygon(std::move(polygon), color, transform, img);
 }
 
 void SemanticMap::DrawHistory(const ObstacleHistory& history,
                               const cv::Scalar& color, const double base_x,
-                              const double base_y, cv::Mat* img) {
+                              const double base_y, cv::Mat* img,
+                              const cv::Matx23d* transform) {
   for (int i = history.feature_size() - 1; i >= 0; --i) {
     const Feature& feature = history.feature(i);
     double time_decay = 1.0 - ego_feature_.timestamp() + feature.timestamp();
     cv::Scalar decay_color = color * time_decay;
     if (feature.id() == FLAGS_ego_vehicle_id) {
-      DrawRect(feature, decay_color, base_x, base_y, img);
+      DrawRect(feature, decay_color, base_x, base_y, img, transform);
     } else {
       if (feature.polygon_point_size() == 0) {
         AERROR << "No polygon points in feature, please check!";
         continue;
       }
-      DrawPoly(feature, decay_color, base_x, base_y, img);
+      DrawPoly(feature, decay_color, base_x, base_y, img, transform);
     }
   }
 }
@@ -374,14 +473,39 @@ cv::Mat SemanticMap::CropArea(const cv::Mat& input_img,
   return output_img;
 }
 
+cv::Matx23d SemanticMap::CropTransform(const cv::Point2i& center_point,
+                                       const double heading) {
+  // rotate as CropArea, then move its 400 x 400 crop to the origin and scale
+  // it to 224 x 224 sampling at pixel centers as cv::resize
+  cv::Matx23d transform =
+      cv::getRotationMatrix2D(center_point, 90.0 - heading * 180.0 / M_PI, 1.0);
+  transform(0, 2) -= center_point.x - 200;
+  transform(1, 2) -= center_point.y - 300;
+  const double scale = 224.0 / 400.0;
+  transform = transform * scale;
+  transform(0, 2) += 0.5 * scale - 0.5;
+  transform(1, 2) += 0.5 * scale - 0.5;
+  return transform;
+}
+
 cv::Mat SemanticMap::CropByHistory(const ObstacleHistory& history,
                                    const cv::Scalar& color, const double base_x,
                                    const double base_y) {
-  cv::Mat feature_map = curr_img_.clone();
-  DrawHistory(history, color, base_x, base_y, &feature_map);
   const Feature& curr_feature = history.feature(0);
   const cv::Point2i& center_point = GetTransPoint(
       curr_feature.position().x(), curr_feature.position().y(), base_x, base_y);
+  if (FLAGS_enable_semantic_map_tiles) {
+    // Warp only the crop out of the shared image and draw the history of the
+    // obstacle on the crop.
+    const cv::Matx23d transform =
+        CropTransform(center_point, curr_feature.theta());
+    cv::Mat output_img;
+    cv::warpAffine(curr_img_, output_img, transform, cv::Size(224, 224));
+    DrawHistory(history, color, base_x, base_y, &output_img, &transform);
+    return output_img;
+  }
+  cv::Mat feature_map = curr_img_.clone();
+  DrawHistory(history, color, base_x, base_y, &feature_map);
   return CropArea(feature_map, center_point, curr_feature.theta());
 }
 
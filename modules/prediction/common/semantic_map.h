@@ -17,11 +17,14 @@
 #pragma once
 
 #include <future>
+#include <memory>
 #include <unordered_map>
+#include <utility>
 
 #include "opencv2/opencv.hpp"
 
 #include "cyber/common/macros.h"
+#include "modules/common/util/lru_cache.h"
 #include "modules/common_msgs/prediction_msgs/feature.pb.h"
 
 namespace apollo {
@@ -47,37 +50,58 @@ class SemanticMap {
                        static_cast<int>(2000 - (y - base_y) / 0.1));
   }
 
+  // Get the bottom left corner of the base image around (x, y), on the
+  // pixel grid of the tiles if they are enabled
+  void GetBasePosition(const double x, const double y, double* base_x,
+                       double* base_y);
+
   void DrawBaseMap(const double x, const double y, const double base_x,
                    const double base_y);
 
   void DrawBaseMapThread();
 
-  void DrawRoads(const common::PointENU& center_point, const double base_x,
-                 const double base_y,
+  // Copy the base image from the tiles it overlaps, drawing the missing ones
+  void DrawBaseMapFromTiles(const double base_x, const double base_y);
+
+  cv::Mat DrawTile(const int tile_x, const int tile_y);
+
+  // Draw the map objects within radius of center_point
+  void DrawStaticLayers(const common::PointENU& center_point,
+                        const double radius, const double base_x,
+                        const double base_y, cv::Mat* img);
+
+  void DrawRoads(const common::PointENU& center_point, const double radius,
+                 const double base_x, const double base_y, cv::Mat* img,
                  const cv::Scalar& color = cv::Scalar(64, 64, 64));
 
-  void DrawJunctions(const common::PointENU& center_point, const double base_x,
-                     const double base_y,
+  void DrawJunctions(const common::PointENU& center_point, const double radius,
+                     const double base_x, const double base_y, cv::Mat* img,
                      const cv::Scalar& color = cv::Scalar(128, 128, 128));
 
-  void DrawCrosswalks(const common::PointENU& center_point, const double base_x,
-                      const double base_y,
+  void DrawCrosswalks(const common::PointENU& center_point,
+                      const double radius, const double base_x,
+                      const double base_y, cv::Mat* img,
                       const cv::Scalar& color = cv::Scalar(192, 192, 192));
 
-  void DrawLanes(const common::PointENU& center_point, const double base_x,
-                 const double base_y,
+  void DrawLanes(const common::PointENU& center_point, const double radius,
+                 const double base_x, const double base_y, cv::Mat* img,
                  const cv::Scalar& color = cv::Scalar(255, 255, 255));
 
   cv::Scalar HSVtoRGB(double H = 1.0, double S = 1.0, double V = 1.0);
 
+  // The polygons are drawn through transform from the base image pixels if
+  // it is given
   void DrawRect(const Feature& feature, const cv::Scalar& color,
-                const double base_x, const double base_y, cv::Mat* img);
+                const double base_x, const double base_y, cv::Mat* img,
+                const cv::Matx23d* transform = nullptr);
 
   void DrawPoly(const Feature& feature, const cv::Scalar& color,
-                const double base_x, const double base_y, cv::Mat* img);
+                const double base_x, const double base_y, cv::Mat* img,
+                const cv::Matx23d* transform = nullptr);
 
   void DrawHistory(const ObstacleHistory& history, const cv::Scalar& color,
-                   const double base_x, const double base_y, cv::Mat* img);
+                   const double base_x, const double base_y, cv::Mat* img,
+                   const cv::Matx23d* transform = nullptr);
 
   // Draw adc trajectory in semantic map
   void DrawADCTrajectory(const cv::Scalar& color, const double base_x,
@@ -86,6 +110,10 @@ class SemanticMap {
   cv::Mat CropArea(const cv::Mat& input_img, const cv::Point2i& center_point,
                    const double heading);
 
+  // The affine transform from the base image to the crop of CropArea
+  cv::Matx23d CropTransform(const cv::Point2i& center_point,
+                            const double heading);
+
   cv::Mat CropByHistory(const ObstacleHistory& history, const cv::Scalar& color,
                         const double base_x, const double base_y);
 
@@ -97,6 +125,10 @@ class SemanticMap {
 
   std::mutex draw_base_map_thread_mutex_;
 
+  // static map layers drawn in world aligned tiles, by tile index
+  std::unique_ptr<common::util::LRUCache<std::pair<int, int>, cv::Mat>>
+      tiles_;
+
   // base_image, base_x, and base_y to be used in the current cycle
   cv::Mat curr_img_;
   double curr_base_x_ = 0.0;
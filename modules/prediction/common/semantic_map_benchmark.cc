@@ -0,0 +1,193 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * Per frame cost of the semantic map with and without the tiles: the base
+ * map drawn in RunCurrFrame, synchronously, and the crops of all the
+ * obstacles. The ego vehicle drives along the lanes of the base map from
+ * its first lane, with --obstacles vehicles ahead and behind it.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/common/file.h"
+#include "modules/common_msgs/map_msgs/map.pb.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_system_gflags.h"
+#include "modules/prediction/common/semantic_map.h"
+
+DEFINE_int32(frames, 300, "frames to run");
+DEFINE_int32(obstacles, 30, "obstacles around the ego vehicle");
+DEFINE_double(frame_distance, 1.5, "distance driven per frame, in meters");
+
+namespace {
+
+using apollo::hdmap::HDMapUtil;
+using apollo::hdmap::LaneInfoConstPtr;
+using apollo::prediction::Feature;
+using apollo::prediction::ObstacleHistory;
+using apollo::prediction::SemanticMap;
+
+constexpr int kHistoryLength = 10;
+constexpr double kFrameTime = 0.1;
+
+struct RoutePoint {
+  double x;
+  double y;
+  double heading;
+};
+
+// Points every meter along the first successors of the first lane.
+std::vector<RoutePoint> BuildRoute() {
+  std::vector<RoutePoint> route;
+  apollo::hdmap::Map map;
+  if (!apollo::cyber::common::GetProtoFromFile(apollo::hdmap::BaseMapFile(),
+                                               &map) ||
+      map.lane().empty()) {
+    return route;
+  }
+  LaneInfoConstPtr lane = HDMapUtil::BaseMap().GetLaneById(map.lane(0).id());
+  std::vector<std::string> visited;
+  while (lane != nullptr &&
+         std::find(visited.begin(), visited.end(), lane->id().id()) ==
+             visited.end()) {
+    visited.push_back(lane->id().id());
+    for (double s = 0.0; s < lane->total_length(); s += 1.0) {
+      const auto point = lane->GetSmoothPoint(s);
+      route.push_back({point.x(), point.y(), lane->Heading(s)});
+    }
+    if (lane->lane().successor_id().empty()) {
+      break;
+    }
+    lane = HDMapUtil::BaseMap().GetLaneById(lane->lane().successor_id(0));
+  }
+  return route;
+}
+
+const RoutePoint& PointAt(const std::vector<RoutePoint>& route, double s) {
+  const int index = static_cast<int>(std::floor(s));
+  return route[std::max(0, std::min(static_cast<int>(route.size()) - 1,
+                                    index))];
+}
+
+Feature MakeFeature(int id, const RoutePoint& point, double lateral,
+                    double timestamp) {
+  Feature feature;
+  feature.set_id(id);
+  feature.set_timestamp(timestamp);
+  const double x = point.x - std::sin(point.heading) * lateral;
+  const double y = point.y + std::cos(point.heading) * lateral;
+  feature.mutable_position()->set_x(x);
+  feature.mutable_position()->set_y(y);
+  feature.set_theta(point.heading);
+  feature.set_velocity_heading(point.heading);
+  feature.set_length(4.5);
+  feature.set_width(2.0);
+  const double c = std::cos(point.heading);
+  const double s = std::sin(point.heading);
+  const std::pair<double, double> corners[] = {
+      {2.25, 1.0}, {-2.25, 1.0}, {-2.25, -1.0}, {2.25, -1.0}};
+  for (const auto& corner : corners) {
+    auto* polygon_point = feature.add_polygon_point();
+    polygon_point->set_x(x + c * corner.first - s * corner.second);
+    polygon_point->set_y(y + s * corner.first + c * corner.second);
+  }
+  return feature;
+}
+
+std::unordered_map<int, ObstacleHistory> MakeFrame(
+    const std::vector<RoutePoint>& route, int frame) {
+  std::unordered_map<int, ObstacleHistory> histories;
+  const double ego_s = 100.0 + frame * FLAGS_frame_distance;
+  for (int k = -1; k < FLAGS_obstacles; ++k) {
+    const int id = k < 0 ? FLAGS_ego_vehicle_id : k;
+    // spread the obstacles 50 m ahead and behind, on the neighbor lanes
+    const double offset =
+        k < 0 ? 0.0 : -50.0 + 100.0 * k / std::max(1, FLAGS_obstacles);
+    const double lateral = k < 0 ? 0.0 : 3.5 * (k % 3 - 1);
+    ObstacleHistory& history = histories[id];
+    for (int i = 0; i < kHistoryLength; ++i) {
+      const double s = ego_s + offset - i * FLAGS_frame_distance;
+      *history.add_feature() = MakeFeature(
+          id, PointAt(route, s), lateral, (frame - i) * kFrameTime);
+    }
+  }
+  return histories;
+}
+
+void Run(const std::vector<RoutePoint>& route, bool tiles) {
+  FLAGS_enable_semantic_map_tiles = tiles;
+  SemanticMap semantic_map;
+  semantic_map.Init();
+  std::vector<double> base_ms;
+  std::vector<double> crop_ms;
+  for (int frame = 0; frame < FLAGS_frames; ++frame) {
+    const auto histories = MakeFrame(route, frame);
+    auto start = std::chrono::steady_clock::now();
+    semantic_map.RunCurrFrame(histories);
+    base_ms.push_back(std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - start)
+                          .count());
+    start = std::chrono::steady_clock::now();
+    cv::Mat feature_map;
+    for (int id = 0; id < FLAGS_obstacles; ++id) {
+      semantic_map.GetMapById(id, &feature_map);
+    }
+    crop_ms.push_back(std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - start)
+                          .count());
+  }
+  auto print = [](const char* name, std::vector<double> ms) {
+    std::sort(ms.begin(), ms.end());
+    double sum = 0.0;
+    for (double t : ms) {
+      sum += t;
+    }
+    printf("  %-6s mean %8.3f ms, p50 %8.3f ms, max %8.3f ms\n", name,
+           sum / static_cast<double>(ms.size()), ms[ms.size() / 2], ms.back());
+  };
+  printf("%s:\n", tiles ? "tiles" : "redraw");
+  print("frame", base_ms);
+  print("crops", crop_ms);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  FLAGS_enable_async_draw_base_image = false;
+  FLAGS_img_show_semantic_map = false;
+  const std::vector<RoutePoint> route = BuildRoute();
+  if (route.empty()) {
+    fprintf(stderr, "no lanes in %s\n", apollo::hdmap::BaseMapFile().c_str());
+    return 1;
+  }
+  printf("%d frames along %zu m of lanes, %d obstacles\n", FLAGS_frames,
+         route.size(), FLAGS_obstacles);
+  Run(route, false);
+  Run(route, true);
+  return 0;
+}
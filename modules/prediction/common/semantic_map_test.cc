@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/semantic_map.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/prediction/common/kml_map_based_test.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_system_gflags.h"
+
+namespace apollo {
+namespace prediction {
+
+namespace {
+
+constexpr int kObstacleId = 1;
+constexpr int kHistoryLength = 10;
+
+Feature MakeFeature(const int id, const hdmap::LaneInfoConstPtr& lane,
+                    const double s, const double timestamp) {
+  Feature feature;
+  feature.set_id(id);
+  feature.set_timestamp(timestamp);
+  const common::PointENU point = lane->GetSmoothPoint(s);
+  const double heading = lane->Heading(s);
+  feature.mutable_position()->set_x(point.x());
+  feature.mutable_position()->set_y(point.y());
+  feature.set_theta(heading);
+  feature.set_length(4.5);
+  feature.set_width(2.0);
+  const double c = std::cos(heading);
+  const double d = std::sin(heading);
+  const double corners[4][2] = {
+      {2.25, 1.0}, {-2.25, 1.0}, {-2.25, -1.0}, {2.25, -1.0}};
+  for (const auto& corner : corners) {
+    auto* polygon_point = feature.add_polygon_point();
+    polygon_point->set_x(point.x() + c * corner[0] - d * corner[1]);
+    polygon_point->set_y(point.y() + d * corner[0] + c * corner[1]);
+  }
+  return feature;
+}
+
+}  // namespace
+
+class SemanticMapTest : public KMLMapBasedTest {
+ public:
+  SemanticMapTest() {
+    FLAGS_enable_async_draw_base_image = false;
+    FLAGS_img_show_semantic_map = false;
+  }
+
+  ~SemanticMapTest() { FLAGS_enable_semantic_map_tiles = false; }
+
+ protected:
+  // The ego vehicle and an obstacle 20 m ahead of it on the same lane
+  std::unordered_map<int, ObstacleHistory> MakeFrame() {
+    const auto lane =
+        hdmap::HDMapUtil::BaseMap().GetLaneById(hdmap::MakeMapId("l61"));
+    std::unordered_map<int, ObstacleHistory> histories;
+    if (lane == nullptr) {
+      return histories;
+    }
+    const double ego_s = lane->total_length() / 2.0;
+    for (const int id : {FLAGS_ego_vehicle_id, kObstacleId}) {
+      const double offset = id == kObstacleId ? 20.0 : 0.0;
+      for (int i = 0; i < kHistoryLength; ++i) {
+        const double s = std::max(0.0, ego_s + offset - i * 1.0);
+        *histories[id].add_feature() = MakeFeature(id, lane, s, -0.1 * i);
+      }
+    }
+    return histories;
+  }
+
+  cv::Mat Crop(const bool tiles, const int id) {
+    FLAGS_enable_semantic_map_tiles = tiles;
+    SemanticMap semantic_map;
+    semantic_map.Init();
+    semantic_map.RunCurrFrame(MakeFrame());
+    cv::Mat feature_map;
+    EXPECT_TRUE(semantic_map.GetMapById(id, &feature_map));
+    return feature_map;
+  }
+};
+
+TEST_F(SemanticMapTest, TiledCropMatchesRedraw) {
+  ASSERT_FALSE(MakeFrame().empty());
+  for (const int id : {FLAGS_ego_vehicle_id, kObstacleId}) {
+    const cv::Mat redraw = Crop(false, id);
+    const cv::Mat tiled = Crop(true, id);
+    ASSERT_EQ(redraw.size(), cv::Size(224, 224));
+    ASSERT_EQ(tiled.size(), redraw.size());
+    ASSERT_EQ(tiled.type(), redraw.type());
+
+    cv::Mat diff;
+    cv::absdiff(redraw, tiled, diff);
+    // The warp resamples edges slightly differently from rotate and resize,
+    // and the histories are drawn with sub-pixel points on the crop.
+    const cv::Scalar mean_diff = cv::mean(diff);
+    for (int c = 0; c < 3; ++c) {
+      EXPECT_LT(mean_diff[c], 4.0) << "obstacle " << id << " channel " << c;
+    }
+    cv::Mat gray_diff;
+    cv::cvtColor(diff, gray_diff, cv::COLOR_BGR2GRAY);
+    const double far_ratio = cv::countNonZero(gray_diff > 64) /
+                             static_cast<double>(gray_diff.total());
+    EXPECT_LT(far_ratio, 0.02) << "obstacle " << id;
+  }
+}
+
+}  // namespace prediction
+}  // namespace apollo
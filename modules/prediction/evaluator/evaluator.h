@@ -83,6 +83,20 @@ class Evaluator {
                         ObstaclesContainer* obstacles_container) {
     return Evaluate(obstacle, obstacles_container);
   }
+
+  /**
+   * @brief Defer the model inference of the obstacles evaluated from now on
+   *        to EndBatch, to run it once for all of them. Evaluators without
+   *        a model evaluate as usual.
+   */
+  virtual void BeginBatch() {}
+
+  /**
+   * @brief Run the model inference deferred since BeginBatch and write its
+   *        results to the obstacles.
+   */
+  virtual void EndBatch() {}
+
   /**
    * @brief Get the name of evaluator
    */
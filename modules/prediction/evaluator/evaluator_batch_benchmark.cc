@@ -0,0 +1,150 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * Model inference latency of a frame with one forward per lane sequence, as
+ * the evaluators run without batching, and with one forward per model on
+ * the ModelBatch of the frame. A frame has --obstacles vehicles with
+ * --lane_sequences lane sequences each for the cruise MLP, a quarter of
+ * them also in a junction for the junction MLP, as at a busy intersection.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/evaluator/model_batch.h"
+
+DEFINE_int32(frames, 100, "frames to run");
+DEFINE_int32(obstacles, 60, "vehicles per frame");
+DEFINE_int32(lane_sequences, 3, "lane sequences per vehicle");
+
+namespace {
+
+using apollo::prediction::ModelBatch;
+
+// the input sizes of CruiseMLPEvaluator and JunctionMLPEvaluator
+constexpr int kCruiseInputDim = 23 + 5 * 9 + 4 * 20;
+constexpr int kJunctionInputDim = 4 + 2 * 5 + 4 + 12 * 8;
+
+struct Latency {
+  std::vector<double> ms;
+
+  void Print(const char* name) {
+    std::sort(ms.begin(), ms.end());
+    double sum = 0.0;
+    for (double t : ms) {
+      sum += t;
+    }
+    printf("%-10s mean %8.3f ms, p50 %8.3f ms, p99 %8.3f ms\n", name,
+           sum / static_cast<double>(ms.size()), ms[ms.size() / 2],
+           ms[std::min(ms.size() - 1, ms.size() * 99 / 100)]);
+  }
+};
+
+double Elapsed(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  torch::set_num_threads(1);
+  const torch::Device device(torch::kCPU);
+  torch::jit::script::Module cruise_model =
+      torch::jit::load(FLAGS_torch_vehicle_cruise_go_file, device);
+  torch::jit::script::Module junction_model =
+      torch::jit::load(FLAGS_torch_vehicle_junction_mlp_file, device);
+
+  torch::manual_seed(0);
+  const int num_cruise_rows = FLAGS_obstacles * FLAGS_lane_sequences;
+  const int num_junction_rows = FLAGS_obstacles / 4;
+  printf("%d frames of %d cruise and %d junction rows\n", FLAGS_frames,
+         num_cruise_rows, num_junction_rows);
+
+  Latency per_row;
+  Latency batched;
+  double max_diff = 0.0;
+  for (int frame = 0; frame < FLAGS_frames; ++frame) {
+    std::vector<torch::Tensor> cruise_rows;
+    std::vector<torch::Tensor> junction_rows;
+    for (int i = 0; i < num_cruise_rows; ++i) {
+      cruise_rows.push_back(torch::randn({1, kCruiseInputDim}));
+    }
+    for (int i = 0; i < num_junction_rows; ++i) {
+      junction_rows.push_back(torch::randn({1, kJunctionInputDim}));
+    }
+
+    std::vector<double> row_outputs;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& row : cruise_rows) {
+      std::vector<torch::jit::IValue> torch_inputs = {row.to(device)};
+      auto output = cruise_model.forward(torch_inputs).toTuple();
+      at::Tensor probability = output->elements()[0].toTensor();
+      row_outputs.push_back(probability.accessor<float, 2>()[0][0]);
+    }
+    for (const auto& row : junction_rows) {
+      std::vector<torch::jit::IValue> torch_inputs = {row.to(device)};
+      at::Tensor probability = junction_model.forward(torch_inputs).toTensor();
+      row_outputs.push_back(probability.accessor<float, 2>()[0][0]);
+    }
+    per_row.ms.push_back(Elapsed(start));
+
+    std::vector<double> batch_outputs(row_outputs.size());
+    start = std::chrono::steady_clock::now();
+    ModelBatch cruise_batch;
+    ModelBatch junction_batch;
+    for (int i = 0; i < num_cruise_rows; ++i) {
+      cruise_batch.Add(
+          {cruise_rows[i]},
+          [&batch_outputs, i](const torch::jit::IValue& output, int64_t index) {
+            at::Tensor probability = output.toTuple()->elements()[0].toTensor();
+            batch_outputs[i] = probability.accessor<float, 2>()[index][0];
+          });
+    }
+    for (int i = 0; i < num_junction_rows; ++i) {
+      junction_batch.Add(
+          {junction_rows[i]}, [&batch_outputs, i, num_cruise_rows](
+                                  const torch::jit::IValue& output,
+                                  int64_t index) {
+            at::Tensor probability = output.toTensor();
+            batch_outputs[num_cruise_rows + i] =
+                probability.accessor<float, 2>()[index][0];
+          });
+    }
+    cruise_batch.Run(&cruise_model, device);
+    junction_batch.Run(&junction_model, device);
+    batched.ms.push_back(Elapsed(start));
+
+    for (size_t i = 0; i < row_outputs.size(); ++i) {
+      max_diff =
+          std::max(max_diff, std::abs(row_outputs[i] - batch_outputs[i]));
+    }
+  }
+
+  per_row.Print("per row");
+  batched.Print("batched");
+  printf("max output difference %g\n", max_diff);
+  return 0;
+}
@@ -213,6 +213,13 @@ void EvaluatorManager::Run(
     semantic_map_->RunCurrFrame(obstacle_id_history_map_);
   }
 
+  // Gather the model inputs of all the obstacles to run each model once.
+  if (FLAGS_enable_batched_evaluation) {
+    for (auto& evaluator : evaluators_) {
+      evaluator.second->BeginBatch();
+    }
+  }
+
   std::vector<Obstacle*> dynamic_env;
 
   if (FLAGS_enable_multi_thread) {
@@ -242,6 +249,12 @@ void EvaluatorManager::Run(
                        obstacles_container, dynamic_env);
     }
   }
+
+  if (FLAGS_enable_batched_evaluation) {
+    for (auto& evaluator : evaluators_) {
+      evaluator.second->EndBatch();
+    }
+  }
 }
 
 void EvaluatorManager::EvaluateObstacle(
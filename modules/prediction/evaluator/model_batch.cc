@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/evaluator/model_batch.h"
+
+#include <utility>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace prediction {
+
+void ModelBatch::Add(std::vector<torch::Tensor> inputs,
+                     OutputHandler handler) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!inputs_.empty()) {
+    CHECK_EQ(inputs.size(), inputs_.front().size());
+  }
+  inputs_.push_back(std::move(inputs));
+  handlers_.push_back(std::move(handler));
+}
+
+void ModelBatch::Run(torch::jit::script::Module* model,
+                     const torch::Device& device) {
+  std::vector<std::vector<torch::Tensor>> inputs;
+  std::vector<OutputHandler> handlers;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    inputs.swap(inputs_);
+    handlers.swap(handlers_);
+  }
+  if (inputs.empty()) {
+    return;
+  }
+
+  // Stack each input of the samples along the batch dimension.
+  std::vector<torch::jit::IValue> torch_inputs;
+  std::vector<torch::Tensor> tensors(inputs.size());
+  for (size_t i = 0; i < inputs.front().size(); ++i) {
+    for (size_t j = 0; j < inputs.size(); ++j) {
+      tensors[j] = std::move(inputs[j][i]);
+    }
+    torch_inputs.push_back(torch::cat(tensors, 0).to(device));
+  }
+  if (tuple_input_) {
+    torch_inputs = {c10::ivalue::Tuple::create(std::move(torch_inputs))};
+  }
+
+  torch::jit::IValue output = model->forward(torch_inputs);
+  if (output.isTensor()) {
+    output = output.toTensor().to(torch::kCPU);
+  } else if (output.isTuple()) {
+    std::vector<torch::jit::IValue> elements;
+    for (const auto& element : output.toTuple()->elements()) {
+      elements.push_back(element.isTensor() ? element.toTensor().to(torch::kCPU)
+                                            : element);
+    }
+    output = c10::ivalue::Tuple::create(std::move(elements));
+  }
+  ADEBUG << "Ran a batch of " << handlers.size() << " samples.";
+  for (size_t i = 0; i < handlers.size(); ++i) {
+    handlers[i](output, static_cast<int64_t>(i));
+  }
+}
+
+size_t ModelBatch::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return handlers_.size();
+}
+
+}  // namespace prediction
+}  // namespace apollo
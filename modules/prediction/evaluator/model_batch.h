@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Batch of the inputs of a TorchScript model gathered from many
+ *        obstacles, run in a single forward.
+ */
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "torch/script.h"
+#include "torch/torch.h"
+
+namespace apollo {
+namespace prediction {
+
+class ModelBatch {
+ public:
+  /**
+   * @brief Handler of the output of one sample: the output of the model on
+   *        the whole batch, on CPU, and the index of the sample in it.
+   */
+  using OutputHandler =
+      std::function<void(const torch::jit::IValue& output, int64_t index)>;
+
+  /**
+   * @brief Constructor
+   * @param If the model takes its inputs as a single tuple
+   */
+  explicit ModelBatch(bool tuple_input = false) : tuple_input_(tuple_input) {}
+
+  /**
+   * @brief Queue a sample. Thread safe.
+   * @param The inputs of the model, each with a batch dimension of one
+   * @param The handler of the output of the sample
+   */
+  void Add(std::vector<torch::Tensor> inputs, OutputHandler handler);
+
+  /**
+   * @brief Run the model once on the samples queued, concatenated along the
+   *        batch dimension, and call their handlers in the order they were
+   *        queued. Empties the batch.
+   * @param The model
+   * @param The device to run the model on
+   */
+  void Run(torch::jit::script::Module* model, const torch::Device& device);
+
+  /**
+   * @brief Get the number of samples queued.
+   */
+  size_t size() const;
+
+ private:
+  const bool tuple_input_;
+  mutable std::mutex mutex_;
+  std::vector<std::vector<torch::Tensor>> inputs_;
+  std::vector<OutputHandler> handlers_;
+};
+
+}  // namespace prediction
+}  // namespace apollo
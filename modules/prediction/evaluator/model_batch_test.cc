@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/evaluator/model_batch.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace prediction {
+
+class ModelBatchTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    model_.define(R"JIT(
+def forward(self, x, y):
+    return (x.sum(1, keepdim=True) + y, x * 2.0)
+)JIT");
+    tuple_model_.define(R"JIT(
+def forward(self, inputs: Tuple[Tensor, Tensor]):
+    x, y = inputs
+    return x.sum(1, keepdim=True) + y
+)JIT");
+  }
+
+ protected:
+  torch::jit::script::Module model_{"model"};
+  torch::jit::script::Module tuple_model_{"tuple_model"};
+};
+
+TEST_F(ModelBatchTest, RunsSamplesInOneBatch) {
+  ModelBatch batch;
+  std::vector<float> sums(3, -1.0f);
+  std::vector<float> doubled(3, -1.0f);
+  for (int i = 0; i < 3; ++i) {
+    batch.Add({torch::full({1, 4}, static_cast<float>(i)),
+               torch::full({1, 1}, 10.0f)},
+              [&, i](const torch::jit::IValue& output, int64_t index) {
+                EXPECT_EQ(i, index);
+                auto elements = output.toTuple()->elements();
+                at::Tensor sum = elements[0].toTensor();
+                at::Tensor twice = elements[1].toTensor();
+                EXPECT_EQ(3, sum.size(0));
+                sums[i] = sum.accessor<float, 2>()[index][0];
+                doubled[i] = twice.accessor<float, 2>()[index][3];
+              });
+  }
+  EXPECT_EQ(3u, batch.size());
+  batch.Run(&model_, torch::kCPU);
+  EXPECT_EQ(0u, batch.size());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_FLOAT_EQ(4.0f * i + 10.0f, sums[i]);
+    EXPECT_FLOAT_EQ(2.0f * i, doubled[i]);
+  }
+}
+
+TEST_F(ModelBatchTest, TupleInput) {
+  ModelBatch batch(true);
+  std::vector<float> sums(2, -1.0f);
+  for (int i = 0; i < 2; ++i) {
+    batch.Add({torch::full({1, 2}, static_cast<float>(i + 1)),
+               torch::full({1, 1}, 1.0f)},
+              [&, i](const torch::jit::IValue& output, int64_t index) {
+                at::Tensor sum = output.toTensor();
+                sums[i] = sum.accessor<float, 2>()[index][0];
+              });
+  }
+  batch.Run(&tuple_model_, torch::kCPU);
+  EXPECT_FLOAT_EQ(3.0f, sums[0]);
+  EXPECT_FLOAT_EQ(5.0f, sums[1]);
+}
+
+TEST_F(ModelBatchTest, EmptyBatch) {
+  ModelBatch batch;
+  batch.Run(&model_, torch::kCPU);
+  EXPECT_EQ(0u, batch.size());
+}
+
+TEST_F(ModelBatchTest, AddFromThreads) {
+  ModelBatch batch;
+  const int kNumThreads = 4;
+  const int kNumSamples = 50;
+  std::vector<float> sums(kNumThreads * kNumSamples, -1.0f);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kNumSamples; ++i) {
+        const int sample = t * kNumSamples + i;
+        batch.Add({torch::full({1, 1}, static_cast<float>(sample)),
+                   torch::zeros({1, 1})},
+                  [&, sample](const torch::jit::IValue& output,
+                              int64_t index) {
+                    at::Tensor sum = output.toTuple()->elements()[0].toTensor();
+                    sums[sample] = sum.accessor<float, 2>()[index][0];
+                  });
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(static_cast<size_t>(kNumThreads * kNumSamples), batch.size());
+  batch.Run(&model_, torch::kCPU);
+  for (int i = 0; i < kNumThreads * kNumSamples; ++i) {
+    EXPECT_FLOAT_EQ(static_cast<float>(i), sums[i]);
+  }
+}
+
+}  // namespace prediction
+}  // namespace apollo
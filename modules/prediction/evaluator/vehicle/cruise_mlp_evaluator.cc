@@ -120,13 +120,24 @@ bool CruiseMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
       return true;  // Skip Compute probability for offline mode
     }
 
-    std::vector<torch::jit::IValue> torch_inputs;
     int input_dim = static_cast<int>(
         OBSTACLE_FEATURE_SIZE + SINGLE_LANE_FEATURE_SIZE * LANE_POINTS_SIZE);
-    torch::Tensor torch_input = torch::zeros({1, input_dim});
-    for (size_t i = 0; i < feature_values.size(); ++i) {
-      torch_input[0][i] = static_cast<float>(feature_values[i]);
+    std::vector<float> input_values(feature_values.begin(),
+                                    feature_values.end());
+    torch::Tensor torch_input =
+        torch::from_blob(input_values.data(), {1, input_dim}).clone();
+    if (batching_) {
+      ModelBatch* batch =
+          lane_sequence_ptr->vehicle_on_lane() ? &go_batch_ : &cutin_batch_;
+      batch->Add({std::move(torch_input)},
+                 [lane_sequence_ptr](const torch::jit::IValue& torch_output,
+                                     int64_t index) {
+                   SetLaneSequenceOutput(torch_output, index,
+                                         lane_sequence_ptr);
+                 });
+      continue;
     }
+    std::vector<torch::jit::IValue> torch_inputs;
     torch_inputs.push_back(std::move(torch_input.to(device_)));
     if (lane_sequence_ptr->vehicle_on_lane()) {
       ModelInference(torch_inputs, torch_go_model_, lane_sequence_ptr);
@@ -548,15 +559,30 @@ void CruiseMLPEvaluator::ModelInference(
     const std::vector<torch::jit::IValue>& torch_inputs,
     torch::jit::script::Module torch_model_ptr,
     LaneSequence* lane_sequence_ptr) {
-  auto torch_output_tuple = torch_model_ptr.forward(torch_inputs).toTuple();
+  SetLaneSequenceOutput(torch_model_ptr.forward(torch_inputs), 0,
+                        lane_sequence_ptr);
+}
+
+void CruiseMLPEvaluator::SetLaneSequenceOutput(
+    const torch::jit::IValue& torch_output, int64_t index,
+    LaneSequence* lane_sequence_ptr) {
+  auto torch_output_tuple = torch_output.toTuple();
   auto probability_tensor =
       torch_output_tuple->elements()[0].toTensor().to(torch::kCPU);
   auto finish_time_tensor =
       torch_output_tuple->elements()[1].toTensor().to(torch::kCPU);
   lane_sequence_ptr->set_probability(apollo::common::math::Sigmoid(
-      static_cast<double>(probability_tensor.accessor<float, 2>()[0][0])));
+      static_cast<double>(probability_tensor.accessor<float, 2>()[index][0])));
   lane_sequence_ptr->set_time_to_lane_center(
-      static_cast<double>(finish_time_tensor.accessor<float, 2>()[0][0]));
+      static_cast<double>(finish_time_tensor.accessor<float, 2>()[index][0]));
+}
+
+void CruiseMLPEvaluator::BeginBatch() { batching_ = true; }
+
+void CruiseMLPEvaluator::EndBatch() {
+  batching_ = false;
+  go_batch_.Run(&torch_go_model_, device_);
+  cutin_batch_.Run(&torch_cutin_model_, device_);
 }
 
 }  // namespace prediction
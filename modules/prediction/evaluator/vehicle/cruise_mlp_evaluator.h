@@ -23,6 +23,7 @@
 #include "torch/torch.h"
 
 #include "modules/prediction/evaluator/evaluator.h"
+#include "modules/prediction/evaluator/model_batch.h"
 
 #include "modules/prediction/container/obstacles/obstacles_container.h"
 
@@ -63,6 +64,16 @@ class CruiseMLPEvaluator : public Evaluator {
    */
   std::string GetName() override { return "CRUISE_MLP_EVALUATOR"; }
 
+  /**
+   * @brief Override BeginBatch
+   */
+  void BeginBatch() override;
+
+  /**
+   * @brief Override EndBatch
+   */
+  void EndBatch() override;
+
   void Clear();
 
  private:
@@ -105,6 +116,17 @@ class CruiseMLPEvaluator : public Evaluator {
                       torch::jit::script::Module torch_model_ptr,
                       LaneSequence* lane_sequence_ptr);
 
+  /**
+   * @brief Set the probability and the time to lane center of a lane
+   *        sequence from a row of the model output
+   * @param Model output
+   * @param Row of the lane sequence
+   * @param Lane sequence pointer
+   */
+  static void SetLaneSequenceOutput(const torch::jit::IValue& torch_output,
+                                    int64_t index,
+                                    LaneSequence* lane_sequence_ptr);
+
  private:
   static const size_t OBSTACLE_FEATURE_SIZE = 23 + 5 * 9;
   static const size_t INTERACTION_FEATURE_SIZE = 8;
@@ -114,6 +136,10 @@ class CruiseMLPEvaluator : public Evaluator {
   torch::jit::script::Module torch_go_model_;
   torch::jit::script::Module torch_cutin_model_;
   torch::Device device_;
+
+  bool batching_ = false;
+  ModelBatch go_batch_;
+  ModelBatch cutin_batch_;
 };
 
 }  // namespace prediction
@@ -56,5 +56,40 @@ TEST_F(CruiseMLPEvaluatorTest, OnLaneCase) {
   cruise_mlp_evaluator.Clear();
 }
 
+TEST_F(CruiseMLPEvaluatorTest, BatchedMatchesPerRow) {
+  CruiseMLPEvaluator cruise_mlp_evaluator;
+  ObstaclesContainer per_row_container;
+  per_row_container.Insert(perception_obstacles_);
+  per_row_container.BuildLaneGraph();
+  Obstacle* per_row_obstacle = per_row_container.GetObstacle(1);
+  ASSERT_NE(per_row_obstacle, nullptr);
+  cruise_mlp_evaluator.Evaluate(per_row_obstacle, &per_row_container);
+
+  ObstaclesContainer batched_container;
+  batched_container.Insert(perception_obstacles_);
+  batched_container.BuildLaneGraph();
+  Obstacle* batched_obstacle = batched_container.GetObstacle(1);
+  ASSERT_NE(batched_obstacle, nullptr);
+  cruise_mlp_evaluator.BeginBatch();
+  cruise_mlp_evaluator.Evaluate(batched_obstacle, &batched_container);
+  cruise_mlp_evaluator.EndBatch();
+
+  const LaneGraph& per_row_graph =
+      per_row_obstacle->latest_feature().lane().lane_graph();
+  const LaneGraph& batched_graph =
+      batched_obstacle->latest_feature().lane().lane_graph();
+  ASSERT_GT(per_row_graph.lane_sequence_size(), 0);
+  ASSERT_EQ(per_row_graph.lane_sequence_size(),
+            batched_graph.lane_sequence_size());
+  for (int i = 0; i < per_row_graph.lane_sequence_size(); ++i) {
+    const LaneSequence& per_row = per_row_graph.lane_sequence(i);
+    const LaneSequence& batched = batched_graph.lane_sequence(i);
+    EXPECT_NEAR(per_row.probability(), batched.probability(), 1e-5);
+    EXPECT_NEAR(per_row.time_to_lane_center(), batched.time_to_lane_center(),
+                1e-5);
+  }
+  cruise_mlp_evaluator.Clear();
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -96,16 +96,37 @@ bool JunctionMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
     ADEBUG << "Save extracted features for learning locally.";
     return true;  // Skip Compute probability for offline mode
   }
-  std::vector<torch::jit::IValue> torch_inputs;
   int input_dim = static_cast<int>(
       OBSTACLE_FEATURE_SIZE + EGO_VEHICLE_FEATURE_SIZE + JUNCTION_FEATURE_SIZE);
-  torch::Tensor torch_input = torch::zeros({1, input_dim});
-  for (size_t i = 0; i < feature_values.size(); ++i) {
-    torch_input[0][i] = static_cast<float>(feature_values[i]);
+  if (feature_values.size() != static_cast<size_t>(input_dim)) {
+    AERROR << "Obstacle [" << id << "] has " << feature_values.size()
+           << " feature values instead of " << input_dim << ".";
+    return false;
   }
-  torch_inputs.push_back(std::move(torch_input.to(device_)));
+  std::vector<float> input_values(feature_values.begin(),
+                                  feature_values.end());
+  torch::Tensor torch_input =
+      torch::from_blob(input_values.data(), {1, input_dim}).clone();
   std::vector<double> probability;
   if (latest_feature_ptr->junction_feature().junction_exit_size() > 1) {
+    if (batching_ &&
+        !latest_feature_ptr->lane().lane_graph().lane_sequence().empty()) {
+      batch_.Add({std::move(torch_input)},
+                 [this, latest_feature_ptr](
+                     const torch::jit::IValue& torch_output, int64_t index) {
+                   at::Tensor torch_output_tensor = torch_output.toTensor();
+                   auto output = torch_output_tensor.accessor<float, 2>();
+                   std::vector<double> batch_probability;
+                   for (int i = 0; i < output.size(1); ++i) {
+                     batch_probability.push_back(
+                         static_cast<double>(output[index][i]));
+                   }
+                   SetProbabilities(batch_probability, latest_feature_ptr);
+                 });
+      return true;
+    }
+    std::vector<torch::jit::IValue> torch_inputs;
+    torch_inputs.push_back(std::move(torch_input.to(device_)));
     at::Tensor torch_output_tensor =
         torch_model_.forward(torch_inputs).toTensor().to(torch::kCPU);
     auto torch_output = torch_output_tensor.accessor<float, 2>();
@@ -118,6 +139,11 @@ bool JunctionMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
                                            EGO_VEHICLE_FEATURE_SIZE + 8 * i]);
     }
   }
+  return SetProbabilities(probability, latest_feature_ptr);
+}
+
+bool JunctionMLPEvaluator::SetProbabilities(
+    const std::vector<double>& probability, Feature* latest_feature_ptr) {
   for (double prob : probability) {
     latest_feature_ptr->mutable_junction_feature()
         ->add_junction_mlp_probability(prob);
@@ -127,7 +153,8 @@ bool JunctionMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
       latest_feature_ptr->mutable_lane()->mutable_lane_graph();
   CHECK_NOTNULL(lane_graph_ptr);
   if (lane_graph_ptr->lane_sequence().empty()) {
-    AERROR << "Obstacle [" << id << "] has no lane sequences.";
+    AERROR << "Obstacle [" << latest_feature_ptr->id()
+           << "] has no lane sequences.";
     return false;
   }
 
@@ -160,6 +187,13 @@ bool JunctionMLPEvaluator::Evaluate(Obstacle* obstacle_ptr,
   return true;
 }
 
+void JunctionMLPEvaluator::BeginBatch() { batching_ = true; }
+
+void JunctionMLPEvaluator::EndBatch() {
+  batching_ = false;
+  batch_.Run(&torch_model_, device_);
+}
+
 void JunctionMLPEvaluator::ExtractFeatureValues(
     Obstacle* obstacle_ptr, ObstaclesContainer* obstacles_container,
     std::vector<double>* feature_values) {
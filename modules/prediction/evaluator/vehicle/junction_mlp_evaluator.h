@@ -24,6 +24,7 @@
 
 #include "modules/prediction/container/obstacles/obstacles_container.h"
 #include "modules/prediction/evaluator/evaluator.h"
+#include "modules/prediction/evaluator/model_batch.h"
 
 namespace apollo {
 namespace prediction {
@@ -68,6 +69,16 @@ class JunctionMLPEvaluator : public Evaluator {
    */
   std::string GetName() override { return "JUNCTION_MLP_EVALUATOR"; }
 
+  /**
+   * @brief Override BeginBatch
+   */
+  void BeginBatch() override;
+
+  /**
+   * @brief Override EndBatch
+   */
+  void EndBatch() override;
+
  private:
   /**
    * @brief Set obstacle feature vector
@@ -100,6 +111,14 @@ class JunctionMLPEvaluator : public Evaluator {
    */
   void LoadModel();
 
+  /**
+   * @brief Set the junction exit and lane sequence probabilities
+   * @param Probabilities of the 12 fan areas
+   * @param Latest feature pointer
+   */
+  bool SetProbabilities(const std::vector<double>& probability,
+                        Feature* latest_feature_ptr);
+
  private:
   // obstacle feature with 4 basic features and 5 frames of history position
   static const size_t OBSTACLE_FEATURE_SIZE = 4 + 2 * 5;
@@ -110,6 +129,9 @@ class JunctionMLPEvaluator : public Evaluator {
 
   torch::jit::script::Module torch_model_;
   torch::Device device_;
+
+  bool batching_ = false;
+  ModelBatch batch_;
 };
 
 }  // namespace prediction
@@ -64,5 +64,44 @@ TEST_F(JunctionMLPEvaluatorTest, InJunctionCase) {
   junction_mlp_evaluator.Clear();
 }
 
+TEST_F(JunctionMLPEvaluatorTest, BatchedMatchesPerRow) {
+  JunctionMLPEvaluator junction_mlp_evaluator;
+  ObstaclesContainer per_row_container;
+  per_row_container.GetJunctionAnalyzer()->Init("j2");
+  per_row_container.Insert(perception_obstacles_);
+  per_row_container.BuildJunctionFeature();
+  Obstacle* per_row_obstacle = per_row_container.GetObstacle(1);
+  ASSERT_NE(per_row_obstacle, nullptr);
+  junction_mlp_evaluator.Evaluate(per_row_obstacle, &per_row_container);
+
+  ObstaclesContainer batched_container;
+  batched_container.GetJunctionAnalyzer()->Init("j2");
+  batched_container.Insert(perception_obstacles_);
+  batched_container.BuildJunctionFeature();
+  Obstacle* batched_obstacle = batched_container.GetObstacle(1);
+  ASSERT_NE(batched_obstacle, nullptr);
+  junction_mlp_evaluator.BeginBatch();
+  junction_mlp_evaluator.Evaluate(batched_obstacle, &batched_container);
+  junction_mlp_evaluator.EndBatch();
+
+  const Feature& per_row = per_row_obstacle->latest_feature();
+  const Feature& batched = batched_obstacle->latest_feature();
+  ASSERT_EQ(per_row.junction_feature().junction_mlp_probability_size(), 12);
+  ASSERT_EQ(batched.junction_feature().junction_mlp_probability_size(), 12);
+  for (int i = 0; i < 12; ++i) {
+    EXPECT_NEAR(per_row.junction_feature().junction_mlp_probability(i),
+                batched.junction_feature().junction_mlp_probability(i), 1e-5);
+  }
+  const LaneGraph& per_row_graph = per_row.lane().lane_graph();
+  const LaneGraph& batched_graph = batched.lane().lane_graph();
+  ASSERT_EQ(per_row_graph.lane_sequence_size(),
+            batched_graph.lane_sequence_size());
+  for (int i = 0; i < per_row_graph.lane_sequence_size(); ++i) {
+    EXPECT_NEAR(per_row_graph.lane_sequence(i).probability(),
+                batched_graph.lane_sequence(i).probability(), 1e-5);
+  }
+  junction_mlp_evaluator.Clear();
+}
+
 }  // namespace prediction
 }  // namespace apollo
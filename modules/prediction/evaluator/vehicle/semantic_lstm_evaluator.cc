@@ -95,6 +95,20 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
         pos_history[i].second - pos_history[i + 1].second;
   }
 
+  if (batching_) {
+    // The image tensor is a view of img_float, copy it to outlive it.
+    ModelBatch* batch = obstacle_ptr->IsPedestrian() ? &pedestrian_batch_
+                                                     : &vehicle_batch_;
+    batch->Add({img_tensor.clone(), std::move(obstacle_pos),
+                std::move(obstacle_pos_step)},
+               [this, latest_feature_ptr](const torch::jit::IValue& output,
+                                          int64_t index) {
+                 SetPredictedTrajectory(output.toTensor(), index,
+                                        latest_feature_ptr);
+               });
+    return true;
+  }
+
   // Build input features for torch
   std::vector<torch::jit::IValue> torch_inputs;
 
@@ -120,6 +134,13 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
   std::chrono::duration<double> diff = end_time - start_time;
   ADEBUG << "Semantic_LSTM_evaluator used time: " << diff.count() * 1000
          << " ms.";
+  SetPredictedTrajectory(torch_output_tensor, 0, latest_feature_ptr);
+  return true;
+}
+
+void SemanticLSTMEvaluator::SetPredictedTrajectory(
+    const at::Tensor& torch_output_tensor, int64_t index,
+    Feature* latest_feature_ptr) {
   auto torch_output = torch_output_tensor.accessor<float, 3>();
 
   // Get the trajectory
@@ -137,8 +158,8 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
       prev_y = last_point.y();
     }
     TrajectoryPoint* point = trajectory->add_trajectory_point();
-    double dx = static_cast<double>(torch_output[0][i][0]);
-    double dy = static_cast<double>(torch_output[0][i][1]);
+    double dx = static_cast<double>(torch_output[index][i][0]);
+    double dy = static_cast<double>(torch_output[index][i][1]);
 
     double heading = latest_feature_ptr->velocity_heading();
     Vec2d offset(dx, dy);
@@ -149,9 +170,11 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
     point->mutable_path_point()->set_y(point_y);
 
     if (torch_output_tensor.sizes()[2] == 5) {
-      double sigma_xr = std::abs(static_cast<double>(torch_output[0][i][2]));
-      double sigma_yr = std::abs(static_cast<double>(torch_output[0][i][3]));
-      double corr_r = static_cast<double>(torch_output[0][i][4]);
+      double sigma_xr =
+          std::abs(static_cast<double>(torch_output[index][i][2]));
+      double sigma_yr =
+          std::abs(static_cast<double>(torch_output[index][i][3]));
+      double corr_r = static_cast<double>(torch_output[index][i][4]);
       Eigen::Matrix2d cov_matrix_r;
       cov_matrix_r(0, 0) = sigma_xr * sigma_xr;
       cov_matrix_r(0, 1) = corr_r * sigma_xr * sigma_yr;
@@ -212,8 +235,14 @@ bool SemanticLSTMEvaluator::Evaluate(Obstacle* obstacle_ptr,
                    FLAGS_prediction_trajectory_time_resolution);
     }
   }
+}
 
-  return true;
+void SemanticLSTMEvaluator::BeginBatch() { batching_ = true; }
+
+void SemanticLSTMEvaluator::EndBatch() {
+  batching_ = false;
+  vehicle_batch_.Run(&torch_vehicle_model_, device_);
+  pedestrian_batch_.Run(&torch_pedestrian_model_, device_);
 }
 
 bool SemanticLSTMEvaluator::ExtractObstacleHistory(
@@ -22,6 +22,7 @@
 
 #include "modules/prediction/common/semantic_map.h"
 #include "modules/prediction/evaluator/evaluator.h"
+#include "modules/prediction/evaluator/model_batch.h"
 #include "torch/extension.h"
 #include "torch/script.h"
 
@@ -68,18 +69,41 @@ class SemanticLSTMEvaluator : public Evaluator {
    */
   std::string GetName() override { return "SEMANTIC_LSTM_EVALUATOR"; }
 
+  /**
+   * @brief Override BeginBatch
+   */
+  void BeginBatch() override;
+
+  /**
+   * @brief Override EndBatch
+   */
+  void EndBatch() override;
+
  private:
   /**
    * @brief Load model file
    */
   void LoadModel();
 
+  /**
+   * @brief Add the predicted trajectory from a row of the model output
+   * @param Model output on CPU
+   * @param Row of the obstacle
+   * @param Latest feature pointer
+   */
+  void SetPredictedTrajectory(const at::Tensor& torch_output_tensor,
+                              int64_t index, Feature* latest_feature_ptr);
+
  private:
   torch::jit::script::Module torch_vehicle_model_;
   torch::jit::script::Module torch_pedestrian_model_;
   at::Tensor torch_default_output_tensor_;
   torch::Device device_;
   SemanticMap* semantic_map_;
+
+  bool batching_ = false;
+  ModelBatch vehicle_batch_{true};
+  ModelBatch pedestrian_batch_{true};
 };
 
 }  // namespace prediction
@@ -20,6 +20,7 @@
 #include "cyber/record/record_reader.h"
 #include "cyber/time/clock.h"
 #include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/latency_recorder/latency_tracer.h"
 #include "modules/common/util/message_util.h"
 
 #include "modules/prediction/common/feature_output.h"
@@ -274,6 +275,9 @@ bool PredictionComponent::PredictionEndToEndProc(
   ADEBUG << "End to end time elapsed: " << diff.count() * 1000 << " msec.";
 
   // Publish output
+  common::LatencyTracer::ContinueTrace(
+      perception_msg.header(), "prediction", cyber::Time(frame_start_time_),
+      prediction_obstacles.mutable_header());
   common::util::FillHeader(node_->Name(), &prediction_obstacles);
   prediction_writer_->Write(prediction_obstacles);
   return true;
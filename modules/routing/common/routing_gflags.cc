@@ -32,3 +32,14 @@ DEFINE_bool(enable_change_lane_in_result, true,
 
 DEFINE_uint32(routing_response_history_interval_ms, 1000,
               "ms, emit routing resposne for this time interval");
+
+DEFINE_bool(enable_routing_contraction_hierarchy, false,
+            "guide the search with the contraction hierarchy generated by "
+            "topo_creator when the request has no black list");
+
+DEFINE_string(routing_contraction_hierarchy_filename, "routing_map_ch.bin",
+              "contraction hierarchy file, next to the routing map");
+
+DEFINE_int32(routing_cache_size, 0,
+             "number of recent routes kept for identical requests, 0 to "
+             "disable the cache");
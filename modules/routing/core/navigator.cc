@@ -16,10 +16,14 @@
 
 #include "modules/routing/core/navigator.h"
 
+#include <cmath>
+
+#include "absl/strings/str_cat.h"
 #include "cyber/common/file.h"
 #include "modules/routing/common/routing_gflags.h"
 #include "modules/routing/graph/sub_topo_graph.h"
 #include "modules/routing/strategy/a_star_strategy.h"
+#include "modules/routing/strategy/contraction_hierarchy_strategy.h"
 
 namespace apollo {
 namespace routing {
@@ -81,6 +85,26 @@ void SetErrorCode(const common::ErrorCode& error_code_id,
   }
 }
 
+// Way points are keyed at millimeter resolution.
+std::string GetRouteCacheKey(const RoutingRequest& request) {
+  std::string key;
+  for (const auto& wp : request.waypoint()) {
+    absl::StrAppend(&key, "w:", wp.id(), ":",
+                    static_cast<int64_t>(std::llround(wp.s() * 1000.0)), ";");
+  }
+  for (const auto& bl : request.blacklisted_lane()) {
+    absl::StrAppend(&key, "l:", bl.id(), ":",
+                    static_cast<int64_t>(std::llround(bl.start_s() * 1000.0)),
+                    ":",
+                    static_cast<int64_t>(std::llround(bl.end_s() * 1000.0)),
+                    ";");
+  }
+  for (const auto& road : request.blacklisted_road()) {
+    absl::StrAppend(&key, "r:", road, ";");
+  }
+  return key;
+}
+
 void PrintDebugData(const std::vector<NodeWithRange>& nodes) {
   AINFO << "Route lane id\tis virtual\tstart s\tend s";
   for (const auto& node : nodes) {
@@ -107,12 +131,42 @@ Navigator::Navigator(const std::string& topo_file_path) {
   }
   black_list_generator_.reset(new BlackListRangeGenerator);
   result_generator_.reset(new ResultGenerator);
+  if (FLAGS_enable_routing_contraction_hierarchy) {
+    InitContractionHierarchy(topo_file_path, graph);
+  }
+  if (FLAGS_routing_cache_size > 0) {
+    route_cache_.reset(
+        new common::util::LRUCache<std::string, std::vector<NodeWithRange>>(
+            FLAGS_routing_cache_size));
+  }
   is_ready_ = true;
   AINFO << "The navigator is ready.";
 }
 
 Navigator::~Navigator() {}
 
+void Navigator::InitContractionHierarchy(const std::string& topo_file_path,
+                                         const Graph& graph) {
+  const auto pos = topo_file_path.find_last_of('/');
+  const std::string hierarchy_file_path =
+      pos == std::string::npos
+          ? FLAGS_routing_contraction_hierarchy_filename
+          : absl::StrCat(topo_file_path.substr(0, pos), "/",
+                         FLAGS_routing_contraction_hierarchy_filename);
+  ContractionHierarchy hierarchy;
+  if (!cyber::common::GetProtoFromFile(hierarchy_file_path, &hierarchy)) {
+    AWARN << "Failed to read contraction hierarchy from "
+          << hierarchy_file_path << ", use A* search only.";
+    return;
+  }
+  contraction_hierarchy_.reset(new ContractionHierarchyGraph());
+  if (!contraction_hierarchy_->Init(graph, hierarchy, graph_.get())) {
+    AWARN << "Contraction hierarchy " << hierarchy_file_path
+          << " does not match the topo graph, use A* search only.";
+    contraction_hierarchy_.reset();
+  }
+}
+
 bool Navigator::IsReady() const { return is_ready_; }
 
 void Navigator::Clear() { topo_range_manager_.Clear(); }
@@ -150,10 +204,15 @@ bool Navigator::MergeRoute(
 
 bool Navigator::SearchRouteByStrategy(
     const TopoGraph* graph, const std::vector<const TopoNode*>& way_nodes,
-    const std::vector<double>& way_s,
+    const std::vector<double>& way_s, bool use_contraction_hierarchy,
     std::vector<NodeWithRange>* const result_nodes) const {
   std::unique_ptr<Strategy> strategy_ptr;
-  strategy_ptr.reset(new AStarStrategy(FLAGS_enable_change_lane_in_result));
+  if (use_contraction_hierarchy) {
+    strategy_ptr.reset(new ContractionHierarchyStrategy(
+        FLAGS_enable_change_lane_in_result, contraction_hierarchy_.get()));
+  } else {
+    strategy_ptr.reset(new AStarStrategy(FLAGS_enable_change_lane_in_result));
+  }
 
   result_nodes->clear();
   std::vector<NodeWithRange> node_vec;
@@ -223,16 +282,32 @@ bool Navigator::SearchRoute(const RoutingRequest& request,
   }
 
   std::vector<NodeWithRange> result_nodes;
-  if (!SearchRouteByStrategy(graph_.get(), way_nodes, way_s, &result_nodes)) {
-    SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE,
-                 "Failed to find route with request!",
-                 response->mutable_status());
-    return false;
-  }
-  if (result_nodes.empty()) {
-    SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE, "Failed to result nodes!",
-                 response->mutable_status());
-    return false;
+  const std::string cache_key =
+      route_cache_ == nullptr ? std::string() : GetRouteCacheKey(request);
+  if (route_cache_ != nullptr &&
+      route_cache_->GetCopy(cache_key, &result_nodes)) {
+    ADEBUG << "Route found in cache.";
+  } else {
+    // The hierarchy knows nothing about black lists.
+    const bool use_contraction_hierarchy =
+        contraction_hierarchy_ != nullptr &&
+        request.blacklisted_lane().empty() &&
+        request.blacklisted_road().empty();
+    if (!SearchRouteByStrategy(graph_.get(), way_nodes, way_s,
+                               use_contraction_hierarchy, &result_nodes)) {
+      SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE,
+                   "Failed to find route with request!",
+                   response->mutable_status());
+      return false;
+    }
+    if (result_nodes.empty()) {
+      SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE,
+                   "Failed to result nodes!", response->mutable_status());
+      return false;
+    }
+    if (route_cache_ != nullptr) {
+      route_cache_->Put(cache_key, result_nodes);
+    }
   }
   result_nodes.front().SetStartS(request.waypoint().begin()->s());
   result_nodes.back().SetEndS(request.waypoint().rbegin()->s());
@@ -20,8 +20,10 @@
 #include <string>
 #include <vector>
 
+#include "modules/common/util/lru_cache.h"
 #include "modules/routing/core/black_list_range_generator.h"
 #include "modules/routing/core/result_generator.h"
+#include "modules/routing/graph/contraction_hierarchy_graph.h"
 
 namespace apollo {
 namespace routing {
@@ -43,9 +45,12 @@ class Navigator {
 
   void Clear();
 
+  void InitContractionHierarchy(const std::string& topo_file_path,
+                                const Graph& graph);
+
   bool SearchRouteByStrategy(
       const TopoGraph* graph, const std::vector<const TopoNode*>& way_nodes,
-      const std::vector<double>& way_s,
+      const std::vector<double>& way_s, bool use_contraction_hierarchy,
       std::vector<NodeWithRange>* const result_nodes) const;
 
   bool MergeRoute(const std::vector<NodeWithRange>& node_vec,
@@ -59,6 +64,13 @@ class Navigator {
 
   std::unique_ptr<BlackListRangeGenerator> black_list_generator_;
   std::unique_ptr<ResultGenerator> result_generator_;
+
+  std::unique_ptr<ContractionHierarchyGraph> contraction_hierarchy_;
+  // Result lanes of recent requests, keyed by their way points and black
+  // lists. Only valid for graph_, a reloaded graph needs a new Navigator.
+  std::unique_ptr<
+      common::util::LRUCache<std::string, std::vector<NodeWithRange>>>
+      route_cache_;
 };
 
 }  // namespace routing
@@ -0,0 +1,266 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/graph/contraction_hierarchy_graph.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <string>
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+using QueueEntry = std::pair<double, int>;
+using MinQueue = std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+                                     std::greater<QueueEntry>>;
+
+// Distance and the previous node on the shortest path of one search side.
+struct Label {
+  double dist = std::numeric_limits<double>::max();
+  int parent = -1;
+};
+
+double GetDist(const std::unordered_map<int, Label>& labels, int node) {
+  const auto iter = labels.find(node);
+  return iter == labels.end() ? std::numeric_limits<double>::max()
+                              : iter->second.dist;
+}
+
+}  // namespace
+
+double ContractionHierarchyGraph::ArcCost(const Node& from_node,
+                                          const Node& to_node,
+                                          const Edge& edge) {
+  double cost = edge.cost() + to_node.cost();
+  if (edge.direction_type() != Edge::FORWARD) {
+    cost -= (from_node.cost() + to_node.cost()) / 2.0;
+  }
+  return std::max(cost, 0.0);
+}
+
+bool ContractionHierarchyGraph::GetGraphArcs(const Graph& graph,
+                                             std::vector<Arc>* const arcs) {
+  std::unordered_map<std::string, int> node_index_map;
+  for (int i = 0; i < graph.node_size(); ++i) {
+    node_index_map[graph.node(i).lane_id()] = i;
+  }
+  arcs->clear();
+  arcs->reserve(graph.edge_size());
+  for (const auto& edge : graph.edge()) {
+    const auto from_iter = node_index_map.find(edge.from_lane_id());
+    const auto to_iter = node_index_map.find(edge.to_lane_id());
+    if (from_iter == node_index_map.end() || to_iter == node_index_map.end()) {
+      AERROR << "Edge " << edge.from_lane_id() << " -> " << edge.to_lane_id()
+             << " refers to unknown lane.";
+      return false;
+    }
+    if (from_iter->second == to_iter->second) {
+      continue;
+    }
+    Arc arc;
+    arc.from = from_iter->second;
+    arc.to = to_iter->second;
+    arc.cost = ArcCost(graph.node(arc.from), graph.node(arc.to), edge);
+    arcs->push_back(arc);
+  }
+  return true;
+}
+
+bool ContractionHierarchyGraph::Init(const Graph& graph,
+                                     const ContractionHierarchy& hierarchy,
+                                     const TopoGraph* topo_graph) {
+  const int num_nodes = graph.node_size();
+  if (hierarchy.rank_size() != num_nodes) {
+    AERROR << "Contraction hierarchy has " << hierarchy.rank_size()
+           << " nodes, topo graph has " << num_nodes;
+    return false;
+  }
+  if (hierarchy.hdmap_version() != graph.hdmap_version() ||
+      hierarchy.hdmap_district() != graph.hdmap_district()) {
+    AERROR << "Contraction hierarchy was built for map "
+           << hierarchy.hdmap_district() << " " << hierarchy.hdmap_version()
+           << ", topo graph is " << graph.hdmap_district() << " "
+           << graph.hdmap_version();
+    return false;
+  }
+
+  topo_nodes_.assign(num_nodes, nullptr);
+  node_index_map_.clear();
+  for (int i = 0; i < num_nodes; ++i) {
+    topo_nodes_[i] = topo_graph->GetNode(graph.node(i).lane_id());
+    if (topo_nodes_[i] == nullptr) {
+      AERROR << "Lane " << graph.node(i).lane_id() << " is not in topo graph.";
+      return false;
+    }
+    node_index_map_[topo_nodes_[i]] = i;
+  }
+  rank_.assign(hierarchy.rank().begin(), hierarchy.rank().end());
+
+  std::vector<Arc> arcs;
+  if (!GetGraphArcs(graph, &arcs)) {
+    return false;
+  }
+  for (const auto& shortcut : hierarchy.shortcut()) {
+    if (shortcut.from_node() < 0 || shortcut.from_node() >= num_nodes ||
+        shortcut.to_node() < 0 || shortcut.to_node() >= num_nodes ||
+        shortcut.via_node() < 0 || shortcut.via_node() >= num_nodes) {
+      AERROR << "Shortcut refers to unknown node.";
+      return false;
+    }
+    Arc arc;
+    arc.from = shortcut.from_node();
+    arc.to = shortcut.to_node();
+    arc.via = shortcut.via_node();
+    arc.cost = shortcut.cost();
+    arcs.push_back(arc);
+  }
+
+  arc_map_.clear();
+  for (const auto& arc : arcs) {
+    AddArc(arc);
+  }
+  upward_arcs_.assign(num_nodes, {});
+  downward_arcs_.assign(num_nodes, {});
+  for (const auto& key_arc : arc_map_) {
+    const Arc& arc = key_arc.second;
+    if (rank_[arc.to] > rank_[arc.from]) {
+      upward_arcs_[arc.from].push_back({arc.to, arc.cost});
+    } else {
+      downward_arcs_[arc.to].push_back({arc.from, arc.cost});
+    }
+  }
+  AINFO << "Contraction hierarchy loaded with " << hierarchy.shortcut_size()
+        << " shortcuts.";
+  return true;
+}
+
+void ContractionHierarchyGraph::AddArc(const Arc& arc) {
+  auto result = arc_map_.emplace(ArcKey(arc.from, arc.to), arc);
+  if (!result.second && arc.cost < result.first->second.cost) {
+    result.first->second = arc;
+  }
+}
+
+bool ContractionHierarchyGraph::Search(
+    const TopoNode* src_node, const TopoNode* dest_node,
+    std::vector<const TopoNode*>* const result_nodes) const {
+  const auto src_iter = node_index_map_.find(src_node->OriginNode());
+  const auto dest_iter = node_index_map_.find(dest_node->OriginNode());
+  if (src_iter == node_index_map_.end() ||
+      dest_iter == node_index_map_.end()) {
+    AERROR << "Search node is not in contraction hierarchy.";
+    return false;
+  }
+  const int src = src_iter->second;
+  const int dest = dest_iter->second;
+
+  // The search spaces of both sides stay small, so labels live in hash maps
+  // rather than in arrays sized by the whole graph.
+  std::unordered_map<int, Label> labels[2];
+  MinQueue queues[2];
+  labels[0][src].dist = 0.0;
+  labels[1][dest].dist = 0.0;
+  queues[0].emplace(0.0, src);
+  queues[1].emplace(0.0, dest);
+  const std::vector<std::vector<HalfArc>>* arcs[2] = {&upward_arcs_,
+                                                      &downward_arcs_};
+
+  double best = std::numeric_limits<double>::max();
+  int meeting_node = -1;
+  while (!queues[0].empty() || !queues[1].empty()) {
+    for (int side = 0; side < 2; ++side) {
+      auto& queue = queues[side];
+      if (queue.empty()) {
+        continue;
+      }
+      if (queue.top().first >= best) {
+        // Nothing left on this side can improve the best path.
+        queue = MinQueue();
+        continue;
+      }
+      const auto [dist, node] = queue.top();
+      queue.pop();
+      if (dist > GetDist(labels[side], node)) {
+        continue;
+      }
+      const double other_dist = GetDist(labels[1 - side], node);
+      if (other_dist != std::numeric_limits<double>::max() &&
+          dist + other_dist < best) {
+        best = dist + other_dist;
+        meeting_node = node;
+      }
+      for (const auto& arc : (*arcs[side])[node]) {
+        const double next_dist = dist + arc.cost;
+        auto& label = labels[side][arc.node];
+        if (next_dist < label.dist) {
+          label.dist = next_dist;
+          label.parent = node;
+          queue.emplace(next_dist, arc.node);
+        }
+      }
+    }
+  }
+  if (meeting_node < 0) {
+    AINFO << "Contraction hierarchy found no route from "
+           << src_node->LaneId() << " to " << dest_node->LaneId();
+    return false;
+  }
+
+  // Up-down path in the hierarchy: src ... meeting_node ... dest.
+  std::vector<int> hierarchy_path;
+  for (int node = meeting_node; node >= 0;
+       node = labels[0].at(node).parent) {
+    hierarchy_path.push_back(node);
+  }
+  std::reverse(hierarchy_path.begin(), hierarchy_path.end());
+  for (int node = labels[1].at(meeting_node).parent; node >= 0;
+       node = labels[1].at(node).parent) {
+    hierarchy_path.push_back(node);
+  }
+
+  std::vector<int> path = {hierarchy_path.front()};
+  for (size_t i = 1; i < hierarchy_path.size(); ++i) {
+    Unpack(hierarchy_path[i - 1], hierarchy_path[i], &path);
+  }
+  result_nodes->clear();
+  for (const int node : path) {
+    result_nodes->push_back(topo_nodes_[node]);
+  }
+  return true;
+}
+
+void ContractionHierarchyGraph::Unpack(int from, int to,
+                                       std::vector<int>* const path) const {
+  std::vector<std::pair<int, int>> stack = {{from, to}};
+  while (!stack.empty()) {
+    const auto [arc_from, arc_to] = stack.back();
+    stack.pop_back();
+    const Arc& arc = arc_map_.at(ArcKey(arc_from, arc_to));
+    if (arc.via < 0) {
+      path->push_back(arc_to);
+      continue;
+    }
+    stack.emplace_back(arc.via, arc_to);
+    stack.emplace_back(arc_from, arc.via);
+  }
+}
+
+}  // namespace routing
+}  // namespace apollo
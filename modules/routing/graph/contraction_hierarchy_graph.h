@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "modules/routing/graph/topo_graph.h"
+
+namespace apollo {
+namespace routing {
+
+/**
+ * @class ContractionHierarchyGraph
+ * @brief Answers lane level shortest path queries on a TopoGraph with the
+ * shortcuts of a ContractionHierarchy, using a bidirectional search that only
+ * climbs the hierarchy. The hierarchy ignores black lists and s ranges, so the
+ * result is meant to guide a search on the SubTopoGraph, not to replace it.
+ */
+class ContractionHierarchyGraph {
+ public:
+  struct Arc {
+    int from = -1;
+    int to = -1;
+    // Contracted node the arc stands for, or -1 for an edge of the Graph.
+    int via = -1;
+    double cost = 0.0;
+  };
+
+  /**
+   * @brief Cost of moving along edge onto its to node, as AStarStrategy sees
+   * it, clamped to be non-negative.
+   */
+  static double ArcCost(const Node& from_node, const Node& to_node,
+                        const Edge& edge);
+
+  /**
+   * @brief The edges of graph as arcs between node indices.
+   */
+  static bool GetGraphArcs(const Graph& graph, std::vector<Arc>* const arcs);
+
+  ContractionHierarchyGraph() = default;
+  ~ContractionHierarchyGraph() = default;
+
+  bool Init(const Graph& graph, const ContractionHierarchy& hierarchy,
+            const TopoGraph* topo_graph);
+
+  /**
+   * @brief Find the cheapest sequence of lanes from src_node to dest_node,
+   * both inclusive. Sub nodes are mapped to their origin nodes.
+   */
+  bool Search(const TopoNode* src_node, const TopoNode* dest_node,
+              std::vector<const TopoNode*>* const result_nodes) const;
+
+ private:
+  struct HalfArc {
+    int node = -1;
+    double cost = 0.0;
+  };
+
+  static uint64_t ArcKey(int from, int to) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(from)) << 32) |
+           static_cast<uint32_t>(to);
+  }
+
+  void AddArc(const Arc& arc);
+  void Unpack(int from, int to, std::vector<int>* const path) const;
+
+  std::vector<const TopoNode*> topo_nodes_;
+  std::unordered_map<const TopoNode*, int> node_index_map_;
+  std::vector<int> rank_;
+  // upward_arcs_[u]: arcs u -> v with rank(v) > rank(u), for the forward
+  // search. downward_arcs_[v]: arcs u -> v with rank(u) > rank(v), walked
+  // backward from v by the backward search.
+  std::vector<std::vector<HalfArc>> upward_arcs_;
+  std::vector<std::vector<HalfArc>> downward_arcs_;
+  // The cheapest arc between two nodes, to unpack shortcuts.
+  std::unordered_map<uint64_t, Arc> arc_map_;
+};
+
+}  // namespace routing
+}  // namespace apollo
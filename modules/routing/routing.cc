@@ -16,8 +16,11 @@
 
 #include "modules/routing/routing.h"
 
+#include <sys/stat.h>
+
 #include <limits>
 #include <unordered_map>
+#include <utility>
 
 #include "modules/common/util/point_factory.h"
 #include "modules/map/hdmap/hdmap_common.h"
@@ -30,15 +33,30 @@ using apollo::common::ErrorCode;
 using apollo::common::PointENU;
 using apollo::hdmap::ParkingSpaceInfoConstPtr;
 
+namespace {
+
+// The modification time of the file in ns, 0 if it can not be stat'ed.
+int64_t GetModifiedTimeNs(const std::string& file) {
+  struct stat file_stat;
+  if (stat(file.c_str(), &file_stat) != 0) {
+    return 0;
+  }
+  return static_cast<int64_t>(file_stat.st_mtim.tv_sec) * 1000000000 +
+         file_stat.st_mtim.tv_nsec;
+}
+
+}  // namespace
+
 std::string Routing::Name() const { return FLAGS_routing_node_name; }
 
 Routing::Routing()
     : monitor_logger_buffer_(common::monitor::MonitorMessageItem::ROUTING) {}
 
 apollo::common::Status Routing::Init() {
-  const auto routing_map_file = apollo::hdmap::RoutingMapFile();
-  AINFO << "Use routing topology graph path: " << routing_map_file;
-  navigator_ptr_.reset(new Navigator(routing_map_file));
+  routing_map_file_ = apollo::hdmap::RoutingMapFile();
+  AINFO << "Use routing topology graph path: " << routing_map_file_;
+  routing_map_mtime_ns_ = GetModifiedTimeNs(routing_map_file_);
+  navigator_ptr_.reset(new Navigator(routing_map_file_));
 
   hdmap_ = apollo::hdmap::HDMapUtil::BaseMapPtr();
   ACHECK(hdmap_) << "Failed to load map file:" << apollo::hdmap::BaseMapFile();
@@ -57,6 +75,23 @@ apollo::common::Status Routing::Start() {
   return apollo::common::Status::OK();
 }
 
+void Routing::ReloadNavigatorIfChanged() {
+  const int64_t mtime_ns = GetModifiedTimeNs(routing_map_file_);
+  if (mtime_ns == 0 || mtime_ns == routing_map_mtime_ns_) {
+    return;
+  }
+  // Recorded first, so that a broken map is not loaded again every request.
+  routing_map_mtime_ns_ = mtime_ns;
+  AINFO << "Routing topology graph changed, reload " << routing_map_file_;
+  std::unique_ptr<Navigator> navigator(new Navigator(routing_map_file_));
+  if (!navigator->IsReady()) {
+    AWARN << "Failed to reload routing topology graph, keep the loaded one.";
+    return;
+  }
+  // The routes cached by the old navigator go with its graph.
+  navigator_ptr_ = std::move(navigator);
+}
+
 std::vector<RoutingRequest> Routing::FillLaneInfoIfMissing(
     const RoutingRequest& routing_request) {
   std::vector<RoutingRequest> fixed_requests;
@@ -316,6 +351,7 @@ bool Routing::Process(const std::shared_ptr<RoutingRequest>& routing_request,
                       RoutingResponse* const routing_response) {
   CHECK_NOTNULL(routing_response);
   AINFO << "Get new routing request:" << routing_request->DebugString();
+  ReloadNavigatorIfChanged();
 
   const auto& fixed_requests = FillLaneInfoIfMissing(*routing_request);
   double min_routing_length = std::numeric_limits<double>::max();
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -61,6 +62,13 @@ class Routing {
                RoutingResponse *const routing_response);
 
  private:
+  /**
+   * @brief Load the routing topology graph again if the file changed since it
+   *  was loaded, e.g. rewritten by topo_creator. The new graph comes with an
+   *  empty route cache. The old one is kept if the new one fails to load.
+   */
+  void ReloadNavigatorIfChanged();
+
   std::vector<RoutingRequest> FillLaneInfoIfMissing(
       const RoutingRequest &routing_request);
 
@@ -88,6 +96,9 @@ class Routing {
 
  private:
   std::unique_ptr<Navigator> navigator_ptr_;
+  std::string routing_map_file_;
+  // modification time of routing_map_file_ when navigator_ptr_ loaded it
+  int64_t routing_map_mtime_ns_ = 0;
   common::monitor::MonitorLogBuffer monitor_logger_buffer_;
 
   const hdmap::HDMap *hdmap_ = nullptr;
@@ -18,6 +18,7 @@
 #include <cmath>
 #include <limits>
 #include <queue>
+#include <utility>
 
 #include "modules/routing/common/routing_gflags.h"
 #include "modules/routing/graph/sub_topo_graph.h"
@@ -204,6 +205,11 @@ bool Reconstruct(
 AStarStrategy::AStarStrategy(bool enable_change)
     : change_lane_enabled_(enable_change) {}
 
+void AStarStrategy::SetCorridor(
+    std::unordered_set<const TopoNode*> corridor) {
+  corridor_ = std::move(corridor);
+}
+
 void AStarStrategy::Clear() {
   closed_set_.clear();
   open_set_.clear();
@@ -280,6 +286,9 @@ bool AStarStrategy::Search(const TopoGraph* graph,
       if (closed_set_.count(to_node) == 1) {
         continue;
       }
+      if (!corridor_.empty() && corridor_.count(to_node->OriginNode()) == 0) {
+        continue;
+      }
       if (GetResidualS(edge, to_node) < FLAGS_min_length_for_lane_change) {
         continue;
       }
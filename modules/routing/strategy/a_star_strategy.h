@@ -34,6 +34,12 @@ class AStarStrategy : public Strategy {
                       const TopoNode* src_node, const TopoNode* dest_node,
                       std::vector<NodeWithRange>* const result_nodes);
 
+  /**
+   * @brief Only expand nodes whose origin node is in corridor. An empty
+   * corridor searches the whole graph.
+   */
+  void SetCorridor(std::unordered_set<const TopoNode*> corridor);
+
  private:
   void Clear();
   double HeuristicCost(const TopoNode* src_node, const TopoNode* dest_node);
@@ -42,6 +48,7 @@ class AStarStrategy : public Strategy {
 
  private:
   bool change_lane_enabled_;
+  std::unordered_set<const TopoNode*> corridor_;
   std::unordered_set<const TopoNode*> open_set_;
   std::unordered_set<const TopoNode*> closed_set_;
   std::unordered_map<const TopoNode*, const TopoNode*> came_from_;
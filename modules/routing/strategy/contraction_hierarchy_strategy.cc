@@ -0,0 +1,59 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/strategy/contraction_hierarchy_strategy.h"
+
+#include <unordered_set>
+#include <utility>
+
+#include "modules/routing/strategy/a_star_strategy.h"
+
+namespace apollo {
+namespace routing {
+
+ContractionHierarchyStrategy::ContractionHierarchyStrategy(
+    bool enable_change, const ContractionHierarchyGraph* hierarchy)
+    : change_lane_enabled_(enable_change), hierarchy_(hierarchy) {}
+
+bool ContractionHierarchyStrategy::Search(
+    const TopoGraph* graph, const SubTopoGraph* sub_graph,
+    const TopoNode* src_node, const TopoNode* dest_node,
+    std::vector<NodeWithRange>* const result_nodes) {
+  std::vector<const TopoNode*> lanes;
+  if (hierarchy_->Search(src_node, dest_node, &lanes)) {
+    // Lateral neighbors leave A* room to move a lane change to where the
+    // residual length allows it.
+    std::unordered_set<const TopoNode*> corridor(lanes.begin(), lanes.end());
+    for (const auto* lane : lanes) {
+      for (const auto* edge : lane->OutToLeftOrRightEdge()) {
+        corridor.insert(edge->ToNode());
+      }
+    }
+    AStarStrategy corridor_strategy(change_lane_enabled_);
+    corridor_strategy.SetCorridor(std::move(corridor));
+    if (corridor_strategy.Search(graph, sub_graph, src_node, dest_node,
+                                 result_nodes)) {
+      return true;
+    }
+    AINFO << "No route in contraction hierarchy corridor of " << lanes.size()
+          << " lanes, fall back to full search.";
+  }
+  AStarStrategy strategy(change_lane_enabled_);
+  return strategy.Search(graph, sub_graph, src_node, dest_node, result_nodes);
+}
+
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,51 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "modules/routing/graph/contraction_hierarchy_graph.h"
+#include "modules/routing/graph/sub_topo_graph.h"
+#include "modules/routing/strategy/strategy.h"
+
+namespace apollo {
+namespace routing {
+
+/**
+ * @class ContractionHierarchyStrategy
+ * @brief Finds the lane sequence with the contraction hierarchy first, then
+ * runs A* on the sub graph restricted to those lanes and their neighbors, so
+ * the lane change and s range rules of AStarStrategy still apply. Falls back
+ * to a full A* search if the corridor has no valid route.
+ */
+class ContractionHierarchyStrategy : public Strategy {
+ public:
+  ContractionHierarchyStrategy(bool enable_change,
+                               const ContractionHierarchyGraph* hierarchy);
+  ~ContractionHierarchyStrategy() = default;
+
+  virtual bool Search(const TopoGraph* graph, const SubTopoGraph* sub_graph,
+                      const TopoNode* src_node, const TopoNode* dest_node,
+                      std::vector<NodeWithRange>* const result_nodes);
+
+ private:
+  bool change_lane_enabled_;
+  const ContractionHierarchyGraph* hierarchy_;
+};
+
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Routes random origin/destination pairs on the routing map of
+ * --map_dir with plain A*, with the contraction hierarchy, and with the route
+ * cache, and prints latency statistics of each. Run topo_creator first so
+ * that the contraction hierarchy exists.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/routing/common/routing_gflags.h"
+#include "modules/routing/core/navigator.h"
+
+DEFINE_int32(routing_benchmark_requests, 1000,
+             "number of random origin/destination pairs");
+DEFINE_int32(routing_benchmark_seed, 0, "seed of the random pairs");
+
+namespace {
+
+using apollo::routing::Graph;
+using apollo::routing::Navigator;
+using apollo::routing::RoutingRequest;
+using apollo::routing::RoutingResponse;
+
+struct Result {
+  std::vector<double> latencies_ms;
+  std::vector<std::string> roads;
+  int num_success = 0;
+};
+
+Result Run(Navigator* navigator, const std::vector<RoutingRequest>& requests) {
+  Result result;
+  for (const auto& request : requests) {
+    RoutingResponse response;
+    const auto start = std::chrono::steady_clock::now();
+    const bool success = navigator->SearchRoute(request, &response);
+    const auto end = std::chrono::steady_clock::now();
+    result.latencies_ms.push_back(
+        std::chrono::duration<double, std::milli>(end - start).count());
+    std::string road;
+    if (success) {
+      ++result.num_success;
+      for (const auto& segment : response.road()) {
+        road += segment.ShortDebugString();
+      }
+    }
+    result.roads.push_back(road);
+  }
+  return result;
+}
+
+void Report(const std::string& name, const Result& result,
+            const Result& baseline) {
+  std::vector<double> latencies = result.latencies_ms;
+  std::sort(latencies.begin(), latencies.end());
+  const double mean =
+      std::accumulate(latencies.begin(), latencies.end(), 0.0) /
+      static_cast<double>(latencies.size());
+  const auto percentile = [&latencies](double p) {
+    return latencies[std::min(
+        latencies.size() - 1,
+        static_cast<size_t>(p * static_cast<double>(latencies.size())))];
+  };
+  int num_same = 0;
+  for (size_t i = 0; i < result.roads.size(); ++i) {
+    if (result.roads[i] == baseline.roads[i]) {
+      ++num_same;
+    }
+  }
+  AINFO << name << ": mean " << mean << " ms, p50 " << percentile(0.5)
+        << " ms, p99 " << percentile(0.99) << " ms, max " << latencies.back()
+        << " ms, " << result.num_success << "/" << latencies.size()
+        << " routed, " << num_same << " same as A*";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  FLAGS_alsologtostderr = true;
+
+  const std::string routing_map = apollo::hdmap::RoutingMapFile();
+  Graph graph;
+  ACHECK(apollo::cyber::common::GetProtoFromFile(routing_map, &graph))
+      << "Failed to read topology graph from " << routing_map;
+  ACHECK(graph.node_size() > 0) << "Empty topology graph " << routing_map;
+
+  std::mt19937 random(FLAGS_routing_benchmark_seed);
+  std::uniform_int_distribution<int> pick(0, graph.node_size() - 1);
+  std::vector<RoutingRequest> requests(FLAGS_routing_benchmark_requests);
+  for (auto& request : requests) {
+    for (const double ratio : {0.25, 0.75}) {
+      const auto& node = graph.node(pick(random));
+      auto* waypoint = request.add_waypoint();
+      waypoint->set_id(node.lane_id());
+      waypoint->set_s(node.length() * ratio);
+    }
+  }
+
+  FLAGS_minloglevel = google::WARNING;
+  FLAGS_routing_cache_size = 0;
+  FLAGS_enable_routing_contraction_hierarchy = false;
+  Navigator a_star_navigator(routing_map);
+  FLAGS_enable_routing_contraction_hierarchy = true;
+  Navigator hierarchy_navigator(routing_map);
+  FLAGS_routing_cache_size = FLAGS_routing_benchmark_requests;
+  Navigator cached_navigator(routing_map);
+  ACHECK(a_star_navigator.IsReady() && hierarchy_navigator.IsReady() &&
+         cached_navigator.IsReady());
+
+  const Result a_star = Run(&a_star_navigator, requests);
+  const Result hierarchy = Run(&hierarchy_navigator, requests);
+  Run(&cached_navigator, requests);
+  const Result cached = Run(&cached_navigator, requests);
+  FLAGS_minloglevel = google::INFO;
+
+  AINFO << requests.size() << " random requests on " << routing_map;
+  Report("A*", a_star, a_star);
+  Report("contraction hierarchy", hierarchy, a_star);
+  Report("route cache hit", cached, a_star);
+  return 0;
+}
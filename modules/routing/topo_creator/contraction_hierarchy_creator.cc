@@ -0,0 +1,252 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/topo_creator/contraction_hierarchy_creator.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/routing/graph/contraction_hierarchy_graph.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+using Arc = ContractionHierarchyGraph::Arc;
+
+// Witness searches are cut off after this many settled nodes. A missed
+// witness only costs a superfluous shortcut, never a wrong route.
+constexpr int kMaxWitnessSettledNodes = 500;
+
+class Contractor {
+ public:
+  explicit Contractor(const std::vector<Arc>& arcs, int num_nodes)
+      : out_arcs_(num_nodes),
+        in_arcs_(num_nodes),
+        contracted_(num_nodes, false),
+        contracted_neighbors_(num_nodes, 0),
+        witness_dist_(num_nodes, std::numeric_limits<double>::max()) {
+    for (const auto& arc : arcs) {
+      AddArc(arc.from, arc.to, arc.cost);
+    }
+  }
+
+  void Run(ContractionHierarchy* const hierarchy) {
+    const int num_nodes = static_cast<int>(out_arcs_.size());
+    using QueueEntry = std::pair<int, int>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+                        std::greater<QueueEntry>>
+        queue;
+    for (int node = 0; node < num_nodes; ++node) {
+      queue.emplace(Priority(node), node);
+    }
+    hierarchy->mutable_rank()->Resize(num_nodes, 0);
+    int rank = 0;
+    while (!queue.empty()) {
+      const int node = queue.top().second;
+      queue.pop();
+      // Lazy update: the priority may have grown since it was queued.
+      const int priority = Priority(node);
+      if (!queue.empty() && priority > queue.top().first) {
+        queue.emplace(priority, node);
+        continue;
+      }
+      Contract(node, false);
+      hierarchy->set_rank(node, rank++);
+    }
+    for (const auto& key_shortcut : shortcuts_) {
+      *hierarchy->add_shortcut() = key_shortcut.second;
+    }
+  }
+
+ private:
+  static uint64_t Key(int from, int to) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(from)) << 32) |
+           static_cast<uint32_t>(to);
+  }
+
+  // Returns true if the arc is new or cheaper than the existing one.
+  bool AddArc(int from, int to, double cost) {
+    auto result = out_arcs_[from].emplace(to, cost);
+    if (!result.second) {
+      if (cost >= result.first->second) {
+        return false;
+      }
+      result.first->second = cost;
+    }
+    in_arcs_[to][from] = cost;
+    return true;
+  }
+
+  // Edge difference plus the number of contracted neighbors, which spreads
+  // the contraction evenly over the graph.
+  int Priority(int node) {
+    const int num_arcs = static_cast<int>(in_arcs_[node].size() +
+                                          out_arcs_[node].size());
+    return Contract(node, true) - num_arcs + contracted_neighbors_[node];
+  }
+
+  // Returns the number of shortcuts contracting node needs; adds them unless
+  // simulate is set.
+  int Contract(int node, bool simulate) {
+    int num_shortcuts = 0;
+    for (const auto& in_arc : in_arcs_[node]) {
+      const int from = in_arc.first;
+      double max_cost = 0.0;
+      for (const auto& out_arc : out_arcs_[node]) {
+        if (out_arc.first != from) {
+          max_cost = std::max(max_cost, in_arc.second + out_arc.second);
+        }
+      }
+      WitnessSearch(from, node, max_cost);
+      for (const auto& out_arc : out_arcs_[node]) {
+        const int to = out_arc.first;
+        if (to == from) {
+          continue;
+        }
+        const double cost = in_arc.second + out_arc.second;
+        if (witness_dist_[to] <= cost) {
+          continue;
+        }
+        ++num_shortcuts;
+        if (!simulate && AddArc(from, to, cost)) {
+          Shortcut& shortcut = shortcuts_[Key(from, to)];
+          shortcut.set_from_node(from);
+          shortcut.set_to_node(to);
+          shortcut.set_via_node(node);
+          shortcut.set_cost(cost);
+        }
+      }
+    }
+    if (!simulate) {
+      contracted_[node] = true;
+      for (const auto& in_arc : in_arcs_[node]) {
+        out_arcs_[in_arc.first].erase(node);
+        ++contracted_neighbors_[in_arc.first];
+      }
+      for (const auto& out_arc : out_arcs_[node]) {
+        in_arcs_[out_arc.first].erase(node);
+        ++contracted_neighbors_[out_arc.first];
+      }
+      in_arcs_[node].clear();
+      out_arcs_[node].clear();
+    }
+    return num_shortcuts;
+  }
+
+  // Bounded Dijkstra from source in the remaining graph without via. Leaves
+  // the distances in witness_dist_.
+  void WitnessSearch(int source, int via, double max_cost) {
+    for (const int node : witness_touched_) {
+      witness_dist_[node] = std::numeric_limits<double>::max();
+    }
+    witness_touched_.clear();
+
+    using QueueEntry = std::pair<double, int>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+                        std::greater<QueueEntry>>
+        queue;
+    witness_dist_[source] = 0.0;
+    witness_touched_.push_back(source);
+    queue.emplace(0.0, source);
+    int settled = 0;
+    while (!queue.empty() && settled < kMaxWitnessSettledNodes) {
+      const auto [dist, node] = queue.top();
+      queue.pop();
+      if (dist > witness_dist_[node]) {
+        continue;
+      }
+      if (dist > max_cost) {
+        break;
+      }
+      ++settled;
+      for (const auto& arc : out_arcs_[node]) {
+        const int next = arc.first;
+        if (next == via || contracted_[next]) {
+          continue;
+        }
+        const double next_dist = dist + arc.second;
+        if (next_dist < witness_dist_[next]) {
+          if (witness_dist_[next] == std::numeric_limits<double>::max()) {
+            witness_touched_.push_back(next);
+          }
+          witness_dist_[next] = next_dist;
+          queue.emplace(next_dist, next);
+        }
+      }
+    }
+  }
+
+  std::vector<std::unordered_map<int, double>> out_arcs_;
+  std::vector<std::unordered_map<int, double>> in_arcs_;
+  std::vector<bool> contracted_;
+  std::vector<int> contracted_neighbors_;
+  std::vector<double> witness_dist_;
+  std::vector<int> witness_touched_;
+  std::unordered_map<uint64_t, Shortcut> shortcuts_;
+};
+
+}  // namespace
+
+ContractionHierarchyCreator::ContractionHierarchyCreator(
+    const std::string& topo_file_path, const std::string& dump_file_path)
+    : topo_file_path_(topo_file_path), dump_file_path_(dump_file_path) {}
+
+bool ContractionHierarchyCreator::Create() {
+  Graph graph;
+  if (!cyber::common::GetProtoFromFile(topo_file_path_, &graph)) {
+    AERROR << "Failed to read topology graph from " << topo_file_path_;
+    return false;
+  }
+  ContractionHierarchy hierarchy;
+  if (!Contract(graph, &hierarchy)) {
+    AERROR << "Failed to contract topology graph " << topo_file_path_;
+    return false;
+  }
+  if (!cyber::common::SetProtoToBinaryFile(hierarchy, dump_file_path_)) {
+    AERROR << "Failed to dump contraction hierarchy into file "
+           << dump_file_path_;
+    return false;
+  }
+  AINFO << "Contraction hierarchy with " << hierarchy.shortcut_size()
+        << " shortcuts is dumped successfully. Path: " << dump_file_path_;
+  return true;
+}
+
+bool ContractionHierarchyCreator::Contract(
+    const Graph& graph, ContractionHierarchy* const hierarchy) {
+  std::vector<Arc> arcs;
+  if (!ContractionHierarchyGraph::GetGraphArcs(graph, &arcs)) {
+    return false;
+  }
+  hierarchy->Clear();
+  hierarchy->set_hdmap_version(graph.hdmap_version());
+  hierarchy->set_hdmap_district(graph.hdmap_district());
+  Contractor contractor(arcs, graph.node_size());
+  contractor.Run(hierarchy);
+  return true;
+}
+
+}  // namespace routing
+}  // namespace apollo
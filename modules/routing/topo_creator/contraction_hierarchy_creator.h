@@ -0,0 +1,49 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <string>
+
+#include "modules/routing/proto/topo_graph.pb.h"
+
+namespace apollo {
+namespace routing {
+
+/**
+ * @class ContractionHierarchyCreator
+ * @brief Contracts the nodes of a routing topo graph one by one, in the order
+ * of least added shortcuts, and dumps the node ranks and shortcuts next to it.
+ */
+class ContractionHierarchyCreator {
+ public:
+  ContractionHierarchyCreator(const std::string& topo_file_path,
+                              const std::string& dump_file_path);
+
+  ~ContractionHierarchyCreator() = default;
+
+  bool Create();
+
+  static bool Contract(const Graph& graph,
+                       ContractionHierarchy* const hierarchy);
+
+ private:
+  std::string topo_file_path_;
+  std::string dump_file_path_;
+};
+
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,208 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/routing/topo_creator/contraction_hierarchy_creator.h"
+
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/routing/graph/contraction_hierarchy_graph.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+using Arc = ContractionHierarchyGraph::Arc;
+
+constexpr double kInf = std::numeric_limits<double>::max();
+
+// A grid of roads with `lanes` parallel lanes each, going east and north,
+// with random lane costs and lane changes between neighboring lanes.
+void GetGridGraph(int size, int lanes, Graph* graph) {
+  std::mt19937 random(42);
+  std::uniform_real_distribution<double> cost(1.0, 10.0);
+  graph->set_hdmap_version("1.0");
+  graph->set_hdmap_district("grid");
+  const auto lane_id = [](int x, int y, int dir, int lane) {
+    return std::to_string(x) + "_" + std::to_string(y) + "_" +
+           std::to_string(dir) + "_" + std::to_string(lane);
+  };
+  const auto add_edge = [graph](const std::string& from, const std::string& to,
+                                double edge_cost, Edge::DirectionType type) {
+    auto* edge = graph->add_edge();
+    edge->set_from_lane_id(from);
+    edge->set_to_lane_id(to);
+    edge->set_cost(edge_cost);
+    edge->set_direction_type(type);
+  };
+  for (int x = 0; x < size; ++x) {
+    for (int y = 0; y < size; ++y) {
+      for (int dir = 0; dir < 2; ++dir) {
+        for (int lane = 0; lane < lanes; ++lane) {
+          auto* node = graph->add_node();
+          node->set_lane_id(lane_id(x, y, dir, lane));
+          node->set_length(100.0);
+          node->set_cost(cost(random));
+          node->set_road_id(lane_id(x, y, dir, 0));
+        }
+      }
+    }
+  }
+  for (int x = 0; x < size; ++x) {
+    for (int y = 0; y < size; ++y) {
+      for (int dir = 0; dir < 2; ++dir) {
+        for (int lane = 0; lane < lanes; ++lane) {
+          const auto from = lane_id(x, y, dir, lane);
+          if (lane > 0) {
+            add_edge(from, lane_id(x, y, dir, lane - 1), 5.0, Edge::LEFT);
+          }
+          if (lane + 1 < lanes) {
+            add_edge(from, lane_id(x, y, dir, lane + 1), 5.0, Edge::RIGHT);
+          }
+          // Straight on and turns at the end of the road.
+          const int next_x = x + (dir == 0 ? 1 : 0);
+          const int next_y = y + (dir == 1 ? 1 : 0);
+          if (next_x < size && next_y < size) {
+            add_edge(from, lane_id(next_x, next_y, dir, lane), 0.0,
+                     Edge::FORWARD);
+            add_edge(from, lane_id(next_x, next_y, 1 - dir, lane),
+                     cost(random), Edge::FORWARD);
+          }
+        }
+      }
+    }
+  }
+}
+
+double Dijkstra(const std::vector<Arc>& arcs, int num_nodes, int src,
+                int dest) {
+  std::vector<std::vector<std::pair<int, double>>> out(num_nodes);
+  for (const auto& arc : arcs) {
+    out[arc.from].emplace_back(arc.to, arc.cost);
+  }
+  std::vector<double> dist(num_nodes, kInf);
+  using QueueEntry = std::pair<double, int>;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+                      std::greater<QueueEntry>>
+      queue;
+  dist[src] = 0.0;
+  queue.emplace(0.0, src);
+  while (!queue.empty()) {
+    const auto [d, node] = queue.top();
+    queue.pop();
+    if (d > dist[node]) {
+      continue;
+    }
+    for (const auto& arc : out[node]) {
+      if (d + arc.second < dist[arc.first]) {
+        dist[arc.first] = d + arc.second;
+        queue.emplace(dist[arc.first], arc.first);
+      }
+    }
+  }
+  return dist[dest];
+}
+
+}  // namespace
+
+TEST(ContractionHierarchyCreatorTest, MatchesDijkstra) {
+  Graph graph;
+  GetGridGraph(8, 3, &graph);
+  ContractionHierarchy hierarchy;
+  ASSERT_TRUE(ContractionHierarchyCreator::Contract(graph, &hierarchy));
+  EXPECT_EQ(graph.node_size(), hierarchy.rank_size());
+  EXPECT_EQ(graph.hdmap_version(), hierarchy.hdmap_version());
+
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  ContractionHierarchyGraph hierarchy_graph;
+  ASSERT_TRUE(hierarchy_graph.Init(graph, hierarchy, &topo_graph));
+
+  std::vector<Arc> arcs;
+  ASSERT_TRUE(ContractionHierarchyGraph::GetGraphArcs(graph, &arcs));
+  std::unordered_map<std::string, int> node_index;
+  for (int i = 0; i < graph.node_size(); ++i) {
+    node_index[graph.node(i).lane_id()] = i;
+  }
+  std::unordered_map<std::string, double> arc_cost;
+  for (const auto& arc : arcs) {
+    const auto key = std::to_string(arc.from) + ">" + std::to_string(arc.to);
+    const auto iter = arc_cost.find(key);
+    if (iter == arc_cost.end() || arc.cost < iter->second) {
+      arc_cost[key] = arc.cost;
+    }
+  }
+
+  std::mt19937 random(7);
+  std::uniform_int_distribution<int> pick(0, graph.node_size() - 1);
+  int num_routes = 0;
+  for (int i = 0; i < 200; ++i) {
+    const int src = pick(random);
+    const int dest = pick(random);
+    const double expected = Dijkstra(arcs, graph.node_size(), src, dest);
+    std::vector<const TopoNode*> result;
+    const bool found = hierarchy_graph.Search(
+        topo_graph.GetNode(graph.node(src).lane_id()),
+        topo_graph.GetNode(graph.node(dest).lane_id()), &result);
+    ASSERT_EQ(expected != kInf, found) << src << " -> " << dest;
+    if (!found) {
+      continue;
+    }
+    ++num_routes;
+    ASSERT_FALSE(result.empty());
+    EXPECT_EQ(graph.node(src).lane_id(), result.front()->LaneId());
+    EXPECT_EQ(graph.node(dest).lane_id(), result.back()->LaneId());
+    // The unpacked route only uses graph edges and is as cheap as Dijkstra.
+    double cost = 0.0;
+    for (size_t j = 1; j < result.size(); ++j) {
+      const auto key = std::to_string(node_index[result[j - 1]->LaneId()]) +
+                       ">" + std::to_string(node_index[result[j]->LaneId()]);
+      const auto iter = arc_cost.find(key);
+      ASSERT_NE(arc_cost.end(), iter) << "no edge " << key;
+      cost += iter->second;
+    }
+    EXPECT_NEAR(expected, cost, 1e-6) << src << " -> " << dest;
+  }
+  EXPECT_GT(num_routes, 0);
+}
+
+TEST(ContractionHierarchyCreatorTest, RejectsMismatchedGraph) {
+  Graph graph;
+  GetGridGraph(3, 2, &graph);
+  ContractionHierarchy hierarchy;
+  ASSERT_TRUE(ContractionHierarchyCreator::Contract(graph, &hierarchy));
+
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  ContractionHierarchyGraph hierarchy_graph;
+  hierarchy.set_hdmap_version("2.0");
+  EXPECT_FALSE(hierarchy_graph.Init(graph, hierarchy, &topo_graph));
+  hierarchy.set_hdmap_version(graph.hdmap_version());
+  hierarchy.mutable_rank()->RemoveLast();
+  EXPECT_FALSE(hierarchy_graph.Init(graph, hierarchy, &topo_graph));
+}
+
+}  // namespace routing
+}  // namespace apollo
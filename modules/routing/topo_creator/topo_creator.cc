@@ -14,9 +14,13 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <cstdio>
+
+#include "absl/strings/str_cat.h"
 #include "cyber/common/file.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/routing/common/routing_gflags.h"
+#include "modules/routing/topo_creator/contraction_hierarchy_creator.h"
 #include "modules/routing/topo_creator/graph_creator.h"
 
 int main(int argc, char **argv) {
@@ -39,5 +43,18 @@ int main(int argc, char **argv) {
 
   AINFO << "Create routing topo successfully from " << base_map << " to "
         << routing_map;
+
+  // Shortcuts for Navigator, built from the topo graph just dumped.
+  const auto hierarchy_file = absl::StrCat(
+      FLAGS_map_dir, "/", FLAGS_routing_contraction_hierarchy_filename);
+  apollo::routing::ContractionHierarchyCreator hierarchy_creator(
+      apollo::hdmap::RoutingMapFile(), hierarchy_file);
+  if (!hierarchy_creator.Create()) {
+    // The routing map is already written, Navigator routes with A* alone
+    // when it finds no hierarchy, so do not leave an old one behind.
+    std::remove(hierarchy_file.c_str());
+    AERROR << "Create routing contraction hierarchy failed, routing falls "
+              "back to A* search.";
+  }
   return 0;
 }
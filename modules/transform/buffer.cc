@@ -22,6 +22,10 @@
 #include "cyber/time/clock.h"
 #include "modules/common/adapters/adapter_gflags.h"
 
+DEFINE_bool(enable_lock_free_transform_buffer, false,
+            "Serve transform lookups from the lock-free buffer, falling back "
+            "to tf2::BufferCore.");
+
 using Time = ::apollo::cyber::Time;
 using Clock = ::apollo::cyber::Clock;
 
@@ -76,6 +80,7 @@ void Buffer::SubscriptionCallbackImpl(
   if (now.ToNanosecond() < last_update_.ToNanosecond()) {
     AINFO << "Detected jump back in time. Clearing TF buffer.";
     clear();
+    lock_free_core_.Clear();
     // cache static transform stamped again.
     for (auto& msg : static_msgs_) {
       setTransform(msg, authority, true);
@@ -113,6 +118,12 @@ void Buffer::SubscriptionCallbackImpl(
         static_msgs_.push_back(trans_stamped);
       }
       setTransform(trans_stamped, authority, is_static);
+      if (FLAGS_enable_lock_free_transform_buffer) {
+        std::string error;
+        if (!lock_free_core_.SetTransform(trans_stamped, is_static, &error)) {
+          ADEBUG << "Lock-free buffer rejected transform: " << error;
+        }
+      }
     } catch (tf2::TransformException& ex) {
       std::string temp = ex.what();
       AERROR << "Failure to set received transform:" << temp.c_str();
@@ -170,9 +181,17 @@ TransformStamped Buffer::lookupTransform(const std::string& target_frame,
                                          const cyber::Time& time,
                                          const float timeout_second) const {
   tf2::Time tf2_time(time.ToNanosecond());
+  TransformStamped trans_stamped;
+  if (FLAGS_enable_lock_free_transform_buffer) {
+    geometry_msgs::TransformStamped tf2_trans_stamped;
+    if (lock_free_core_.LookupTransform(target_frame, source_frame, tf2_time,
+                                        &tf2_trans_stamped)) {
+      TF2MsgToCyber(tf2_trans_stamped, trans_stamped);
+      return trans_stamped;
+    }
+  }
   geometry_msgs::TransformStamped tf2_trans_stamped =
       tf2::BufferCore::lookupTransform(target_frame, source_frame, tf2_time);
-  TransformStamped trans_stamped;
   TF2MsgToCyber(tf2_trans_stamped, trans_stamped);
   return trans_stamped;
 }
@@ -196,6 +215,11 @@ bool Buffer::canTransform(const std::string& target_frame,
                           const std::string& source_frame,
                           const cyber::Time& time, const float timeout_second,
                           std::string* errstr) const {
+  if (FLAGS_enable_lock_free_transform_buffer &&
+      lock_free_core_.CanTransform(target_frame, source_frame,
+                                   time.ToNanosecond())) {
+    return true;
+  }
   uint64_t timeout_ns =
       static_cast<uint64_t>(timeout_second * kSecondToNanoFactor);
   uint64_t start_time = Clock::Now().ToNanosecond();  // time.ToNanosecond();
@@ -20,11 +20,15 @@
 #include <string>
 #include <vector>
 
+#include "gflags/gflags.h"
 #include "tf2/buffer_core.h"
 #include "tf2/convert.h"
 
 #include "cyber/node/node.h"
 #include "modules/transform/buffer_interface.h"
+#include "modules/transform/lock_free_buffer_core.h"
+
+DECLARE_bool(enable_lock_free_transform_buffer);
 
 namespace apollo {
 namespace transform {
@@ -136,6 +140,11 @@ class Buffer : public BufferInterface, public tf2::BufferCore {
   cyber::Time last_update_;
   std::vector<geometry_msgs::TransformStamped> static_msgs_;
 
+  // Serves lookupTransform/canTransform without a fixed frame when
+  // FLAGS_enable_lock_free_transform_buffer is set; BufferCore remains the
+  // fallback for anything it can not answer.
+  LockFreeBufferCore lock_free_core_;
+
   DECLARE_SINGLETON(Buffer)
 };  // class
 
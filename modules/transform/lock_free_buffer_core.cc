@@ -0,0 +1,554 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/transform/lock_free_buffer_core.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace apollo {
+namespace transform {
+
+namespace {
+
+constexpr size_t kMaxCachedChainsPerThread = 256;
+
+std::atomic<uint64_t> next_instance_id{1};
+
+void SetError(const std::string& message, std::string* error) {
+  if (error != nullptr) {
+    *error = message;
+  }
+}
+
+tf2::Transform ToTransform(const geometry_msgs::Transform& msg) {
+  tf2::Quaternion rotation(msg.rotation.x, msg.rotation.y, msg.rotation.z,
+                           msg.rotation.w);
+  rotation.normalize();
+  return tf2::Transform(
+      rotation,
+      tf2::Vector3(msg.translation.x, msg.translation.y, msg.translation.z));
+}
+
+void FromTransform(const tf2::Transform& transform,
+                   geometry_msgs::Transform* msg) {
+  const auto& origin = transform.getOrigin();
+  const auto rotation = transform.getRotation();
+  msg->translation.x = origin.x();
+  msg->translation.y = origin.y();
+  msg->translation.z = origin.z();
+  msg->rotation.x = rotation.x();
+  msg->rotation.y = rotation.y();
+  msg->rotation.z = rotation.z();
+  msg->rotation.w = rotation.w();
+}
+
+}  // namespace
+
+/**
+ * @brief History of one dynamic frame. Single writer, any number of readers.
+ * A slot holds the sample with absolute index (version - 1); the writer
+ * invalidates the slot before overwriting it, so a reader detects a sample
+ * that was replaced while it was being read.
+ */
+class LockFreeBufferCore::FrameRing {
+ public:
+  struct Sample {
+    tf2::Time stamp = 0;
+    tf2::Transform transform;
+  };
+
+  explicit FrameRing(size_t capacity)
+      : capacity_(capacity), slots_(new Slot[capacity]) {}
+
+  bool Push(tf2::Time stamp, const tf2::Transform& transform) {
+    const uint64_t count = count_.load(std::memory_order_relaxed);
+    if (count > begin_.load(std::memory_order_relaxed) &&
+        stamp < last_stamp_) {
+      return false;
+    }
+    Slot& slot = slots_[count % capacity_];
+    slot.version.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const auto& origin = transform.getOrigin();
+    const auto rotation = transform.getRotation();
+    slot.stamp.store(stamp, std::memory_order_relaxed);
+    slot.values[0].store(origin.x(), std::memory_order_relaxed);
+    slot.values[1].store(origin.y(), std::memory_order_relaxed);
+    slot.values[2].store(origin.z(), std::memory_order_relaxed);
+    slot.values[3].store(rotation.x(), std::memory_order_relaxed);
+    slot.values[4].store(rotation.y(), std::memory_order_relaxed);
+    slot.values[5].store(rotation.z(), std::memory_order_relaxed);
+    slot.values[6].store(rotation.w(), std::memory_order_relaxed);
+
+    slot.version.store(count + 1, std::memory_order_release);
+    count_.store(count + 1, std::memory_order_release);
+    last_stamp_ = stamp;
+    return true;
+  }
+
+  void Clear() {
+    begin_.store(count_.load(std::memory_order_relaxed),
+                 std::memory_order_release);
+  }
+
+  bool LatestStamp(tf2::Time* stamp) const {
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    Sample sample;
+    if (!Window(&begin, &end) || !Read(end - 1, &sample)) {
+      return false;
+    }
+    *stamp = sample.stamp;
+    return true;
+  }
+
+  /**
+   * @brief Sample the frame at time (0 for the latest sample), interpolating
+   * between the two closest samples. Bounded number of steps.
+   */
+  bool Lookup(tf2::Time time, Sample* result, std::string* error) const {
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    Sample upper;
+    if (!Window(&begin, &end) || !Read(end - 1, &upper)) {
+      SetError("no data", error);
+      return false;
+    }
+    if (time == 0 || time == upper.stamp) {
+      *result = upper;
+      return true;
+    }
+    if (time > upper.stamp) {
+      SetError("lookup would require extrapolation into the future", error);
+      return false;
+    }
+
+    // Smallest index whose stamp is not before time. Slots overwritten
+    // during the search are older than the window, hence before time.
+    uint64_t lo = begin;
+    uint64_t hi = end - 1;
+    while (lo < hi) {
+      const uint64_t mid = lo + (hi - lo) / 2;
+      Sample sample;
+      if (!Read(mid, &sample) || sample.stamp < time) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+        upper = sample;
+      }
+    }
+    if (upper.stamp == time) {
+      *result = upper;
+      return true;
+    }
+    Sample lower;
+    if (hi == begin || !Read(hi - 1, &lower) || lower.stamp > time) {
+      SetError("lookup would require extrapolation into the past", error);
+      return false;
+    }
+    if (!Read(hi, &upper)) {
+      SetError("sample was overwritten during lookup", error);
+      return false;
+    }
+
+    const double ratio = static_cast<double>(time - lower.stamp) /
+                         static_cast<double>(upper.stamp - lower.stamp);
+    result->stamp = time;
+    result->transform.setOrigin(tf2::lerp(lower.transform.getOrigin(),
+                                          upper.transform.getOrigin(), ratio));
+    result->transform.setRotation(tf2::slerp(
+        lower.transform.getRotation(), upper.transform.getRotation(), ratio));
+    return true;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> version{0};
+    std::atomic<uint64_t> stamp{0};
+    std::atomic<double> values[7];
+  };
+
+  bool Window(uint64_t* begin, uint64_t* end) const {
+    *end = count_.load(std::memory_order_acquire);
+    *begin = std::max(begin_.load(std::memory_order_acquire),
+                      *end > capacity_ ? *end - capacity_ : 0);
+    return *begin < *end;
+  }
+
+  bool Read(uint64_t index, Sample* sample) const {
+    const Slot& slot = slots_[index % capacity_];
+    const uint64_t version = slot.version.load(std::memory_order_acquire);
+    if (version != index + 1) {
+      return false;
+    }
+    sample->stamp = slot.stamp.load(std::memory_order_relaxed);
+    double values[7];
+    for (int i = 0; i < 7; ++i) {
+      values[i] = slot.values[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.version.load(std::memory_order_relaxed) != version) {
+      return false;
+    }
+    sample->transform.setOrigin(tf2::Vector3(values[0], values[1], values[2]));
+    sample->transform.setRotation(
+        tf2::Quaternion(values[3], values[4], values[5], values[6]));
+    return true;
+  }
+
+  const size_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> begin_{0};
+  // Writer only.
+  tf2::Time last_stamp_ = 0;
+};
+
+struct LockFreeBufferCore::Frame {
+  std::string name;
+  uint32_t parent = kNoFrame;
+  bool is_static = false;
+  // parent <- frame, for static frames.
+  tf2::Transform transform = tf2::Transform::getIdentity();
+  // History of parent <- frame, for dynamic frames. Owned by rings_.
+  FrameRing* ring = nullptr;
+};
+
+struct LockFreeBufferCore::Snapshot {
+  uint64_t version = 0;
+  std::unordered_map<std::string, uint32_t> frame_ids;
+  std::vector<Frame> frames;
+};
+
+/**
+ * @brief Resolved path between two frames. Each side goes from a frame up to
+ * the common ancestor; consecutive static edges are composed into one step.
+ */
+struct LockFreeBufferCore::Chain {
+  struct Step {
+    const FrameRing* ring = nullptr;
+    tf2::Transform transform = tf2::Transform::getIdentity();
+  };
+  uint64_t snapshot_version = 0;
+  std::vector<Step> source_steps;
+  std::vector<Step> target_steps;
+};
+
+struct LockFreeBufferCore::ChainCache {
+  uint64_t instance_id = 0;
+  uint64_t snapshot_version = 0;
+  std::unordered_map<std::string, Chain> chains;
+};
+
+LockFreeBufferCore::LockFreeBufferCore(size_t cache_size)
+    : cache_size_(std::max<size_t>(cache_size, 2)),
+      instance_id_(next_instance_id.fetch_add(1)) {
+  Publish(std::make_unique<Snapshot>());
+}
+
+LockFreeBufferCore::~LockFreeBufferCore() = default;
+
+uint32_t LockFreeBufferCore::FindOrAddFrame(const std::string& name,
+                                            Snapshot* snapshot) {
+  auto iter = snapshot->frame_ids.find(name);
+  if (iter != snapshot->frame_ids.end()) {
+    return iter->second;
+  }
+  const auto id = static_cast<uint32_t>(snapshot->frames.size());
+  snapshot->frames.emplace_back();
+  snapshot->frames.back().name = name;
+  snapshot->frame_ids.emplace(name, id);
+  return id;
+}
+
+void LockFreeBufferCore::Publish(std::unique_ptr<Snapshot> snapshot) {
+  const Snapshot* current = snapshot_.load(std::memory_order_relaxed);
+  snapshot->version = current == nullptr ? 1 : current->version + 1;
+  snapshot_.store(snapshot.get(), std::memory_order_release);
+  snapshots_.push_back(std::move(snapshot));
+}
+
+bool LockFreeBufferCore::SetTransform(
+    const geometry_msgs::TransformStamped& transform, bool is_static,
+    std::string* error) {
+  const std::string& parent = transform.header.frame_id;
+  const std::string& child = transform.child_frame_id;
+  if (parent.empty() || child.empty()) {
+    SetError("empty frame id", error);
+    return false;
+  }
+  if (parent == child) {
+    SetError("frame_id and child_frame_id are the same: " + child, error);
+    return false;
+  }
+  const auto& t = transform.transform;
+  if (std::isnan(t.translation.x) || std::isnan(t.translation.y) ||
+      std::isnan(t.translation.z) || std::isnan(t.rotation.x) ||
+      std::isnan(t.rotation.y) || std::isnan(t.rotation.z) ||
+      std::isnan(t.rotation.w)) {
+    SetError("transform from " + parent + " to " + child + " contains nan",
+             error);
+    return false;
+  }
+  const tf2::Transform value = ToTransform(t);
+
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  const Snapshot* current = snapshot_.load(std::memory_order_relaxed);
+  const Frame* frame = nullptr;
+  uint32_t parent_id = kNoFrame;
+  auto iter = current->frame_ids.find(child);
+  if (iter != current->frame_ids.end()) {
+    frame = &current->frames[iter->second];
+  }
+  iter = current->frame_ids.find(parent);
+  if (iter != current->frame_ids.end()) {
+    parent_id = iter->second;
+  }
+
+  const bool changed =
+      frame == nullptr || parent_id == kNoFrame || frame->parent != parent_id ||
+      frame->is_static != is_static ||
+      (is_static && !(frame->transform == value)) ||
+      (!is_static && frame->ring == nullptr);
+  if (changed) {
+    auto snapshot = std::make_unique<Snapshot>(*current);
+    const uint32_t child_id = FindOrAddFrame(child, snapshot.get());
+    parent_id = FindOrAddFrame(parent, snapshot.get());
+    // Refuse edges that would close a loop.
+    for (uint32_t id = parent_id; id != kNoFrame;
+         id = snapshot->frames[id].parent) {
+      if (id == child_id) {
+        SetError("transform from " + parent + " to " + child +
+                     " would create a loop",
+                 error);
+        return false;
+      }
+    }
+    Frame& updated = snapshot->frames[child_id];
+    updated.parent = parent_id;
+    updated.is_static = is_static;
+    if (is_static) {
+      updated.transform = value;
+    } else if (updated.ring == nullptr) {
+      rings_.push_back(std::make_unique<FrameRing>(cache_size_));
+      updated.ring = rings_.back().get();
+    }
+    frame = &updated;
+    Publish(std::move(snapshot));
+  }
+
+  if (!is_static && !frame->ring->Push(transform.header.stamp, value)) {
+    SetError("dropped old data for frame " + child, error);
+    return false;
+  }
+  return true;
+}
+
+void LockFreeBufferCore::Clear() {
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  for (auto& ring : rings_) {
+    ring->Clear();
+  }
+}
+
+bool LockFreeBufferCore::ResolveChain(const Snapshot& snapshot,
+                                      const std::string& target_frame,
+                                      const std::string& source_frame,
+                                      Chain* chain, std::string* error) const {
+  const auto target_iter = snapshot.frame_ids.find(target_frame);
+  if (target_iter == snapshot.frame_ids.end()) {
+    SetError("frame " + target_frame + " does not exist", error);
+    return false;
+  }
+  const auto source_iter = snapshot.frame_ids.find(source_frame);
+  if (source_iter == snapshot.frame_ids.end()) {
+    SetError("frame " + source_frame + " does not exist", error);
+    return false;
+  }
+
+  const auto ancestors = [&snapshot](uint32_t id) {
+    std::vector<uint32_t> path;
+    for (; id != kNoFrame; id = snapshot.frames[id].parent) {
+      path.push_back(id);
+    }
+    return path;
+  };
+  const auto target_path = ancestors(target_iter->second);
+  const auto source_path = ancestors(source_iter->second);
+
+  size_t target_length = 0;
+  size_t source_length = source_path.size();
+  for (; target_length < target_path.size(); ++target_length) {
+    const auto found = std::find(source_path.begin(), source_path.end(),
+                                 target_path[target_length]);
+    if (found != source_path.end()) {
+      source_length = found - source_path.begin();
+      break;
+    }
+  }
+  if (target_length == target_path.size()) {
+    SetError("frames " + target_frame + " and " + source_frame +
+                 " are not part of the same tree",
+             error);
+    return false;
+  }
+
+  const auto build_steps = [&snapshot](const std::vector<uint32_t>& path,
+                                       size_t length,
+                                       std::vector<Chain::Step>* steps) {
+    steps->clear();
+    for (size_t i = 0; i < length; ++i) {
+      const Frame& frame = snapshot.frames[path[i]];
+      if (!frame.is_static) {
+        steps->emplace_back();
+        steps->back().ring = frame.ring;
+      } else if (!steps->empty() && steps->back().ring == nullptr) {
+        steps->back().transform = frame.transform * steps->back().transform;
+      } else {
+        steps->emplace_back();
+        steps->back().transform = frame.transform;
+      }
+    }
+  };
+  chain->snapshot_version = snapshot.version;
+  build_steps(source_path, source_length, &chain->source_steps);
+  build_steps(target_path, target_length, &chain->target_steps);
+  return true;
+}
+
+const LockFreeBufferCore::Chain* LockFreeBufferCore::GetChain(
+    const Snapshot& snapshot, const std::string& target_frame,
+    const std::string& source_frame, std::string* error) const {
+  thread_local ChainCache cache;
+  if (cache.instance_id != instance_id_ ||
+      cache.snapshot_version != snapshot.version ||
+      cache.chains.size() >= kMaxCachedChainsPerThread) {
+    cache.instance_id = instance_id_;
+    cache.snapshot_version = snapshot.version;
+    cache.chains.clear();
+  }
+
+  // Reused so that a cache hit does not allocate.
+  thread_local std::string key;
+  key.assign(target_frame).push_back('\n');
+  key.append(source_frame);
+  auto iter = cache.chains.find(key);
+  if (iter != cache.chains.end()) {
+    return &iter->second;
+  }
+  Chain chain;
+  if (!ResolveChain(snapshot, target_frame, source_frame, &chain, error)) {
+    return nullptr;
+  }
+  return &cache.chains.emplace(key, std::move(chain)).first->second;
+}
+
+bool LockFreeBufferCore::Evaluate(const Chain& chain, tf2::Time time,
+                                  tf2::Transform* transform, tf2::Time* stamp,
+                                  std::string* error) const {
+  const auto compose = [error](const std::vector<Chain::Step>& steps,
+                               tf2::Time time, tf2::Transform* result) {
+    *result = tf2::Transform::getIdentity();
+    FrameRing::Sample sample;
+    for (const auto& step : steps) {
+      if (step.ring == nullptr) {
+        *result = step.transform * *result;
+      } else if (step.ring->Lookup(time, &sample, error)) {
+        *result = sample.transform * *result;
+      } else {
+        return false;
+      }
+    }
+    return true;
+  };
+  const auto evaluate_at = [&](tf2::Time time) {
+    tf2::Transform source_to_ancestor;
+    tf2::Transform target_to_ancestor;
+    if (!compose(chain.source_steps, time, &source_to_ancestor) ||
+        !compose(chain.target_steps, time, &target_to_ancestor)) {
+      return false;
+    }
+    *transform = target_to_ancestor.inverse() * source_to_ancestor;
+    *stamp = time;
+    return true;
+  };
+  if (time != 0) {
+    return evaluate_at(time);
+  }
+
+  // Latest time at which every dynamic frame of the chain has data. The
+  // writer may overwrite that sample between the two steps if the reader is
+  // preempted for a whole ring, so retry a bounded number of times.
+  constexpr int kMaxLatestAttempts = 3;
+  for (int attempt = 0; attempt < kMaxLatestAttempts; ++attempt) {
+    tf2::Time common_time = 0;
+    bool has_dynamic_frame = false;
+    for (const auto* steps : {&chain.source_steps, &chain.target_steps}) {
+      for (const auto& step : *steps) {
+        if (step.ring == nullptr) {
+          continue;
+        }
+        tf2::Time latest = 0;
+        if (!step.ring->LatestStamp(&latest)) {
+          SetError("no data for a frame in the chain", error);
+          return false;
+        }
+        common_time =
+            has_dynamic_frame ? std::min(common_time, latest) : latest;
+        has_dynamic_frame = true;
+      }
+    }
+    if (evaluate_at(common_time)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LockFreeBufferCore::LookupTransform(
+    const std::string& target_frame, const std::string& source_frame,
+    tf2::Time time, geometry_msgs::TransformStamped* transform,
+    std::string* error) const {
+  const Snapshot* snapshot = snapshot_.load(std::memory_order_acquire);
+  const Chain* chain = GetChain(*snapshot, target_frame, source_frame, error);
+  if (chain == nullptr) {
+    return false;
+  }
+  tf2::Transform value;
+  tf2::Time stamp = 0;
+  if (!Evaluate(*chain, time, &value, &stamp, error)) {
+    return false;
+  }
+  transform->header.stamp = stamp;
+  transform->header.frame_id = target_frame;
+  transform->child_frame_id = source_frame;
+  FromTransform(value, &transform->transform);
+  return true;
+}
+
+bool LockFreeBufferCore::CanTransform(const std::string& target_frame,
+                                      const std::string& source_frame,
+                                      tf2::Time time,
+                                      std::string* error) const {
+  geometry_msgs::TransformStamped transform;
+  return LookupTransform(target_frame, source_frame, time, &transform, error);
+}
+
+}  // namespace transform
+}  // namespace apollo
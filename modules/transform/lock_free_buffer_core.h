@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "geometry_msgs/transform_stamped.h"
+#include "tf2/LinearMath/Transform.h"
+#include "tf2/time.h"
+
+namespace apollo {
+namespace transform {
+
+/**
+ * @class LockFreeBufferCore
+ * @brief A transform store for the lookup hot path. Readers never take a
+ * lock:
+ *   - the frame tree and all static transforms live in an immutable snapshot
+ *     published through an atomic pointer;
+ *   - every dynamic frame keeps its history in a fixed size ring buffer,
+ *     whose slots are validated with a per-slot version, so a reader does a
+ *     bounded number of steps whatever the writer is doing;
+ *   - the chain between two frames (with consecutive static edges already
+ *     composed) is resolved once per thread and reused for repeated queries.
+ * Writers are serialized by a mutex. Samples of a dynamic frame must arrive
+ * in time order; older samples are dropped.
+ */
+class LockFreeBufferCore {
+ public:
+  explicit LockFreeBufferCore(size_t cache_size = kDefaultCacheSize);
+  ~LockFreeBufferCore();
+
+  LockFreeBufferCore(const LockFreeBufferCore&) = delete;
+  LockFreeBufferCore& operator=(const LockFreeBufferCore&) = delete;
+
+  /**
+   * @brief Add a transform from transform.header.frame_id (parent) to
+   * transform.child_frame_id.
+   * @return false if the transform was rejected.
+   */
+  bool SetTransform(const geometry_msgs::TransformStamped& transform,
+                    bool is_static, std::string* error = nullptr);
+
+  /**
+   * @brief Drop the history of all dynamic frames. Static transforms and the
+   * frame tree are kept.
+   */
+  void Clear();
+
+  /**
+   * @brief Get the transform from source_frame to target_frame at time. A
+   * time of 0 means the latest time at which the whole chain is available.
+   * @return false with a reason in error if the transform is not available.
+   */
+  bool LookupTransform(const std::string& target_frame,
+                       const std::string& source_frame, tf2::Time time,
+                       geometry_msgs::TransformStamped* transform,
+                       std::string* error = nullptr) const;
+
+  bool CanTransform(const std::string& target_frame,
+                    const std::string& source_frame, tf2::Time time,
+                    std::string* error = nullptr) const;
+
+  static constexpr size_t kDefaultCacheSize = 1024;
+
+ private:
+  static constexpr uint32_t kNoFrame = UINT32_MAX;
+
+  class FrameRing;
+  struct Frame;
+  struct Snapshot;
+  struct Chain;
+  struct ChainCache;
+
+  uint32_t FindOrAddFrame(const std::string& name, Snapshot* snapshot);
+  void Publish(std::unique_ptr<Snapshot> snapshot);
+
+  bool ResolveChain(const Snapshot& snapshot, const std::string& target_frame,
+                    const std::string& source_frame, Chain* chain,
+                    std::string* error) const;
+  const Chain* GetChain(const Snapshot& snapshot,
+                        const std::string& target_frame,
+                        const std::string& source_frame,
+                        std::string* error) const;
+  bool Evaluate(const Chain& chain, tf2::Time time,
+                tf2::Transform* transform, tf2::Time* stamp,
+                std::string* error) const;
+
+  const size_t cache_size_;
+  const uint64_t instance_id_;
+
+  std::atomic<const Snapshot*> snapshot_{nullptr};
+
+  // Writer side state, guarded by write_mutex_. Snapshots replaced by a
+  // newer one are retired rather than deleted, since readers may still hold
+  // them; the frame tree and static transforms change rarely.
+  std::mutex write_mutex_;
+  std::vector<std::unique_ptr<const Snapshot>> snapshots_;
+  std::vector<std::unique_ptr<FrameRing>> rings_;
+};
+
+}  // namespace transform
+}  // namespace apollo
@@ -0,0 +1,185 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Lookup throughput of tf2::BufferCore and LockFreeBufferCore, on the
+ * two-branch frame tree of third_party/tf2/test/speed_test.cpp, with several
+ * reader threads and one writer publishing the dynamic frames at 1 kHz.
+ *
+ * Usage: lock_free_buffer_core_benchmark [num_levels] [lookups_per_thread]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tf2/buffer_core.h"
+#include "tf2/exceptions.h"
+
+#include "modules/transform/lock_free_buffer_core.h"
+
+namespace {
+
+using apollo::transform::LockFreeBufferCore;
+using SetFunction =
+    std::function<void(const geometry_msgs::TransformStamped&, bool)>;
+using LookupFunction = std::function<bool(const std::string&,
+                                          const std::string&, tf2::Time)>;
+
+constexpr tf2::Time kSecond = 1000000000UL;
+
+// root <- 0 <- 1 ... <- num_levels/2 - 1 and
+// root <- num_levels/2 <- ... <- num_levels - 1, as in speed_test.cpp. Every
+// other edge is static, like sensor extrinsics hanging off dynamic frames.
+void Publish(int num_levels, tf2::Time stamp, bool dynamic_only,
+             const SetFunction& set_transform) {
+  geometry_msgs::TransformStamped t;
+  t.header.stamp = stamp;
+  t.transform.translation.x = 1.0;
+  t.transform.rotation.w = 1.0;
+  for (int i = 0; i < num_levels; ++i) {
+    const bool is_static = (i % 2 == 1);
+    if (dynamic_only && is_static) {
+      continue;
+    }
+    const bool branch_root = (i == 0 || i == num_levels / 2);
+    t.header.frame_id = branch_root ? "root" : std::to_string(i - 1);
+    t.child_frame_id = std::to_string(i);
+    t.transform.translation.y = static_cast<double>(stamp % 1000) * 1e-3;
+    set_transform(t, is_static);
+  }
+}
+
+double RunReaders(int num_threads, int lookups_per_thread,
+                  const std::string& target, const std::string& source,
+                  const LookupFunction& lookup, int* failures) {
+  std::atomic<int> failed{0};
+  std::vector<std::thread> threads;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < lookups_per_thread; ++j) {
+        if (!lookup(target, source, 0)) {
+          ++failed;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  *failures = failed.load();
+  return std::chrono::duration<double>(end - start).count();
+}
+
+void RunCase(const char* name, int num_levels, int lookups_per_thread,
+             const SetFunction& set_transform, const LookupFunction& lookup) {
+  Publish(num_levels, kSecond, false, set_transform);
+  Publish(num_levels, 2 * kSecond, false, set_transform);
+
+  const std::string target = std::to_string(num_levels - 1);
+  const std::string source = std::to_string(num_levels / 2 - 1);
+
+  // Single thread, fixed times, no writer: the speed_test.cpp numbers.
+  for (const tf2::Time time : {tf2::Time(0), kSecond, kSecond + kSecond / 2}) {
+    const auto start = std::chrono::steady_clock::now();
+    int failures = 0;
+    for (int i = 0; i < lookups_per_thread; ++i) {
+      if (!lookup(target, source, time)) {
+        ++failures;
+      }
+    }
+    const double seconds = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+    printf("%s: lookup at %.1fs, 1 thread: %.1f ns/lookup, %d failures\n",
+           name, static_cast<double>(time) / kSecond,
+           seconds * 1e9 / lookups_per_thread, failures);
+  }
+
+  // Several readers at Time(0) while the dynamic frames keep moving.
+  std::atomic<bool> stop{false};
+  std::thread writer([&] {
+    tf2::Time stamp = 3 * kSecond;
+    while (!stop.load()) {
+      Publish(num_levels, stamp, true, set_transform);
+      stamp += kSecond / 1000;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+  const int max_threads =
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  for (int threads = 1; threads <= std::max(8, max_threads); threads *= 2) {
+    int failures = 0;
+    const double seconds = RunReaders(threads, lookups_per_thread, target,
+                                      source, lookup, &failures);
+    printf(
+        "%s: %d reader thread(s) + writer: %.2f M lookups/s, "
+        "%.1f ns/lookup/thread, %d failures\n",
+        name, threads, threads * lookups_per_thread / seconds * 1e-6,
+        seconds * 1e9 / lookups_per_thread, failures);
+  }
+  stop = true;
+  writer.join();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int num_levels = argc > 1 ? std::atoi(argv[1]) : 10;
+  const int lookups_per_thread = argc > 2 ? std::atoi(argv[2]) : 200000;
+  printf("%d-level tree, %d lookups per thread\n", num_levels,
+         lookups_per_thread);
+
+  tf2::BufferCore buffer_core;
+  RunCase(
+      "tf2::BufferCore", num_levels, lookups_per_thread,
+      [&buffer_core](const geometry_msgs::TransformStamped& t, bool is_static) {
+        buffer_core.setTransform(t, "benchmark", is_static);
+      },
+      [&buffer_core](const std::string& target, const std::string& source,
+                     tf2::Time time) {
+        try {
+          buffer_core.lookupTransform(target, source, time);
+        } catch (tf2::TransformException& ex) {
+          return false;
+        }
+        return true;
+      });
+
+  LockFreeBufferCore lock_free_core;
+  RunCase(
+      "LockFreeBufferCore", num_levels, lookups_per_thread,
+      [&lock_free_core](const geometry_msgs::TransformStamped& t,
+                        bool is_static) {
+        lock_free_core.SetTransform(t, is_static);
+      },
+      [&lock_free_core](const std::string& target, const std::string& source,
+                        tf2::Time time) {
+        geometry_msgs::TransformStamped transform;
+        return lock_free_core.LookupTransform(target, source, time,
+                                              &transform);
+      });
+  return 0;
+}
@@ -0,0 +1,205 @@
+/******************************************************************************
+ * Copyright 2026 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/transform/lock_free_buffer_core.h"
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tf2/buffer_core.h"
+
+namespace apollo {
+namespace transform {
+
+namespace {
+
+geometry_msgs::TransformStamped MakeTransform(const std::string& parent,
+                                              const std::string& child,
+                                              tf2::Time stamp, double x,
+                                              double y, double yaw) {
+  geometry_msgs::TransformStamped transform;
+  transform.header.stamp = stamp;
+  transform.header.frame_id = parent;
+  transform.child_frame_id = child;
+  transform.transform.translation.x = x;
+  transform.transform.translation.y = y;
+  transform.transform.translation.z = 0.5;
+  transform.transform.rotation.z = std::sin(yaw / 2.0);
+  transform.transform.rotation.w = std::cos(yaw / 2.0);
+  return transform;
+}
+
+void ExpectNear(const geometry_msgs::TransformStamped& expected,
+                const geometry_msgs::TransformStamped& actual) {
+  constexpr double kEpsilon = 1e-9;
+  EXPECT_EQ(expected.header.stamp, actual.header.stamp);
+  EXPECT_EQ(expected.header.frame_id, actual.header.frame_id);
+  EXPECT_EQ(expected.child_frame_id, actual.child_frame_id);
+  const auto& e = expected.transform;
+  const auto& a = actual.transform;
+  EXPECT_NEAR(e.translation.x, a.translation.x, kEpsilon);
+  EXPECT_NEAR(e.translation.y, a.translation.y, kEpsilon);
+  EXPECT_NEAR(e.translation.z, a.translation.z, kEpsilon);
+  // q and -q are the same rotation.
+  const double dot = e.rotation.w * a.rotation.w + e.rotation.x * a.rotation.x +
+                     e.rotation.y * a.rotation.y + e.rotation.z * a.rotation.z;
+  const double sign = dot < 0.0 ? -1.0 : 1.0;
+  EXPECT_NEAR(e.rotation.x, sign * a.rotation.x, kEpsilon);
+  EXPECT_NEAR(e.rotation.y, sign * a.rotation.y, kEpsilon);
+  EXPECT_NEAR(e.rotation.z, sign * a.rotation.z, kEpsilon);
+  EXPECT_NEAR(e.rotation.w, sign * a.rotation.w, kEpsilon);
+}
+
+// world <- localization <- novatel <- {velodyne128, front_6mm}, where
+// localization is dynamic and the sensors are static.
+void FillVehicleTree(tf2::BufferCore* reference, LockFreeBufferCore* core) {
+  const std::vector<geometry_msgs::TransformStamped> statics = {
+      MakeTransform("localization", "novatel", 0, 0.0, 0.1, 0.0),
+      MakeTransform("novatel", "velodyne128", 0, 1.2, -0.3, 0.05),
+      MakeTransform("velodyne128", "front_6mm", 0, 0.4, 0.0, -0.02),
+  };
+  for (const auto& transform : statics) {
+    reference->setTransform(transform, "test", true);
+    EXPECT_TRUE(core->SetTransform(transform, true));
+  }
+  for (int i = 1; i <= 10; ++i) {
+    const auto transform =
+        MakeTransform("world", "localization", i * 100, i * 1.5, i * 0.2,
+                      0.1 * i);
+    reference->setTransform(transform, "test", false);
+    EXPECT_TRUE(core->SetTransform(transform, false));
+  }
+}
+
+}  // namespace
+
+TEST(LockFreeBufferCoreTest, MatchesBufferCore) {
+  tf2::BufferCore reference;
+  LockFreeBufferCore core;
+  FillVehicleTree(&reference, &core);
+
+  const std::vector<std::pair<std::string, std::string>> queries = {
+      {"world", "velodyne128"},   {"world", "front_6mm"},
+      {"novatel", "velodyne128"}, {"velodyne128", "world"},
+      {"front_6mm", "novatel"},   {"localization", "front_6mm"},
+  };
+  for (const auto& query : queries) {
+    for (tf2::Time time : {tf2::Time(0), tf2::Time(100), tf2::Time(250),
+                           tf2::Time(999), tf2::Time(1000)}) {
+      geometry_msgs::TransformStamped actual;
+      std::string error;
+      ASSERT_TRUE(core.LookupTransform(query.first, query.second, time,
+                                       &actual, &error))
+          << error;
+      ExpectNear(reference.lookupTransform(query.first, query.second, time),
+                 actual);
+    }
+  }
+}
+
+TEST(LockFreeBufferCoreTest, Errors) {
+  LockFreeBufferCore core;
+  std::string error;
+  geometry_msgs::TransformStamped transform;
+  EXPECT_FALSE(core.LookupTransform("world", "novatel", 0, &transform, &error));
+
+  EXPECT_TRUE(core.SetTransform(
+      MakeTransform("world", "novatel", 100, 1, 0, 0), false));
+  EXPECT_TRUE(core.SetTransform(
+      MakeTransform("world", "novatel", 200, 2, 0, 0), false));
+  EXPECT_FALSE(core.CanTransform("world", "novatel", 50, &error));
+  EXPECT_FALSE(core.CanTransform("world", "novatel", 201, &error));
+  EXPECT_TRUE(core.CanTransform("world", "novatel", 150, &error));
+
+  // Out of order sample, loop and disconnected tree.
+  EXPECT_FALSE(core.SetTransform(
+      MakeTransform("world", "novatel", 150, 1, 0, 0), false));
+  EXPECT_FALSE(
+      core.SetTransform(MakeTransform("novatel", "world", 0, 1, 0, 0), true));
+  EXPECT_TRUE(
+      core.SetTransform(MakeTransform("map", "camera", 0, 1, 0, 0), true));
+  EXPECT_FALSE(core.CanTransform("world", "camera", 0, &error));
+
+  core.Clear();
+  EXPECT_FALSE(core.CanTransform("world", "novatel", 0, &error));
+  EXPECT_TRUE(
+      core.SetTransform(MakeTransform("world", "novatel", 50, 1, 0, 0), false));
+  EXPECT_TRUE(core.CanTransform("world", "novatel", 50, &error));
+}
+
+TEST(LockFreeBufferCoreTest, RingOverwritesOldestSamples) {
+  LockFreeBufferCore core(8);
+  for (int i = 1; i <= 20; ++i) {
+    EXPECT_TRUE(core.SetTransform(MakeTransform("world", "novatel", i * 10,
+                                                i, 0, 0),
+                                  false));
+  }
+  std::string error;
+  EXPECT_FALSE(core.CanTransform("world", "novatel", 100, &error));
+  geometry_msgs::TransformStamped transform;
+  EXPECT_TRUE(core.LookupTransform("world", "novatel", 175, &transform));
+  EXPECT_NEAR(17.5, transform.transform.translation.x, 1e-9);
+}
+
+TEST(LockFreeBufferCoreTest, ConcurrentReadersAndWriter) {
+  LockFreeBufferCore core(256);
+  EXPECT_TRUE(core.SetTransform(
+      MakeTransform("novatel", "velodyne128", 0, 1.0, 0.0, 0.0), true));
+  EXPECT_TRUE(core.SetTransform(
+      MakeTransform("world", "novatel", 1, 1.0, 0.0, 0.0), false));
+
+  // A reader preempted while the writer laps the whole ring may fail a
+  // lookup, but must never see a torn or mismatched sample.
+  std::atomic<bool> done{false};
+  std::atomic<int> lookups{0};
+  std::atomic<int> torn_reads{0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&core, &done, &lookups, &torn_reads] {
+      geometry_msgs::TransformStamped transform;
+      while (!done.load()) {
+        if (!core.LookupTransform("world", "velodyne128", 0, &transform)) {
+          continue;
+        }
+        ++lookups;
+        // The writer sets x = stamp, plus the static 1.0 offset.
+        const double expected =
+            static_cast<double>(transform.header.stamp) + 1.0;
+        if (std::abs(transform.transform.translation.x - expected) > 1e-9) {
+          ++torn_reads;
+        }
+      }
+    });
+  }
+  for (int i = 2; i < 100000; ++i) {
+    core.SetTransform(MakeTransform("world", "novatel", i, i, 0.0, 0.0), false);
+    if (i % 64 == 0) {
+      std::this_thread::yield();
+    }
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_GT(lookups.load(), 0);
+  EXPECT_EQ(0, torn_reads.load());
+}
+
+}  // namespace transform
+}  // namespace apollo